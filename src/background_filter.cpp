@@ -0,0 +1,140 @@
+#include "background_filter.h"
+#include "streaming_filter.h"
+#include "utils/trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+BackgroundFilter::BackgroundFilter(Options options)
+    : options_(options) {
+    worker_ = std::thread([this] { workerLoop(); });
+}
+
+BackgroundFilter::~BackgroundFilter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        cancelBelow_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_release);
+    }
+    wake_.notify_one();
+    worker_.join();
+}
+
+uint64_t BackgroundFilter::start(Signal input, std::unique_ptr<SignalProcessor> filter) {
+    if (!filter) throw std::invalid_argument("BackgroundFilter: filter must not be null");
+
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = ++nextJob_;
+        pending_    = Job{id, std::move(input), std::move(filter)};
+        hasPending_ = true;
+        busy_.store(true, std::memory_order_release);
+        // Всё, что было запущено раньше, больше не нужно
+        cancelBelow_.store(id, std::memory_order_release);
+    }
+    wake_.notify_one();
+    return id;
+}
+
+void BackgroundFilter::cancel() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelBelow_.store(nextJob_ + 1, std::memory_order_release);
+}
+
+void BackgroundFilter::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stop_ || hasPending_; });
+            if (stop_) return;
+            job = std::move(pending_);
+            hasPending_ = false;
+        }
+
+        runJob(job);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!hasPending_) busy_.store(false, std::memory_order_release);
+    }
+}
+
+void BackgroundFilter::runJob(Job& job) {
+    TRACE_SCOPE("BackgroundFilter::job");
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    auto elapsedUs = [&] {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    };
+    auto cancelled = [&] { return job.id < cancelBelow_.load(std::memory_order_acquire); };
+
+    const Signal& input = job.input;
+    const size_t  total = input.size();
+    Signal output(total, std::numeric_limits<double>::quiet_NaN());
+
+    if (cancelled()) {
+        publish(job, output, 0, FilterSnapshot::State::CANCELLED, 0);
+        return;
+    }
+    publish(job, output, 0, FilterSnapshot::State::RUNNING, 0);
+
+    try {
+        const size_t reach = job.filter->getReach();
+        if (reach == SignalProcessor::kNonLocal) {
+            // Один участок — весь сигнал
+            Signal result;
+            job.filter->processInto(input, result);
+            if (cancelled()) {
+                publish(job, output, 0, FilterSnapshot::State::CANCELLED, elapsedUs());
+                return;
+            }
+            publish(job, result, result.size(), FilterSnapshot::State::FINISHED, elapsedUs());
+            return;
+        }
+
+        // Участки с перекрытием h дают тот же результат, что и весь сигнал
+        const size_t chunk = std::max({options_.chunkSize, 8 * reach, size_t(1)});
+        Signal window, filtered;
+        for (size_t begin = 0; begin < total; begin += chunk) {
+            if (cancelled()) {
+                publish(job, output, begin, FilterSnapshot::State::CANCELLED, elapsedUs());
+                return;
+            }
+            const size_t end = std::min(total, begin + chunk);
+            processLocalRange(*job.filter, input, begin, end, window, filtered,
+                              output.data() + begin);
+
+            publish(job, output, end,
+                    end == total ? FilterSnapshot::State::FINISHED : FilterSnapshot::State::RUNNING,
+                    elapsedUs());
+        }
+        if (total == 0) publish(job, output, 0, FilterSnapshot::State::FINISHED, elapsedUs());
+    } catch (const std::exception& e) {
+        publish(job, output, 0, FilterSnapshot::State::FAILED, elapsedUs(), e.what());
+    }
+}
+
+void BackgroundFilter::publish(const Job& job, const Signal& output, size_t done,
+                               FilterSnapshot::State state, long long elapsedUs,
+                               const std::string& error) {
+    FilterSnapshot& s = snapshots_.writeBuffer();
+
+    // Буфер мог отстать на пару публикаций этого же задания — дописываем
+    // только недостающее; буфер прошлого задания начинается заново
+    if (s.job != job.id || s.output.size() != output.size() || done < s.done) {
+        s.output.assign(output.size(), std::numeric_limits<double>::quiet_NaN());
+        s.done = 0;
+    }
+    std::copy(output.begin() + s.done, output.begin() + done, s.output.begin() + s.done);
+
+    s.done      = done;
+    s.total     = output.size();
+    s.job       = job.id;
+    s.state     = state;
+    s.elapsedUs = elapsedUs;
+    s.error     = error;
+    snapshots_.publish();
+}
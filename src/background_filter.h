@@ -0,0 +1,127 @@
+#ifndef BACKGROUND_FILTER_H
+#define BACKGROUND_FILTER_H
+
+#include "signal_processor.h"
+#include "utils/triple_buffer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Параметры фоновой фильтрации
+ */
+struct BackgroundFilterOptions {
+    size_t chunkSize = 65536;   ///< Отсчётов в участке локального фильтра (не меньше 8·h)
+};
+
+/**
+ * Снимок хода фоновой фильтрации
+ */
+struct FilterSnapshot {
+    enum class State {
+        IDLE,        ///< Заданий не было
+        RUNNING,
+        FINISHED,
+        CANCELLED,
+        FAILED       ///< Фильтр бросил исключение (error)
+    };
+
+    SignalProcessor::Signal output;          ///< Длины total; отсчёты [done, total) — NaN
+    size_t                  done      = 0;
+    size_t                  total     = 0;
+    uint64_t                job       = 0;   ///< Номер задания (start())
+    State                   state     = State::IDLE;
+    long long               elapsedUs = 0;
+    std::string             error;
+
+    double progress() const { return total ? static_cast<double>(done) / total : 0.0; }
+};
+
+/**
+ * Фильтрация в фоновом потоке с выдачей частичных результатов
+ *
+ * start() передаёт сигнал и фильтр рабочему потоку и сразу возвращается;
+ * новое задание отменяет текущее. Локальный фильтр (getReach() конечен)
+ * обрабатывается участками по chunkSize отсчётов с перекрытием h — результат
+ * совпадает с process() всего сигнала, а готовое начало появляется сразу.
+ * Нелокальный фильтр (Винер, Калман, спектральное вычитание) считается
+ * целиком, одним участком.
+ *
+ * После каждого участка рабочий поток публикует снимок через TripleBuffer:
+ * поток отрисовки вызывает poll() каждый кадр, не блокируясь и не дожидаясь
+ * фильтра. Снимки обновляются дописыванием новых отсчётов, а не полным
+ * копированием.
+ *
+ * Отмена (cancel() или новый start()) срабатывает на границе участка:
+ * текущий process() нелокального фильтра доводится до конца, но его
+ * результат отбрасывается. Деструктор отменяет задание и ждёт поток.
+ */
+class BackgroundFilter {
+public:
+    using Signal  = SignalProcessor::Signal;
+    using Options = BackgroundFilterOptions;
+
+    explicit BackgroundFilter(Options options = Options());
+    ~BackgroundFilter();
+
+    BackgroundFilter(const BackgroundFilter&) = delete;
+    BackgroundFilter& operator=(const BackgroundFilter&) = delete;
+
+    /**
+     * Начать фильтрацию (текущее задание отменяется)
+     * @return Номер задания (FilterSnapshot::job)
+     * @throws std::invalid_argument если filter пуст
+     */
+    uint64_t start(Signal input, std::unique_ptr<SignalProcessor> filter);
+
+    /** Отменить текущее задание (снимок перейдёт в CANCELLED) */
+    void cancel();
+
+    /**
+     * Поток отрисовки: забрать последний снимок
+     * @return true — snapshot() обновился с прошлого вызова
+     */
+    bool poll() { return snapshots_.update(); }
+
+    /** Поток отрисовки: последний забранный снимок */
+    const FilterSnapshot& snapshot() const { return snapshots_.readBuffer(); }
+
+    /** Задание выполняется или ждёт рабочего потока */
+    bool busy() const { return busy_.load(std::memory_order_acquire); }
+
+private:
+    struct Job {
+        uint64_t                         id = 0;
+        Signal                           input;
+        std::unique_ptr<SignalProcessor> filter;
+    };
+
+    void workerLoop();
+    void runJob(Job& job);
+
+    /** Опубликовать ход задания: в снимок дописываются output[snapshot.done, done) */
+    void publish(const Job& job, const Signal& output, size_t done, FilterSnapshot::State state,
+                 long long elapsedUs, const std::string& error = std::string());
+
+    Options                      options_;
+    TripleBuffer<FilterSnapshot> snapshots_;
+
+    std::mutex              mutex_;     ///< Только передача заданий, не снимков
+    std::condition_variable wake_;
+    Job                     pending_;
+    bool                    hasPending_ = false;
+    bool                    stop_       = false;
+    uint64_t                nextJob_    = 0;
+
+    std::atomic<uint64_t> cancelBelow_{0};   ///< Задания с меньшим номером отменены
+    std::atomic<bool>     busy_{false};
+    std::thread           worker_;
+};
+
+#endif // BACKGROUND_FILTER_H
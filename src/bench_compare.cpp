@@ -0,0 +1,85 @@
+/**
+ * bench_compare — сравнение JSON-результатов бенчмарков с базовой линией
+ *
+ * Запуск:
+ *   ./build/bench_compare [опции] BASELINE.json CURRENT.json
+ *
+ * Принимает отчёты pipeline_benchmark --json и
+ * PerformanceTester::saveResultsToJSON (results/benchmark_results.json).
+ * Код выхода: 0 — регрессий нет, 2 — значимое замедление, потеря SNR, рост
+ * числа выделений или несопоставимые наборы сигналов, 1 — ошибка.
+ */
+
+#include "utils/bench_report.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+static void printUsage(const char* prog) {
+    std::cout << "Использование: " << prog << " [опции] BASELINE.json CURRENT.json\n\n"
+              << "Опции:\n"
+              << "  -h, --help            Показать эту справку\n"
+              << "  --time-tolerance X    Допустимое замедление, доля (по умолчанию 0.05)\n"
+              << "  --snr-tolerance DB    Допустимая потеря SNR, дБ (по умолчанию 0.1)\n";
+}
+
+static void printEnvironment(const char* title, const BenchReport& report) {
+    const BenchEnvironment& env = report.environment;
+    std::cout << title << ": " << report.benchmark << ", " << env.gitRevision
+              << ", " << env.timestamp << "\n"
+              << "  " << env.compiler << " [" << env.buildFlags << "]\n"
+              << "  " << env.cpuModel << ", потоков: " << env.hardwareThreads << "\n";
+    for (const std::string& warning : env.warnings) {
+        std::cout << "  ВНИМАНИЕ: " << warning << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchThresholds thresholds;
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        try {
+            if (a == "-h" || a == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (a == "--time-tolerance" && hasValue) {
+                thresholds.timeTolerance = std::stod(argv[++i]);
+            } else if (a == "--snr-tolerance" && hasValue) {
+                thresholds.snrTolerance = std::stod(argv[++i]);
+            } else if (a.rfind("--", 0) != 0) {
+                positional.push_back(a);
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Неверное значение опции " << a << "\n";
+            return 1;
+        }
+    }
+
+    if (positional.size() != 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        const BenchReport baseline = readBenchJson(positional[0]);
+        const BenchReport current  = readBenchJson(positional[1]);
+
+        printEnvironment("Базовая линия", baseline);
+        printEnvironment("Текущий запуск", current);
+        std::cout << "\n";
+
+        const BenchComparison cmp = compareBenchReports(baseline, current, thresholds);
+        std::cout << formatBenchComparison(cmp, thresholds);
+        return cmp.failed() ? 2 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << "\n";
+        return 1;
+    }
+}
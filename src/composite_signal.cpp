@@ -0,0 +1,467 @@
+#include "composite_signal.h"
+#include "utils/parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+/// Отсчётов в плитке параллельного расчёта
+constexpr size_t kTileSize  = 16384;
+
+/// Блок табличного синуса: sin(a + b·k) = sin a·cos bk + cos a·sin bk,
+/// k < kSineBlock; sin a, cos a — точно в начале блока (выровнено глобально)
+constexpr size_t kSineBlock = 64;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Встроенная спецификация: прежние signal0()…signal9() generate_extended_data
+// ─────────────────────────────────────────────────────────────────────────────
+
+const char* const kDefaultSpecText = R"(# Составные сигналы generate_extended_data (длина по умолчанию 4096)
+
+signal 0: Sine → LFM chirp → Sine
+sine      0    1/3  freq=0.02
+sine      1/3  2/3  freq=0.02 sweep=0.10
+sine      2/3  1    freq=0.10
+
+signal 1: Square → Triangle → Fast Square
+square    0    1/3  freq=0.03
+triangle  1/3  2/3  freq=0.03
+square    2/3  1    freq=0.06
+
+signal 2: Exponential envelope × Sine (rise+decay)
+sine      0    1/2  freq=0.04 env=rise tau=1/6
+sine      1/2  1    freq=0.04 env=decay tau=1/6
+
+signal 3: Multiple Gaussian pulses (different widths)
+gaussian  0    1    center=0.10 width=30/4096 amp=1.0
+gaussian  0    1    center=0.20 width=50/4096 amp=0.7
+gaussian  0    1    center=0.30 width=20/4096 amp=1.3
+gaussian  0    1    center=0.42 width=80/4096 amp=0.5
+gaussian  0    1    center=0.55 width=35/4096 amp=1.1
+gaussian  0    1    center=0.65 width=60/4096 amp=0.8
+gaussian  0    1    center=0.78 width=25/4096 amp=1.5
+gaussian  0    1    center=0.90 width=45/4096 amp=0.6
+
+signal 4: AM-modulated Sine (carrier 0.1, mod 0.005)
+sine      0    1    freq=0.10 env=am fm=0.005 depth=0.8
+
+signal 5: Sawtooth with increasing frequency (chirp-like)
+sawtooth  0    1    freq=0.01 sweep=0.12
+
+signal 6: Trapezoid + Steps + Sawtooth + Rectangular pulse
+trapezoid 0       1/4     rise=0.25
+constant  1/4     0.3325  amp=-0.5
+constant  0.3325  0.415   amp=0.5
+constant  0.415   1/2     amp=1.0
+sawtooth  1/2     3/4     freq=0.04
+constant  0.84375 0.90625 amp=1.0
+
+signal 7: Sine with sudden phase jumps (0 → π/2 → π)
+sine      0    1/3  freq=0.05
+sine      1/3  2/3  freq=0.05 phase=pi/2
+sine      2/3  1    freq=0.05 phase=pi
+
+signal 8: Two-frequency beating (f1=0.08, f2=0.085)
+sine      0    1    freq=0.08  amp=0.5
+sine      0    1    freq=0.085 amp=0.5
+
+signal 9: Multi-type: Sine → Square → Triangle → Gaussian pulse
+sine      0    1/4  freq=0.04
+square    1/4  1/2  freq=0.04
+triangle  1/2  3/4  freq=0.04
+gaussian  3/4  1    center=0.875 width=1/16
+)";
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Разбор
+// ─────────────────────────────────────────────────────────────────────────────
+
+[[noreturn]] void specError(size_t line, const std::string& message) {
+    throw std::runtime_error("Спецификация сигнала, строка " + std::to_string(line) +
+                             ": " + message);
+}
+
+double parsePlain(const std::string& text, size_t line) {
+    size_t pos = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &pos);
+    } catch (const std::exception&) {
+        pos = 0;
+    }
+    if (text.empty() || pos != text.size()) specError(line, "не число: '" + text + "'");
+    return value;
+}
+
+/// Число вида 0.25, 1/3, pi, -pi/2, 3pi/4
+double parseNumber(std::string text, size_t line) {
+    double denominator = 1.0;
+    if (const size_t slash = text.find('/'); slash != std::string::npos) {
+        denominator = parsePlain(text.substr(slash + 1), line);
+        if (denominator == 0.0) specError(line, "деление на ноль в '" + text + "'");
+        text.resize(slash);
+    }
+
+    double numerator = 1.0;
+    if (text.size() >= 2 && text.compare(text.size() - 2, 2, "pi") == 0) {
+        text.resize(text.size() - 2);
+        const double factor = text.empty() ? 1.0 : text == "-" ? -1.0 : parsePlain(text, line);
+        numerator = factor * M_PI;
+    } else {
+        numerator = parsePlain(text, line);
+    }
+    return numerator / denominator;
+}
+
+Waveform parseWaveform(const std::string& name, size_t line) {
+    if (name == "sine")      return Waveform::SINE;
+    if (name == "square")    return Waveform::SQUARE;
+    if (name == "triangle")  return Waveform::TRIANGLE;
+    if (name == "sawtooth")  return Waveform::SAWTOOTH;
+    if (name == "gaussian")  return Waveform::GAUSSIAN;
+    if (name == "trapezoid") return Waveform::TRAPEZOID;
+    if (name == "constant")  return Waveform::CONSTANT;
+    specError(line, "неизвестная форма волны '" + name + "'");
+}
+
+Envelope parseEnvelope(const std::string& name, size_t line) {
+    if (name == "none")  return Envelope::NONE;
+    if (name == "rise")  return Envelope::RISE;
+    if (name == "decay") return Envelope::DECAY;
+    if (name == "am")    return Envelope::AM;
+    specError(line, "неизвестная огибающая '" + name + "'");
+}
+
+void setParameter(SignalSegment& seg, const std::string& key, const std::string& value,
+                  size_t line) {
+    if (key == "env") {
+        seg.envelope = parseEnvelope(value, line);
+        return;
+    }
+
+    const double v = parseNumber(value, line);
+    if      (key == "amp")    seg.amplitude    = v;
+    else if (key == "freq")   seg.frequency    = v;
+    else if (key == "sweep")  seg.sweepTo      = v;
+    else if (key == "phase")  seg.phase        = v;
+    else if (key == "duty")   seg.dutyCycle    = v;
+    else if (key == "center") seg.center       = v;
+    else if (key == "width")  seg.width        = v;
+    else if (key == "rise")   seg.rise         = v;
+    else if (key == "tau")    seg.tau          = v;
+    else if (key == "fm")     seg.modFrequency = v;
+    else if (key == "depth")  seg.modDepth     = v;
+    else if (key == "fade")   seg.fade         = v;
+    else specError(line, "неизвестный параметр '" + key + "'");
+}
+
+void validateSegment(const SignalSegment& seg, size_t line) {
+    if (!(seg.begin >= 0.0 && seg.begin < seg.end && seg.end <= 1.0)) {
+        specError(line, "границы участка должны удовлетворять 0 ≤ begin < end ≤ 1");
+    }
+    if (seg.width <= 0.0 || seg.tau <= 0.0) specError(line, "width и tau должны быть > 0");
+    if (seg.dutyCycle <= 0.0 || seg.dutyCycle >= 1.0) specError(line, "duty должна быть в (0, 1)");
+    if (seg.rise <= 0.0 || seg.rise > 0.5) specError(line, "rise должна быть в (0, 0.5]");
+    if (seg.fade < 0.0) specError(line, "fade не может быть отрицательной");
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Построение
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Участок, привязанный к конкретной длине сигнала
+ */
+struct SegmentPlan {
+    const SignalSegment* seg;
+    size_t first, last;         ///< Отсчёты с ненулевым весом [first, last)
+    double start, span;         ///< Начало и длина участка в отсчётах (точно)
+    double fadeIn, fadeOut;     ///< Ширина переходов в отсчётах (0 — резко)
+    double stop;                ///< start + span
+    double length;              ///< Длина всего сигнала
+
+    std::array<double, kSineBlock> cosTable, sinTable;  ///< Для синуса без свипа
+
+    SegmentPlan(const SignalSegment& s, size_t numSamples) : seg(&s) {
+        const double L = static_cast<double>(numSamples);
+        length = L;
+        start = s.begin * L;
+        stop  = s.end * L;
+        span  = stop - start;
+
+        const double w = s.fade * L;
+        fadeIn  = s.begin > 0.0 ? w : 0.0;
+        fadeOut = s.end   < 1.0 ? w : 0.0;
+
+        auto clampIndex = [L](double x) {
+            return static_cast<size_t>(std::clamp(x, 0.0, L));
+        };
+        first = fadeIn  > 0.0 ? clampIndex(std::floor(start - 0.5 * fadeIn))
+                              : clampIndex(std::round(start));
+        last  = fadeOut > 0.0 ? clampIndex(std::ceil(stop + 0.5 * fadeOut))
+                              : clampIndex(std::round(stop));
+
+        const double omega = 2.0 * M_PI * s.frequency;
+        for (size_t k = 0; k < kSineBlock; ++k) {
+            cosTable[k] = std::cos(omega * static_cast<double>(k));
+            sinTable[k] = std::sin(omega * static_cast<double>(k));
+        }
+    }
+};
+
+/// Дробная часть x (x − ⌊x⌋ ∈ [0, 1))
+inline double fraction(double x) {
+    return x - std::floor(x);
+}
+
+/// Мгновенная частота: постоянная или линейный свип по участку
+inline double instantFrequency(const SegmentPlan& p, double t) {
+    const SignalSegment& s = *p.seg;
+    return s.sweepTo ? s.frequency + (*s.sweepTo - s.frequency) * (t - p.start) / p.span
+                     : s.frequency;
+}
+
+/// Форма волны участка на отсчётах [lo, hi) → out[0 .. hi − lo)
+void renderWaveform(const SegmentPlan& p, size_t lo, size_t hi, double* out) {
+    const SignalSegment& s = *p.seg;
+    const size_t n = hi - lo;
+    const double A = s.amplitude;
+    const double cycles0 = s.phase / (2.0 * M_PI);
+
+    switch (s.waveform) {
+        case Waveform::SINE:
+            if (!s.sweepTo) {
+                // Табличный синус: блоки выровнены по глобальному номеру отсчёта,
+                // поэтому значения не зависят от разбиения на плитки
+                const double omega = 2.0 * M_PI * s.frequency;
+                size_t i = lo;
+                while (i < hi) {
+                    const size_t base = i - i % kSineBlock;
+                    const size_t end  = std::min(hi, base + kSineBlock);
+                    const double a    = omega * static_cast<double>(base) + s.phase;
+                    const double sa = A * std::sin(a), ca = A * std::cos(a);
+                    const double* ct = p.cosTable.data() + (i - base);
+                    const double* st = p.sinTable.data() + (i - base);
+                    double* dst = out + (i - lo);
+                    for (size_t k = 0; k < end - i; ++k) dst[k] = sa * ct[k] + ca * st[k];
+                    i = end;
+                }
+            } else {
+                for (size_t k = 0; k < n; ++k) {
+                    const double t = static_cast<double>(lo + k);
+                    out[k] = A * std::sin(2.0 * M_PI * instantFrequency(p, t) * t + s.phase);
+                }
+            }
+            break;
+
+        case Waveform::SQUARE:
+            for (size_t k = 0; k < n; ++k) {
+                const double t = static_cast<double>(lo + k);
+                out[k] = fraction(instantFrequency(p, t) * t + cycles0) < s.dutyCycle ? A : -A;
+            }
+            break;
+
+        case Waveform::TRIANGLE:
+            for (size_t k = 0; k < n; ++k) {
+                const double t  = static_cast<double>(lo + k);
+                const double ph = fraction(instantFrequency(p, t) * t + cycles0);
+                out[k] = A * ((ph < 0.5) ? (4.0 * ph - 1.0) : (3.0 - 4.0 * ph));
+            }
+            break;
+
+        case Waveform::SAWTOOTH:
+            for (size_t k = 0; k < n; ++k) {
+                const double t = static_cast<double>(lo + k);
+                out[k] = A * (2.0 * fraction(instantFrequency(p, t) * t + cycles0) - 1.0);
+            }
+            break;
+
+        case Waveform::GAUSSIAN: {
+            const double center = s.center ? *s.center * p.length : p.start + 0.5 * p.span;
+            const double sigma  = s.width * p.length;
+            const double inv    = 1.0 / (2.0 * sigma * sigma);
+            for (size_t k = 0; k < n; ++k) {
+                const double dt = static_cast<double>(lo + k) - center;
+                out[k] = A * std::exp(-dt * dt * inv);
+            }
+            break;
+        }
+
+        case Waveform::TRAPEZOID: {
+            const double edge = s.rise * p.span;
+            for (size_t k = 0; k < n; ++k) {
+                const double tt = static_cast<double>(lo + k) - p.start;
+                double v;
+                if (tt < edge)                  v = tt / edge;
+                else if (tt < p.span - edge)    v = 1.0;
+                else                            v = 1.0 - (tt - (p.span - edge)) / edge;
+                out[k] = A * std::clamp(v, 0.0, 1.0);
+            }
+            break;
+        }
+
+        case Waveform::CONSTANT:
+            std::fill(out, out + n, A);
+            break;
+    }
+}
+
+/// Огибающая и веса переходов
+void applyEnvelope(const SegmentPlan& p, size_t lo, size_t hi, double* out) {
+    const SignalSegment& s = *p.seg;
+    const size_t n = hi - lo;
+
+    switch (s.envelope) {
+        case Envelope::NONE:
+            break;
+        case Envelope::RISE:
+        case Envelope::DECAY: {
+            const double T = s.tau * p.length;
+            const bool rise = s.envelope == Envelope::RISE;
+            for (size_t k = 0; k < n; ++k) {
+                const double e = std::exp(-(static_cast<double>(lo + k) - p.start) / T);
+                out[k] *= rise ? 1.0 - e : e;
+            }
+            break;
+        }
+        case Envelope::AM:
+            for (size_t k = 0; k < n; ++k) {
+                const double t = static_cast<double>(lo + k);
+                out[k] *= 1.0 + s.modDepth * std::sin(2.0 * M_PI * s.modFrequency * t);
+            }
+            break;
+    }
+
+    if (p.fadeIn > 0.0 || p.fadeOut > 0.0) {
+        const double inStart = p.start - 0.5 * p.fadeIn;
+        const double outEnd  = p.stop  + 0.5 * p.fadeOut;
+        for (size_t k = 0; k < n; ++k) {
+            const double t = static_cast<double>(lo + k);
+            double w = 1.0;
+            if (p.fadeIn > 0.0)  w *= std::clamp((t - inStart) / p.fadeIn, 0.0, 1.0);
+            if (p.fadeOut > 0.0) w *= std::clamp((outEnd - t) / p.fadeOut, 0.0, 1.0);
+            out[k] *= w;
+        }
+    }
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Публичный интерфейс
+// ─────────────────────────────────────────────────────────────────────────────
+
+std::vector<CompositeSignalSpec> parseCompositeSpecs(std::istream& in) {
+    std::vector<CompositeSignalSpec> specs;
+    std::string text;
+    size_t line = 0;
+
+    while (std::getline(in, text)) {
+        ++line;
+        if (const size_t hash = text.find('#'); hash != std::string::npos) text.resize(hash);
+
+        std::istringstream tokens(text);
+        std::string head;
+        if (!(tokens >> head)) continue;
+
+        if (head == "signal") {
+            CompositeSignalSpec spec;
+            std::getline(tokens >> std::ws, spec.description);
+            while (!spec.description.empty() && std::isspace(static_cast<unsigned char>(spec.description.back()))) {
+                spec.description.pop_back();
+            }
+            specs.push_back(std::move(spec));
+            continue;
+        }
+
+        if (specs.empty()) specError(line, "участок до первой строки 'signal'");
+
+        SignalSegment seg;
+        seg.waveform = parseWaveform(head, line);
+
+        std::string begin, end;
+        if (!(tokens >> begin >> end)) specError(line, "ожидались границы участка begin end");
+        seg.begin = parseNumber(begin, line);
+        seg.end   = parseNumber(end, line);
+
+        std::string param;
+        while (tokens >> param) {
+            const size_t eq = param.find('=');
+            if (eq == std::string::npos || eq == 0 || eq + 1 == param.size()) {
+                specError(line, "ожидался параметр key=value, получено '" + param + "'");
+            }
+            setParameter(seg, param.substr(0, eq), param.substr(eq + 1), line);
+        }
+
+        validateSegment(seg, line);
+        specs.back().segments.push_back(seg);
+    }
+
+    for (const auto& spec : specs) {
+        if (spec.segments.empty()) {
+            throw std::runtime_error("Спецификация сигнала: у '" + spec.description +
+                                     "' нет ни одного участка");
+        }
+    }
+    return specs;
+}
+
+std::vector<CompositeSignalSpec> loadCompositeSpecs(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    return parseCompositeSpecs(file);
+}
+
+const std::string& defaultCompositeSpecText() {
+    static const std::string text = kDefaultSpecText;
+    return text;
+}
+
+std::vector<CompositeSignalSpec> defaultCompositeSpecs() {
+    std::istringstream in(defaultCompositeSpecText());
+    return parseCompositeSpecs(in);
+}
+
+SignalProcessor::Signal renderCompositeSignal(const CompositeSignalSpec& spec,
+                                              size_t length,
+                                              size_t numThreads) {
+    SignalProcessor::Signal out(length, 0.0);
+    if (length == 0) return out;
+
+    std::vector<SegmentPlan> plans;
+    plans.reserve(spec.segments.size());
+    for (const auto& seg : spec.segments) plans.emplace_back(seg, length);
+
+    const size_t numTiles = (length + kTileSize - 1) / kTileSize;
+    parallelFor(numTiles, numThreads, [&](size_t tile) {
+        const size_t a = tile * kTileSize;
+        const size_t b = std::min(length, a + kTileSize);
+        std::vector<double> scratch(b - a);
+
+        // Участки прибавляются в порядке спецификации — сумма не зависит от плиток
+        for (const SegmentPlan& p : plans) {
+            const size_t lo = std::max(a, p.first);
+            const size_t hi = std::min(b, p.last);
+            if (lo >= hi) continue;
+
+            renderWaveform(p, lo, hi, scratch.data());
+            applyEnvelope(p, lo, hi, scratch.data());
+            double* dst = out.data() + lo;
+            for (size_t k = 0; k < hi - lo; ++k) dst[k] += scratch[k];
+        }
+    });
+
+    return out;
+}
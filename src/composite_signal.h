@@ -0,0 +1,126 @@
+#ifndef COMPOSITE_SIGNAL_H
+#define COMPOSITE_SIGNAL_H
+
+/**
+ * Составные сигналы, заданные декларативно.
+ *
+ * Сигнал — список участков. Участок занимает долю [begin, end) общей длины,
+ * описывается формой волны и параметрами; перекрывающиеся участки
+ * складываются. Поскольку границы, центры и ширины заданы в долях длины,
+ * одна спецификация даёт сигнал любой длины.
+ *
+ * Текстовый формат (одна строка — один участок):
+ *
+ *   # комментарий
+ *   signal Sine → LFM chirp → Sine           ← начало нового сигнала, описание
+ *   sine      0    1/3  freq=0.02
+ *   sine      1/3  2/3  freq=0.02 sweep=0.10 fade=0.01
+ *   sine      2/3  1    freq=0.10
+ *
+ * Формы: sine, square, triangle, sawtooth, gaussian, trapezoid, constant.
+ * Числа допускают дроби и множитель pi: 1/3, pi/2, 3pi/4, 0.25.
+ *
+ * Параметры (key=value):
+ *   amp     — амплитуда (1)
+ *   freq    — частота, циклов на отсчёт (0.05); периодические формы
+ *   sweep   — конечная частота линейного свипа по участку (нет)
+ *   phase   — начальная фаза, рад (0)
+ *   duty    — скважность меандра (0.5)
+ *   center  — центр гауссова импульса, доля общей длины (середина участка)
+ *   width   — СКО гауссова импульса, доля общей длины (0.01)
+ *   rise    — фронт трапеции, доля участка (0.25)
+ *   env     — огибающая: none, rise (1 − e^{−τ/T}), decay (e^{−τ/T}), am
+ *   tau     — постоянная времени огибающей T, доля общей длины (1/6)
+ *   fm      — частота AM-огибающей (0.005)
+ *   depth   — глубина AM-модуляции (0.8)
+ *   fade    — ширина линейного перехода на внутренних границах, доля
+ *             общей длины (0 — резкий переход); два соседних участка
+ *             с одинаковым fade дают плавную смену режима
+ *
+ * Отсчёт n относится к участку, если round(begin·L) ≤ n < round(end·L).
+ */
+
+#include "signal_processor.h"
+
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Форма волны участка
+ */
+enum class Waveform {
+    SINE,
+    SQUARE,
+    TRIANGLE,
+    SAWTOOTH,
+    GAUSSIAN,
+    TRAPEZOID,
+    CONSTANT
+};
+
+/**
+ * Огибающая участка (время отсчитывается от начала участка)
+ */
+enum class Envelope {
+    NONE,
+    RISE,
+    DECAY,
+    AM
+};
+
+/**
+ * Участок составного сигнала
+ */
+struct SignalSegment {
+    Waveform              waveform     = Waveform::SINE;
+    double                begin        = 0.0;
+    double                end          = 1.0;
+    double                amplitude    = 1.0;
+    double                frequency    = 0.05;
+    std::optional<double> sweepTo;                      ///< Конечная частота свипа
+    double                phase        = 0.0;
+    double                dutyCycle    = 0.5;
+    std::optional<double> center;                       ///< По умолчанию — середина участка
+    double                width        = 0.01;
+    double                rise         = 0.25;
+    Envelope              envelope     = Envelope::NONE;
+    double                tau          = 1.0 / 6.0;
+    double                modFrequency = 0.005;
+    double                modDepth     = 0.8;
+    double                fade         = 0.0;
+};
+
+/**
+ * Спецификация одного сигнала
+ */
+struct CompositeSignalSpec {
+    std::string                description;
+    std::vector<SignalSegment> segments;
+};
+
+/**
+ * Разобрать текстовую спецификацию (формат — см. начало файла)
+ * @throws std::runtime_error с номером строки при синтаксической ошибке
+ */
+std::vector<CompositeSignalSpec> parseCompositeSpecs(std::istream& in);
+
+/** Загрузить спецификацию из файла */
+std::vector<CompositeSignalSpec> loadCompositeSpecs(const std::string& filename);
+
+/** Текст встроенной спецификации — десять составных сигналов generate_extended_data */
+const std::string& defaultCompositeSpecText();
+
+/** Встроенные спецификации (разобранный defaultCompositeSpecText()) */
+std::vector<CompositeSignalSpec> defaultCompositeSpecs();
+
+/**
+ * Построить сигнал длиной length. Отсчёты считаются плитками параллельно;
+ * результат не зависит от числа потоков.
+ */
+SignalProcessor::Signal renderCompositeSignal(const CompositeSignalSpec& spec,
+                                              size_t length,
+                                              size_t numThreads = 0);
+
+#endif // COMPOSITE_SIGNAL_H
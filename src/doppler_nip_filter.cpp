@@ -1,11 +1,13 @@
 #include "doppler_nip_filter.h"
+#include "utils/csv_reader.h"
+#include "utils/csv_writer.h"
+#include "utils/signal_file.h"
+#include "utils/trace.h"
 
 #include <cmath>
 #include <numeric>
 #include <algorithm>
 #include <stdexcept>
-#include <fstream>
-#include <sstream>
 #include <iostream>
 #include <iomanip>
 
@@ -47,6 +49,7 @@ std::string DopplerNipFilter::getName() const
 
 ComplexSignal DopplerNipFilter::computeDFT(const ComplexSignal& x)
 {
+    TRACE_SCOPE("DopplerNipFilter::computeDFT");
     const size_t N = x.size();
     if (N == 0) return CVector();
 
@@ -73,6 +76,7 @@ ComplexSignal DopplerNipFilter::computeDFT(const ComplexSignal& x)
 
 ComplexSignal DopplerNipFilter::computeIDFT(const ComplexSignal& Y)
 {
+    TRACE_SCOPE("DopplerNipFilter::computeIDFT");
     const size_t N = Y.size();
     if (N == 0) return CVector();
 
@@ -99,6 +103,7 @@ ComplexSignal DopplerNipFilter::computeIDFT(const ComplexSignal& Y)
 
 NipDetectionResult DopplerNipFilter::detectNip(const ComplexSignal& Y) const
 {
+    TRACE_SCOPE("DopplerNipFilter::detectNip");
     NipDetectionResult result;
     const size_t N = Y.size();
     if (N < 2) return result;
@@ -201,6 +206,7 @@ void DopplerNipFilter::compensateNip(ComplexSignal& Y,
                                      const NipDetectionResult& det,
                                      int N)
 {
+    TRACE_SCOPE("DopplerNipFilter::compensateNip");
     if (!det.detected || N <= 0) return;
 
     const double nipLevelPerBin = det.amplitude / static_cast<double>(N);
@@ -249,6 +255,7 @@ SignalProcessor::Signal DopplerNipFilter::getSpectrumDiff() const
 
 ComplexSignal DopplerNipFilter::process(const ComplexSignal& burstSamples)
 {
+    TRACE_SCOPE("DopplerNipFilter::process");
     const size_t N = burstSamples.size();
     if (N == 0) return CVector();
 
@@ -308,6 +315,13 @@ ComplexSignal DopplerNipFilter::process(const SignalProcessor::Signal& iChannel,
     return process(cs);
 }
 
+const NipDetectionResult& DopplerNipFilter::detect(const ComplexSignal& burstSamples)
+{
+    lastDetection_ = burstSamples.empty() ? NipDetectionResult()
+                                          : detectNip(computeDFT(burstSamples));
+    return lastDetection_;
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Утилиты
 // ─────────────────────────────────────────────────────────────────────────────
@@ -342,38 +356,36 @@ SignalProcessor::Signal DopplerNipFilter::getMagnitude(const ComplexSignal& cs)
 
 ComplexSignal DopplerNipFilter::loadFromCSV(const std::string& filename)
 {
-    std::ifstream file(filename);
-    if (!file.is_open())
+    // Пропуск комментариев '#' и одностолбцовый формат (только Re)
+    // поддерживаются в readComplexCSV
+    try {
+        return readComplexCSV(filename);
+    } catch (const std::runtime_error&) {
         throw std::runtime_error("DopplerNipFilter::loadFromCSV: не удалось открыть " + filename);
-
-    ComplexSignal result;
-    std::string line;
-    while (std::getline(file, line)) {
-        // Пропускаем комментарии (строки, начинающиеся с #)
-        if (line.empty() || line[0] == '#') continue;
-
-        std::istringstream ss(line);
-        std::string sRe, sIm;
-        if (!std::getline(ss, sRe, ',')) continue;
-        if (!std::getline(ss, sIm, ',')) {
-            // Только вещественная часть (обратная совместимость)
-            result.emplace_back(std::stod(sRe), 0.0);
-        } else {
-            result.emplace_back(std::stod(sRe), std::stod(sIm));
-        }
     }
-
-    return result;
 }
 
 void DopplerNipFilter::saveToCSV(const ComplexSignal& signal,
                                   const std::string& filename)
 {
-    std::ofstream file(filename);
-    if (!file.is_open())
+    try {
+        writeComplexCSV(filename, signal, 8);
+    } catch (const std::runtime_error&) {
         throw std::runtime_error("DopplerNipFilter::saveToCSV: не удалось открыть " + filename);
+    }
+}
+
+ComplexSignal DopplerNipFilter::loadFromFile(const std::string& filename)
+{
+    return isSignalFilePath(filename) ? loadComplexSignalBinary(filename)
+                                      : loadFromCSV(filename);
+}
 
-    file << std::fixed << std::setprecision(8);
-    for (const auto& c : signal)
-        file << c.real() << "," << c.imag() << "\n";
+void DopplerNipFilter::saveToFile(const ComplexSignal& signal,
+                                   const std::string& filename)
+{
+    if (isSignalFilePath(filename))
+        saveComplexSignalBinary(signal, filename);
+    else
+        saveToCSV(signal, filename);
 }
@@ -148,6 +148,13 @@ public:
     ComplexSignal process(const SignalProcessor::Signal& iChannel,
                           const SignalProcessor::Signal& qChannel);
 
+    /**
+     * Только обнаружение: ДПФ и проверка критериев, без компенсации,
+     * вычисления спектров в дБ и вывода в консоль. Для массовой обработки
+     * (тысячи дискретов дальности). Обновляет getLastDetection().
+     */
+    const NipDetectionResult& detect(const ComplexSignal& burstSamples);
+
     // ── Доступ к результатам ──────────────────────────────────────────────
 
     /** Результат последнего обнаружения */
@@ -193,6 +200,16 @@ public:
      */
     static void saveToCSV(const ComplexSignal& signal, const std::string& filename);
 
+    /**
+     * Загрузить комплексный сигнал из CSV или бинарного контейнера (.sig).
+     */
+    static ComplexSignal loadFromFile(const std::string& filename);
+
+    /**
+     * Сохранить комплексный сигнал в CSV или бинарный контейнер (.sig).
+     */
+    static void saveToFile(const ComplexSignal& signal, const std::string& filename);
+
     /**
      * Установить параметры алгоритма.
      */
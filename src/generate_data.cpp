@@ -1,7 +1,10 @@
+#include <filesystem>
 #include <iostream>
 #include <string>
 
 #include "signal_generator.h"
+#include "signal_source.h"
+#include "utils/signal_archive.h"
 
 void printUsage(const char* programName) {
     std::cout << "Использование: " << programName << " [опции]\n\n";
@@ -12,6 +15,12 @@ void printUsage(const char* programName) {
     std::cout << "  -s, --seed S         Начальное значение для генератора (по умолчанию: 42)\n";
     std::cout << "  -f, --frequency F    Масштаб частоты сигналов (по умолчанию: 0.05)\n";
     std::cout << "  -o, --output DIR     Выходная директория (по умолчанию: data)\n";
+    std::cout << "  -j, --threads N      Потоки генерации (0 — по числу ядер, по умолчанию: 0);\n";
+    std::cout << "                       результат не зависит от числа потоков\n";
+    std::cout << "  --binary             Сохранять в бинарном контейнере .sig вместо CSV\n";
+    std::cout << "  -a, --archive FILE   Сохранить весь набор в один архив .sga вместо директорий\n";
+    std::cout << "  --soak L             Одна пара soak.sig длиной L отсчётов (потоковая генерация,\n";
+    std::cout << "                       память не зависит от L; допускаются суффиксы k, M, G)\n";
     std::cout << "\n";
     std::cout << "Примечания:\n";
     std::cout << "  Масштаб частоты: 1.0 = исходная частота, 0.05 = в 20 раз меньше\n";
@@ -21,6 +30,58 @@ void printUsage(const char* programName) {
     std::cout << "  " << programName << " -n 50 -l 2000 -o test_data\n";
     std::cout << "  " << programName << " -f 0.1 -n 20     # удвоенная частота\n";
     std::cout << "  " << programName << " -f 0.025 -n 20   # половинная частота\n";
+    std::cout << "  " << programName << " --soak 1G         # 10^9 отсчётов для длительных прогонов\n";
+}
+
+/// Длина с необязательным суффиксом k / M / G (степени 10)
+static uint64_t parseLength(const std::string& text) {
+    size_t pos = 0;
+    uint64_t value = std::stoull(text, &pos);
+    const std::string suffix = text.substr(pos);
+    if (suffix == "k" || suffix == "K") value *= 1000ull;
+    else if (suffix == "M") value *= 1000000ull;
+    else if (suffix == "G") value *= 1000000000ull;
+    else if (!suffix.empty()) throw std::invalid_argument("неизвестный суффикс длины: " + suffix);
+    return value;
+}
+
+/**
+ * Потоковая генерация одной длинной пары (clean, noisy) в .sig:
+ * синус + случайные выбросы, блоками по SignalSource::kDefaultBlockSize
+ */
+static void generateSoak(uint64_t length, unsigned int seed, double frequencyScale,
+                         const std::string& outputDir) {
+    const std::string cleanFile = outputDir + "/clean/soak" + kSignalFileExtension;
+    const std::string noisyFile = outputDir + "/noisy/soak" + kSignalFileExtension;
+    std::filesystem::create_directories(outputDir + "/clean");
+    std::filesystem::create_directories(outputDir + "/noisy");
+
+    BasicSignalSource  clean(SignalGenerator::SignalType::SINE, length, 1.0, 0.1 * frequencyScale);
+    ImpulseNoiseSource noise(seed, length, SignalGenerator::NoiseType::RANDOM_SPIKES, 0.01, 2.0);
+
+    SignalFileWriter cleanWriter(cleanFile, SampleType::FLOAT64);
+    SignalFileWriter noisyWriter(noisyFile, SampleType::FLOAT64);
+
+    std::vector<double> cleanBlock(SignalSource::kDefaultBlockSize);
+    std::vector<double> noiseBlock(SignalSource::kDefaultBlockSize);
+    uint64_t lastPercent = 0;
+
+    while (size_t n = clean.generateBlock(cleanBlock)) {
+        noise.generateBlock(std::span<double>(noiseBlock.data(), n));
+        cleanWriter.append(std::span<const double>(cleanBlock.data(), n));
+        for (size_t i = 0; i < n; ++i) noiseBlock[i] += cleanBlock[i];
+        noisyWriter.append(std::span<const double>(noiseBlock.data(), n));
+
+        const uint64_t percent = clean.position() * 100 / length;
+        if (percent != lastPercent) {
+            lastPercent = percent;
+            std::cout << "Сгенерировано " << percent << "%\r" << std::flush;
+        }
+    }
+
+    cleanWriter.finalize();
+    noisyWriter.finalize();
+    std::cout << "\nСохранено: " << cleanFile << ", " << noisyFile << "\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -30,6 +91,10 @@ int main(int argc, char* argv[]) {
     unsigned int seed = 42;
     double frequencyScale = 0.05; // В 20 раз меньше исходной частоты
     std::string outputDir = "data";
+    std::string extension = ".csv";
+    std::string archiveFile;
+    uint64_t soakLength = 0;
+    size_t numThreads = 0;
 
     // Парсинг аргументов командной строки
     for (int i = 1; i < argc; i++) {
@@ -75,6 +140,33 @@ int main(int argc, char* argv[]) {
                 return 1;
             }
         }
+        else if (arg == "--binary") {
+            extension = ".sig";
+        }
+        else if (arg == "-a" || arg == "--archive") {
+            if (i + 1 < argc) {
+                archiveFile = argv[++i];
+            } else {
+                std::cerr << "Ошибка: не указан файл архива для " << arg << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "-j" || arg == "--threads") {
+            if (i + 1 < argc) {
+                numThreads = std::stoul(argv[++i]);
+            } else {
+                std::cerr << "Ошибка: не указано число потоков для " << arg << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--soak") {
+            if (i + 1 < argc) {
+                soakLength = parseLength(argv[++i]);
+            } else {
+                std::cerr << "Ошибка: не указана длина для " << arg << std::endl;
+                return 1;
+            }
+        }
         else if (arg == "-o" || arg == "--output") {
             if (i + 1 < argc) {
                 outputDir = argv[++i];
@@ -108,14 +200,30 @@ int main(int argc, char* argv[]) {
     std::cout << "  Выходная директория: " << outputDir << "\n\n";
 
     try {
+        if (soakLength > 0) {
+            std::cout << "Потоковая генерация soak-пары: " << soakLength << " отсчетов\n";
+            generateSoak(soakLength, seed, frequencyScale, outputDir);
+            return 0;
+        }
+
         // Создаем генератор сигналов
         SignalGenerator generator(seed);
 
         std::cout << "Генерация тестового набора данных...\n";
-        auto dataset = generator.generateTestDataset(signalLength, numSignals, frequencyScale);
+        auto dataset = generator.generateTestDataset(signalLength, numSignals, frequencyScale,
+                                                     numThreads);
 
         std::cout << "Сгенерировано " << dataset.size() << " пар сигналов\n";
 
+        if (!archiveFile.empty()) {
+            std::cout << "Сохранение набора в архив: " << archiveFile << "\n";
+            SignalArchiveWriter writer(archiveFile);
+            writer.addPairs(dataset);
+            writer.finalize();
+            std::cout << "Генерация тестовых данных завершена успешно!\n";
+            return 0;
+        }
+
         // Создаем директории для сохранения
         std::string cleanDir = outputDir + "/clean";
         std::string noisyDir = outputDir + "/noisy";
@@ -126,11 +234,11 @@ int main(int argc, char* argv[]) {
 
         // Сохраняем каждую пару сигналов
         for (size_t i = 0; i < dataset.size(); ++i) {
-            std::string cleanFile = cleanDir + "/signal_" + std::to_string(i) + ".csv";
-            std::string noisyFile = noisyDir + "/signal_" + std::to_string(i) + ".csv";
+            std::string cleanFile = cleanDir + "/signal_" + std::to_string(i) + extension;
+            std::string noisyFile = noisyDir + "/signal_" + std::to_string(i) + extension;
 
-            SignalGenerator::saveSignalToCSV(dataset[i].first, cleanFile);
-            SignalGenerator::saveSignalToCSV(dataset[i].second, noisyFile);
+            SignalGenerator::saveSignal(dataset[i].first, cleanFile);
+            SignalGenerator::saveSignal(dataset[i].second, noisyFile);
 
             if ((i + 1) % 10 == 0 || i == dataset.size() - 1) {
                 std::cout << "Сохранено " << (i + 1) << "/" << dataset.size()
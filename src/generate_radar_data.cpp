@@ -1,5 +1,7 @@
 #include "doppler_nip_filter.h"
+#include "radar_scenario.h"
 #include "signal_processor.h"
+#include "utils/noise_engine.h"
 
 #include <iostream>
 #include <fstream>
@@ -8,8 +10,9 @@
 #include <vector>
 #include <complex>
 #include <cmath>
-#include <random>
 #include <iomanip>
+#include <chrono>
+#include <stdexcept>
 #include <sys/stat.h>
 
 #ifndef M_PI
@@ -31,18 +34,20 @@ struct Target {
  * @param N         Число импульсов в пачке
  * @param targets   Список целей
  * @param noiseStd  СКО белого шума приёмника (I и Q независимо)
- * @param rng       ГПСЧ
+ * @param noise     Генератор шума
  */
 CVector generateBurst(int N,
                       const std::vector<Target>& targets,
                       double noiseStd,
-                      std::mt19937& rng)
+                      NoiseEngine& noise)
 {
-    std::normal_distribution<double> noiseDist(0.0, noiseStd);
+    // Шум I и Q одним буфером: чётные отсчёты — I, нечётные — Q
+    std::vector<double> iq(2 * static_cast<size_t>(N));
+    noise.fillGaussian(iq, 0.0, noiseStd);
     CVector burst(static_cast<size_t>(N));
 
     for (int n = 0; n < N; ++n) {
-        Complex sample(noiseDist(rng), noiseDist(rng));
+        Complex sample(iq[2 * static_cast<size_t>(n)], iq[2 * static_cast<size_t>(n) + 1]);
 
         for (size_t t = 0; t < targets.size(); ++t) {
             const double amp  = targets[t].amplitude;
@@ -87,37 +92,157 @@ void printBurstInfo(const std::string& label, const CVector& burst)
 }
 
 /**
- * Сохраняет пару (clean, noisy) в файлы формата  <base>_clean.csv / <base>_noisy.csv.
+ * Сохраняет пару (clean, noisy) в файлы формата  <base>_clean<ext> / <base>_noisy<ext>.
+ * @param ext  ".csv" (Re,Im) или ".sig" (бинарный контейнер)
  */
 void savePair(const CVector& clean,
               const CVector& noisy,
               const std::string& outDir,
-              int idx)
+              int idx,
+              const std::string& ext)
 {
     std::ostringstream ss;
     ss << outDir << "/burst_" << std::setw(2) << std::setfill('0') << idx;
     const std::string base = ss.str();
 
-    DopplerNipFilter::saveToCSV(clean, base + "_clean.csv");
-    DopplerNipFilter::saveToCSV(noisy, base + "_noisy.csv");
+    DopplerNipFilter::saveToFile(clean, base + "_clean" + ext);
+    DopplerNipFilter::saveToFile(noisy, base + "_noisy" + ext);
 
     std::cout << "  Сохранён сценарий " << idx
-              << ": " << base << "_[clean|noisy].csv\n";
+              << ": " << base << "_[clean|noisy]" << ext << "\n";
+}
+
+// ═════════════════════════════════════════════════════════════════════════════
+// Режим --scenario: куб дальность × импульс с разметкой НИП
+// ═════════════════════════════════════════════════════════════════════════════
+
+static void printScenarioUsage(const char* programName)
+{
+    const RadarScenarioConfig d;
+    std::cout << "Использование: " << programName << " --scenario [опции]\n\n"
+              << "  --gates G          Дискретов дальности (по умолчанию: " << d.numGates << ")\n"
+              << "  --pulses N         Импульсов в пачке (по умолчанию: " << d.numPulses << ")\n"
+              << "  --targets T        Число целей (по умолчанию: " << d.numTargets << ")\n"
+              << "  --nip-rate R       Среднее число НИП на импульс (по умолчанию: " << d.nipRate << ")\n"
+              << "  --nip-width W      Макс. протяжённость НИП, дискретов (по умолчанию: " << d.nipMaxWidth << ")\n"
+              << "  --nip-amp MIN MAX  Диапазон амплитуд НИП (по умолчанию: "
+              << d.nipAmplitudeMin << " " << d.nipAmplitudeMax << ")\n"
+              << "  --clutter A        Амплитуда помехи от местных предметов, 0 — без неё (по умолчанию: "
+              << d.clutterAmplitude << ")\n"
+              << "  --noise S          СКО шума приёмника (по умолчанию: " << d.noiseStd << ")\n"
+              << "  --seed S           Начальное значение ГСЧ (по умолчанию: " << d.seed << ")\n"
+              << "  -j, --threads N    Потоки (0 — по числу ядер); результат от N не зависит\n"
+              << "  -o, --output DIR   Выходная директория (по умолчанию: data/radar/scenario)\n"
+              << "  --float32          Хранить отсчёты как complex<float> (по умолчанию)\n"
+              << "  --float64          Хранить отсчёты как complex<double>\n"
+              << "  --no-save          Не сохранять файлы (только генерация и оценка)\n"
+              << "  --evaluate         Прогнать DopplerNipFilter по всем дискретам и\n"
+              << "                     сравнить с разметкой\n";
+}
+
+static int runScenario(int argc, char* argv[])
+{
+    RadarScenarioConfig cfg;
+    std::string outDir = std::string(ROOT_PATH) + "/data/radar/scenario";
+    SampleType  type   = SampleType::COMPLEX64;
+    bool save = true, evaluate = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("не указано значение для " + arg);
+            return argv[++i];
+        };
+
+        if      (arg == "--scenario")                  continue;
+        else if (arg == "-h" || arg == "--help")      { printScenarioUsage(argv[0]); return 0; }
+        else if (arg == "--gates")                      cfg.numGates = std::stoul(value());
+        else if (arg == "--pulses")                     cfg.numPulses = std::stoul(value());
+        else if (arg == "--targets")                    cfg.numTargets = std::stoul(value());
+        else if (arg == "--nip-rate")                   cfg.nipRate = std::stod(value());
+        else if (arg == "--nip-width")                  cfg.nipMaxWidth = std::stoul(value());
+        else if (arg == "--nip-amp") {
+            cfg.nipAmplitudeMin = std::stod(value());
+            cfg.nipAmplitudeMax = std::stod(value());
+        }
+        else if (arg == "--clutter")                    cfg.clutterAmplitude = std::stod(value());
+        else if (arg == "--noise")                      cfg.noiseStd = std::stod(value());
+        else if (arg == "--seed")                       cfg.seed = std::stoull(value());
+        else if (arg == "-j" || arg == "--threads")     cfg.numThreads = std::stoul(value());
+        else if (arg == "-o" || arg == "--output")      outDir = value();
+        else if (arg == "--float32")                    type = SampleType::COMPLEX64;
+        else if (arg == "--float64")                    type = SampleType::COMPLEX128;
+        else if (arg == "--no-save")                    save = false;
+        else if (arg == "--evaluate")                   evaluate = true;
+        else {
+            std::cerr << "Неизвестный аргумент: " << arg << "\n";
+            printScenarioUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "Сценарий: " << cfg.numGates << " дискретов × " << cfg.numPulses
+              << " импульсов, целей: " << cfg.numTargets
+              << ", НИП/импульс: " << cfg.nipRate << ", seed=" << cfg.seed << "\n";
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const RadarScenario scenario = generateRadarScenario(cfg);
+    const auto t1 = std::chrono::steady_clock::now();
+
+    size_t nipCells = 0;
+    for (uint8_t m : scenario.nipMask) nipCells += m;
+    std::cout << "  Сгенерировано за " << std::fixed << std::setprecision(3)
+              << std::chrono::duration<double>(t1 - t0).count() << " с; событий НИП: "
+              << scenario.nipEvents.size() << ", поражённых ячеек: " << nipCells << "\n";
+
+    if (save) {
+        saveRadarScenario(scenario, outDir, type);
+        std::cout << "  Сохранено в " << outDir
+                  << " (scenario_[clean|noisy].sig, scenario_nip.csv, scenario_targets.csv)\n";
+    }
+
+    if (evaluate) {
+        const NipDetectorEvaluation ev = evaluateNipDetector(scenario, DopplerNipFilter(),
+                                                             cfg.numThreads);
+        std::cout << "\nDopplerNipFilter по " << ev.gates << " дискретам:\n"
+                  << "  Дискретов с НИП:       " << ev.gatesWithNip << "\n"
+                  << "  Вероятность обнаруж.:  " << std::setprecision(4) << ev.detectionRate() << "\n"
+                  << "  Верный импульс m̂:      " << ev.correctPulse << " из " << ev.detected << "\n"
+                  << "  Ложные тревоги:        " << ev.falseAlarms
+                  << " (доля " << ev.falseAlarmRate() << ")\n"
+                  << "  Производительность:    " << std::setprecision(0) << ev.gatesPerSecond()
+                  << " дискретов/с\n";
+    }
+    return 0;
 }
 
 // ═════════════════════════════════════════════════════════════════════════════
 // main
 // ═════════════════════════════════════════════════════════════════════════════
 
-int main()
+int main(int argc, char* argv[])
 {
+    // --binary: сохранять пачки в бинарном контейнере .sig вместо CSV
+    std::string ext = ".csv";
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--binary") ext = ".sig";
+        if (std::string(argv[i]) == "--scenario") {
+            try {
+                return runScenario(argc, argv);
+            } catch (const std::exception& e) {
+                std::cerr << "Ошибка: " << e.what() << "\n";
+                return 1;
+            }
+        }
+    }
+
     const std::string outDir = std::string(ROOT_PATH) + "/data/radar";
     // Создаём директорию (POSIX)
     mkdir(outDir.c_str(), 0755);
 
     std::cout << "Генерация тестовых РЛС данных → " << outDir << "\n\n";
 
-    std::mt19937 rng(12345u);
+    NoiseEngine noise(12345u);
 
     // Общие параметры пачки
     const int    N        = 64;    // число зондирующих импульсов (степень двойки)
@@ -138,13 +263,13 @@ int main()
                   << "), НИП[" << nipIdx << "], A_nip=" << nipAmp << "\n";
 
         std::vector<Target> targets = { {amp, fd, 0.0} };
-        CVector clean = generateBurst(N, targets, noiseStd, rng);
+        CVector clean = generateBurst(N, targets, noiseStd, noise);
         CVector noisy = clean;
         addNip(noisy, nipIdx, nipAmp, nipPhi);
 
         printBurstInfo("clean", clean);
         printBurstInfo("noisy", noisy);
-        savePair(clean, noisy, outDir, sc);
+        savePair(clean, noisy, outDir, sc, ext);
         std::cout << "\n";
     }
 
@@ -163,13 +288,13 @@ int main()
                   << "), НИП[" << nipIdx << "], A_nip=" << nipAmp << "\n";
 
         std::vector<Target> targets = { {amp, fd, 0.0} };
-        CVector clean = generateBurst(N, targets, noiseStd, rng);
+        CVector clean = generateBurst(N, targets, noiseStd, noise);
         CVector noisy = clean;
         addNip(noisy, nipIdx, nipAmp, nipPhi);
 
         printBurstInfo("clean", clean);
         printBurstInfo("noisy", noisy);
-        savePair(clean, noisy, outDir, sc);
+        savePair(clean, noisy, outDir, sc, ext);
         std::cout << "\n";
     }
 
@@ -186,13 +311,13 @@ int main()
                   << ": только шум, НИП[" << nipIdx << "], A_nip=" << nipAmp << "\n";
 
         std::vector<Target> targets;  // нет целей
-        CVector clean = generateBurst(N, targets, noiseStd, rng);
+        CVector clean = generateBurst(N, targets, noiseStd, noise);
         CVector noisy = clean;
         addNip(noisy, nipIdx, nipAmp, nipPhi);
 
         printBurstInfo("clean", clean);
         printBurstInfo("noisy", noisy);
-        savePair(clean, noisy, outDir, sc);
+        savePair(clean, noisy, outDir, sc, ext);
         std::cout << "\n";
     }
 
@@ -210,13 +335,13 @@ int main()
                   << "], A_nip=" << nipAmp << "\n";
 
         std::vector<Target> targets = { {1.0, 0.10, 0.0}, {0.6, 0.30, 1.0} };
-        CVector clean = generateBurst(N, targets, noiseStd, rng);
+        CVector clean = generateBurst(N, targets, noiseStd, noise);
         CVector noisy = clean;
         addNip(noisy, nipIdx, nipAmp, nipPhi);
 
         printBurstInfo("clean", clean);
         printBurstInfo("noisy", noisy);
-        savePair(clean, noisy, outDir, sc);
+        savePair(clean, noisy, outDir, sc, ext);
         std::cout << "\n";
     }
 
@@ -235,13 +360,13 @@ int main()
                   << "), НИП[N-1=" << nipIdx << "], A_nip=" << nipAmp << "\n";
 
         std::vector<Target> targets = { {amp, fd, 0.5} };
-        CVector clean = generateBurst(N, targets, noiseStd, rng);
+        CVector clean = generateBurst(N, targets, noiseStd, noise);
         CVector noisy = clean;
         addNip(noisy, nipIdx, nipAmp, nipPhi);
 
         printBurstInfo("clean", clean);
         printBurstInfo("noisy", noisy);
-        savePair(clean, noisy, outDir, sc);
+        savePair(clean, noisy, outDir, sc, ext);
         std::cout << "\n";
     }
 
@@ -257,12 +382,12 @@ int main()
                   << ": 1 цель (f_d=" << fd << "), без НИП (контроль)\n";
 
         std::vector<Target> targets = { {amp, fd, 0.0} };
-        CVector clean = generateBurst(N, targets, noiseStd, rng);
+        CVector clean = generateBurst(N, targets, noiseStd, noise);
         CVector noisy = clean;  // НИП нет → noisy == clean
 
         printBurstInfo("clean", clean);
         printBurstInfo("noisy", noisy);
-        savePair(clean, noisy, outDir, sc);
+        savePair(clean, noisy, outDir, sc, ext);
         std::cout << "\n";
     }
 
@@ -31,6 +31,7 @@ static void printUsage(const char* prog) {
               << "  --impulse-rate R        Плотность импульсных выбросов 0..1 (по умолчанию: 0.02)\n"
               << "  --impulse-amp A         Амплитуда выбросов в единицах RMS (по умолчанию: 5.0)\n"
               << "  -o, --output DIR        Выходная директория (по умолчанию: data/wiener)\n"
+              << "  --binary                Сохранять в бинарном контейнере .sig вместо CSV\n"
               << "\nОписание сигналов:\n"
               << "  0: Медленный синус (f=0.005) + гауссов шум\n"
               << "  1: Экспоненциальная кривая + гауссов шум\n"
@@ -49,6 +50,7 @@ int main(int argc, char* argv[]) {
     double      impulseDensity  = 0.02;
     double      impulseAmplitude = 5.0;
     std::string outputDir       = "data/wiener";
+    std::string extension       = ".csv";
 
     for (int i = 1; i < argc; ++i) {
         std::string a = argv[i];
@@ -65,6 +67,8 @@ int main(int argc, char* argv[]) {
             impulseDensity = std::stod(argv[++i]);
         } else if (a == "--impulse-amp" && i + 1 < argc) {
             impulseAmplitude = std::stod(argv[++i]);
+        } else if (a == "--binary") {
+            extension = ".sig";
         } else if ((a == "-o" || a == "--output") && i + 1 < argc) {
             outputDir = argv[++i];
         } else {
@@ -109,11 +113,11 @@ int main(int argc, char* argv[]) {
 
         std::cout << "Сохранение:\n";
         for (size_t i = 0; i < dataset.size(); ++i) {
-            std::string cleanFile = cleanDir + "/signal_" + std::to_string(i) + ".csv";
-            std::string noisyFile = noisyDir + "/signal_" + std::to_string(i) + ".csv";
+            std::string cleanFile = cleanDir + "/signal_" + std::to_string(i) + extension;
+            std::string noisyFile = noisyDir + "/signal_" + std::to_string(i) + extension;
 
-            SignalGenerator::saveSignalToCSV(dataset[i].first,  cleanFile);
-            SignalGenerator::saveSignalToCSV(dataset[i].second, noisyFile);
+            SignalGenerator::saveSignal(dataset[i].first,  cleanFile);
+            SignalGenerator::saveSignal(dataset[i].second, noisyFile);
 
             std::cout << "  [" << i << "] " << descriptions[i] << "\n"
                       << "       clean -> " << cleanFile << "\n"
@@ -124,9 +128,9 @@ int main(int argc, char* argv[]) {
                   << " пар сигналов по " << signalLength << " отсчётов.\n\n"
                   << "Использование с фильтром Винера:\n"
                   << "  ./echo_filter_test -f wiener -i " << noisyDir
-                  << "/signal_0.csv -c " << cleanDir << "/signal_0.csv\n"
+                  << "/signal_0" << extension << " -c " << cleanDir << "/signal_0" << extension << "\n"
                   << "  ./signal_filter_gui -f wiener -i " << noisyDir
-                  << "/signal_0.csv -c " << cleanDir << "/signal_0.csv\n";
+                  << "/signal_0" << extension << " -c " << cleanDir << "/signal_0" << extension << "\n";
 
     } catch (const std::exception& e) {
         std::cerr << "Ошибка: " << e.what() << "\n";
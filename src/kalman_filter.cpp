@@ -1,4 +1,5 @@
 #include "kalman_filter.h"
+#include "utils/trace.h"
 #include <boost/numeric/ublas/lu.hpp>
 #include <stdexcept>
 #include <cmath>
@@ -33,13 +34,18 @@ KalmanFilter::KalmanFilter(double processNoise, double measurementNoise, double
 }
 
 SignalProcessor::Signal KalmanFilter::process(const Signal& input) {
+    Signal output;
+    processInto(input, output);
+    return output;
+}
+
+void KalmanFilter::processInto(const Signal& input, Signal& output) {
+    TRACE_SCOPE("KalmanFilter::process");
+    output.resize(input.size());
     if (input.empty()) {
-        return Signal();
+        return;
     }
 
-    Signal output;
-    output.reserve(input.size());
-
     // Сброс состояния для каждого нового сигнала
     reset();
 
@@ -53,7 +59,7 @@ SignalProcessor::Signal KalmanFilter::process(const Signal& input) {
             P_ = identity_matrix<double>(2);
 
             initialized_ = true;
-            output.push_back(input[i]);
+            output[i] = input[i];
         } else {
             // Шаг предсказания
             predict();
@@ -62,11 +68,9 @@ SignalProcessor::Signal KalmanFilter::process(const Signal& input) {
             update(input[i]);
 
             // Выходное значение - позиция (первый элемент вектора состояния)
-            output.push_back(x_(0));
+            output[i] = x_(0);
         }
     }
-
-    return output;
 }
 
 std::string KalmanFilter::getName() const {
@@ -44,12 +44,20 @@ public:
      */
     Signal process(const Signal& input) override;
 
+    /** Выход пишется в output без промежуточного вектора */
+    void processInto(const Signal& input, Signal& output) override;
+
     /**
      * Получить имя фильтра
      * @return Строковое представление имени фильтра
      */
     std::string getName() const override;
 
+    /** Независимая копия фильтра */
+    std::unique_ptr<SignalProcessor> clone() const override {
+        return std::make_unique<KalmanFilter>(*this);
+    }
+
     /**
      * Установить параметры фильтра
      * @param processNoise Дисперсия шума процесса
@@ -15,6 +15,7 @@
 #include "kalman_filter.h"
 #include "signal_generator.h"
 #include "performance_tester.h"
+#include "parameter_tuner.h"
 
 void printHeader() {
     std::cout << "================================================\n";
@@ -59,9 +60,10 @@ void demonstrateAlgorithms() {
     for (auto& filter : filters) {
         auto [filteredSignal, executionTime] = filter->measurePerformance(noisySignal);
 
-        double snr = calculateSNR(cleanSignal, filteredSignal);
-        double mse = calculateMSE(cleanSignal, filteredSignal);
-        double correlation = calculateCorrelation(cleanSignal, filteredSignal);
+        const QualityMetrics quality = calculateQualityMetrics(cleanSignal, filteredSignal);
+        double snr = quality.snr;
+        double mse = quality.mse;
+        double correlation = quality.correlation;
 
         std::cout << filter->getName() << ":\n";
         std::cout << "  SNR: " << std::fixed << std::setprecision(2) << snr << " дБ\n";
@@ -115,9 +117,10 @@ void demonstrateBasicSignals() {
         auto [filteredSignal, executionTime] = filter->measurePerformance(noisySignal);
 
         // Вычисляем метрики качества
-        double snr = calculateSNR(cleanSignal, filteredSignal);
-        double mse = calculateMSE(cleanSignal, filteredSignal);
-        double correlation = calculateCorrelation(cleanSignal, filteredSignal);
+        const QualityMetrics quality = calculateQualityMetrics(cleanSignal, filteredSignal);
+        double snr = quality.snr;
+        double mse = quality.mse;
+        double correlation = quality.correlation;
 
         std::cout << SignalGenerator::signalTypeToString(signalType) << " сигнал:\n";
         std::cout << "  SNR: " << std::fixed << std::setprecision(2) << snr << " дБ\n";
@@ -173,8 +176,15 @@ void runFullBenchmark() {
     std::cout << "Генерация тестового набора данных...\n";
     tester.generateTestDataset(1000, 30);
 
+    // Циклы, IPC и промахи кэша — если ядро разрешает perf_event_open
+    tester.setCollectPerfCounters(true);
+
     std::cout << "Запуск тестирования...\n\n";
-    auto results = tester.runFullTest();
+    // Качество — параллельно на всех ядрах, время — отдельным проходом на одном ядре
+    PerformanceTester::RunOptions options;
+    options.numThreads   = 0;
+    options.serialTiming = true;
+    auto results = tester.runFullTest(options);
 
     // Генерируем и выводим отчет
     std::string report = tester.generateReport(results);
@@ -183,9 +193,11 @@ void runFullBenchmark() {
     // Сохраняем результаты
     try {
         tester.saveResultsToCSV(results, "results/benchmark_results.csv");
+        tester.saveResultsToJSON(results, "results/benchmark_results.json");
         tester.saveTestDataset("data/clean", "data/noisy");
         std::cout << "Результаты сохранены в файлы:\n";
         std::cout << "  - results/benchmark_results.csv\n";
+        std::cout << "  - results/benchmark_results.json\n";
         std::cout << "  - data/clean/ и data/noisy/\n";
     } catch (const std::exception& e) {
         std::cerr << "Ошибка при сохранении: " << e.what() << std::endl;
@@ -206,28 +218,15 @@ void runScalabilityTest() {
         OutlierDetection::DetectionMethod::MAD_BASED,
         OutlierDetection::InterpolationMethod::LINEAR, 3.0, 11));
 
-    // Тестируем на различных размерах сигналов
-    std::vector<size_t> signalLengths = {100, 250, 500, 1000, 2000, 4000};
-
-    std::cout << "Тестирование на сигналах длиной: ";
-    for (size_t length : signalLengths) {
-        std::cout << length << " ";
-    }
-    std::cout << "отсчетов\n\n";
+    // Длины от 100 до 10^7 отсчётов, три точки на декаду; медленные
+    // алгоритмы останавливаются, когда вызов становится дольше 2 с
+    PerformanceTester::ScalabilityOptions options;
 
-    auto scalabilityResults = tester.testScalability(signalLengths);
+    std::cout << "Тестирование на сигналах длиной от " << options.minLength
+              << " до " << options.maxLength << " отсчетов\n\n";
 
-    // Выводим результаты масштабируемости
-    std::cout << "Результаты тестирования масштабируемости:\n\n";
-
-    for (const auto& [algorithmName, results] : scalabilityResults) {
-        std::cout << algorithmName << ":\n";
-        for (const auto& [length, time] : results) {
-            std::cout << "  " << length << " отсчетов: "
-                      << std::fixed << std::setprecision(0) << time << " мкс\n";
-        }
-        std::cout << "\n";
-    }
+    auto scalabilityResults = tester.testScalability(options);
+    std::cout << tester.generateScalabilityReport(scalabilityResults) << std::endl;
 }
 
 void showMenu() {
@@ -252,45 +251,32 @@ int main(int argc, char* argv[]) {
         std::format("{}/data/noisy/{}", ROOT_PATH, filename)
     );
 
-    std::cout << "=== Перебор параметров WienerFilter (w_opt = R⁻¹·p) ===\n";
-    std::cout << std::format("{:<40} {:>8} {:>14} {:>12}\n",
-        "Алгоритм", "SNR(дБ)", "MSE", "Корреляция");
-    std::cout << std::string(76, '-') << "\n";
-
-    // Перебираем: filterOrder × desiredWindow × regularization
-    struct WParams { size_t order; size_t win; double reg; };
-    std::vector<WParams> grid = {
-        {4,  3, 1e-4}, {4,  5, 1e-4}, {4,  9, 1e-4},
-        {8,  3, 1e-4}, {8,  5, 1e-4}, {8,  9, 1e-4}, {8, 15, 1e-4},
-        {12, 5, 1e-4}, {12, 9, 1e-4}, {12,15, 1e-4},
-        {16, 5, 1e-4}, {16, 9, 1e-4}, {16,15, 1e-4}, {16,21, 1e-4},
-        {24, 9, 1e-4}, {24,15, 1e-4}, {24,21, 1e-4},
-        {32,15, 1e-4}, {32,21, 1e-4}, {32,31, 1e-4},
-        {8,  9, 1e-3}, {8,  9, 1e-5},
-        {16,15, 1e-3}, {16,15, 1e-5},
-    };
+    std::cout << "=== Подбор параметров WienerFilter (w_opt = R⁻¹·p) ===\n";
 
-    double bestSNR = -1e9;
-    WParams bestP{};
+    // filterOrder × desiredWindow × regularization — последовательным делением:
+    // большая часть сетки отсеивается на коротких префиксах сигнала
+    ParameterTuner tuner({{cleanSignal, noisySignal}});
+    const TuningResult result = tuner.tune(wienerParameterSpace());
 
-    for (const auto& p : grid) {
-        WienerFilter wf(p.order, p.win, p.reg);
-        const auto& filtered = wf.process(noisySignal);
-
-        double snr  = calculateSNR(cleanSignal, filtered);
-        double mse  = calculateMSE(cleanSignal, filtered);
-        double corr = calculateCorrelation(cleanSignal, filtered);
+    for (size_t r = 0; r < result.rungs.size(); ++r) {
+        const TuningRung& rung = result.rungs[r];
+        std::cout << std::format("Ступень {}: {:>3} кандидатов, префикс {:>5}, {:>7.1f} мс\n",
+            r, rung.candidates, rung.prefix, rung.elapsedNs / 1e6);
+    }
+    std::cout << "\n";
 
-        std::string label = std::format("ord={} win={} reg={:.0e}",
-            p.order, p.win, p.reg);
+    std::cout << std::format("{:<40} {:>8} {:>14} {:>12}\n",
+        "Алгоритм", "SNR(дБ)", "MSE", "Корреляция");
+    std::cout << std::string(76, '-') << "\n";
 
+    // Кандидаты, дошедшие до полной длины сигнала
+    for (const TuningCandidate& c : result.ranking) {
+        if (c.rung + 1 != result.rungs.size()) break;
         std::cout << std::format("{:<40} {:>8.2f} {:>14.3e} {:>12.4f}\n",
-            label, snr, mse, corr);
-
-        if (snr > bestSNR) { bestSNR = snr; bestP = p; }
+            c.description, c.mean.snr, c.mean.mse, c.mean.correlation);
     }
 
     std::cout << std::string(76, '-') << "\n";
-    std::cout << std::format("Лучшие параметры: ord={} win={} reg={:.0e}  →  SNR={:.2f} дБ\n",
-        bestP.order, bestP.win, bestP.reg, bestSNR);
+    std::cout << std::format("Лучшие параметры: {}  →  SNR={:.2f} дБ\n",
+        result.best().description, result.best().mean.snr);
 }
@@ -1,5 +1,6 @@
 #include "median_filter.h"
 #include "utils/median.h"
+#include "utils/trace.h"
 
 #include <algorithm>
 #include <deque>
@@ -10,18 +11,18 @@ MedianFilter::MedianFilter(size_t windowSize) {
 }
 
 SignalProcessor::Signal MedianFilter::process(const Signal& input) {
-    if (input.empty()) {
-        return Signal();
-    }
-
     Signal output;
-    output.reserve(input.size());
+    processInto(input, output);
+    return output;
+}
+
+void MedianFilter::processInto(const Signal& input, Signal& output) {
+    TRACE_SCOPE("MedianFilter::process");
+    output.resize(input.size());
 
     for (size_t i = 0; i < input.size(); ++i) {
-        output.push_back(computeWindowMedian(input, i));
+        output[i] = computeWindowMedian(input, i);
     }
-
-    return output;
 }
 
 std::string MedianFilter::getName() const {
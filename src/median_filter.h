@@ -25,11 +25,19 @@ public:
      */
     Signal process(const Signal& input) override;
 
+    /** Выход пишется в output без промежуточного вектора */
+    void processInto(const Signal& input, Signal& output) override;
+
     /**
      * Получить имя алгоритма
      */
     std::string getName() const override;
 
+    /** Независимая копия фильтра */
+    std::unique_ptr<SignalProcessor> clone() const override {
+        return std::make_unique<MedianFilter>(*this);
+    }
+
     /**
      * Установить размер окна
      * @param windowSize Новый размер окна (должен быть нечетным)
@@ -39,7 +47,10 @@ public:
     /**
      * Получить текущий размер окна
      */
-    size_t getWindowSize() const;
+    size_t getWindowSize() const override;
+
+    /** Половина окна: края дополняются крайними отсчётами */
+    size_t getReach() const override { return windowSize_ / 2; }
 
 private:
     /**
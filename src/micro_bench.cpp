@@ -0,0 +1,461 @@
+/**
+ * micro_bench — микро-бенчмарки ядер из src/utils и фильтров по отдельности
+ *
+ * Запуск:
+ *   ./build/micro_bench [опции]
+ *
+ * Наборы:
+ *   fft_inplace/N          — прямое БПФ, N = 2^6 … 2^20
+ *   median/w               — median() окна w
+ *   solveLinearSystem/M    — LU-решение системы M×M (матрица Тёплица, как в Винере)
+ *   metrics/separate/N     — calculateSNR + calculateMSE + calculateCorrelation
+ *   metrics/fused/N        — calculateQualityMetrics (один проход)
+ *   chain/serial/B         — Outlier → Wiener → SavGol для B блоков по 4096 в одном потоке
+ *   chain/pipelined/B      — то же через PipelinedExecutor (этап на поток)
+ *   <Фильтр>/N             — SignalProcessor::process на сетке длин и параметров
+ *
+ * Опции:
+ *   --filter TEXT          только бенчмарки, в имени которых есть TEXT
+ *   --list                 вывести имена и выйти
+ *   --json FILE            сохранить результаты в JSON (utils/bench_report.h)
+ *   --baseline FILE        сравнить с сохранённым JSON; при регрессии код выхода 2
+ *   --time-tolerance X     допустимое замедление, доля (по умолчанию 0.05)
+ *   --runs N               повторить весь набор N раз (разброс между прогонами)
+ *   --quick                короткие замеры (прогрев 1, минимум 3 повтора)
+ *
+ * Быстрые операции (доли микросекунды) выполняются пачками: размер пачки
+ * подбирается так, чтобы один замер длился не меньше kMinBatchNs, иначе
+ * время вызова steady_clock сравнимо с измеряемым. Результаты вычислений
+ * проходят через doNotOptimize, чтобы компилятор не удалил их.
+ */
+
+#include "signal_generator.h"
+#include "median_filter.h"
+#include "wiener_filter.h"
+#include "robust_wiener_filter.h"
+#include "morphological_filter.h"
+#include "savgol_filter.h"
+#include "kalman_filter.h"
+#include "outlier_detection.h"
+#include "spectral_subtraction_filter.h"
+#include "pipelined_executor.h"
+#include "utils/fft.h"
+#include "utils/median.h"
+#include "utils/linear_system_solver.h"
+#include "utils/timing.h"
+#include "utils/bench_report.h"
+#include "utils/random.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Минимальная длительность одного замера, нс
+static constexpr double kMinBatchNs = 2000.0;
+
+/**
+ * Один бенчмарк: setup готовит данные и возвращает замеряемую операцию
+ */
+struct MicroBenchmark {
+    std::string name;
+    size_t      items;   ///< Обрабатываемых элементов за вызов (для пропускной способности)
+    std::function<std::function<void()>()> setup;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Входные данные
+// ─────────────────────────────────────────────────────────────────────────────
+static std::vector<double> randomVector(size_t n, uint64_t seed) {
+    Xoshiro256 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> v(n);
+    for (double& x : v) x = dist(rng);
+    return v;
+}
+
+static SignalProcessor::Signal noisySignal(size_t n) {
+    SignalGenerator generator(42);
+    return generator.generateTestDataset(n, 1).front().second;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Наборы бенчмарков
+// ─────────────────────────────────────────────────────────────────────────────
+static void addFftBenchmarks(std::vector<MicroBenchmark>& out) {
+    for (size_t log2n = 6; log2n <= 20; log2n += 2) {
+        const size_t n = size_t(1) << log2n;
+        out.push_back({"fft_inplace/" + std::to_string(n), n, [n] {
+            auto re = randomVector(n, n);
+            auto input = std::make_shared<CVector>(n);
+            for (size_t i = 0; i < n; ++i) (*input)[i] = Complex(re[i], 0.0);
+            auto work = std::make_shared<CVector>(n);
+            // Повторное БПФ того же буфера переполнилось бы — вход копируется
+            // в заранее выделенный буфер (O(N) против O(N log N))
+            return std::function<void()>([input, work] {
+                std::copy(input->begin(), input->end(), work->begin());
+                fft_impl::fft_inplace(*work);
+                doNotOptimize(work->data());
+                clobberMemory();
+            });
+        }});
+    }
+}
+
+static void addMedianBenchmarks(std::vector<MicroBenchmark>& out) {
+    for (size_t w : {3, 5, 7, 11, 15, 31, 63, 127, 255}) {
+        out.push_back({"median/" + std::to_string(w), w, [w] {
+            auto window = std::make_shared<std::vector<double>>(randomVector(w, w));
+            return std::function<void()>([window] {
+                const double m = median(*window);
+                doNotOptimize(m);
+            });
+        }});
+    }
+}
+
+static void addSolverBenchmarks(std::vector<MicroBenchmark>& out) {
+    namespace ublas = boost::numeric::ublas;
+    for (size_t m : {4, 8, 16, 32, 64, 128}) {
+        out.push_back({"solveLinearSystem/" + std::to_string(m), m, [m] {
+            // Автокорреляционная матрица Тёплица AR(1)-процесса: симметричная,
+            // положительно определённая — как R в фильтре Винера
+            auto A = std::make_shared<ublas::matrix<double>>(m, m);
+            auto b = std::make_shared<ublas::vector<double>>(m);
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t j = 0; j < m; ++j) {
+                    (*A)(i, j) = std::pow(0.9, std::abs(static_cast<double>(i) - j));
+                }
+                (*b)(i) = std::pow(0.9, static_cast<double>(i + 1));
+            }
+            return std::function<void()>([A, b] {
+                auto w = solveLinearSystem(*A, *b);
+                doNotOptimize(w.data().begin());
+                clobberMemory();
+            });
+        }});
+    }
+}
+
+static void addMetricsBenchmarks(std::vector<MicroBenchmark>& out) {
+    for (size_t n : {1000, 10000, 100000}) {
+        auto makeInputs = [n] {
+            auto clean = std::make_shared<std::vector<double>>(randomVector(n, n));
+            auto processed = std::make_shared<std::vector<double>>(randomVector(n, n + 1));
+            for (size_t i = 0; i < n; ++i) (*processed)[i] = (*clean)[i] + 0.1 * (*processed)[i];
+            return std::make_pair(clean, processed);
+        };
+        out.push_back({"metrics/separate/" + std::to_string(n), n, [makeInputs] {
+            auto [clean, processed] = makeInputs();
+            return std::function<void()>([clean, processed] {
+                doNotOptimize(calculateSNR(*clean, *processed));
+                doNotOptimize(calculateMSE(*clean, *processed));
+                doNotOptimize(calculateCorrelation(*clean, *processed));
+            });
+        }});
+        out.push_back({"metrics/fused/" + std::to_string(n), n, [makeInputs] {
+            auto [clean, processed] = makeInputs();
+            return std::function<void()>([clean, processed] {
+                const QualityMetrics m = calculateQualityMetrics(*clean, *processed);
+                doNotOptimize(m);
+            });
+        }});
+    }
+}
+
+static void addChainBenchmarks(std::vector<MicroBenchmark>& out) {
+    constexpr size_t kBlockSize = 4096;
+    auto makeStages = [] {
+        std::vector<std::unique_ptr<SignalProcessor>> stages;
+        stages.push_back(std::make_unique<OutlierDetection>(
+            OutlierDetection::DetectionMethod::MAD_BASED,
+            OutlierDetection::InterpolationMethod::LINEAR, 3.0, 11));
+        stages.push_back(std::make_unique<WienerFilter>(16, 9, 1e-4));
+        stages.push_back(std::make_unique<SavgolFilter>(21, 4));
+        return stages;
+    };
+    auto makeBlocks = [](size_t count) {
+        auto blocks = std::make_shared<std::vector<SignalProcessor::Signal>>();
+        for (size_t b = 0; b < count; ++b) blocks->push_back(randomVector(kBlockSize, b));
+        return blocks;
+    };
+
+    for (size_t count : {16, 64}) {
+        out.push_back({"chain/serial/" + std::to_string(count), count * kBlockSize,
+                       [makeStages, makeBlocks, count] {
+            auto stages = std::make_shared<std::vector<std::unique_ptr<SignalProcessor>>>(
+                makeStages());
+            auto blocks = makeBlocks(count);
+            auto buffers = std::make_shared<std::array<SignalProcessor::Signal, 2>>();
+            return std::function<void()>([stages, blocks, buffers] {
+                for (const auto& block : *blocks) {
+                    const SignalProcessor::Signal* in = &block;
+                    for (size_t s = 0; s < stages->size(); ++s) {
+                        (*stages)[s]->processInto(*in, (*buffers)[s % 2]);
+                        in = &(*buffers)[s % 2];
+                    }
+                    doNotOptimize(in->data());
+                }
+                clobberMemory();
+            });
+        }});
+        out.push_back({"chain/pipelined/" + std::to_string(count), count * kBlockSize,
+                       [makeStages, makeBlocks, count] {
+            auto executor = std::make_shared<PipelinedExecutor>(makeStages());
+            auto blocks = makeBlocks(count);
+            return std::function<void()>([executor, blocks] {
+                size_t next = 0;
+                executor->run(
+                    [&](SignalProcessor::Signal& block) {
+                        if (next == blocks->size()) return false;
+                        block.assign((*blocks)[next].begin(), (*blocks)[next].end());
+                        ++next;
+                        return true;
+                    },
+                    [](size_t, const SignalProcessor::Signal& block) {
+                        doNotOptimize(block.data());
+                    });
+                clobberMemory();
+            });
+        }});
+    }
+}
+
+static void addFilterBenchmarks(std::vector<MicroBenchmark>& out) {
+    using Factory = std::function<std::unique_ptr<SignalProcessor>()>;
+    const std::vector<Factory> factories = {
+        [] { return std::make_unique<MedianFilter>(5); },
+        [] { return std::make_unique<MedianFilter>(51); },
+        [] { return std::make_unique<WienerFilter>(8, 5, 1e-4); },
+        [] { return std::make_unique<WienerFilter>(32, 31, 1e-4); },
+        [] { return std::make_unique<RobustWienerFilter>(10, 5, 1e-4, 3.5, 11); },
+        [] { return std::make_unique<MorphologicalFilter>(
+                 MorphologicalFilter::Operation::OPENING, 5); },
+        [] { return std::make_unique<MorphologicalFilter>(
+                 MorphologicalFilter::Operation::OPENING, 31); },
+        [] { return std::make_unique<SavgolFilter>(11, 3); },
+        [] { return std::make_unique<SavgolFilter>(31, 4); },
+        [] { return std::make_unique<KalmanFilter>(0.1, 1.0, 1.0); },
+        [] { return std::make_unique<OutlierDetection>(
+                 OutlierDetection::DetectionMethod::MAD_BASED,
+                 OutlierDetection::InterpolationMethod::LINEAR, 3.0, 11); },
+        [] { return std::make_unique<OutlierDetection>(
+                 OutlierDetection::DetectionMethod::ADAPTIVE_THRESHOLD,
+                 OutlierDetection::InterpolationMethod::AUTOREGRESSIVE, 2.0, 7); },
+        [] { return std::make_unique<SpectralSubtractionFilter>(256); },
+    };
+
+    for (const Factory& factory : factories) {
+        const std::string name = factory()->getName();
+        for (size_t n : {1000, 10000, 100000}) {
+            out.push_back({name + "/" + std::to_string(n), n, [factory, n] {
+                std::shared_ptr<SignalProcessor> filter = factory();
+                auto input = std::make_shared<SignalProcessor::Signal>(noisySignal(n));
+                return std::function<void()>([filter, input] {
+                    auto output = filter->process(*input);
+                    doNotOptimize(output.data());
+                    clobberMemory();
+                });
+            }});
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Замер
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// Наименьшая пачка (степень двойки), которая выполняется не меньше kMinBatchNs
+static size_t calibrateBatch(const std::function<void()>& op) {
+    using Clock = std::chrono::steady_clock;
+    op();   // Прогрев кэшей и ленивой инициализации
+    for (size_t batch = 1; ; batch *= 2) {
+        const auto start = Clock::now();
+        for (size_t i = 0; i < batch; ++i) op();
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        if (ns >= kMinBatchNs || batch >= (size_t(1) << 24)) return batch;
+    }
+}
+
+/// Статистика пачки → на один вызов
+static TimingStats perCall(TimingStats stats, size_t batch) {
+    const double k = 1.0 / static_cast<double>(batch);
+    for (double* v : {&stats.minNs, &stats.medianNs, &stats.meanNs, &stats.p90Ns,
+                      &stats.p99Ns, &stats.maxNs, &stats.madNs}) {
+        *v *= k;
+    }
+    return stats;
+}
+
+static TimingStats runBenchmark(const MicroBenchmark& bench, const TimingOptions& options) {
+    const std::function<void()> op = bench.setup();
+    const size_t batch = calibrateBatch(op);
+    const TimingStats stats = measureTiming([&] {
+        for (size_t i = 0; i < batch; ++i) op();
+    }, options);
+    return perCall(stats, batch);
+}
+
+static void printUsage(const char* prog) {
+    std::cout << "Использование: " << prog << " [опции]\n\n"
+              << "Опции:\n"
+              << "  -h, --help            Показать эту справку\n"
+              << "  --filter TEXT         Только бенчмарки, в имени которых есть TEXT\n"
+              << "  --list                Вывести имена и выйти\n"
+              << "  --json FILE           Сохранить результаты в JSON\n"
+              << "  --baseline FILE       Сравнить с базовой линией (код выхода 2 при регрессии)\n"
+              << "  --time-tolerance X    Допустимое замедление, доля (по умолчанию 0.05)\n"
+              << "  --runs N              Повторить весь набор N раз (по умолчанию 1)\n"
+              << "  --quick               Короткие замеры\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string     filter, jsonFile, baselineFile;
+    bool            listOnly = false;
+    size_t          numRuns  = 1;
+    BenchThresholds thresholds;
+    TimingOptions   options;
+    options.warmupRuns = 2;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        try {
+            if (a == "-h" || a == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (a == "--filter" && hasValue) {
+                filter = argv[++i];
+            } else if (a == "--list") {
+                listOnly = true;
+            } else if (a == "--json" && hasValue) {
+                jsonFile = argv[++i];
+            } else if (a == "--baseline" && hasValue) {
+                baselineFile = argv[++i];
+            } else if (a == "--time-tolerance" && hasValue) {
+                thresholds.timeTolerance = std::stod(argv[++i]);
+            } else if (a == "--runs" && hasValue) {
+                numRuns = std::max<size_t>(1, std::stoul(argv[++i]));
+            } else if (a == "--quick") {
+                options.warmupRuns      = 1;
+                options.minRepetitions  = 3;
+                options.maxTotalSeconds = 0.05;
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Неверное значение опции " << a << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<MicroBenchmark> all;
+    addFftBenchmarks(all);
+    addMedianBenchmarks(all);
+    addSolverBenchmarks(all);
+    addMetricsBenchmarks(all);
+    addChainBenchmarks(all);
+    addFilterBenchmarks(all);
+
+    std::vector<MicroBenchmark> benchmarks;
+    for (auto& bench : all) {
+        if (bench.name.find(filter) != std::string::npos) benchmarks.push_back(std::move(bench));
+    }
+
+    if (listOnly) {
+        for (const auto& bench : benchmarks) std::cout << bench.name << "\n";
+        return 0;
+    }
+    if (benchmarks.empty()) {
+        std::cerr << "Нет бенчмарков, подходящих под \"" << filter << "\"\n";
+        return 1;
+    }
+
+    BenchReport baseline;
+    if (!baselineFile.empty()) {
+        try {
+            baseline = readBenchJson(baselineFile);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    BenchReport report;
+    report.benchmark   = "micro_bench";
+    report.environment = currentBenchEnvironment();
+    report.signals     = {"synthetic"};
+
+    std::cout << "micro_bench: " << report.environment.cpuModel << ", "
+              << report.environment.compiler << "\n";
+    for (const std::string& warning : report.environment.warnings) {
+        std::cout << "ВНИМАНИЕ: " << warning << "\n";
+    }
+    std::cout << "\n";
+
+    // runs[bench][run]; прогоны — целиком по всему набору
+    std::vector<std::vector<TimingStats>> runs(benchmarks.size());
+    for (size_t run = 0; run < numRuns; ++run) {
+        if (numRuns > 1) std::cout << "Прогон " << run + 1 << "/" << numRuns << "\n";
+        for (size_t b = 0; b < benchmarks.size(); ++b) {
+            runs[b].push_back(runBenchmark(benchmarks[b], options));
+        }
+    }
+
+    // Заголовок выровнен вручную: setw считает байты, а не символы UTF-8
+    std::cout << "Бенчмарк" << std::string(40, ' ')
+              << "   Медиана, нс" << "       Мин, нс" << "    ±ДИ, %" << "         Мэл/с\n";
+    std::cout << std::string(100, '-') << "\n";
+
+    for (size_t b = 0; b < benchmarks.size(); ++b) {
+        // Прогон с медианным временем
+        std::vector<TimingStats> sorted = runs[b];
+        std::sort(sorted.begin(), sorted.end(), [](const TimingStats& x, const TimingStats& y) {
+            return x.medianNs < y.medianNs;
+        });
+        const TimingStats& t = sorted[sorted.size() / 2];
+
+        std::cout << std::left << std::setw(48) << benchmarks[b].name << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << t.medianNs << std::setw(14) << t.minNs
+                  << std::setprecision(2) << std::setw(10) << t.relativeCI * 100.0
+                  << std::setw(14) << (t.medianNs > 0.0 ? benchmarks[b].items * 1e3 / t.medianNs : 0.0)
+                  << "\n";
+
+        BenchEntry entry;
+        entry.name    = benchmarks[b].name;
+        entry.timings = {t};
+        if (numRuns > 1) {
+            std::vector<double> medians;
+            for (const TimingStats& r : runs[b]) medians.push_back(r.medianNs);
+            entry.runMediansNs = {medians};
+        }
+        report.entries.push_back(std::move(entry));
+    }
+
+    if (!jsonFile.empty()) {
+        try {
+            writeBenchJson(jsonFile, report);
+            std::cout << "\nРезультаты сохранены: " << jsonFile << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    if (!baselineFile.empty()) {
+        const BenchComparison cmp = compareBenchReports(baseline, report, thresholds);
+        std::cout << "\n" << formatBenchComparison(cmp, thresholds);
+        if (cmp.failed()) return 2;
+    }
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "morphological_filter.h"
+#include "utils/trace.h"
 #include <algorithm>
 #include <limits>
 #include <stdexcept>
@@ -16,6 +17,7 @@ MorphologicalFilter::MorphologicalFilter(Operation operation, const std::vector<
 }
 
 SignalProcessor::Signal MorphologicalFilter::process(const Signal& input) {
+    TRACE_SCOPE("MorphologicalFilter::process");
     if (input.empty()) {
         return Signal();
     }
@@ -39,6 +41,12 @@ std::string MorphologicalFilter::getName() const {
            std::to_string(structuringElement_.size());
 }
 
+size_t MorphologicalFilter::getReach() const {
+    const size_t half = structuringElement_.size() / 2;
+    const bool twoPasses = operation_ == Operation::OPENING || operation_ == Operation::CLOSING;
+    return twoPasses ? 2 * half : half;
+}
+
 void MorphologicalFilter::setOperation(Operation operation) {
     operation_ = operation;
 }
@@ -51,6 +59,7 @@ void MorphologicalFilter::setStructuringElement(const std::vector<double>& struc
 }
 
 SignalProcessor::Signal MorphologicalFilter::erosion(const Signal& input) const {
+    TRACE_SCOPE("MorphologicalFilter::erosion");
     Signal result;
     result.reserve(input.size());
 
@@ -80,6 +89,7 @@ SignalProcessor::Signal MorphologicalFilter::erosion(const Signal& input) const
 }
 
 SignalProcessor::Signal MorphologicalFilter::dilation(const Signal& input) const {
+    TRACE_SCOPE("MorphologicalFilter::dilation");
     Signal result;
     result.reserve(input.size());
 
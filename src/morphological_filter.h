@@ -49,6 +49,17 @@ public:
      */
     std::string getName() const override;
 
+    /** Независимая копия фильтра */
+    std::unique_ptr<SignalProcessor> clone() const override {
+        return std::make_unique<MorphologicalFilter>(*this);
+    }
+
+    /** Размер структурирующего элемента */
+    size_t getWindowSize() const override { return structuringElement_.size(); }
+
+    /** Половина элемента на проход; размыкание и замыкание — два прохода */
+    size_t getReach() const override;
+
     /**
      * Установить тип операции
      * @param operation Новый тип операции
@@ -1,5 +1,6 @@
 #include "outlier_detection.h"
 #include "utils/median.h"
+#include "utils/trace.h"
 
 #include <algorithm>
 #include <numeric>
@@ -25,6 +26,7 @@ OutlierDetection::OutlierDetection(DetectionMethod detectionMethod,
 }
 
 SignalProcessor::Signal OutlierDetection::process(const Signal& input) {
+    TRACE_SCOPE("OutlierDetection::process");
     if (input.empty()) {
         return Signal();
     }
@@ -73,6 +75,7 @@ void OutlierDetection::setParameters(DetectionMethod detectionMethod,
 }
 
 std::vector<bool> OutlierDetection::detectOutliers(const Signal& input) const {
+    TRACE_SCOPE("OutlierDetection::detectOutliers");
     switch (detectionMethod_) {
         case DetectionMethod::MAD_BASED:
             return detectMADBased(input);
@@ -204,6 +207,7 @@ std::vector<bool> OutlierDetection::detectAdaptiveThreshold(const Signal& input)
 
 SignalProcessor::Signal OutlierDetection::interpolateLinear(const Signal& input,
                                                             const std::vector<bool>& outliers) const {
+    TRACE_SCOPE("OutlierDetection::interpolateLinear");
     Signal result = input;
 
     for (size_t i = 0; i < outliers.size(); ++i) {
@@ -231,6 +235,7 @@ SignalProcessor::Signal OutlierDetection::interpolateLinear(const Signal& input,
 
 SignalProcessor::Signal OutlierDetection::interpolateMedian(const Signal& input,
                                                             const std::vector<bool>& outliers) const {
+    TRACE_SCOPE("OutlierDetection::interpolateMedian");
     Signal result = input;
     size_t halfWindow = std::min(windowSize_ / 2, static_cast<size_t>(5));
 
@@ -257,6 +262,7 @@ SignalProcessor::Signal OutlierDetection::interpolateMedian(const Signal& input,
 
 SignalProcessor::Signal OutlierDetection::interpolateAutoregressive(const Signal& input,
                                                                     const std::vector<bool>& outliers) const {
+    TRACE_SCOPE("OutlierDetection::interpolateAutoregressive");
     Signal result = input;
 
     // Упрощенная AR модель: используем взвешенное среднее предыдущих значений
@@ -59,6 +59,14 @@ public:
      */
     std::string getName() const override;
 
+    /** Независимая копия фильтра */
+    std::unique_ptr<SignalProcessor> clone() const override {
+        return std::make_unique<OutlierDetection>(*this);
+    }
+
+    /** Размер окна анализа */
+    size_t getWindowSize() const override { return windowSize_; }
+
     /**
      * Установить параметры алгоритма
      * @param detectionMethod Метод обнаружения
@@ -0,0 +1,355 @@
+#include "parameter_tuner.h"
+#include "median_filter.h"
+#include "wiener_filter.h"
+#include "robust_wiener_filter.h"
+#include "morphological_filter.h"
+#include "savgol_filter.h"
+#include "kalman_filter.h"
+#include "outlier_detection.h"
+#include "utils/parallel.h"
+#include "utils/trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ParameterSpace
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+std::atomic<uint64_t> nextSpaceId{0};
+
+} // namespace
+
+ParameterSpace::ParameterSpace(std::string name, Factory factory)
+    : name_(std::move(name)),
+      id_(nextSpaceId.fetch_add(1, std::memory_order_relaxed) + 1),
+      factory_(std::move(factory)) {
+    if (!factory_) {
+        throw std::invalid_argument("ParameterSpace: factory must not be empty");
+    }
+}
+
+ParameterSpace& ParameterSpace::add(std::string name, std::vector<double> values) {
+    if (values.empty()) {
+        throw std::invalid_argument("ParameterSpace: parameter " + name + " has no values");
+    }
+    parameters_.push_back({std::move(name), std::move(values)});
+    return *this;
+}
+
+ParameterSpace& ParameterSpace::addRange(std::string name, double first, double last, double step) {
+    if (step <= 0.0) {
+        throw std::invalid_argument("ParameterSpace: step must be positive");
+    }
+    std::vector<double> values;
+    // Половина шага — запас на ошибку округления при накоплении
+    for (size_t i = 0; first + i * step <= last + step * 0.5; ++i) values.push_back(first + i * step);
+    return add(std::move(name), std::move(values));
+}
+
+ParameterSpace& ParameterSpace::addLog(std::string name, double first, double last, size_t count) {
+    if (first <= 0.0 || last <= 0.0 || count == 0) {
+        throw std::invalid_argument("ParameterSpace: log range must be positive");
+    }
+    std::vector<double> values(count);
+    const double a = std::log(first), b = std::log(last);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = count == 1 ? first : std::exp(a + (b - a) * i / (count - 1));
+    }
+    return add(std::move(name), std::move(values));
+}
+
+ParameterSpace& ParameterSpace::require(Constraint allowed) {
+    constraints_.push_back(std::move(allowed));
+    return *this;
+}
+
+std::vector<ParameterSpace::Values> ParameterSpace::candidates() const {
+    std::vector<Values> result;
+    Values current(parameters_.size());
+    std::vector<size_t> index(parameters_.size(), 0);
+
+    // Счётчик со смешанным основанием: последний параметр меняется быстрее всех
+    for (;;) {
+        for (size_t p = 0; p < parameters_.size(); ++p) current[p] = parameters_[p].values[index[p]];
+        const bool allowed = std::all_of(constraints_.begin(), constraints_.end(),
+                                         [&](const Constraint& c) { return c(current); });
+        if (allowed) result.push_back(current);
+
+        size_t p = parameters_.size();
+        while (p > 0) {
+            --p;
+            if (++index[p] < parameters_[p].values.size()) break;
+            index[p] = 0;
+            if (p == 0) return result;
+        }
+        if (parameters_.empty()) return result;
+    }
+}
+
+std::unique_ptr<SignalProcessor> ParameterSpace::create(const Values& values) const {
+    return factory_(values);
+}
+
+std::string ParameterSpace::describe(const Values& values) const {
+    std::ostringstream out;
+    for (size_t p = 0; p < parameters_.size() && p < values.size(); ++p) {
+        if (p > 0) out << ' ';
+        out << parameters_[p].name << '=' << values[p];
+    }
+    return out.str();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Пространства фильтров библиотеки
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+size_t asSize(double v) { return static_cast<size_t>(std::llround(v)); }
+
+} // namespace
+
+ParameterSpace medianParameterSpace() {
+    return ParameterSpace("median", [](const ParameterSpace::Values& v) {
+               return std::make_unique<MedianFilter>(asSize(v[0]));
+           })
+        .addRange("window", 3, 31, 2);
+}
+
+ParameterSpace wienerParameterSpace() {
+    return ParameterSpace("wiener", [](const ParameterSpace::Values& v) {
+               return std::make_unique<WienerFilter>(asSize(v[0]), asSize(v[1]), v[2]);
+           })
+        .add("order", {4, 8, 12, 16, 24, 32})
+        .add("window", {3, 5, 9, 15, 21, 31})
+        .add("reg", {1e-5, 1e-4, 1e-3});
+}
+
+ParameterSpace robustWienerParameterSpace() {
+    return ParameterSpace("robust_wiener", [](const ParameterSpace::Values& v) {
+               return std::make_unique<RobustWienerFilter>(asSize(v[0]), asSize(v[1]), v[2],
+                                                           v[3], asSize(v[4]));
+           })
+        .add("order", {8, 16, 24})
+        .add("window", {5, 9, 15})
+        .add("reg", {1e-4})
+        .add("threshold", {2.5, 3.5, 4.5})
+        .add("outlierWindow", {7, 11, 15});
+}
+
+ParameterSpace morphologicalParameterSpace() {
+    // operation: 0 — размыкание, 1 — замыкание, 2 — эрозия, 3 — дилатация
+    return ParameterSpace("morphological", [](const ParameterSpace::Values& v) {
+               return std::make_unique<MorphologicalFilter>(
+                   static_cast<MorphologicalFilter::Operation>(asSize(v[0])), asSize(v[1]));
+           })
+        .add("operation", {0, 1, 2, 3})
+        .add("size", {3, 5, 7, 9, 11, 15});
+}
+
+ParameterSpace savgolParameterSpace() {
+    return ParameterSpace("savgol", [](const ParameterSpace::Values& v) {
+               return std::make_unique<SavgolFilter>(asSize(v[0]), asSize(v[1]));
+           })
+        .add("window", {5, 7, 11, 15, 21, 31, 41})
+        .add("order", {2, 3, 4, 5})
+        .require([](const ParameterSpace::Values& v) { return v[1] < v[0]; });
+}
+
+ParameterSpace kalmanParameterSpace() {
+    return ParameterSpace("kalman", [](const ParameterSpace::Values& v) {
+               return std::make_unique<KalmanFilter>(v[0], v[1], 1.0);
+           })
+        .addLog("q", 1e-4, 1.0, 9)
+        .add("r", {0.1, 1.0, 10.0});
+}
+
+ParameterSpace outlierParameterSpace() {
+    // detection: 0 — MAD, 1 — z-score, 2 — адаптивный порог;
+    // interpolation: 0 — линейная, 1 — сплайн, 2 — медиана, 3 — AR
+    return ParameterSpace("outlier", [](const ParameterSpace::Values& v) {
+               return std::make_unique<OutlierDetection>(
+                   static_cast<OutlierDetection::DetectionMethod>(asSize(v[0])),
+                   static_cast<OutlierDetection::InterpolationMethod>(asSize(v[1])),
+                   v[2], asSize(v[3]));
+           })
+        .add("detection", {0, 1, 2})
+        .add("interpolation", {0, 1, 2, 3})
+        .add("threshold", {2.0, 2.5, 3.0, 3.5, 4.0})
+        .add("window", {7, 11, 15});
+}
+
+std::vector<ParameterSpace> builtinParameterSpaces() {
+    return {medianParameterSpace(), wienerParameterSpace(), robustWienerParameterSpace(),
+            morphologicalParameterSpace(), savgolParameterSpace(), kalmanParameterSpace(),
+            outlierParameterSpace()};
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ParameterTuner
+// ─────────────────────────────────────────────────────────────────────────────
+
+ParameterTuner::ParameterTuner(Dataset dataset, TuningOptions options)
+    : dataset_(std::move(dataset)), options_(options) {
+    if (dataset_.empty()) {
+        throw std::invalid_argument("ParameterTuner: dataset is empty");
+    }
+    for (const auto& [clean, noisy] : dataset_) {
+        if (clean.size() != noisy.size() || clean.empty()) {
+            throw std::invalid_argument("ParameterTuner: clean and noisy lengths differ");
+        }
+    }
+}
+
+double ParameterTuner::score(const QualityMetrics& m) const {
+    double s = 0.0;
+    switch (options_.metric) {
+        case TuningMetric::SNR:         s = m.snr;         break;
+        case TuningMetric::MSE:         s = -m.mse;        break;
+        case TuningMetric::CORRELATION: s = m.correlation; break;
+        case TuningMetric::PSNR:        s = m.psnr;        break;
+    }
+    return std::isnan(s) ? -std::numeric_limits<double>::infinity() : s;
+}
+
+TuningResult ParameterTuner::tune(const ParameterSpace& space) {
+    TRACE_SCOPE("ParameterTuner::tune");
+    const std::vector<ParameterSpace::Values> all = space.candidates();
+    if (all.empty()) {
+        throw std::invalid_argument("ParameterTuner: parameter space " + space.name() +
+                                    " has no candidates");
+    }
+
+    size_t maxLength = 0;
+    for (const auto& pair : dataset_) maxLength = std::max(maxLength, pair.first.size());
+
+    // Длины префиксов: от полной длины вниз делением на eta — пока ступеней
+    // не хватает, чтобы сократить кандидатов до одного, и префикс не короче
+    // minPrefix. Если ступеней меньше, последняя оценивает всех оставшихся
+    std::vector<size_t> prefixes{maxLength};
+    if (options_.eta > 1) {
+        size_t survivors = all.size();
+        size_t prefix = maxLength;
+        while (survivors > 1 && prefix / options_.eta >= options_.minPrefix) {
+            survivors = (survivors + options_.eta - 1) / options_.eta;
+            prefix /= options_.eta;
+            prefixes.push_back(prefix);
+        }
+        std::reverse(prefixes.begin(), prefixes.end());
+    }
+
+    std::vector<TuningCandidate> candidates(all.size());
+    for (size_t c = 0; c < all.size(); ++c) {
+        candidates[c].values      = all[c];
+        candidates[c].description = space.describe(all[c]);
+    }
+    std::vector<size_t> alive(all.size());
+    std::iota(alive.begin(), alive.end(), 0);
+
+    TuningResult result;
+    const size_t numSignals = dataset_.size();
+    const QualityMetrics failed{-std::numeric_limits<double>::infinity(),
+                                std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity(),
+                                std::numeric_limits<double>::infinity()};
+
+    for (size_t r = 0; r < prefixes.size(); ++r) {
+        TRACE_SCOPE("ParameterTuner::rung");
+        const auto start = std::chrono::steady_clock::now();
+        TuningRung rung;
+        rung.prefix     = prefixes[r];
+        rung.candidates = alive.size();
+
+        // Оценки, которых нет в кэше: (кандидат, сигнал)
+        auto keyOf = [&](size_t c, size_t s) {
+            return CacheKey{space.id(), candidates[c].values, s,
+                            std::min(rung.prefix, dataset_[s].first.size())};
+        };
+        std::vector<std::pair<size_t, size_t>> tasks;
+        for (size_t c : alive) {
+            for (size_t s = 0; s < numSignals; ++s) {
+                if (cache_.count(keyOf(c, s))) {
+                    ++rung.cacheHits;
+                } else {
+                    tasks.emplace_back(c, s);
+                }
+            }
+        }
+
+        std::vector<QualityMetrics> computed(tasks.size());
+        parallelForWorkers(tasks.size(), options_.numThreads, false, [&](size_t, size_t t) {
+            const auto [c, s] = tasks[t];
+            const auto& [clean, noisy] = dataset_[s];
+            const size_t length = std::min(rung.prefix, clean.size());
+            try {
+                auto filter = space.create(candidates[c].values);
+                const Signal input(noisy.begin(), noisy.begin() + length);
+                const Signal reference(clean.begin(), clean.begin() + length);
+                computed[t] = calculateQualityMetrics(reference, filter->process(input));
+            } catch (const std::exception&) {
+                // Недопустимое сочетание параметров — худшая оценка, не ошибка подбора
+                computed[t] = failed;
+            }
+        });
+        for (size_t t = 0; t < tasks.size(); ++t) {
+            cache_[keyOf(tasks[t].first, tasks[t].second)] = computed[t];
+        }
+        rung.evaluations = tasks.size();
+
+        // Средние по сигналам
+        for (size_t c : alive) {
+            QualityMetrics mean;
+            double total = 0.0;
+            for (size_t s = 0; s < numSignals; ++s) {
+                const QualityMetrics& m = cache_.at(keyOf(c, s));
+                mean.snr         += m.snr;
+                mean.mse         += m.mse;
+                mean.correlation += m.correlation;
+                mean.psnr        += m.psnr;
+                mean.maxError     = std::max(mean.maxError, m.maxError);
+                total            += score(m);
+            }
+            const double n = static_cast<double>(numSignals);
+            mean.snr /= n;
+            mean.mse /= n;
+            mean.correlation /= n;
+            mean.psnr /= n;
+
+            TuningCandidate& cand = candidates[c];
+            cand.mean   = mean;
+            cand.score  = std::isnan(total) ? -std::numeric_limits<double>::infinity() : total / n;
+            cand.prefix = rung.prefix;
+            cand.rung   = r;
+        }
+
+        // Лучшие 1/eta проходят дальше (при равенстве — в исходном порядке)
+        std::stable_sort(alive.begin(), alive.end(), [&](size_t a, size_t b) {
+            return candidates[a].score > candidates[b].score;
+        });
+        if (r + 1 < prefixes.size()) {
+            alive.resize(std::max<size_t>(1, (alive.size() + options_.eta - 1) / options_.eta));
+        }
+
+        rung.elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        result.rungs.push_back(rung);
+    }
+
+    result.ranking = std::move(candidates);
+    std::stable_sort(result.ranking.begin(), result.ranking.end(),
+                     [](const TuningCandidate& a, const TuningCandidate& b) {
+                         if (a.rung != b.rung) return a.rung > b.rung;
+                         return a.score > b.score;
+                     });
+    return result;
+}
@@ -0,0 +1,192 @@
+#ifndef PARAMETER_TUNER_H
+#define PARAMETER_TUNER_H
+
+#include "signal_processor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * Гиперпараметр: имя и перебираемые значения
+ *
+ * Значения — числа; перечисления (метод, операция) задаются номерами
+ * и приводятся к enum в фабрике пространства.
+ */
+struct TunableParameter {
+    std::string         name;
+    std::vector<double> values;
+};
+
+/**
+ * Пространство параметров фильтра: описание параметров и фабрика
+ *
+ * Набор значений (Values) — по одному на параметр, в порядке добавления.
+ * Кандидаты — декартово произведение значений, из которого ограничения
+ * (require) исключают недопустимые сочетания.
+ *
+ * Каждое созданное пространство получает свой номер (id()), копии его
+ * сохраняют: по нему ParameterTuner отличает пространства с одинаковым
+ * именем, но другой фабрикой или другим порядком параметров.
+ */
+class ParameterSpace {
+public:
+    using Values     = std::vector<double>;
+    using Factory    = std::function<std::unique_ptr<SignalProcessor>(const Values&)>;
+    using Constraint = std::function<bool(const Values&)>;
+
+    ParameterSpace(std::string name, Factory factory);
+
+    /** Параметр с явным списком значений */
+    ParameterSpace& add(std::string name, std::vector<double> values);
+
+    /** Параметр first, first + step, … ≤ last */
+    ParameterSpace& addRange(std::string name, double first, double last, double step);
+
+    /** count значений, равномерно по логарифмической шкале от first до last */
+    ParameterSpace& addLog(std::string name, double first, double last, size_t count);
+
+    /** Оставить только сочетания, для которых allowed(values) == true */
+    ParameterSpace& require(Constraint allowed);
+
+    const std::string& name() const { return name_; }
+
+    /** Номер пространства: уникален для каждого конструктора, общий у копий */
+    uint64_t id() const { return id_; }
+
+    const std::vector<TunableParameter>& parameters() const { return parameters_; }
+
+    /** Все допустимые сочетания значений */
+    std::vector<Values> candidates() const;
+
+    /** Создать фильтр с параметрами values */
+    std::unique_ptr<SignalProcessor> create(const Values& values) const;
+
+    /** «order=8 window=5 reg=0.0001» */
+    std::string describe(const Values& values) const;
+
+private:
+    std::string                   name_;
+    uint64_t                      id_;
+    Factory                       factory_;
+    std::vector<TunableParameter> parameters_;
+    std::vector<Constraint>       constraints_;
+};
+
+/** Пространства параметров фильтров библиотеки */
+ParameterSpace medianParameterSpace();
+ParameterSpace wienerParameterSpace();
+ParameterSpace robustWienerParameterSpace();
+ParameterSpace morphologicalParameterSpace();
+ParameterSpace savgolParameterSpace();
+ParameterSpace kalmanParameterSpace();
+ParameterSpace outlierParameterSpace();
+
+/** Все пространства выше (имена: median, wiener, robust_wiener, morphological, savgol, kalman, outlier) */
+std::vector<ParameterSpace> builtinParameterSpaces();
+
+/**
+ * Критерий качества (усредняется по сигналам; больше — лучше)
+ */
+enum class TuningMetric {
+    SNR,           ///< SNR, дБ
+    MSE,           ///< −MSE
+    CORRELATION,   ///< Коэффициент корреляции
+    PSNR           ///< PSNR, дБ
+};
+
+/**
+ * Параметры подбора
+ */
+struct TuningOptions {
+    size_t       eta        = 3;     ///< На каждой ступени остаётся 1/eta кандидатов; ≤ 1 — полный перебор
+    size_t       minPrefix  = 256;   ///< Длина префикса первой ступени (не меньше)
+    size_t       numThreads = 0;     ///< Потоков (0 — по числу ядер)
+    TuningMetric metric     = TuningMetric::SNR;
+};
+
+/**
+ * Кандидат и его оценка на последней пройденной ступени
+ */
+struct TuningCandidate {
+    ParameterSpace::Values values;
+    std::string            description;
+    double                 score  = 0.0;   ///< Среднее по сигналам значение критерия
+    QualityMetrics         mean;           ///< Средние метрики на этой ступени
+    size_t                 prefix = 0;     ///< Длина префикса ступени
+    size_t                 rung   = 0;     ///< Номер последней пройденной ступени
+};
+
+/**
+ * Ступень последовательного деления
+ */
+struct TuningRung {
+    size_t    prefix      = 0;   ///< Длина префикса сигналов
+    size_t    candidates  = 0;   ///< Кандидатов на ступени
+    size_t    evaluations = 0;   ///< Вызовов фильтра (кандидат × сигнал)
+    size_t    cacheHits   = 0;   ///< Оценок, взятых из кэша
+    long long elapsedNs   = 0;
+};
+
+struct TuningResult {
+    /** Все кандидаты: дошедшие дальше — раньше, на одной ступени — по убыванию score */
+    std::vector<TuningCandidate> ranking;
+    std::vector<TuningRung>      rungs;
+
+    const TuningCandidate& best() const { return ranking.front(); }
+};
+
+/**
+ * Подбор гиперпараметров последовательным делением (successive halving)
+ *
+ * Ступень r оценивает выживших кандидатов на префиксах сигналов длины
+ * L_r = N / eta^(R − r) (не меньше minPrefix; последняя ступень — сигналы
+ * целиком) и оставляет лучшую 1/eta часть. Большинство кандидатов
+ * отсеивается на коротких префиксах, поэтому стоимость подбора близка к
+ * нескольким полным прогонам, а не к числу кандидатов × полный прогон.
+ *
+ * Оценки (кандидат × сигнал × длина) выполняются параллельно и кэшируются:
+ * префикс, равный всему сигналу, не пересчитывается на следующих ступенях;
+ * повторный tune() того же пространства (или его копии) использует прежние
+ * оценки. Пространства, созданные отдельно, кэш не делят, даже при
+ * одинаковом имени.
+ */
+class ParameterTuner {
+public:
+    using Signal  = SignalProcessor::Signal;
+    using Dataset = std::vector<std::pair<Signal, Signal>>;   ///< (чистый, зашумлённый)
+
+    /** @throws std::invalid_argument если набор пуст или длины пар различаются */
+    explicit ParameterTuner(Dataset dataset, TuningOptions options = TuningOptions());
+
+    /**
+     * Подобрать параметры
+     * @throws std::invalid_argument если в пространстве нет кандидатов
+     */
+    TuningResult tune(const ParameterSpace& space);
+
+    const TuningOptions& options() const { return options_; }
+    void setOptions(const TuningOptions& options) { options_ = options; }
+
+    size_t cacheSize() const { return cache_.size(); }
+    void clearCache() { cache_.clear(); }
+
+private:
+    /// (ParameterSpace::id(), значения кандидата, сигнал, длина) → метрики;
+    /// ключ — точные значения: describe() округляет их до 6 значащих цифр
+    using CacheKey = std::tuple<uint64_t, ParameterSpace::Values, size_t, size_t>;
+
+    double score(const QualityMetrics& m) const;
+
+    Dataset                             dataset_;
+    TuningOptions                       options_;
+    std::map<CacheKey, QualityMetrics>  cache_;
+};
+
+#endif // PARAMETER_TUNER_H
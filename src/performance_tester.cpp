@@ -1,14 +1,23 @@
 #include "performance_tester.h"
+#include "utils/signal_archive.h"
+#include "utils/csv_writer.h"
+#include "utils/bench_report.h"
+#include "utils/parallel.h"
+#include "utils/median.h"
 #include <algorithm>
 #include <numeric>
 #include <fstream>
 #include <iomanip>
 #include <cmath>
+#include <limits>
 #include <sys/stat.h>
 #include <dirent.h>
 #include <iostream>
 #include <sstream>
 
+/// Вызовов process() на один замер аппаратных счётчиков
+static constexpr size_t kPerfCounterRuns = 3;
+
 PerformanceTester::PerformanceTester(unsigned int seed) : generator_(seed) {
 }
 
@@ -35,10 +44,10 @@ void PerformanceTester::loadTestDataset(const std::string& cleanSignalsDir,
 
     for (size_t i = 0; i < numFiles; ++i) {
         try {
-            Signal cleanSignal = SignalGenerator::loadSignalFromCSV(
+            Signal cleanSignal = SignalGenerator::loadSignal(
                 cleanSignalsDir + "/" + cleanFiles[i]
             );
-            Signal noisySignal = SignalGenerator::loadSignalFromCSV(
+            Signal noisySignal = SignalGenerator::loadSignal(
                 noisySignalsDir + "/" + noisyFiles[i]
             );
 
@@ -52,13 +61,98 @@ void PerformanceTester::loadTestDataset(const std::string& cleanSignalsDir,
     }
 }
 
+void PerformanceTester::loadTestArchive(const std::string& archiveFile, size_t numThreads) {
+    testDataset_.clear();
+
+    SignalArchive archive(archiveFile);
+    for (auto& pair : archive.readPairs(numThreads)) {
+        if (pair.first.size() == pair.second.size() && !pair.first.empty()) {
+            testDataset_.push_back(std::move(pair));
+        }
+    }
+}
+
 std::vector<PerformanceTester::DetailedTestResult> PerformanceTester::runFullTest() {
+    return runFullTest(RunOptions());
+}
+
+std::vector<PerformanceTester::DetailedTestResult>
+PerformanceTester::runFullTest(const RunOptions& options) {
+    const size_t numAlgorithms = algorithms_.size();
+    const size_t numSignals    = testDataset_.size();
+
     std::vector<DetailedTestResult> results;
-    results.reserve(algorithms_.size());
+    results.reserve(numAlgorithms);
+    for (const auto& algorithm : algorithms_) {
+        DetailedTestResult result(algorithm->getName());
+        result.snrResults.resize(numSignals);
+        result.mseResults.resize(numSignals);
+        result.correlationResults.resize(numSignals);
+        result.executionTimes.resize(numSignals);
+        result.timings.resize(numSignals);
+        if (collectPerfCounters_) result.perfSamples.resize(numSignals);
+        if (allocTrackingEnabled()) result.allocSamples.resize(numSignals);
+        results.push_back(std::move(result));
+    }
+
+    // Счётчики привязаны к потоку — у каждого рабочего свои, открываются в нём самом
+    const bool parallelCounters = collectPerfCounters_ && !options.serialTiming;
+    std::vector<std::unique_ptr<PerfCounters>> workerCounters(
+        parallelCounters ? resolveThreadCount(options.numThreads) : 0);
+
+    // Каждая задача пишет только в свою ячейку [алгоритм][сигнал] —
+    // сборка результатов не зависит от порядка выполнения
+    parallelForWorkers(numAlgorithms * numSignals, options.numThreads, options.pinThreads,
+                       [&](size_t worker, size_t task) {
+        const size_t a = task / numSignals;
+        const size_t s = task % numSignals;
+        const auto& [cleanSignal, noisySignal] = testDataset_[s];
+
+        // При serialTiming время здесь не нужно — достаточно одного вызова
+        auto algorithm = algorithms_[a]->clone();
+        auto [filteredSignal, timing] = algorithm->benchmark(
+            noisySignal, options.serialTiming ? TimingOptions::singleShot() : timing_);
+
+        const QualityMetrics quality = calculateQualityMetrics(cleanSignal, filteredSignal);
+        DetailedTestResult& result = results[a];
+        result.snrResults[s]         = quality.snr;
+        result.mseResults[s]         = quality.mse;
+        result.correlationResults[s] = quality.correlation;
+        result.timings[s]            = timing;
+
+        if (parallelCounters) {
+            if (!workerCounters[worker]) workerCounters[worker] = std::make_unique<PerfCounters>();
+            result.perfSamples[s] = measurePerfCounters(*algorithm, noisySignal,
+                                                        *workerCounters[worker]);
+        }
+        if (allocTrackingEnabled()) {
+            result.allocSamples[s] = measureAllocations(*algorithm, noisySignal);
+        }
+    });
+
+    if (options.serialTiming) {
+        const std::vector<int> cpus = availableCpus();
+        const int cpu = options.timingCpu >= 0 ? options.timingCpu
+                                               : (cpus.empty() ? -1 : cpus.front());
+        ScopedThreadPin pin(cpu);
+        std::unique_ptr<PerfCounters> counters;
+        if (collectPerfCounters_) counters = std::make_unique<PerfCounters>();
+
+        for (size_t a = 0; a < numAlgorithms; ++a) {
+            for (size_t s = 0; s < numSignals; ++s) {
+                auto algorithm = algorithms_[a]->clone();
+                results[a].timings[s] =
+                    algorithm->benchmark(testDataset_[s].second, timing_).second;
+                if (counters) {
+                    results[a].perfSamples[s] =
+                        measurePerfCounters(*algorithm, testDataset_[s].second, *counters);
+                }
+            }
+        }
+    }
 
-    for (auto& algorithm : algorithms_) {
-        DetailedTestResult result = testAlgorithm(*algorithm);
-        results.push_back(result);
+    for (auto& result : results) {
+        finalizeResult(result);
 
         std::cout << "Завершено тестирование алгоритма: " << result.algorithmName
                   << " (SNR: " << std::fixed << std::setprecision(2)
@@ -74,29 +168,92 @@ PerformanceTester::DetailedTestResult PerformanceTester::testAlgorithm(SignalPro
     result.snrResults.reserve(testDataset_.size());
     result.mseResults.reserve(testDataset_.size());
     result.correlationResults.reserve(testDataset_.size());
-    result.executionTimes.reserve(testDataset_.size());
+    result.timings.reserve(testDataset_.size());
+
+    std::unique_ptr<PerfCounters> counters;
+    if (collectPerfCounters_) {
+        counters = std::make_unique<PerfCounters>();
+        result.perfSamples.reserve(testDataset_.size());
+    }
 
     for (const auto& [cleanSignal, noisySignal] : testDataset_) {
         // Измеряем производительность и применяем фильтр
-        auto [filteredSignal, executionTime] = algorithm.measurePerformance(noisySignal);
+        auto [filteredSignal, timing] = algorithm.benchmark(noisySignal, timing_);
 
-        // Вычисляем метрики качества
-        double snr = calculateSNR(cleanSignal, filteredSignal);
-        double mse = calculateMSE(cleanSignal, filteredSignal);
-        double correlation = calculateCorrelation(cleanSignal, filteredSignal);
+        // Вычисляем метрики качества (один проход по сигналам)
+        const QualityMetrics quality = calculateQualityMetrics(cleanSignal, filteredSignal);
 
         // Сохраняем результаты
-        result.snrResults.push_back(snr);
-        result.mseResults.push_back(mse);
-        result.correlationResults.push_back(correlation);
-        result.executionTimes.push_back(executionTime);
+        result.snrResults.push_back(quality.snr);
+        result.mseResults.push_back(quality.mse);
+        result.correlationResults.push_back(quality.correlation);
+        result.timings.push_back(timing);
+        if (counters) {
+            result.perfSamples.push_back(measurePerfCounters(algorithm, noisySignal, *counters));
+        }
+        if (allocTrackingEnabled()) {
+            result.allocSamples.push_back(measureAllocations(algorithm, noisySignal));
+        }
     }
 
+    finalizeResult(result);
+    return result;
+}
+
+void PerformanceTester::finalizeResult(DetailedTestResult& result) const {
     // Вычисляем статистические показатели
     auto [avgSNR, stdSNR] = calculateStatistics(result.snrResults);
     auto [avgMSE, stdMSE] = calculateStatistics(result.mseResults);
     auto [avgCorrelation, stdCorrelation] = calculateStatistics(result.correlationResults);
-    auto [avgExecutionTime, stdExecutionTime] = calculateTimeStatistics(result.executionTimes);
+
+    // Время сигнала — медиана его замеров, устойчивая к редким задержкам
+    result.executionTimes.resize(result.timings.size());
+    result.minTimeNs = result.medianTimeNs = result.p90TimeNs = 0.0;
+    result.p99TimeNs = result.madTimeNs = 0.0;
+    result.timingSamples = result.timingRejected = 0;
+    for (size_t i = 0; i < result.timings.size(); ++i) {
+        const TimingStats& t = result.timings[i];
+        result.executionTimes[i] = t.medianNs * 1e-3;
+        result.minTimeNs      += t.minNs;
+        result.medianTimeNs   += t.medianNs;
+        result.p90TimeNs      += t.p90Ns;
+        result.p99TimeNs      += t.p99Ns;
+        result.madTimeNs      += t.madNs;
+        result.timingSamples  += t.samples;
+        result.timingRejected += t.rejected;
+    }
+    if (!result.timings.empty()) {
+        const double n = static_cast<double>(result.timings.size());
+        result.minTimeNs    /= n;
+        result.medianTimeNs /= n;
+        result.p90TimeNs    /= n;
+        result.p99TimeNs    /= n;
+        result.madTimeNs    /= n;
+    }
+    auto [avgExecutionTime, stdExecutionTime] = calculateStatistics(result.executionTimes);
+
+    // Счётчики: событие действительно, только если снято на всех сигналах
+    result.perfCounters = PerfCounterValues();
+    if (!result.perfSamples.empty()) {
+        result.perfCounters = result.perfSamples.front();
+        for (size_t i = 1; i < result.perfSamples.size(); ++i) {
+            result.perfCounters += result.perfSamples[i];
+        }
+        result.perfCounters /= static_cast<double>(result.perfSamples.size());
+    }
+
+    result.avgAllocations = result.avgAllocBytes = result.avgPeakBytes = 0.0;
+    for (const AllocStats& a : result.allocSamples) {
+        result.avgAllocations += static_cast<double>(a.allocations);
+        result.avgAllocBytes  += static_cast<double>(a.bytes);
+        result.avgPeakBytes   += static_cast<double>(a.peakBytes);
+    }
+    if (!result.allocSamples.empty()) {
+        const double n = static_cast<double>(result.allocSamples.size());
+        result.avgAllocations /= n;
+        result.avgAllocBytes  /= n;
+        result.avgPeakBytes   /= n;
+    }
 
     result.avgSNR = avgSNR;
     result.stdSNR = stdSNR;
@@ -106,8 +263,32 @@ PerformanceTester::DetailedTestResult PerformanceTester::testAlgorithm(SignalPro
     result.stdCorrelation = stdCorrelation;
     result.avgExecutionTime = avgExecutionTime;
     result.stdExecutionTime = stdExecutionTime;
+}
 
-    return result;
+PerfCounterValues PerformanceTester::measurePerfCounters(SignalProcessor& algorithm,
+                                                         const Signal& input,
+                                                         PerfCounters& counters) const {
+    if (!counters.available()) return PerfCounterValues();
+
+    // Отдельный проход: ioctl вокруг каждого замеряемого вызова исказил бы время
+    counters.start();
+    for (size_t i = 0; i < kPerfCounterRuns; ++i) {
+        Signal output = algorithm.process(input);
+        (void)output;
+    }
+    PerfCounterValues values = counters.stop();
+    values /= static_cast<double>(kPerfCounterRuns);
+    return values;
+}
+
+AllocStats PerformanceTester::measureAllocations(SignalProcessor& algorithm,
+                                                 const Signal& input) const {
+    AllocScope scope;
+    {
+        Signal output = algorithm.process(input);
+        (void)output;
+    }
+    return scope.stats();
 }
 
 std::map<std::string, double> PerformanceTester::compareAlgorithms(SignalProcessor& algorithm1,
@@ -159,7 +340,7 @@ std::string PerformanceTester::generateReport(const std::vector<DetailedTestResu
                << std::setw(12) << std::fixed << std::setprecision(2) << result.avgSNR
                << std::setw(12) << std::scientific << std::setprecision(2) << result.avgMSE
                << std::setw(12) << std::fixed << std::setprecision(3) << result.avgCorrelation
-               << std::setw(15) << std::fixed << std::setprecision(0) << result.avgExecutionTime
+               << std::setw(15) << std::fixed << std::setprecision(2) << result.avgExecutionTime
                << "\n";
     }
 
@@ -173,8 +354,77 @@ std::string PerformanceTester::generateReport(const std::vector<DetailedTestResu
                << result.avgMSE << " ± " << result.stdMSE << "\n";
         report << "  Корреляция: " << std::fixed << std::setprecision(3)
                << result.avgCorrelation << " ± " << result.stdCorrelation << "\n";
-        report << "  Время выполнения: " << std::fixed << std::setprecision(0)
-               << result.avgExecutionTime << " ± " << result.stdExecutionTime << " мкс\n\n";
+        report << "  Время выполнения: " << std::fixed << std::setprecision(2)
+               << result.avgExecutionTime << " ± " << result.stdExecutionTime << " мкс\n";
+        report << "  Время (мин / медиана / p90 / p99): " << std::setprecision(2)
+               << result.minTimeNs * 1e-3 << " / " << result.medianTimeNs * 1e-3 << " / "
+               << result.p90TimeNs * 1e-3 << " / " << result.p99TimeNs * 1e-3 << " мкс"
+               << " (замеров: " << result.timingSamples
+               << ", отброшено: " << result.timingRejected << ")\n\n";
+    }
+
+    // Аппаратные счётчики (если собирались)
+    const bool perfCollected = std::any_of(results.begin(), results.end(),
+        [](const auto& r) { return !r.perfSamples.empty(); });
+    if (perfCollected) {
+        report << "=== АППАРАТНЫЕ СЧЁТЧИКИ (на один вызов) ===\n\n";
+
+        const bool perfAvailable = std::any_of(results.begin(), results.end(),
+            [](const auto& r) { return r.perfCounters.any(); });
+        if (!perfAvailable) {
+            report << "Счётчики недоступны (perf_event_open запрещён или не поддерживается)\n\n";
+        } else {
+            report << std::left << std::setw(25) << "Алгоритм"
+                   << std::right << std::setw(14) << "Циклы"
+                   << std::setw(14) << "Инструкции"
+                   << std::setw(7) << "IPC"
+                   << std::setw(12) << "L1D промахи"
+                   << std::setw(12) << "LLC промахи"
+                   << std::setw(12) << "Ветвл. пром." << "\n";
+            report << std::string(96, '-') << "\n";
+
+            auto counter = [&report](const PerfCounterValues& v, PerfEvent e, int width) {
+                if (v.has(e)) {
+                    report << std::setw(width) << std::fixed << std::setprecision(0) << v.get(e);
+                } else {
+                    report << std::setw(width) << "-";
+                }
+            };
+
+            for (const auto& result : results) {
+                const PerfCounterValues& v = result.perfCounters;
+                report << std::left << std::setw(25) << result.algorithmName << std::right;
+                counter(v, PerfEvent::CYCLES, 14);
+                counter(v, PerfEvent::INSTRUCTIONS, 14);
+                report << std::setw(7) << std::fixed << std::setprecision(2) << v.ipc();
+                counter(v, PerfEvent::L1D_MISSES, 12);
+                counter(v, PerfEvent::LLC_MISSES, 12);
+                counter(v, PerfEvent::BRANCH_MISSES, 12);
+                report << "\n";
+            }
+            report << std::left << "\n";
+        }
+    }
+
+    // Выделения памяти (сборка с SIGNAL_ALLOC_TRACKING)
+    const bool allocCollected = std::any_of(results.begin(), results.end(),
+        [](const auto& r) { return !r.allocSamples.empty(); });
+    if (allocCollected) {
+        report << "=== ВЫДЕЛЕНИЯ ПАМЯТИ (на один вызов) ===\n\n";
+        report << std::left << std::setw(25) << "Алгоритм"
+               << std::right << std::setw(14) << "Выделений"
+               << std::setw(16) << "Байт"
+               << std::setw(16) << "Пик (байт)" << "\n";
+        report << std::string(71, '-') << "\n";
+        for (const auto& result : results) {
+            report << std::left << std::setw(25) << result.algorithmName << std::right
+                   << std::fixed << std::setprecision(1)
+                   << std::setw(14) << result.avgAllocations
+                   << std::setprecision(0)
+                   << std::setw(16) << result.avgAllocBytes
+                   << std::setw(16) << result.avgPeakBytes << "\n";
+        }
+        report << std::left << "\n";
     }
 
     // Рекомендации
@@ -203,27 +453,82 @@ std::string PerformanceTester::generateReport(const std::vector<DetailedTestResu
 
 void PerformanceTester::saveResultsToCSV(const std::vector<DetailedTestResult>& results,
                                           const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file for writing: " + filename);
-    }
+    CsvWriter file(filename);
 
     // Заголовок
-    file << "Algorithm,Avg_SNR,Std_SNR,Avg_MSE,Std_MSE,Avg_Correlation,Std_Correlation,"
-         << "Avg_ExecutionTime,Std_ExecutionTime\n";
+    file.writeText("Algorithm,Avg_SNR,Std_SNR,Avg_MSE,Std_MSE,Avg_Correlation,Std_Correlation,"
+                   "Avg_ExecutionTime,Std_ExecutionTime,"
+                   "Min_Time_ns,Median_Time_ns,P90_Time_ns,P99_Time_ns,MAD_Time_ns,"
+                   "Timing_Samples,Timing_Rejected,"
+                   "Cycles,Instructions,IPC,L1D_Misses,LLC_Misses,Branch_Misses,"
+                   "Allocations,Alloc_Bytes,Peak_Live_Bytes\n");
 
     // Данные
     for (const auto& result : results) {
-        file << result.algorithmName << ","
-             << result.avgSNR << "," << result.stdSNR << ","
-             << result.avgMSE << "," << result.stdMSE << ","
-             << result.avgCorrelation << "," << result.stdCorrelation << ","
-             << result.avgExecutionTime << "," << result.stdExecutionTime << "\n";
+        file.writeText(result.algorithmName);
+        for (double value : {result.avgSNR, result.stdSNR,
+                             result.avgMSE, result.stdMSE,
+                             result.avgCorrelation, result.stdCorrelation,
+                             result.avgExecutionTime, result.stdExecutionTime,
+                             result.minTimeNs, result.medianTimeNs,
+                             result.p90TimeNs, result.p99TimeNs, result.madTimeNs}) {
+            file.writeChar(',').writeDouble(value);
+        }
+        file.writeChar(',').writeIndex(result.timingSamples);
+        file.writeChar(',').writeIndex(result.timingRejected);
+
+        // Недоступные счётчики — пустые ячейки
+        const PerfCounterValues& perf = result.perfCounters;
+        for (PerfEvent event : {PerfEvent::CYCLES, PerfEvent::INSTRUCTIONS}) {
+            file.writeChar(',');
+            if (perf.has(event)) file.writeDouble(perf.get(event));
+        }
+        file.writeChar(',');
+        if (perf.has(PerfEvent::CYCLES) && perf.has(PerfEvent::INSTRUCTIONS)) {
+            file.writeDouble(perf.ipc());
+        }
+        for (PerfEvent event : {PerfEvent::L1D_MISSES, PerfEvent::LLC_MISSES,
+                                PerfEvent::BRANCH_MISSES}) {
+            file.writeChar(',');
+            if (perf.has(event)) file.writeDouble(perf.get(event));
+        }
+
+        // Без учёта выделений — пустые ячейки
+        for (double value : {result.avgAllocations, result.avgAllocBytes, result.avgPeakBytes}) {
+            file.writeChar(',');
+            if (!result.allocSamples.empty()) file.writeDouble(value);
+        }
+        file.writeChar('\n');
     }
 
     file.close();
 }
 
+void PerformanceTester::saveResultsToJSON(const std::vector<DetailedTestResult>& results,
+                                           const std::string& filename) const {
+    BenchReport report;
+    report.benchmark   = "performance_tester";
+    report.environment = currentBenchEnvironment();
+    for (size_t i = 0; i < testDataset_.size(); ++i) {
+        report.signals.push_back("signal_" + std::to_string(i));
+    }
+
+    for (const auto& result : results) {
+        BenchEntry entry;
+        entry.name           = result.algorithmName;
+        entry.snr            = result.snrResults;
+        entry.mse            = result.mseResults;
+        entry.correlation    = result.correlationResults;
+        entry.timings        = result.timings;
+        entry.hasAllocations = !result.allocSamples.empty();
+        entry.allocations    = result.avgAllocations;
+        entry.peakBytes      = result.avgPeakBytes;
+        report.entries.push_back(std::move(entry));
+    }
+
+    writeBenchJson(filename, report);
+}
+
 void PerformanceTester::saveTestDataset(const std::string& cleanDir,
                                         const std::string& noisyDir) const {
     createDirectoryIfNotExists(cleanDir);
@@ -238,6 +543,15 @@ void PerformanceTester::saveTestDataset(const std::string& cleanDir,
     }
 }
 
+void PerformanceTester::saveTestArchive(const std::string& archiveFile, bool compress) const {
+    SignalArchiveWriter::Options options;
+    options.codec = compress ? ChunkCodec::SHUFFLE_ZLIB : ChunkCodec::RAW;
+
+    SignalArchiveWriter writer(archiveFile, options);
+    writer.addPairs(testDataset_);
+    writer.finalize();
+}
+
 std::map<std::string, double> PerformanceTester::getDatasetStatistics() const {
     std::map<std::string, double> stats;
 
@@ -270,56 +584,258 @@ std::map<std::string, double> PerformanceTester::getDatasetStatistics() const {
 
 std::map<std::string, std::vector<std::pair<size_t, double>>>
 PerformanceTester::testScalability(const std::vector<size_t>& signalLengths) {
+    ScalabilityOptions options;
+    options.lengths          = signalLengths;
+    options.signalsPerLength = 10; // Используем меньше сигналов для ускорения
+    options.maxCallSeconds   = std::numeric_limits<double>::infinity();
+    options.timing           = timing_;
 
     std::map<std::string, std::vector<std::pair<size_t, double>>> scalabilityResults;
+    for (const ScalabilityResult& result : testScalability(options)) {
+        auto& series = scalabilityResults[result.algorithmName];
+        for (const ScalabilityPoint& point : result.points) {
+            series.emplace_back(point.length, point.medianUs);
+        }
+    }
+    return scalabilityResults;
+}
 
-    // Сохраняем оригинальный тестовый набор
-    auto originalDataset = testDataset_;
+std::vector<PerformanceTester::ScalabilityResult>
+PerformanceTester::testScalability(const ScalabilityOptions& options) {
+    std::vector<size_t> lengths = options.lengths;
+    if (lengths.empty()) {
+        const double step = std::pow(10.0, 1.0 / static_cast<double>(
+                                               std::max<size_t>(1, options.lengthsPerDecade)));
+        const double last = static_cast<double>(options.maxLength) * (1.0 + 1e-9);
+        for (double n = static_cast<double>(std::max<size_t>(1, options.minLength)); n <= last;
+             n *= step) {
+            const size_t length = static_cast<size_t>(std::llround(n));
+            if (lengths.empty() || length != lengths.back()) lengths.push_back(length);
+        }
+    }
 
-    for (size_t length : signalLengths) {
-        // Генерируем данные для текущей длины
-        generateTestDataset(length, 10); // Используем меньше сигналов для ускорения
+    std::vector<ScalabilityResult> results(algorithms_.size());
+    for (size_t a = 0; a < algorithms_.size(); ++a) {
+        results[a].algorithmName = algorithms_[a]->getName();
+        results[a].windowSize    = algorithms_[a]->getWindowSize();
+    }
+    std::vector<bool> active(algorithms_.size(), true);
+
+    for (size_t length : lengths) {
+        if (std::none_of(active.begin(), active.end(), [](bool v) { return v; })) break;
+
+        const auto dataset = generator_.generateTestDataset(length, options.signalsPerLength);
+
+        for (size_t a = 0; a < algorithms_.size(); ++a) {
+            if (!active[a]) continue;
+            ScalabilityResult& result = results[a];
+
+            // Прогноз времени вызова по наклону между двумя последними длинами
+            if (!result.points.empty()) {
+                const ScalabilityPoint& last = result.points.back();
+                double slope = 1.0;
+                if (result.points.size() >= 2) {
+                    const ScalabilityPoint& prev = result.points[result.points.size() - 2];
+                    if (last.medianUs > 0.0 && prev.medianUs > 0.0) {
+                        slope = std::log(last.medianUs / prev.medianUs) /
+                                std::log(static_cast<double>(last.length) / prev.length);
+                    }
+                }
+                slope = std::clamp(slope, 1.0, 3.0);
+                const double predictedSeconds = last.medianUs * 1e-6 *
+                    std::pow(static_cast<double>(length) / last.length, slope);
+                if (predictedSeconds > options.maxCallSeconds) {
+                    active[a] = false;
+                    result.truncated = true;
+                    continue;
+                }
+            }
+
+            std::vector<double> medians;
+            for (const auto& [clean, noisy] : dataset) {
+                medians.push_back(algorithms_[a]->benchmark(noisy, options.timing).second.medianNs
+                                  / 1000.0);
+            }
 
-        // Тестируем каждый алгоритм
-        for (auto& algorithm : algorithms_) {
-            auto result = testAlgorithm(*algorithm);
-            scalabilityResults[result.algorithmName].emplace_back(length, result.avgExecutionTime);
+            ScalabilityPoint point;
+            point.length   = length;
+            point.minUs    = *std::min_element(medians.begin(), medians.end());
+            point.medianUs = median(medians);
+            if (point.medianUs > 0.0) {
+                // Отсчётов за мкс = млн отсчётов/с; байт за мкс / 1000 = ГБ/с
+                const double samples = static_cast<double>(length);
+                point.msamplesPerSec = samples / point.medianUs;
+                point.gbPerSec       = 2.0 * samples * sizeof(double) / point.medianUs / 1000.0;
+            }
+            result.points.push_back(point);
         }
     }
 
-    // Восстанавливаем оригинальный набор
-    testDataset_ = originalDataset;
+    for (ScalabilityResult& result : results) fitComplexity(result);
+    return results;
+}
 
-    return scalabilityResults;
+std::string PerformanceTester::complexityModelName(ComplexityModel model) {
+    switch (model) {
+        case ComplexityModel::LINEAR:    return "O(N)";
+        case ComplexityModel::N_LOG_N:   return "O(N log N)";
+        case ComplexityModel::N_WINDOW:  return "O(N·w)";
+        case ComplexityModel::QUADRATIC: return "O(N²)";
+    }
+    return "?";
 }
 
-std::pair<double, double> PerformanceTester::calculateStatistics(const std::vector<double>& values) const {
-    if (values.empty()) {
-        return std::make_pair(0.0, 0.0);
+void PerformanceTester::fitComplexity(ScalabilityResult& result) {
+    result.fits.clear();
+    result.exponent = 0.0;
+    const auto& points = result.points;
+    if (points.empty()) return;
+
+    const double w = static_cast<double>(std::max<size_t>(1, result.windowSize));
+    auto basis = [w](ComplexityModel model, double n) {
+        switch (model) {
+            case ComplexityModel::LINEAR:    return n;
+            case ComplexityModel::N_LOG_N:   return n * std::log2(std::max(n, 2.0));
+            case ComplexityModel::N_WINDOW:  return n * w;
+            case ComplexityModel::QUADRATIC: return n * n;
+        }
+        return n;
+    };
+
+    for (ComplexityModel model : {ComplexityModel::LINEAR, ComplexityModel::N_LOG_N,
+                                  ComplexityModel::N_WINDOW, ComplexityModel::QUADRATIC}) {
+        // Взвешенные МНК для t = a + c·f, веса 1/t²
+        double sw = 0, swf = 0, swff = 0, swt = 0, swft = 0;
+        for (const ScalabilityPoint& p : points) {
+            if (p.medianUs <= 0.0) continue;
+            const double f  = basis(model, static_cast<double>(p.length));
+            const double wt = 1.0 / (p.medianUs * p.medianUs);
+            sw += wt;  swf += wt * f;  swff += wt * f * f;
+            swt += wt * p.medianUs;  swft += wt * f * p.medianUs;
+        }
+
+        ComplexityFit fit{model};
+        const double det = sw * swff - swf * swf;
+        if (points.size() >= 2 && det > 0.0) {
+            fit.coefficient = (sw * swft - swf * swt) / det;
+            fit.intercept   = (swt - fit.coefficient * swf) / sw;
+        }
+        // Отрицательные накладные расходы бессмысленны — прямая через ноль
+        if (points.size() < 2 || det <= 0.0 || fit.intercept < 0.0) {
+            fit.intercept   = 0.0;
+            fit.coefficient = swff > 0.0 ? swft / swff : 0.0;
+        }
+        fit.coefficient = std::max(0.0, fit.coefficient);
+
+        double err = 0.0;
+        size_t n = 0;
+        for (const ScalabilityPoint& p : points) {
+            if (p.medianUs <= 0.0) continue;
+            const double predicted = fit.intercept +
+                fit.coefficient * basis(model, static_cast<double>(p.length));
+            err += std::pow((predicted - p.medianUs) / p.medianUs, 2);
+            ++n;
+        }
+        fit.rmsRelError = n ? std::sqrt(err / static_cast<double>(n)) : 0.0;
+        result.fits.push_back(fit);
     }
 
-    double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    // O(N) и O(N·w) по N неразличимы: при w > 1 линейный рост относим к O(N·w)
+    const auto best = std::min_element(result.fits.begin(), result.fits.end(),
+        [](const ComplexityFit& a, const ComplexityFit& b) { return a.rmsRelError < b.rmsRelError; });
+    result.bestModel = best->model;
+    if (result.bestModel == ComplexityModel::LINEAR && result.windowSize > 1) {
+        result.bestModel = ComplexityModel::N_WINDOW;
+    } else if (result.bestModel == ComplexityModel::N_WINDOW && result.windowSize <= 1) {
+        result.bestModel = ComplexityModel::LINEAR;
+    }
 
-    double variance = 0.0;
-    for (double value : values) {
-        variance += (value - mean) * (value - mean);
+    // Показатель степени по верхней половине длин
+    std::vector<std::pair<double, double>> logs;
+    for (size_t i = points.size() / 2; i < points.size(); ++i) {
+        if (points[i].medianUs > 0.0) {
+            logs.emplace_back(std::log(static_cast<double>(points[i].length)),
+                              std::log(points[i].medianUs));
+        }
     }
-    variance /= values.size();
+    if (logs.size() >= 2) {
+        double mx = 0, my = 0;
+        for (const auto& [x, y] : logs) { mx += x; my += y; }
+        mx /= logs.size();
+        my /= logs.size();
+        double sxy = 0, sxx = 0;
+        for (const auto& [x, y] : logs) { sxy += (x - mx) * (y - my); sxx += (x - mx) * (x - mx); }
+        result.exponent = sxx > 0.0 ? sxy / sxx : 0.0;
+    }
+}
 
-    return std::make_pair(mean, std::sqrt(variance));
+/// Обозначение модели, дополненное пробелами до width символов (в UTF-8 «·» и «²» — по 2 байта)
+static std::string padModelName(PerformanceTester::ComplexityModel model, size_t width) {
+    std::string name = PerformanceTester::complexityModelName(model);
+    const size_t chars = static_cast<size_t>(std::count_if(name.begin(), name.end(),
+        [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+    if (chars < width) name.append(width - chars, ' ');
+    return name;
 }
 
-std::pair<double, double> PerformanceTester::calculateTimeStatistics(const std::vector<long long>& values) const {
+std::string PerformanceTester::generateScalabilityReport(
+        const std::vector<ScalabilityResult>& results) const {
+    std::ostringstream report;
+    report << "=== МАСШТАБИРУЕМОСТЬ ===\n\n";
+    report << "Полоса — минимальный трафик: чтение входа и запись выхода (2·N·8 байт)\n\n";
+
+    for (const auto& result : results) {
+        report << result.algorithmName;
+        if (result.windowSize > 1) report << " (w = " << result.windowSize << ")";
+        report << ":\n";
+        report << "           N      Время, мкс       Мотсч/с      ГБ/с\n";
+        for (const auto& p : result.points) {
+            report << std::right << std::setw(12) << p.length << std::fixed
+                   << std::setprecision(1) << std::setw(16) << p.medianUs
+                   << std::setprecision(2) << std::setw(14) << p.msamplesPerSec
+                   << std::setprecision(3) << std::setw(10) << p.gbPerSec << "\n";
+        }
+        if (result.truncated && !result.points.empty()) {
+            report << "  Остановлено после N = " << result.points.back().length
+                   << ": следующий вызов дольше предела времени\n";
+        }
+
+        for (const auto& fit : result.fits) {
+            if (fit.model == ComplexityModel::N_WINDOW && result.windowSize <= 1) continue;
+            report << "  " << padModelName(fit.model, 12)
+                   << std::scientific << std::setprecision(3)
+                   << " c = " << fit.coefficient << " мкс, a = " << fit.intercept << " мкс"
+                   << std::fixed << std::setprecision(1)
+                   << ", ошибка " << fit.rmsRelError * 100.0 << "%\n";
+        }
+        report << "  Лучшая модель: " << complexityModelName(result.bestModel)
+               << ", показатель степени " << std::setprecision(2) << result.exponent << "\n\n";
+    }
+
+    // Сводка
+    report << "Алгоритм                            Модель          Показатель       Макс. N\n";
+    report << std::string(78, '-') << "\n";
+    for (const auto& result : results) {
+        report << std::left << std::setw(36) << result.algorithmName
+               << padModelName(result.bestModel, 14)
+               << std::right << std::fixed << std::setprecision(2)
+               << std::setw(12) << result.exponent
+               << std::setw(14) << (result.points.empty() ? 0 : result.points.back().length)
+               << "\n";
+    }
+    return report.str();
+}
+
+std::pair<double, double> PerformanceTester::calculateStatistics(const std::vector<double>& values) const {
     if (values.empty()) {
         return std::make_pair(0.0, 0.0);
     }
 
-    double mean = static_cast<double>(std::accumulate(values.begin(), values.end(), 0LL)) / values.size();
+    double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
 
     double variance = 0.0;
-    for (long long value : values) {
-        double diff = static_cast<double>(value) - mean;
-        variance += diff * diff;
+    for (double value : values) {
+        variance += (value - mean) * (value - mean);
     }
     variance /= values.size();
 
@@ -343,7 +859,9 @@ std::vector<std::string> PerformanceTester::getFilesInDirectory(const std::strin
         struct dirent* entry;
         while ((entry = readdir(dir)) != nullptr) {
             std::string filename = entry->d_name;
-            if (filename.length() > 4 && filename.substr(filename.length() - 4) == ".csv") {
+            if (filename.length() > 4 &&
+                (filename.substr(filename.length() - 4) == ".csv" ||
+                 filename.substr(filename.length() - 4) == ".sig")) {
                 files.push_back(filename);
             }
         }
@@ -352,5 +870,14 @@ std::vector<std::string> PerformanceTester::getFilesInDirectory(const std::strin
         std::cerr << "Error reading directory " << directory << std::endl;
     }
 
+    // Если рядом с CSV лежит бинарный контейнер с тем же именем — берём только его
+    std::sort(files.begin(), files.end());
+    const std::vector<std::string> all = files;
+    files.erase(std::remove_if(files.begin(), files.end(), [&all](const std::string& f) {
+        if (f.substr(f.length() - 4) != ".csv") return false;
+        const std::string sig = f.substr(0, f.length() - 4) + ".sig";
+        return std::binary_search(all.begin(), all.end(), sig);
+    }), files.end());
+
     return files;
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "signal_processor.h"
 #include "signal_generator.h"
+#include "utils/perf_counters.h"
+#include "utils/alloc_tracker.h"
 #include <memory>
 #include <vector>
 #include <map>
@@ -22,25 +24,137 @@ public:
         std::vector<double> snrResults;      // SNR для каждого тестового сигнала
         std::vector<double> mseResults;      // MSE для каждого тестового сигнала
         std::vector<double> correlationResults; // Корреляция для каждого тестового сигнала
-        std::vector<long long> executionTimes;  // Время выполнения для каждого сигнала
+        std::vector<double> executionTimes;     // Медианное время для каждого сигнала, мкс
+        std::vector<TimingStats> timings;       // Полная статистика замеров для каждого сигнала
 
         // Статистические показатели
         double avgSNR;
         double avgMSE;
         double avgCorrelation;
-        double avgExecutionTime;
+        double avgExecutionTime;                // Среднее по сигналам медианное время, мкс
         double stdSNR;
         double stdMSE;
         double stdCorrelation;
         double stdExecutionTime;
 
+        // Показатели времени, усреднённые по сигналам, нс
+        double minTimeNs    = 0.0;
+        double medianTimeNs = 0.0;
+        double p90TimeNs    = 0.0;
+        double p99TimeNs    = 0.0;
+        double madTimeNs    = 0.0;
+        size_t timingSamples  = 0;              // Учтённые замеры по всем сигналам
+        size_t timingRejected = 0;              // Отброшенные выбросы по всем сигналам
+
+        // Аппаратные счётчики на один вызов process() (пусто, если не собирались)
+        std::vector<PerfCounterValues> perfSamples; // Для каждого сигнала
+        PerfCounterValues perfCounters;         // Среднее по сигналам
+
+        // Выделения памяти на один вызов process() (пусто без SIGNAL_ALLOC_TRACKING)
+        std::vector<AllocStats> allocSamples;   // Для каждого сигнала
+        double avgAllocations = 0.0;            // Среднее число выделений
+        double avgAllocBytes  = 0.0;            // Средний объём выделений, байт
+        double avgPeakBytes   = 0.0;            // Средний пик занятой памяти, байт
+
         DetailedTestResult(const std::string& name = "") : algorithmName(name) {}
     };
 
+    /**
+     * Параметры запуска runFullTest
+     *
+     * Матрица задач (алгоритм × сигнал) раздаётся numThreads потокам; каждая
+     * задача работает со своей копией алгоритма (SignalProcessor::clone),
+     * поэтому фильтры с состоянием (Калман, Винер) не мешают друг другу, а
+     * результаты не зависят от числа потоков и порядка выполнения.
+     *
+     * Время выполнения при параллельном прогоне искажается соседями (общий
+     * кэш, память). pinThreads исключает миграцию потоков между ядрами;
+     * serialTiming повторяет все задачи отдельным последовательным проходом на
+     * одном закреплённом ядре и берёт время оттуда (метрики качества — из
+     * параллельного прогона). Для наиболее чистых замеров timingCpu можно
+     * указать на ядро, изолированное от планировщика (isolcpus).
+     */
+    struct RunOptions {
+        size_t numThreads   = 1;      ///< 1 — последовательно, 0 — по числу ядер
+        bool   pinThreads   = true;   ///< Закрепить рабочие потоки за ядрами
+        bool   serialTiming = false;  ///< Замер времени отдельным проходом на одном ядре
+        int    timingCpu    = -1;     ///< Ядро для serialTiming (-1 — первое доступное)
+    };
+
+    /**
+     * Модели сложности для testScalability: t(N) = a + c·f(N)
+     */
+    enum class ComplexityModel {
+        LINEAR,         ///< O(N)
+        N_LOG_N,        ///< O(N log N)
+        N_WINDOW,       ///< O(N·w), w = SignalProcessor::getWindowSize()
+        QUADRATIC       ///< O(N²)
+    };
+
+    /**
+     * Параметры testScalability
+     *
+     * Длины берутся из lengths либо геометрической прогрессией от minLength
+     * до maxLength с lengthsPerDecade точками на декаду. Рост длины для
+     * алгоритма прекращается, когда прогноз времени одного вызова на
+     * следующей длине (по локальному наклону) превышает maxCallSeconds —
+     * иначе квадратичный алгоритм на 10⁷ отсчётов работал бы часами.
+     */
+    struct ScalabilityOptions {
+        std::vector<size_t> lengths;              ///< Явный список длин (пусто — прогрессия)
+        size_t minLength        = 100;
+        size_t maxLength        = 10'000'000;
+        size_t lengthsPerDecade = 3;
+        size_t signalsPerLength = 2;              ///< Сигналов на каждую длину
+        double maxCallSeconds   = 2.0;            ///< Предел времени одного вызова
+        TimingOptions timing = [] {               ///< Повторы на каждом сигнале
+            TimingOptions o;
+            o.minRepetitions  = 3;
+            o.maxTotalSeconds = 1.0;
+            return o;
+        }();
+    };
+
+    /**
+     * Замер на одной длине
+     */
+    struct ScalabilityPoint {
+        size_t length      = 0;
+        double medianUs    = 0.0;   ///< Медиана по сигналам медианного времени, мкс
+        double minUs       = 0.0;   ///< Наименьшее время среди сигналов, мкс
+        double msamplesPerSec = 0.0;  ///< Пропускная способность, млн отсчётов/с
+        double gbPerSec    = 0.0;   ///< Эффективная полоса: чтение входа + запись выхода
+    };
+
+    /**
+     * Приближение одной моделью
+     */
+    struct ComplexityFit {
+        ComplexityModel model;
+        double intercept   = 0.0;   ///< a, мкс (постоянные накладные расходы)
+        double coefficient = 0.0;   ///< c, мкс на единицу f(N)
+        double rmsRelError = 0.0;   ///< Среднеквадратичная относительная ошибка
+    };
+
+    /**
+     * Результат масштабирования одного алгоритма
+     */
+    struct ScalabilityResult {
+        std::string algorithmName;
+        size_t windowSize = 1;                    ///< w для модели O(N·w)
+        std::vector<ScalabilityPoint> points;
+        std::vector<ComplexityFit> fits;          ///< Все модели
+        ComplexityModel bestModel = ComplexityModel::LINEAR;
+        double exponent  = 0.0;                   ///< Наклон log t / log N по верхней половине длин
+        bool   truncated = false;                 ///< Остановлен до maxLength по maxCallSeconds
+    };
+
 private:
     SignalGenerator generator_;
     std::vector<std::unique_ptr<SignalProcessor>> algorithms_;
     std::vector<std::pair<Signal, Signal>> testDataset_; // (clean, noisy) пары
+    TimingOptions timing_;                               // Правила замера времени
+    bool collectPerfCounters_ = false;                   // Снимать аппаратные счётчики
 
 public:
     /**
@@ -55,6 +169,20 @@ public:
      */
     void addAlgorithm(std::unique_ptr<SignalProcessor> algorithm);
 
+    /**
+     * Задать правила замера времени (прогрев, повторы, отбраковка выбросов)
+     * @param options Параметры замера; TimingOptions::singleShot() — один холодный вызов
+     */
+    void setTimingOptions(const TimingOptions& options) { timing_ = options; }
+
+    /**
+     * Снимать аппаратные счётчики (циклы, инструкции, промахи кэша и
+     * предсказателя переходов) для каждого замеряемого вызова.
+     * Если perf_event_open недоступен, столбцы счётчиков остаются пустыми
+     * @param enable Включить сбор
+     */
+    void setCollectPerfCounters(bool enable) { collectPerfCounters_ = enable; }
+
     /**
      * Генерировать тестовый набор данных
      * @param signalLength Длина каждого сигнала
@@ -65,19 +193,33 @@ public:
                             size_t numSignals = 50);
 
     /**
-     * Загрузить тестовый набор данных из файлов
+     * Загрузить тестовый набор данных из файлов (.csv или .sig)
      * @param cleanSignalsDir Директория с чистыми сигналами
      * @param noisySignalsDir Директория с зашумленными сигналами
      */
     void loadTestDataset(const std::string& cleanSignalsDir,
                         const std::string& noisySignalsDir);
 
+    /**
+     * Загрузить тестовый набор данных из архива (.sga)
+     * @param archiveFile Файл архива с парами "clean/<x>", "noisy/<x>"
+     * @param numThreads Потоки для декодирования (0 — по числу ядер)
+     */
+    void loadTestArchive(const std::string& archiveFile, size_t numThreads = 0);
+
     /**
      * Запустить полное тестирование всех алгоритмов
      * @return Детальные результаты для каждого алгоритма
      */
     std::vector<DetailedTestResult> runFullTest();
 
+    /**
+     * Запустить полное тестирование параллельно по матрице (алгоритм × сигнал)
+     * @param options Число потоков, закрепление за ядрами, режим замера времени
+     * @return Детальные результаты в порядке добавления алгоритмов
+     */
+    std::vector<DetailedTestResult> runFullTest(const RunOptions& options);
+
     /**
      * Тестировать один алгоритм на всем наборе данных
      * @param algorithm Алгоритм для тестирования
@@ -109,6 +251,16 @@ public:
     void saveResultsToCSV(const std::vector<DetailedTestResult>& results,
                          const std::string& filename) const;
 
+    /**
+     * Сохранить результаты в JSON (см. utils/bench_report.h): окружение запуска,
+     * метрики качества и статистика времени по каждому сигналу. Файл можно
+     * сравнить с базовой линией программой bench_compare
+     * @param results Результаты тестирования
+     * @param filename Имя файла для сохранения
+     */
+    void saveResultsToJSON(const std::vector<DetailedTestResult>& results,
+                           const std::string& filename) const;
+
     /**
      * Сохранить тестовый набор данных
      * @param cleanDir Директория для чистых сигналов
@@ -117,6 +269,13 @@ public:
     void saveTestDataset(const std::string& cleanDir,
                         const std::string& noisyDir) const;
 
+    /**
+     * Сохранить тестовый набор данных в один архив (.sga)
+     * @param archiveFile Имя файла архива
+     * @param compress Сжимать блоки (zlib с перестановкой байтов)
+     */
+    void saveTestArchive(const std::string& archiveFile, bool compress = true) const;
+
     /**
      * Получить статистику по тестовому набору
      * @return Статистическая информация о данных
@@ -131,20 +290,61 @@ public:
     std::map<std::string, std::vector<std::pair<size_t, double>>>
     testScalability(const std::vector<size_t>& signalLengths);
 
+    /**
+     * Масштабирование с повторными замерами и подбором модели сложности
+     *
+     * Для каждой модели t(N) = a + c·f(N) коэффициенты подбираются методом
+     * наименьших квадратов с весами 1/t² (относительная ошибка, иначе длинные
+     * сигналы подавляют короткие); лучшая модель — с наименьшей ошибкой.
+     * Показатель степени — наклон в логарифмических осях по верхней половине
+     * длин, где накладные расходы уже не влияют.
+     * @param options Длины, число сигналов, правила замера
+     * @return Результаты в порядке добавления алгоритмов
+     */
+    std::vector<ScalabilityResult> testScalability(const ScalabilityOptions& options);
+
+    /**
+     * Отчёт о масштабируемости: таблица времени, пропускной способности и
+     * полосы по длинам, подобранные модели и показатель степени
+     */
+    std::string generateScalabilityReport(const std::vector<ScalabilityResult>& results) const;
+
+    /**
+     * Подобрать модели сложности по замерам (используется testScalability)
+     * @param result Результат с заполненными points и windowSize
+     */
+    static void fitComplexity(ScalabilityResult& result);
+
+    /** Обозначение модели: "O(N)", "O(N log N)", ... */
+    static std::string complexityModelName(ComplexityModel model);
+
 private:
     /**
-     * Вычислить статистические показатели
-     * @param values Вектор значений
-     * @return Пара (среднее, стандартное отклонение)
+     * Заполнить средние и СКО по уже собранным поэлементным результатам
+     * @param result Результат с заполненными векторами метрик
      */
-    std::pair<double, double> calculateStatistics(const std::vector<double>& values) const;
+    void finalizeResult(DetailedTestResult& result) const;
 
     /**
-     * Вычислить статистические показатели для времени выполнения
-     * @param values Вектор значений времени
+     * Снять счётчики для уже прогретого алгоритма: kPerfCounterRuns вызовов
+     * process() подряд, результат — на один вызов
+     * @param counters Счётчики, открытые в текущем потоке
+     */
+    PerfCounterValues measurePerfCounters(SignalProcessor& algorithm, const Signal& input,
+                                          PerfCounters& counters) const;
+
+    /**
+     * Подсчитать выделения памяти одного вызова process() прогретого алгоритма
+     * (только при сборке с SIGNAL_ALLOC_TRACKING)
+     */
+    AllocStats measureAllocations(SignalProcessor& algorithm, const Signal& input) const;
+
+    /**
+     * Вычислить статистические показатели
+     * @param values Вектор значений
      * @return Пара (среднее, стандартное отклонение)
      */
-    std::pair<double, double> calculateTimeStatistics(const std::vector<long long>& values) const;
+    std::pair<double, double> calculateStatistics(const std::vector<double>& values) const;
 
     /**
      * Создать директорию если она не существует
@@ -153,7 +353,8 @@ private:
     void createDirectoryIfNotExists(const std::string& path) const;
 
     /**
-     * Получить список файлов в директории
+     * Получить список файлов сигналов (.csv, .sig) в директории.
+     * Если для сигнала есть и CSV, и контейнер .sig, возвращается только .sig
      * @param directory Путь к директории
      * @return Список имен файлов
      */
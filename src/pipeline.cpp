@@ -0,0 +1,140 @@
+#include "pipeline.h"
+#include "utils/trace.h"
+
+#include <chrono>
+#include <stdexcept>
+
+Pipeline::Pipeline(const Pipeline& other)
+    : pointwiseNames_(other.pointwiseNames_), stats_(other.stats_) {
+    stages_.reserve(other.stages_.size());
+    for (const Stage& stage : other.stages_) {
+        stages_.push_back({stage.processor ? stage.processor->clone() : nullptr,
+                           stage.pointwise});
+    }
+}
+
+Pipeline& Pipeline::operator=(const Pipeline& other) {
+    if (this != &other) {
+        Pipeline copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+Pipeline& Pipeline::add(std::unique_ptr<SignalProcessor> stage) {
+    if (!stage) {
+        throw std::invalid_argument("Pipeline stage must not be null");
+    }
+    stages_.push_back({std::move(stage), {}});
+    pointwiseNames_.emplace_back();
+    stats_.push_back({stageName(stages_.back(), pointwiseNames_.back())});
+    return *this;
+}
+
+Pipeline& Pipeline::addPointwise(std::string name, Pointwise fn) {
+    if (!fn) {
+        throw std::invalid_argument("Pipeline pointwise stage must not be empty");
+    }
+    // Первый этап цепочки — копирование входа, к нему и присоединяется функция
+    if (stages_.empty()) {
+        stages_.push_back({nullptr, {}});
+        pointwiseNames_.emplace_back();
+        stats_.emplace_back();
+    }
+    stages_.back().pointwise.push_back(std::move(fn));
+    pointwiseNames_.back().push_back(std::move(name));
+    stats_.back().name = stageName(stages_.back(), pointwiseNames_.back());
+    return *this;
+}
+
+std::string Pipeline::stageName(const Stage& stage, const std::vector<std::string>& names) {
+    std::string name = stage.processor ? stage.processor->getName() : std::string();
+    for (const std::string& n : names) {
+        if (!name.empty()) name += '+';
+        name += n;
+    }
+    return name;
+}
+
+SignalProcessor::Signal Pipeline::process(const Signal& input) {
+    Signal output;
+    processInto(input, output);
+    return output;
+}
+
+void Pipeline::processInto(const Signal& input, Signal& output) {
+    TRACE_SCOPE("Pipeline::process");
+    if (stages_.empty()) {
+        output = input;
+        return;
+    }
+
+    const Signal* source = &input;
+    for (size_t s = 0; s < stages_.size(); ++s) {
+        TRACE_SCOPE("Pipeline::stage");
+        const auto start = std::chrono::steady_clock::now();
+
+        const Stage& stage = stages_[s];
+        Signal& target = s + 1 == stages_.size() ? output : buffers_[s % 2];
+        if (stage.processor) {
+            stage.processor->processInto(*source, target);
+        } else {
+            target.assign(source->begin(), source->end());
+        }
+
+        if (!stage.pointwise.empty()) {
+            for (double& v : target) {
+                for (const Pointwise& fn : stage.pointwise) v = fn(v);
+            }
+        }
+
+        const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        StageStats& st = stats_[s];
+        st.lastNs   = ns;
+        st.totalNs += ns;
+        ++st.calls;
+
+        source = &target;
+    }
+}
+
+std::string Pipeline::getName() const {
+    std::string name;
+    for (const StageStats& st : stats_) {
+        if (!name.empty()) name += "→";
+        name += st.name;
+    }
+    return name.empty() ? "Pipeline" : name;
+}
+
+size_t Pipeline::getWindowSize() const {
+    size_t window = 1;
+    for (const Stage& stage : stages_) {
+        if (stage.processor) window += stage.processor->getWindowSize() - 1;
+    }
+    return window;
+}
+
+size_t Pipeline::getReach() const {
+    size_t reach = 0;
+    for (const Stage& stage : stages_) {
+        if (!stage.processor) continue;
+        const size_t h = stage.processor->getReach();
+        if (h == kNonLocal) return kNonLocal;
+        reach += h;
+    }
+    return reach;
+}
+
+void Pipeline::resetStats() {
+    for (StageStats& st : stats_) {
+        st.lastNs  = 0;
+        st.totalNs = 0;
+        st.calls   = 0;
+    }
+}
+
+size_t Pipeline::bufferBytes() const {
+    return (buffers_[0].capacity() + buffers_[1].capacity()) * sizeof(double);
+}
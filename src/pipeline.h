@@ -0,0 +1,120 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "signal_processor.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Цепочка обработчиков: выход каждого этапа — вход следующего
+ *
+ * Промежуточные результаты пишутся попеременно в два буфера, которые живут
+ * между вызовами, через SignalProcessor::processInto: после первого вызова на
+ * сигнале той же длины сама цепочка памяти не выделяет (выделения внутри
+ * фильтров остаются на их совести). Последний этап пишет сразу в выход.
+ *
+ * Поточечные этапы (addPointwise: y[i] = f(x[i])) не получают своего буфера:
+ * подряд идущие сливаются в один проход, который выполняется на месте по
+ * выходу предыдущего этапа. В статистике слитые этапы — один этап с именем
+ * «A+B».
+ *
+ * Время каждого этапа (steady_clock) доступно через stageStats(); при сборке
+ * с трассировкой этапы видны и в трассе (Pipeline::stage).
+ *
+ * Пример:
+ *   Pipeline chain;
+ *   chain.emplace<OutlierDetection>()
+ *        .emplace<MedianFilter>(5)
+ *        .addPointwise("clip", [](double v) { return std::clamp(v, -1.0, 1.0); });
+ *   auto y = chain.process(x);
+ */
+class Pipeline : public SignalProcessor {
+public:
+    using Pointwise = std::function<double(double)>;
+
+    /**
+     * Время одного (возможно, слитого) этапа
+     */
+    struct StageStats {
+        std::string name;
+        long long   lastNs  = 0;   ///< Последний вызов, нс
+        long long   totalNs = 0;   ///< Сумма по всем вызовам, нс
+        size_t      calls   = 0;
+    };
+
+    Pipeline() = default;
+    Pipeline(const Pipeline& other);
+    Pipeline& operator=(const Pipeline& other);
+    Pipeline(Pipeline&&) = default;
+    Pipeline& operator=(Pipeline&&) = default;
+
+    /**
+     * Добавить этап в конец цепочки
+     * @throws std::invalid_argument если stage пуст
+     */
+    Pipeline& add(std::unique_ptr<SignalProcessor> stage);
+
+    /** Создать этап на месте: emplace<MedianFilter>(5) */
+    template<typename Processor, typename... Args>
+    Pipeline& emplace(Args&&... args) {
+        return add(std::make_unique<Processor>(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Добавить поточечный этап y[i] = fn(x[i])
+     * @param name Имя этапа (для getName и статистики)
+     * @throws std::invalid_argument если fn пуст
+     */
+    Pipeline& addPointwise(std::string name, Pointwise fn);
+
+    /** Число этапов после слияния поточечных */
+    size_t size() const { return stages_.size(); }
+
+    bool empty() const { return stages_.empty(); }
+
+    /** Пустая цепочка возвращает вход без изменений */
+    Signal process(const Signal& input) override;
+
+    void processInto(const Signal& input, Signal& output) override;
+
+    /** Имена этапов через «→» */
+    std::string getName() const override;
+
+    std::unique_ptr<SignalProcessor> clone() const override {
+        return std::make_unique<Pipeline>(*this);
+    }
+
+    /** Окно композиции: Σ (wᵢ − 1) + 1 */
+    size_t getWindowSize() const override;
+
+    /** Σ hᵢ, если все этапы локальны, иначе kNonLocal */
+    size_t getReach() const override;
+
+    /** Время этапов по всем вызовам с последнего resetStats() */
+    const std::vector<StageStats>& stageStats() const { return stats_; }
+
+    void resetStats();
+
+    /** Байт в промежуточных буферах (живут между вызовами) */
+    size_t bufferBytes() const;
+
+private:
+    /// Этап: обработчик (или копирование входа) и слитые за ним поточечные функции
+    struct Stage {
+        std::unique_ptr<SignalProcessor> processor;
+        std::vector<Pointwise>           pointwise;
+    };
+
+    static std::string stageName(const Stage& stage, const std::vector<std::string>& names);
+
+    std::vector<Stage>                    stages_;
+    std::vector<std::vector<std::string>> pointwiseNames_;   ///< По этапам
+    std::vector<StageStats>               stats_;
+    Signal                                buffers_[2];
+};
+
+#endif // PIPELINE_H
@@ -3,9 +3,26 @@
  * outlier_detection → <filter>
  *
  * Запуск:
- *   ./build/pipeline_benchmark [signal_N.csv]
+ *   ./build/pipeline_benchmark [опции] [signal_N.csv | signal_N.sig | dataset.sga]
  *
- * По умолчанию перебирает все signal_0..signal_9.csv и выводит сводную таблицу.
+ * По умолчанию перебирает все signal_0..signal_9 и выводит сводную таблицу.
+ * Если рядом с signal_N.csv лежит бинарный контейнер signal_N.sig, читается он.
+ * Время — медиана повторных замеров (utils/timing.h).
+ *
+ * Опции:
+ *   --json FILE            сохранить результаты в JSON (utils/bench_report.h)
+ *   --baseline FILE        сравнить с сохранённым JSON; при регрессии код выхода 2
+ *   --time-tolerance X     допустимое замедление, доля (по умолчанию 0.05)
+ *   --snr-tolerance DB     допустимая потеря SNR, дБ (по умолчанию 0.1)
+ *   --runs N               повторить весь прогон N раз; значимость замедления
+ *                          оценивается по разбросу между прогонами (для
+ *                          базовой линии и проверки рекомендуется N ≥ 3)
+ *   --quick                один замер без повторов
+ *   --trace FILE           записать этапы фильтров в Chrome trace JSON
+ *                          (открывается в Perfetto); нужна сборка -DTRACING=ON
+ *
+ * В сборке с -DALLOC_TRACKING=ON таблица дополняется числом выделений памяти
+ * и пиком занятой памяти на один прогон конфигурации.
  */
 
 #include <iostream>
@@ -16,6 +33,7 @@
 #include <memory>
 #include <numeric>
 #include <cmath>
+#include <algorithm>
 
 #include "signal_generator.h"
 #include "signal_processor.h"
@@ -25,6 +43,15 @@
 #include "morphological_filter.h"
 #include "savgol_filter.h"
 #include "kalman_filter.h"
+#include "pipeline.h"
+#include "utils/signal_file.h"
+#include "utils/signal_archive.h"
+#include "utils/alloc_tracker.h"
+#include "utils/bench_report.h"
+#include "utils/timing.h"
+#include "utils/trace.h"
+
+#include <sys/stat.h>
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Результат одного запуска фильтра
@@ -34,64 +61,92 @@ struct RunResult {
     double      snr;
     double      mse;
     double      correlation;
-    long long   timeUs;      ///< Суммарное время (мкс)
+    long long   timeUs;      ///< Медианное время (мкс)
+    double      allocations; ///< Выделений памяти (SIGNAL_ALLOC_TRACKING)
+    double      peakBytes;   ///< Пик занятой памяти, байт
+    TimingStats timing;      ///< Статистика замеров, нс
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Стандартный преdfильтр: OutlierDetection(MAD, linear, 3.0, 11)
+// Проверка существования файла
 // ─────────────────────────────────────────────────────────────────────────────
-static SignalProcessor::Signal applyPrefilter(
-    const SignalProcessor::Signal& noisy,
-    long long& outTimeUs)
-{
-    OutlierDetection pre(
+static bool fileExists(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Предфильтр: MAD-детектор выбросов с линейной интерполяцией
+// ─────────────────────────────────────────────────────────────────────────────
+static OutlierDetection makePrefilter() {
+    return OutlierDetection(
         OutlierDetection::DetectionMethod::MAD_BASED,
         OutlierDetection::InterpolationMethod::LINEAR,
         3.0, 11);
-    auto [out, t] = pre.measurePerformance(noisy);
-    outTimeUs = t;
-    return out;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Запуск одиночного фильтра
+// Запустить одиночный фильтр
 // ─────────────────────────────────────────────────────────────────────────────
 static RunResult runSingle(
     const std::string&             label,
     SignalProcessor&               filter,
     const SignalProcessor::Signal& noisy,
-    const SignalProcessor::Signal& clean)
+    const SignalProcessor::Signal& clean,
+    const TimingOptions&           timingOptions)
 {
-    auto [filtered, t] = filter.measurePerformance(noisy);
+    const TimingStats timing = measureTiming([&] { filter.process(noisy); }, timingOptions);
+
+    // Выделения — на прогретом фильтре, отдельным вызовом
+    AllocScope allocs;
+    auto filtered = filter.process(noisy);
+    const AllocStats a = allocs.stats();
+    const QualityMetrics quality = calculateQualityMetrics(clean, filtered);
+
     return RunResult{
         label,
-        calculateSNR(clean, filtered),
-        calculateMSE(clean, filtered),
-        calculateCorrelation(clean, filtered),
-        t
+        quality.snr,
+        quality.mse,
+        quality.correlation,
+        std::llround(timing.medianNs / 1000.0),
+        static_cast<double>(a.allocations),
+        static_cast<double>(a.peakBytes),
+        timing
     };
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Запуск двухэтапной цепочки: outlier → filter
+// Запустить цепочку outlier → filter
 // ─────────────────────────────────────────────────────────────────────────────
 static RunResult runPipeline(
-    const std::string&             label,
-    SignalProcessor&               filter,
-    const SignalProcessor::Signal& noisy,
-    const SignalProcessor::Signal& clean)
+    const std::string&               label,
+    std::unique_ptr<SignalProcessor> filter,
+    const SignalProcessor::Signal&   noisy,
+    const SignalProcessor::Signal&   clean,
+    const TimingOptions&             timingOptions)
 {
-    long long preTime = 0;
-    auto preOut = applyPrefilter(noisy, preTime);
+    Pipeline chain;
+    chain.add(std::make_unique<OutlierDetection>(makePrefilter()))
+         .add(std::move(filter));
+
+    const TimingStats timing = measureTiming([&] { chain.process(noisy); }, timingOptions);
 
-    auto [filtered, filterTime] = filter.measurePerformance(preOut);
+    AllocScope allocs;
+    auto filtered = chain.process(noisy);
+    const AllocStats a = allocs.stats();
+    const QualityMetrics quality = calculateQualityMetrics(clean, filtered);
 
+    // Промежуточный буфер цепочки выделен при прогреве и жив во время
+    // второго этапа — входит в пик
     return RunResult{
         "Outlier→" + label,
-        calculateSNR(clean, filtered),
-        calculateMSE(clean, filtered),
-        calculateCorrelation(clean, filtered),
-        preTime + filterTime
+        quality.snr,
+        quality.mse,
+        quality.correlation,
+        std::llround(timing.medianNs / 1000.0),
+        static_cast<double>(a.allocations),
+        static_cast<double>(a.peakBytes + (allocTrackingEnabled() ? chain.bufferBytes() : 0)),
+        timing
     };
 }
 
@@ -99,8 +154,12 @@ static RunResult runPipeline(
 // Напечатать строку таблицы
 // ─────────────────────────────────────────────────────────────────────────────
 static void printRow(const RunResult& r) {
-    std::cout << std::format("{:<38} {:>8.2f} {:>14.3e} {:>12.4f} {:>10}\n",
+    std::cout << std::format("{:<38} {:>8.2f} {:>14.3e} {:>12.4f} {:>10}",
         r.label, r.snr, r.mse, r.correlation, r.timeUs);
+    if (allocTrackingEnabled()) {
+        std::cout << std::format(" {:>10.0f} {:>12.0f}", r.allocations, r.peakBytes);
+    }
+    std::cout << "\n";
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -113,12 +172,16 @@ static RunResult average(const std::vector<RunResult>& v) {
         avg.mse         += v[i].mse;
         avg.correlation += v[i].correlation;
         avg.timeUs      += v[i].timeUs;
+        avg.allocations += v[i].allocations;
+        avg.peakBytes   += v[i].peakBytes;
     }
     double n = static_cast<double>(v.size());
     avg.snr         /= n;
     avg.mse         /= n;
     avg.correlation /= n;
     avg.timeUs      = static_cast<long long>(avg.timeUs / n);
+    avg.allocations /= n;
+    avg.peakBytes   /= n;
     avg.label       = "[avg] " + avg.label;
     return avg;
 }
@@ -174,68 +237,247 @@ static std::vector<FilterConfig> makeConfigs() {
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// main
+// Загрузка пар (clean, noisy)
 // ─────────────────────────────────────────────────────────────────────────────
-int main(int argc, char* argv[]) {
-    std::cout << "================================================\n";
-    std::cout << "  PIPELINE BENCHMARK: одиночные vs outlier→filter\n";
-    std::cout << "================================================\n\n";
+struct SignalPair {
+    std::string             name;
+    SignalProcessor::Signal clean;
+    SignalProcessor::Signal noisy;
+};
+
+/**
+ * @param arg Пусто — signal_0..9 из data/clean, data/noisy;
+ *            *.sga — все пары архива; иначе — имя файла в data/clean, data/noisy
+ */
+static std::vector<SignalPair> loadSignals(const std::string& arg) {
+    std::vector<SignalPair> pairs;
+
+    if (isSignalArchivePath(arg)) {
+        try {
+            SignalArchive archive(arg);
+            auto data = archive.readPairs();
+            for (size_t i = 0; i < data.size(); ++i) {
+                pairs.push_back({ std::format("{}[{}]", arg, i),
+                                  std::move(data[i].first), std::move(data[i].second) });
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Ошибка чтения архива " << arg << ": " << e.what() << "\n";
+        }
+        return pairs;
+    }
 
-    // Собираем список сигналов
     std::vector<std::string> signalFiles;
-    if (argc >= 2) {
-        signalFiles.emplace_back(argv[1]);
+    if (!arg.empty()) {
+        signalFiles.push_back(arg);
     } else {
         for (int n = 0; n <= 9; ++n)
             signalFiles.push_back(std::format("signal_{}.csv", n));
     }
 
-    std::string rootPath(ROOT_PATH);
-    auto configs = makeConfigs();
+    const std::string rootPath(ROOT_PATH);
+    for (auto fname : signalFiles) {
+        // Предпочитаем бинарный контейнер, если он есть
+        if (!isSignalFilePath(fname) && fname.size() >= 4) {
+            std::string sig = fname.substr(0, fname.size() - 4) + kSignalFileExtension;
+            if (fileExists(rootPath + "/data/clean/" + sig) &&
+                fileExists(rootPath + "/data/noisy/" + sig))
+                fname = sig;
+        }
 
-    // Для каждой конфигурации храним результаты по всем сигналам
-    // results[cfg_idx][single/pipeline] → vector<RunResult>
-    const size_t C = configs.size();
-    std::vector<std::vector<RunResult>> singleResults(C);
-    std::vector<std::vector<RunResult>> pipeResults(C);
+        try {
+            pairs.push_back({ fname,
+                              SignalGenerator::loadSignal(rootPath + "/data/clean/" + fname),
+                              SignalGenerator::loadSignal(rootPath + "/data/noisy/" + fname) });
+        } catch (const std::exception& e) {
+            std::cerr << "Пропуск " << fname << ": " << e.what() << "\n";
+        }
+    }
+    return pairs;
+}
 
-    // ── Перебираем сигналы ────────────────────────────────────────────────
-    for (const auto& fname : signalFiles) {
-        std::string cleanPath = rootPath + "/data/clean/"  + fname;
-        std::string noisyPath = rootPath + "/data/noisy/" + fname;
+// ─────────────────────────────────────────────────────────────────────────────
+// Повторные прогоны одного сигнала: результат с медианным временем
+// ─────────────────────────────────────────────────────────────────────────────
+static RunResult medianRun(std::vector<RunResult> runs) {
+    auto mid = runs.begin() + runs.size() / 2;
+    std::nth_element(runs.begin(), mid, runs.end(), [](const RunResult& a, const RunResult& b) {
+        return a.timing.medianNs < b.timing.medianNs;
+    });
+    return *mid;
+}
 
-        SignalProcessor::Signal cleanSig, noisySig;
+// ─────────────────────────────────────────────────────────────────────────────
+// JSON-отчёт: одиночные фильтры и цепочки по всем сигналам
+// @param runs runs[signal][run]
+// ─────────────────────────────────────────────────────────────────────────────
+static BenchEntry toBenchEntry(const std::string& name,
+                               const std::vector<std::vector<RunResult>>& runs) {
+    BenchEntry entry;
+    entry.name           = name;
+    entry.hasAllocations = allocTrackingEnabled();
+    for (const auto& signalRuns : runs) {
+        const RunResult r = medianRun(signalRuns);
+        entry.snr.push_back(r.snr);
+        entry.mse.push_back(r.mse);
+        entry.correlation.push_back(r.correlation);
+        entry.timings.push_back(r.timing);
+        entry.allocations += r.allocations;
+        entry.peakBytes   += r.peakBytes;
+
+        if (signalRuns.size() > 1) {
+            std::vector<double> medians;
+            for (const RunResult& run : signalRuns) medians.push_back(run.timing.medianNs);
+            entry.runMediansNs.push_back(std::move(medians));
+        }
+    }
+    if (!runs.empty()) {
+        entry.allocations /= static_cast<double>(runs.size());
+        entry.peakBytes   /= static_cast<double>(runs.size());
+    }
+    return entry;
+}
+
+static void printUsage(const char* prog) {
+    std::cout << "Использование: " << prog << " [опции] [signal_N.csv | signal_N.sig | dataset.sga]\n\n"
+              << "Опции:\n"
+              << "  -h, --help            Показать эту справку\n"
+              << "  --json FILE           Сохранить результаты в JSON\n"
+              << "  --baseline FILE       Сравнить с базовой линией (код выхода 2 при регрессии)\n"
+              << "  --time-tolerance X    Допустимое замедление, доля (по умолчанию 0.05)\n"
+              << "  --snr-tolerance DB    Допустимая потеря SNR, дБ (по умолчанию 0.1)\n"
+              << "  --runs N              Повторить весь прогон N раз (по умолчанию 1)\n"
+              << "  --quick               Один замер без повторов\n"
+              << "  --trace FILE          Сохранить трассу этапов (Chrome trace JSON)\n";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// main
+// ─────────────────────────────────────────────────────────────────────────────
+int main(int argc, char* argv[]) {
+    std::string     signalArg, jsonFile, baselineFile, traceFile;
+    BenchThresholds thresholds;
+    TimingOptions   timingOptions;
+    size_t          numRuns = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        try {
+            if (a == "-h" || a == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (a == "--json" && hasValue) {
+                jsonFile = argv[++i];
+            } else if (a == "--baseline" && hasValue) {
+                baselineFile = argv[++i];
+            } else if (a == "--time-tolerance" && hasValue) {
+                thresholds.timeTolerance = std::stod(argv[++i]);
+            } else if (a == "--snr-tolerance" && hasValue) {
+                thresholds.snrTolerance = std::stod(argv[++i]);
+            } else if (a == "--runs" && hasValue) {
+                numRuns = std::max<size_t>(1, std::stoul(argv[++i]));
+            } else if (a == "--quick") {
+                timingOptions = TimingOptions::singleShot();
+            } else if (a == "--trace" && hasValue) {
+                traceFile = argv[++i];
+            } else if (a.rfind("--", 0) != 0 && signalArg.empty()) {
+                signalArg = a;
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Неверное значение опции " << a << "\n";
+            return 1;
+        }
+    }
+
+    // Базовая линия читается до прогона, чтобы не ждать его впустую
+    BenchReport baseline;
+    if (!baselineFile.empty()) {
         try {
-            cleanSig = SignalGenerator::loadSignalFromCSV(cleanPath);
-            noisySig = SignalGenerator::loadSignalFromCSV(noisyPath);
+            baseline = readBenchJson(baselineFile);
         } catch (const std::exception& e) {
-            std::cerr << "Пропуск " << fname << ": " << e.what() << "\n";
-            continue;
+            std::cerr << e.what() << "\n";
+            return 1;
         }
+    }
+
+    std::cout << "================================================\n";
+    std::cout << "  PIPELINE BENCHMARK: одиночные vs outlier→filter\n";
+    std::cout << "================================================\n\n";
 
-        std::cout << "Обработка: " << fname
-                  << " (" << noisySig.size() << " отсчётов)\n";
+    const BenchEnvironment environment = currentBenchEnvironment();
+    for (const std::string& warning : environment.warnings) {
+        std::cout << "ВНИМАНИЕ: " << warning << "\n";
+    }
+    if (!environment.warnings.empty()) std::cout << "\n";
+
+    if (!traceFile.empty()) {
+        if (!traceCompiledIn()) {
+            std::cout << "ВНИМАНИЕ: сборка без -DTRACING=ON, трасса будет пустой\n\n";
+        }
+        traceSetThreadName("main");
+        traceStart();
+    }
 
-        for (size_t ci = 0; ci < C; ++ci) {
-            auto fs = configs[ci].factory();
-            auto fp = configs[ci].factory();
+    auto signals = loadSignals(signalArg);
+    auto configs = makeConfigs();
 
-            singleResults[ci].push_back(runSingle  (configs[ci].name, *fs, noisySig, cleanSig));
-            pipeResults  [ci].push_back(runPipeline (configs[ci].name, *fp, noisySig, cleanSig));
+    // Для каждой конфигурации храним результаты по всем сигналам и прогонам
+    // runs[cfg_idx][signal][run] → RunResult
+    const size_t C = configs.size();
+    const size_t S = signals.size();
+    std::vector<std::vector<std::vector<RunResult>>> singleRuns(
+        C, std::vector<std::vector<RunResult>>(S));
+    std::vector<std::vector<std::vector<RunResult>>> pipeRuns(
+        C, std::vector<std::vector<RunResult>>(S));
+
+    // ── Перебираем сигналы; повторные прогоны — целиком, чтобы дрейф
+    //    производительности машины попал в разброс между прогонами ───────
+    for (size_t run = 0; run < numRuns; ++run) {
+        if (numRuns > 1) std::cout << "Прогон " << run + 1 << "/" << numRuns << "\n";
+
+        for (size_t si = 0; si < S; ++si) {
+            const auto& [fname, cleanSig, noisySig] = signals[si];
+            std::cout << "Обработка: " << fname
+                      << " (" << noisySig.size() << " отсчётов)\n";
+
+            for (size_t ci = 0; ci < C; ++ci) {
+                auto fs = configs[ci].factory();
+
+                singleRuns[ci][si].push_back(runSingle  (configs[ci].name, *fs, noisySig,
+                                                         cleanSig, timingOptions));
+                pipeRuns  [ci][si].push_back(runPipeline (configs[ci].name, configs[ci].factory(),
+                                                         noisySig, cleanSig, timingOptions));
+            }
         }
     }
 
-    if (singleResults[0].empty()) {
+    if (S == 0) {
         std::cerr << "Нет данных для анализа.\n";
         return 1;
     }
 
+    // Для таблицы — прогон с медианным временем по каждому сигналу
+    std::vector<std::vector<RunResult>> singleResults(C);
+    std::vector<std::vector<RunResult>> pipeResults(C);
+    for (size_t ci = 0; ci < C; ++ci) {
+        for (size_t si = 0; si < S; ++si) {
+            singleResults[ci].push_back(medianRun(singleRuns[ci][si]));
+            pipeResults  [ci].push_back(medianRun(pipeRuns  [ci][si]));
+        }
+    }
+
     // ── Сводная таблица ────────────────────────────────────────────────────
-    const std::string sep(86, '-');
+    const std::string sep(allocTrackingEnabled() ? 110 : 86, '-');
     std::cout << "\n" << sep << "\n";
-    std::cout << std::format("{:<38} {:>8} {:>14} {:>12} {:>10}\n",
+    std::cout << std::format("{:<38} {:>8} {:>14} {:>12} {:>10}",
         "Конфигурация", "SNR(дБ)", "MSE", "Корреляция", "Время(мкс)");
-    std::cout << sep << "\n";
+    if (allocTrackingEnabled()) {
+        std::cout << std::format(" {:>10} {:>12}", "Выделений", "Пик(байт)");
+    }
+    std::cout << "\n" << sep << "\n";
 
     double bestSingleSNR = -1e9, bestPipeSNR = -1e9;
     std::string bestSingleLabel, bestPipeLabel;
@@ -269,5 +511,49 @@ int main(int argc, char* argv[]) {
     std::cout << std::format("Прирост от предфильтрации:  {:>+.2f} дБ\n",
         bestPipeSNR - bestSingleSNR);
 
+    if (!traceFile.empty()) {
+        traceStop();
+        try {
+            writeChromeTrace(traceFile);
+            std::cout << "\nТрасса сохранена: " << traceFile;
+            if (traceDroppedEvents() > 0) {
+                std::cout << " (отброшено событий: " << traceDroppedEvents() << ")";
+            }
+            std::cout << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    // ── JSON и сравнение с базовой линией ──────────────────────────────────
+    BenchReport report;
+    report.benchmark   = "pipeline_benchmark";
+    report.environment = environment;
+    for (const auto& pair : signals) report.signals.push_back(pair.name);
+    for (size_t ci = 0; ci < C; ++ci) {
+        report.entries.push_back(toBenchEntry(configs[ci].name, singleRuns[ci]));
+        report.entries.push_back(toBenchEntry("Outlier→" + configs[ci].name, pipeRuns[ci]));
+    }
+
+    if (!jsonFile.empty()) {
+        try {
+            writeBenchJson(jsonFile, report);
+            std::cout << "\nРезультаты сохранены: " << jsonFile << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    if (!baselineFile.empty()) {
+        const BenchComparison cmp = compareBenchReports(baseline, report, thresholds);
+        std::cout << "\nБазовая линия: " << baselineFile << " ("
+                  << baseline.environment.gitRevision << ", "
+                  << baseline.environment.timestamp << ")\n";
+        std::cout << formatBenchComparison(cmp, thresholds);
+        if (cmp.failed()) return 2;
+    }
+
     return 0;
 }
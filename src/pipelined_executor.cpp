@@ -0,0 +1,208 @@
+#include "pipelined_executor.h"
+#include "utils/parallel.h"
+#include "utils/spsc_queue.h"
+#include "utils/trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+/// Номер блока-признака конца потока
+constexpr size_t kEndOfStream = std::numeric_limits<size_t>::max();
+
+/// Ожидание: сначала активные попытки, затем уступка процессора, затем сон —
+/// простаивающий этап не занимает ядро, нужное медленному соседу
+constexpr unsigned kSpinsBeforeYield = 64;
+constexpr unsigned kSpinsBeforeSleep = 1024;
+constexpr auto     kStallSleep       = std::chrono::microseconds(20);
+
+struct Block {
+    size_t                  index = kEndOfStream;
+    SignalProcessor::Signal data;
+};
+
+using Clock = std::chrono::steady_clock;
+
+long long elapsedNs(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/**
+ * Очереди конвейера: forward[s] — вход этапа s, recycle[s] — пустые буферы,
+ * которые этап s возвращает производителю своего входа
+ */
+struct Links {
+    std::vector<std::unique_ptr<SpscQueue<Block>>> forward;
+    std::vector<std::unique_ptr<SpscQueue<Block>>> recycle;
+    std::atomic<bool>                              abort{false};
+    std::mutex                                     errorMutex;
+    std::exception_ptr                             error;
+
+    Links(size_t stages, size_t capacity) {
+        for (size_t s = 0; s < stages; ++s) {
+            forward.push_back(std::make_unique<SpscQueue<Block>>(capacity));
+            // В обороте одного звена — очередь и по блоку у каждой из сторон
+            recycle.push_back(std::make_unique<SpscQueue<Block>>(capacity + 2));
+        }
+    }
+
+    void fail(std::exception_ptr e) {
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = e;
+        }
+        abort.store(true, std::memory_order_release);
+    }
+
+    /**
+     * Повторять attempt() до успеха; время ожидания добавляется к stallNs
+     * @return false — конвейер остановлен из-за ошибки
+     */
+    template<typename Attempt>
+    bool waitFor(Attempt&& attempt, long long& stallNs) {
+        if (attempt()) return true;
+        const auto start = Clock::now();
+        for (unsigned spins = 0; !attempt(); ++spins) {
+            if (abort.load(std::memory_order_acquire)) return false;
+            if (spins >= kSpinsBeforeSleep) {
+                std::this_thread::sleep_for(kStallSleep);
+            } else if (spins >= kSpinsBeforeYield) {
+                std::this_thread::yield();
+            }
+        }
+        stallNs += elapsedNs(start);
+        return true;
+    }
+
+    /** Пустой буфер для очереди forward[s] (из возвращённых или новый) */
+    Block takeEmpty(size_t s) {
+        Block block;
+        recycle[s]->tryPop(block);
+        return block;
+    }
+
+    /** Вернуть буфер производителю очереди forward[s]; лишние освобождаются */
+    void giveBack(size_t s, Block& block) {
+        recycle[s]->tryPush(block);
+    }
+};
+
+} // namespace
+
+PipelinedExecutor::PipelinedExecutor(std::vector<std::unique_ptr<SignalProcessor>> stages,
+                                     Options options)
+    : stages_(std::move(stages)), options_(options) {
+    if (stages_.empty()) {
+        throw std::invalid_argument("PipelinedExecutor needs at least one stage");
+    }
+    for (const auto& stage : stages_) {
+        if (!stage) throw std::invalid_argument("PipelinedExecutor stage must not be null");
+    }
+    metrics_.resize(stages_.size());
+    for (size_t s = 0; s < stages_.size(); ++s) metrics_[s].name = stages_[s]->getName();
+}
+
+size_t PipelinedExecutor::run(const Source& source, const Sink& sink) {
+    const size_t numStages = stages_.size();
+    for (StageMetrics& m : metrics_) m = StageMetrics{m.name};
+    sourceStallNs_ = 0;
+
+    Links links(numStages, options_.queueCapacity);
+    const std::vector<int> cpus = options_.pinThreads ? availableCpus() : std::vector<int>();
+    const auto runStart = Clock::now();
+
+    auto worker = [&](size_t s) {
+        ScopedThreadPin pin(cpus.empty() ? -1 : cpus[(s + 1) % cpus.size()]);
+        if (traceActive()) traceSetThreadName("stage " + std::to_string(s) + ": " + metrics_[s].name);
+
+        StageMetrics& m = metrics_[s];
+        SignalProcessor& stage = *stages_[s];
+        SpscQueue<Block>& input = *links.forward[s];
+        const bool last = s + 1 == numStages;
+        double depthSum = 0.0;
+        Block in;
+        Block out;   // У последнего этапа — единственный выходной буфер
+
+        try {
+            for (;;) {
+                const size_t depth = input.size();
+                if (!links.waitFor([&] { return input.tryPop(in); }, m.inputStallNs)) return;
+                if (in.index == kEndOfStream) break;
+
+                depthSum += static_cast<double>(depth);
+                m.maxQueueDepth = std::max(m.maxQueueDepth, depth);
+
+                if (!last) out = links.takeEmpty(s + 1);
+                {
+                    TRACE_SCOPE("PipelinedExecutor::stage");
+                    const auto start = Clock::now();
+                    stage.processInto(in.data, out.data);
+                    out.index = in.index;
+                    if (last) sink(out.index, out.data);
+                    m.busyNs += elapsedNs(start);
+                }
+                ++m.blocks;
+                links.giveBack(s, in);
+
+                if (!last) {
+                    SpscQueue<Block>& output = *links.forward[s + 1];
+                    if (!links.waitFor([&] { return output.tryPush(out); }, m.outputStallNs)) return;
+                }
+            }
+            // Признак конца — дальше по конвейеру
+            if (!last) {
+                SpscQueue<Block>& output = *links.forward[s + 1];
+                links.waitFor([&] { return output.tryPush(in); }, m.outputStallNs);
+            }
+        } catch (...) {
+            links.fail(std::current_exception());
+        }
+        if (m.blocks > 0) m.meanQueueDepth = depthSum / static_cast<double>(m.blocks);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numStages);
+    for (size_t s = 0; s < numStages; ++s) threads.emplace_back(worker, s);
+
+    // Источник — в вызывающем потоке
+    size_t produced = 0;
+    try {
+        SpscQueue<Block>& first = *links.forward[0];
+        for (;;) {
+            Block block = links.takeEmpty(0);
+            if (!source(block.data)) break;
+            block.index = produced++;
+            if (!links.waitFor([&] { return first.tryPush(block); }, sourceStallNs_)) break;
+        }
+        Block end;
+        links.waitFor([&] { return first.tryPush(end); }, sourceStallNs_);
+    } catch (...) {
+        links.fail(std::current_exception());
+    }
+
+    for (std::thread& t : threads) t.join();
+    lastRunNs_ = elapsedNs(runStart);
+
+    if (links.error) std::rethrow_exception(links.error);
+    return produced;
+}
+
+std::vector<PipelinedExecutor::Signal> PipelinedExecutor::run(const std::vector<Signal>& blocks) {
+    std::vector<Signal> results(blocks.size());
+    size_t next = 0;
+    run([&](Signal& block) {
+            if (next == blocks.size()) return false;
+            block.assign(blocks[next].begin(), blocks[next].end());
+            ++next;
+            return true;
+        },
+        [&](size_t index, const Signal& block) { results[index] = block; });
+    return results;
+}
@@ -0,0 +1,110 @@
+#ifndef PIPELINED_EXECUTOR_H
+#define PIPELINED_EXECUTOR_H
+
+#include "signal_processor.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Параметры конвейерного исполнения
+ */
+struct PipelinedExecutorOptions {
+    size_t queueCapacity = 4;       ///< Блоков в очереди между соседними этапами
+    bool   pinThreads    = false;   ///< Закрепить этап s за (s+1)-м доступным ядром
+};
+
+/**
+ * Конвейерное исполнение цепочки: каждый этап — в своём потоке
+ *
+ * Поток блоков (импульсы, участки длинного сигнала) проходит этапы по
+ * очереди; этап s работает в рабочем потоке s и получает блоки от этапа
+ * s − 1 через кольцевую очередь без блокировок (utils/spsc_queue.h) ёмкостью
+ * queueCapacity. Пока этап 2 обрабатывает блок k, этап 1 уже обрабатывает
+ * блок k + 1 — пропускная способность стремится к скорости самого медленного
+ * этапа, а не к сумме времён всех этапов.
+ *
+ * Каждый блок обрабатывается этапом как отдельный сигнал
+ * (SignalProcessor::processInto) — состояние между блоками не переносится,
+ * как и при обычном вызове process() для каждого блока.
+ *
+ * Противодавление: если следующий этап не успевает, очередь заполняется и
+ * этап ждёт места; ожидание учитывается в outputStallNs. Ожидание входа —
+ * в inputStallNs. Буферы блоков возвращаются производителю обратными
+ * очередями и переиспользуются: в установившемся режиме исполнитель не
+ * выделяет память.
+ *
+ * Источник вызывается в потоке, вызвавшем run(); приёмник — в потоке
+ * последнего этапа, в порядке блоков. Исключение из этапа, источника или
+ * приёмника останавливает конвейер и пробрасывается из run().
+ */
+class PipelinedExecutor {
+public:
+    using Signal = SignalProcessor::Signal;
+
+    /**
+     * Источник: заполнить block следующим блоком (вектор может содержать
+     * прежние данные — длина задаётся источником); false — блоков больше нет
+     */
+    using Source = std::function<bool(Signal& block)>;
+
+    /** Приёмник: обработанный блок с номером index (с нуля) */
+    using Sink = std::function<void(size_t index, const Signal& block)>;
+
+    using Options = PipelinedExecutorOptions;
+
+    /**
+     * Метрики этапа за последний run()
+     */
+    struct StageMetrics {
+        std::string name;
+        size_t    blocks         = 0;
+        long long busyNs         = 0;   ///< В processInto (и приёмнике — у последнего)
+        long long inputStallNs   = 0;   ///< Ожидание входного блока
+        long long outputStallNs  = 0;   ///< Ожидание места в очереди следующего этапа
+        double    meanQueueDepth = 0;   ///< Средняя длина входной очереди при извлечении
+        size_t    maxQueueDepth  = 0;
+    };
+
+    /**
+     * @param stages Этапы по порядку (Pipeline тоже этап — так несколько
+     *               лёгких этапов делят один поток)
+     * @throws std::invalid_argument если этапов нет или среди них пустой
+     */
+    explicit PipelinedExecutor(std::vector<std::unique_ptr<SignalProcessor>> stages,
+                               Options options = Options());
+
+    PipelinedExecutor(const PipelinedExecutor&) = delete;
+    PipelinedExecutor& operator=(const PipelinedExecutor&) = delete;
+
+    /**
+     * Прогнать все блоки источника через конвейер
+     * @return Число обработанных блоков
+     */
+    size_t run(const Source& source, const Sink& sink);
+
+    /** Прогнать готовые блоки; результат — в том же порядке */
+    std::vector<Signal> run(const std::vector<Signal>& blocks);
+
+    size_t numStages() const { return stages_.size(); }
+
+    const std::vector<StageMetrics>& metrics() const { return metrics_; }
+
+    /** Ожидание источником места в первой очереди за последний run(), нс */
+    long long sourceStallNs() const { return sourceStallNs_; }
+
+    /** Длительность последнего run(), нс */
+    long long lastRunNs() const { return lastRunNs_; }
+
+private:
+    std::vector<std::unique_ptr<SignalProcessor>> stages_;
+    Options                                       options_;
+    std::vector<StageMetrics>                     metrics_;
+    long long                                     sourceStallNs_ = 0;
+    long long                                     lastRunNs_     = 0;
+};
+
+#endif // PIPELINED_EXECUTOR_H
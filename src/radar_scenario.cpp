@@ -0,0 +1,301 @@
+#include "radar_scenario.h"
+#include "utils/csv_writer.h"
+#include "utils/noise_engine.h"
+#include "utils/parallel.h"
+#include "utils/random.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <span>
+#include <stdexcept>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+/// Дискретов дальности в блоке генерации. Фиксирован, чтобы разбиение
+/// на потоки ГСЧ (и результат) не зависело от числа потоков.
+constexpr size_t kGatesPerBlock = 64;
+
+void validateConfig(const RadarScenarioConfig& c) {
+    if (c.numGates == 0 || c.numPulses < 2) {
+        throw std::invalid_argument("generateRadarScenario: нужно numGates ≥ 1 и numPulses ≥ 2");
+    }
+    if (c.targetAmplitudeMin > c.targetAmplitudeMax || c.nipAmplitudeMin > c.nipAmplitudeMax) {
+        throw std::invalid_argument("generateRadarScenario: минимальная амплитуда больше максимальной");
+    }
+    if (c.noiseStd < 0.0 || c.clutterSpread < 0.0 || c.nipRate < 0.0) {
+        throw std::invalid_argument("generateRadarScenario: отрицательное СКО или интенсивность НИП");
+    }
+    if (c.nipRate > 0.0 && c.nipMaxWidth == 0) {
+        throw std::invalid_argument("generateRadarScenario: nipMaxWidth должна быть ≥ 1");
+    }
+}
+
+Complex polar(double amplitude, double phase) {
+    return Complex(amplitude * std::cos(phase), amplitude * std::sin(phase));
+}
+
+/**
+ * Сгенерировать дискреты [g0, g1) куба. Все случайные величины блока берутся
+ * из его собственного потока rng.
+ */
+void generateBlock(RadarScenario& sc, size_t g0, size_t g1, Xoshiro256 rng) {
+    const RadarScenarioConfig& cfg = sc.config;
+    const size_t N     = cfg.numPulses;
+    const size_t gates = g1 - g0;
+    Complex* clean = sc.clean.data() + g0 * N;
+    Complex* noisy = sc.noisy.data() + g0 * N;
+
+    NoiseEngine noise(rng());
+
+    // ── Шум приёмника: I и Q подряд (complex<double> хранится как double[2]) ─
+    std::span<double> iq(reinterpret_cast<double*>(clean), 2 * gates * N);
+    if (cfg.noiseStd > 0.0) {
+        noise.fillGaussian(iq, 0.0, cfg.noiseStd);
+    } else {
+        std::fill(iq.begin(), iq.end(), 0.0);
+    }
+
+    // ── Местные предметы: доплер ~ N(0, spread²), амплитуда спадает с дальностью
+    if (cfg.clutterAmplitude > 0.0) {
+        std::vector<double> doppler(gates), phase(gates);
+        noise.fillGaussian(doppler, 0.0, cfg.clutterSpread);
+        noise.fillUniform(phase, 0.0, 2.0 * M_PI);
+
+        const double decayGates = cfg.clutterDecay * static_cast<double>(cfg.numGates);
+        for (size_t i = 0; i < gates; ++i) {
+            const double g   = static_cast<double>(g0 + i);
+            const double amp = decayGates > 0.0 ? cfg.clutterAmplitude * std::exp(-g / decayGates)
+                                                : cfg.clutterAmplitude;
+            Complex* burst = clean + i * N;
+            for (size_t n = 0; n < N; ++n) {
+                burst[n] += polar(amp, 2.0 * M_PI * doppler[i] * static_cast<double>(n) + phase[i]);
+            }
+        }
+    }
+
+    // ── Цели: отклик делится между двумя соседними дискретами ────────────────
+    for (const RadarTarget& t : sc.targets) {
+        for (size_t n = 0; n < N; ++n) {
+            const double dn = static_cast<double>(n);
+            const double r  = t.range + t.rangeRate * dn;
+            if (r < static_cast<double>(g0) - 1.0 || r >= static_cast<double>(g1)) continue;
+
+            const double lower = std::floor(r);
+            const double frac  = r - lower;
+            const double phase = t.phase + 2.0 * M_PI * (t.doppler * dn + 0.5 * t.dopplerRate * dn * dn);
+            const Complex s = polar(t.amplitude, phase);
+
+            const long long gl = static_cast<long long>(lower);
+            if (gl >= static_cast<long long>(g0) && gl < static_cast<long long>(g1)) {
+                clean[(static_cast<size_t>(gl) - g0) * N + n] += (1.0 - frac) * s;
+            }
+            if (gl + 1 >= static_cast<long long>(g0) && gl + 1 < static_cast<long long>(g1)) {
+                clean[(static_cast<size_t>(gl + 1) - g0) * N + n] += frac * s;
+            }
+        }
+    }
+
+    // ── НИП: своя случайная фаза в каждом поражённом дискрете ────────────────
+    std::copy(clean, clean + gates * N, noisy);
+    std::uniform_real_distribution<double> phaseDist(0.0, 2.0 * M_PI);
+    for (const NipEvent& e : sc.nipEvents) {
+        const size_t first = std::max(g0, e.firstGate);
+        const size_t last  = std::min(g1, e.firstGate + e.numGates);
+        for (size_t g = first; g < last; ++g) {
+            const size_t idx = g * N + e.pulse;
+            sc.noisy[idx]   += polar(e.amplitude, phaseDist(rng));
+            sc.nipMask[idx]  = 1;
+        }
+    }
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// RadarScenario
+// ─────────────────────────────────────────────────────────────────────────────
+
+ComplexSignal RadarScenario::burst(size_t gate, bool withNip) const {
+    if (gate >= numGates()) {
+        throw std::out_of_range("RadarScenario::burst: номер дискрета вне диапазона");
+    }
+    const CVector& cube = withNip ? noisy : clean;
+    const auto begin = cube.begin() + static_cast<std::ptrdiff_t>(gate * numPulses());
+    return ComplexSignal(begin, begin + static_cast<std::ptrdiff_t>(numPulses()));
+}
+
+bool RadarScenario::gateHasNip(size_t gate) const {
+    const auto begin = nipMask.begin() + static_cast<std::ptrdiff_t>(gate * numPulses());
+    return std::find(begin, begin + static_cast<std::ptrdiff_t>(numPulses()), 1) !=
+           begin + static_cast<std::ptrdiff_t>(numPulses());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Генерация
+// ─────────────────────────────────────────────────────────────────────────────
+
+RadarScenario generateRadarScenario(const RadarScenarioConfig& config) {
+    validateConfig(config);
+
+    RadarScenario sc;
+    sc.config = config;
+    const size_t G = config.numGates;
+    const size_t N = config.numPulses;
+
+    // ── Параметры целей и события НИП (последовательно, из основного потока) ─
+    Xoshiro256 rng(config.seed);
+    auto uniform = [&rng](double lo, double hi) {
+        return std::uniform_real_distribution<double>(lo, hi)(rng);
+    };
+
+    sc.targets.reserve(config.numTargets);
+    for (size_t i = 0; i < config.numTargets; ++i) {
+        RadarTarget t;
+        t.range       = uniform(0.0, static_cast<double>(G));
+        t.rangeRate   = uniform(-config.maxRangeRate, config.maxRangeRate);
+        t.doppler     = uniform(-0.5, 0.5);
+        t.dopplerRate = uniform(-config.maxDopplerRate, config.maxDopplerRate);
+        t.amplitude   = uniform(config.targetAmplitudeMin, config.targetAmplitudeMax);
+        t.phase       = uniform(0.0, 2.0 * M_PI);
+        sc.targets.push_back(t);
+    }
+
+    if (config.nipRate > 0.0) {
+        std::poisson_distribution<size_t> count(config.nipRate);
+        std::uniform_int_distribution<size_t> width(1, config.nipMaxWidth);
+        std::uniform_int_distribution<size_t> gate(0, G - 1);
+        for (size_t n = 0; n < N; ++n) {
+            for (size_t k = count(rng); k > 0; --k) {
+                NipEvent e;
+                e.pulse     = n;
+                e.firstGate = gate(rng);
+                e.numGates  = std::min(width(rng), G - e.firstGate);
+                e.amplitude = uniform(config.nipAmplitudeMin, config.nipAmplitudeMax);
+                sc.nipEvents.push_back(e);
+            }
+        }
+    }
+
+    // ── Куб: блоки дальности параллельно, у каждого свой jump-поток ──────────
+    sc.clean.resize(G * N);
+    sc.noisy.resize(G * N);
+    sc.nipMask.assign(G * N, 0);
+
+    const size_t numBlocks = (G + kGatesPerBlock - 1) / kGatesPerBlock;
+    const auto streams = Xoshiro256::streams(Xoshiro256(rng()), numBlocks);
+
+    parallelFor(numBlocks, config.numThreads, [&](size_t b) {
+        const size_t g0 = b * kGatesPerBlock;
+        generateBlock(sc, g0, std::min(G, g0 + kGatesPerBlock), streams[b]);
+    });
+
+    return sc;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Сохранение
+// ─────────────────────────────────────────────────────────────────────────────
+
+void saveRadarScenario(const RadarScenario& scenario, const std::string& directory,
+                       SampleType type) {
+    if (!isComplexSampleType(type)) {
+        throw std::invalid_argument("saveRadarScenario: нужен комплексный тип отсчётов");
+    }
+    std::filesystem::create_directories(directory);
+
+    const auto channels = static_cast<uint32_t>(scenario.numPulses());
+    for (const auto& [name, cube] : {std::pair{"clean", &scenario.clean},
+                                     std::pair{"noisy", &scenario.noisy}}) {
+        SignalFileWriter writer(directory + "/scenario_" + name + ".sig", type, channels);
+        writer.append(std::span<const Complex>(*cube));
+        writer.finalize();
+    }
+
+    // Разметка: одна строка на поражённую ячейку
+    {
+        CsvWriter csv(directory + "/scenario_nip.csv");
+        csv.writeText("Gate,Pulse,Amplitude\n");
+        for (const NipEvent& e : scenario.nipEvents) {
+            for (size_t g = e.firstGate; g < e.firstGate + e.numGates; ++g) {
+                csv.writeIndex(g).writeChar(',').writeIndex(e.pulse).writeChar(',')
+                   .writeDouble(e.amplitude).writeChar('\n');
+            }
+        }
+        csv.close();
+    }
+
+    {
+        CsvWriter csv(directory + "/scenario_targets.csv");
+        csv.writeText("Index,Range,RangeRate,Doppler,DopplerRate,Amplitude,Phase\n");
+        for (size_t i = 0; i < scenario.targets.size(); ++i) {
+            const RadarTarget& t = scenario.targets[i];
+            csv.writeIndex(i);
+            for (double v : {t.range, t.rangeRate, t.doppler, t.dopplerRate, t.amplitude, t.phase}) {
+                csv.writeChar(',').writeDouble(v);
+            }
+            csv.writeChar('\n');
+        }
+        csv.close();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Оценка обнаружителя
+// ─────────────────────────────────────────────────────────────────────────────
+
+NipDetectorEvaluation evaluateNipDetector(const RadarScenario& scenario,
+                                          const DopplerNipFilter& prototype,
+                                          size_t numThreads) {
+    const size_t G = scenario.numGates();
+    const size_t N = scenario.numPulses();
+    const size_t numBlocks = (G + kGatesPerBlock - 1) / kGatesPerBlock;
+
+    std::atomic<size_t> withNip{0}, detected{0}, correctPulse{0}, falseAlarms{0};
+
+    const auto start = std::chrono::steady_clock::now();
+    parallelFor(numBlocks, numThreads, [&](size_t b) {
+        DopplerNipFilter filter = prototype;
+        size_t localWithNip = 0, localDetected = 0, localCorrect = 0, localFalse = 0;
+
+        const size_t g1 = std::min(G, (b + 1) * kGatesPerBlock);
+        for (size_t g = b * kGatesPerBlock; g < g1; ++g) {
+            const NipDetectionResult& r = filter.detect(scenario.burst(g));
+            const bool hasNip = scenario.gateHasNip(g);
+            localWithNip += hasNip;
+            if (!r.detected) continue;
+
+            if (!hasNip) {
+                ++localFalse;
+                continue;
+            }
+            ++localDetected;
+            if (r.pulseIndex >= 0 && static_cast<size_t>(r.pulseIndex) < N &&
+                scenario.nipMask[g * N + static_cast<size_t>(r.pulseIndex)]) {
+                ++localCorrect;
+            }
+        }
+
+        withNip      += localWithNip;
+        detected     += localDetected;
+        correctPulse += localCorrect;
+        falseAlarms  += localFalse;
+    });
+    const auto end = std::chrono::steady_clock::now();
+
+    NipDetectorEvaluation ev;
+    ev.gates        = G;
+    ev.gatesWithNip = withNip;
+    ev.detected     = detected;
+    ev.correctPulse = correctPulse;
+    ev.falseAlarms  = falseAlarms;
+    ev.seconds      = std::chrono::duration<double>(end - start).count();
+    return ev;
+}
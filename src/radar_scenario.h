@@ -0,0 +1,143 @@
+#ifndef RADAR_SCENARIO_H
+#define RADAR_SCENARIO_H
+
+/**
+ * Генератор радиолокационных сценариев: куб дальность × импульс.
+ *
+ * Для каждого дискрета дальности g формируется пачка из N комплексных
+ * отсчётов (вход DopplerNipFilter):
+ *
+ *   x[g][n] = Σ_i s_i[g][n] + c[g][n] + η[g][n] + НИП[g][n]
+ *
+ *   s_i — цели с миграцией по дальности (r(n) = r₀ + ṙ·n, отклик делится
+ *         между двумя соседними дискретами) и по доплеру (f(n) = f₀ + ḟ·n);
+ *   c   — отражения от местных предметов: околонулевой доплер, амплитуда
+ *         спадает с дальностью;
+ *   η   — белый шум приёмника;
+ *   НИП — несинхронные импульсные помехи: в одном импульсе поражается
+ *         непрерывный участок дальности со случайной фазой в каждом дискрете.
+ *
+ * Разметка (какие ячейки (g, n) поражены НИП) сохраняется для оценки
+ * точности обнаружителя. Генерация параллельна по блокам дальности;
+ * у каждого блока свой поток ГСЧ, поэтому результат не зависит от числа
+ * потоков.
+ */
+
+#include "doppler_nip_filter.h"
+#include "utils/signal_file.h"
+
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Параметры сценария
+ */
+struct RadarScenarioConfig {
+    size_t   numGates           = 4096;     ///< Число дискретов дальности
+    size_t   numPulses          = 64;       ///< Число импульсов в пачке
+    size_t   numTargets         = 32;
+    double   targetAmplitudeMin = 0.3;
+    double   targetAmplitudeMax = 3.0;
+    double   maxRangeRate       = 0.05;     ///< |ṙ|, дискретов за импульс
+    double   maxDopplerRate     = 1e-3;     ///< |ḟ|, доля F_PRF за импульс
+    double   noiseStd           = 0.05;     ///< СКО шума (I и Q независимо)
+    double   clutterAmplitude   = 1.0;      ///< Амплитуда помехи у ближней границы (0 — без помехи)
+    double   clutterDecay       = 0.1;      ///< Доля дальности, на которой помеха ослабевает в e раз
+    double   clutterSpread      = 0.01;     ///< СКО доплеровской частоты помехи
+    double   nipRate            = 0.05;     ///< Среднее число НИП на импульс
+    size_t   nipMaxWidth        = 64;       ///< Максимальная протяжённость НИП, дискретов
+    double   nipAmplitudeMin    = 2.0;
+    double   nipAmplitudeMax    = 20.0;
+    uint64_t seed               = 1;
+    size_t   numThreads         = 0;        ///< 0 — по числу ядер
+};
+
+/**
+ * Цель
+ */
+struct RadarTarget {
+    double range;           ///< Дальность в первом импульсе, дискретов
+    double rangeRate;       ///< Миграция по дальности, дискретов за импульс
+    double doppler;         ///< Доплеровская частота в первом импульсе (доля F_PRF)
+    double dopplerRate;     ///< Изменение доплеровской частоты за импульс
+    double amplitude;
+    double phase;
+};
+
+/**
+ * Событие НИП: импульс pulse, дискреты [firstGate, firstGate + numGates)
+ */
+struct NipEvent {
+    size_t pulse;
+    size_t firstGate;
+    size_t numGates;
+    double amplitude;
+};
+
+/**
+ * Сгенерированный сценарий. Кубы хранятся по дискретам дальности:
+ * отсчёт (g, n) — элемент [g · numPulses + n], пачка дискрета непрерывна.
+ */
+struct RadarScenario {
+    RadarScenarioConfig      config;
+    std::vector<RadarTarget> targets;
+    std::vector<NipEvent>    nipEvents;
+    CVector                  clean;     ///< Цели + помеха + шум
+    CVector                  noisy;     ///< clean + НИП
+    std::vector<uint8_t>     nipMask;   ///< 1 — ячейка (g, n) поражена НИП
+
+    size_t numGates()  const { return config.numGates; }
+    size_t numPulses() const { return config.numPulses; }
+
+    /** Пачка дискрета дальности gate */
+    ComplexSignal burst(size_t gate, bool withNip = true) const;
+
+    /** Дискрет содержит хотя бы одну НИП */
+    bool gateHasNip(size_t gate) const;
+};
+
+/**
+ * Сгенерировать сценарий
+ * @throws std::invalid_argument при некорректных параметрах
+ */
+RadarScenario generateRadarScenario(const RadarScenarioConfig& config);
+
+/**
+ * Сохранить сценарий в директорию:
+ *   scenario_clean.sig, scenario_noisy.sig — кубы (кадр = дискрет дальности,
+ *                                            канал = импульс);
+ *   scenario_nip.csv                       — разметка "Gate,Pulse,Amplitude";
+ *   scenario_targets.csv                   — параметры целей.
+ */
+void saveRadarScenario(const RadarScenario& scenario, const std::string& directory,
+                       SampleType type = SampleType::COMPLEX64);
+
+/**
+ * Итоги прогона обнаружителя НИП по всем дискретам сценария
+ */
+struct NipDetectorEvaluation {
+    size_t gates         = 0;
+    size_t gatesWithNip  = 0;
+    size_t detected      = 0;   ///< Верно обнаружено (дискрет с НИП)
+    size_t correctPulse  = 0;   ///< Из них оценка m̂ совпала с поражённым импульсом
+    size_t falseAlarms   = 0;   ///< Обнаружение в дискрете без НИП
+    double seconds       = 0.0; ///< Время обработки
+
+    double detectionRate()  const { return gatesWithNip ? double(detected) / gatesWithNip : 0.0; }
+    double falseAlarmRate() const {
+        const size_t clean = gates - gatesWithNip;
+        return clean ? double(falseAlarms) / clean : 0.0;
+    }
+    double gatesPerSecond() const { return seconds > 0.0 ? gates / seconds : 0.0; }
+};
+
+/**
+ * Прогнать DopplerNipFilter (копию prototype в каждом потоке) по всем дискретам
+ */
+NipDetectorEvaluation evaluateNipDetector(const RadarScenario& scenario,
+                                          const DopplerNipFilter& prototype = DopplerNipFilter(),
+                                          size_t numThreads = 0);
+
+#endif // RADAR_SCENARIO_H
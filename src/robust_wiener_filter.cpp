@@ -2,6 +2,7 @@
 #include "utils/linear_system_solver.h"
 #include "utils/median.h"
 #include "utils/fft.h"
+#include "utils/trace.h"
 
 #include <stdexcept>
 #include <cmath>
@@ -79,6 +80,7 @@ std::vector<double> RobustWienerFilter::getWeights() const
 
 WienerParams RobustWienerFilter::estimateParameters(const std::vector<double>& signal)
 {
+    TRACE_SCOPE("RobustWienerFilter::estimateParameters");
     WienerParams p{};
     const size_t N = signal.size();
 
@@ -201,6 +203,7 @@ WienerParams RobustWienerFilter::estimateParameters(const std::vector<double>& s
 
 SignalProcessor::Signal RobustWienerFilter::process(const Signal& input)
 {
+    TRACE_SCOPE("RobustWienerFilter::process");
     const size_t N = input.size();
     if (N == 0)
         return Signal();
@@ -233,6 +236,7 @@ SignalProcessor::Signal RobustWienerFilter::process(const Signal& input)
     // сглаживать остаточный гауссов шум.
     // Граничное условие: при n < i используется 0.0 (нулевое дополнение),
     // а не input[0], как в классической реализации (артефакт).
+    TRACE_SCOPE("RobustWienerFilter::fir");
     Signal output(N, 0.0);
     for (size_t n = 0; n < N; ++n) {
         double y = 0.0;
@@ -254,6 +258,7 @@ SignalProcessor::Signal RobustWienerFilter::process(const Signal& input)
 
 SignalProcessor::Signal RobustWienerFilter::removeImpulses(const Signal& x) const
 {
+    TRACE_SCOPE("RobustWienerFilter::removeImpulses");
     OutlierDetection detector(
         OutlierDetection::DetectionMethod::MAD_BASED,
         OutlierDetection::InterpolationMethod::MEDIAN_BASED,
@@ -271,6 +276,7 @@ SignalProcessor::Signal RobustWienerFilter::removeImpulses(const Signal& x) cons
 
 SignalProcessor::Signal RobustWienerFilter::estimateDesiredMedian(const Signal& x) const
 {
+    TRACE_SCOPE("RobustWienerFilter::estimateDesiredMedian");
     const size_t N    = x.size();
     const size_t half = desiredWindow_ / 2;
     Signal d(N, 0.0);
@@ -296,6 +302,7 @@ SignalProcessor::Signal RobustWienerFilter::estimateDesiredMedian(const Signal&
 ublas::matrix<double>
 RobustWienerFilter::buildCorrelationMatrix(const Signal& xc) const
 {
+    TRACE_SCOPE("RobustWienerFilter::buildCorrelationMatrix");
     const size_t N = xc.size();
     const size_t M = filterOrder_;
 
@@ -304,9 +311,12 @@ RobustWienerFilter::buildCorrelationMatrix(const Signal& xc) const
     const size_t start = (N > M) ? (M - 1) : 0;
     const size_t K     = (N > start) ? (N - start) : 1;
 
+    // При N ≤ M суммирование идёт с n = 0: недоступные задержки x[n-i], n < i,
+    // считаются нулевыми
     for (size_t n = start; n < N; ++n) {
-        for (size_t i = 0; i < M; ++i) {
-            for (size_t j = 0; j < M; ++j) {
+        const size_t lags = std::min(M, n + 1);
+        for (size_t i = 0; i < lags; ++i) {
+            for (size_t j = 0; j < lags; ++j) {
                 R(i, j) += xc[n - i] * xc[n - j];
             }
         }
@@ -328,6 +338,7 @@ ublas::vector<double>
 RobustWienerFilter::buildCrossCorrelationVector(const Signal& xc,
                                                  const Signal& d) const
 {
+    TRACE_SCOPE("RobustWienerFilter::buildCrossCorrelationVector");
     const size_t N = xc.size();
     const size_t M = filterOrder_;
 
@@ -337,7 +348,8 @@ RobustWienerFilter::buildCrossCorrelationVector(const Signal& xc,
     const size_t K     = (N > start) ? (N - start) : 1;
 
     for (size_t n = start; n < N; ++n) {
-        for (size_t i = 0; i < M; ++i) {
+        const size_t lags = std::min(M, n + 1);
+        for (size_t i = 0; i < lags; ++i) {
             p(i) += d[n] * xc[n - i];
         }
     }
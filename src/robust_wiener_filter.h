@@ -86,6 +86,14 @@ public:
      */
     std::string getName() const override;
 
+    /** Независимая копия фильтра */
+    std::unique_ptr<SignalProcessor> clone() const override {
+        return std::make_unique<RobustWienerFilter>(*this);
+    }
+
+    /** Порядок фильтра M */
+    size_t getWindowSize() const override { return filterOrder_; }
+
     /**
      * Установить параметры
      */
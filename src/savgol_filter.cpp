@@ -1,4 +1,5 @@
 #include "savgol_filter.h"
+#include "utils/trace.h"
 #include <algorithm>
 #include <stdexcept>
 #include <cmath>
@@ -17,6 +18,7 @@ SavgolFilter::SavgolFilter(size_t windowSize, size_t polyOrder)
 }
 
 SignalProcessor::Signal SavgolFilter::process(const Signal& input) {
+    TRACE_SCOPE("SavgolFilter::process");
     if (input.empty()) {
         return Signal();
     }
@@ -50,6 +52,7 @@ void SavgolFilter::setParameters(size_t windowSize, size_t polyOrder) {
 }
 
 void SavgolFilter::calculateCoefficients() {
+    TRACE_SCOPE("SavgolFilter::calculateCoefficients");
     // Создаем систему уравнений для метода наименьших квадратов
     size_t halfWindow = windowSize_ / 2;
 
@@ -155,17 +158,19 @@ double SavgolFilter::applyFilter(const Signal& input, size_t centerIndex) const
 }
 
 double SavgolFilter::getReflectedValue(const Signal& input, int index) const {
-    if (index < 0) {
-        // Отражение в начале сигнала
-        return input[-index];
-    } else if (index >= static_cast<int>(input.size())) {
-        // Отражение в конце сигнала
-        int reflectedIndex = 2 * static_cast<int>(input.size()) - 2 - index;
-        if (reflectedIndex < 0) {
-            return input[0]; // Если всё равно выходим за границы, берем первое значение
-        }
-        return input[reflectedIndex];
-    } else {
+    const int n = static_cast<int>(input.size());
+    if (index >= 0 && index < n) {
         return input[index];
     }
+    if (n == 1) {
+        return input[0];
+    }
+
+    // Зеркальное отражение без повтора крайнего отсчёта (x[-k] = x[k],
+    // x[N-1+k] = x[N-1-k]); для окна длиннее сигнала отражение повторяется
+    // с периодом 2(N-1)
+    const int period = 2 * (n - 1);
+    int folded = index % period;
+    if (folded < 0) folded += period;
+    return input[folded < n ? folded : period - folded];
 }
\ No newline at end of file
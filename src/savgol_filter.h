@@ -33,6 +33,11 @@ public:
      */
     std::string getName() const override;
 
+    /** Независимая копия фильтра */
+    std::unique_ptr<SignalProcessor> clone() const override {
+        return std::make_unique<SavgolFilter>(*this);
+    }
+
     /**
      * Установить параметры фильтра
      * @param windowSize Новый размер окна
@@ -43,7 +48,10 @@ public:
     /**
      * Получить текущий размер окна
      */
-    size_t getWindowSize() const { return windowSize_; }
+    size_t getWindowSize() const override { return windowSize_; }
+
+    /** Половина окна: края — зеркальным отражением */
+    size_t getReach() const override { return windowSize_ / 2; }
 
     /**
      * Получить текущий порядок полинома
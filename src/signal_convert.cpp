@@ -0,0 +1,226 @@
+/**
+ * signal_convert — преобразование сигналов между CSV, бинарным контейнером .sig
+ * и архивом .sga
+ *
+ * Запуск:
+ *   ./build/signal_convert [--float32] INPUT OUTPUT
+ *
+ * Направление определяется по расширению INPUT:
+ *   *.csv → *.sig,  *.sig → *.csv
+ * Если INPUT — директория, преобразуются все .csv (или .sig) файлы в ней,
+ * результаты пишутся в директорию OUTPUT с теми же именами.
+ *
+ * Формат CSV определяется по первой строке: заголовок "Index,Value" —
+ * вещественный сигнал, иначе — комплексная пачка "Re,Im" (data/radar).
+ *
+ * Архивы (.sga):
+ *   ./build/signal_convert --pack ARCHIVE DIR...   # data/clean data/noisy → один файл
+ *   ./build/signal_convert --unpack ARCHIVE OUTDIR
+ * При упаковке имя сигнала — "<имя директории>/<имя файла без расширения>".
+ */
+
+#include "utils/signal_file.h"
+#include "utils/signal_archive.h"
+#include "utils/csv_reader.h"
+#include "utils/csv_writer.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static void printUsage(const char* prog) {
+    std::cout << "Использование: " << prog << " [опции] INPUT OUTPUT\n\n"
+              << "Опции:\n"
+              << "  -h, --help     Показать эту справку\n"
+              << "  --float32      Хранить отсчёты как float32 / complex64 (по умолчанию float64)\n"
+              << "  --pack         Упаковать директории в архив: --pack ARCHIVE DIR...\n"
+              << "  --unpack       Распаковать архив в CSV: --unpack ARCHIVE OUTDIR\n"
+              << "  --no-compress  Не сжимать блоки архива\n"
+              << "\nПримеры:\n"
+              << "  " << prog << " data/noisy/signal_0.csv data/noisy/signal_0.sig\n"
+              << "  " << prog << " data/clean data/clean          # все CSV → .sig рядом\n"
+              << "  " << prog << " data/radar/burst_00_noisy.sig burst.csv\n"
+              << "  " << prog << " --pack data/dataset.sga data/clean data/noisy\n";
+}
+
+/// CSV в формате "Re,Im" (без заголовка "Index,Value")
+static bool isComplexCSV(const std::string& path) {
+    std::ifstream in(path);
+    std::string first;
+    std::getline(in, first);
+    return first.rfind("Index", 0) != 0;
+}
+
+static void convertFile(const fs::path& in, const fs::path& out, bool useFloat32) {
+    if (in.extension() == ".csv") {
+        const bool complex = isComplexCSV(in.string());
+        SampleType type = complex
+            ? (useFloat32 ? SampleType::COMPLEX64 : SampleType::COMPLEX128)
+            : (useFloat32 ? SampleType::FLOAT32   : SampleType::FLOAT64);
+        convertCSVToBinary(in.string(), out.string(), complex, type);
+    } else if (in.extension() == kSignalFileExtension) {
+        convertBinaryToCSV(in.string(), out.string());
+    } else {
+        throw std::runtime_error("неизвестное расширение: " + in.string());
+    }
+
+    std::cout << "  " << in.string() << " -> " << out.string()
+              << " (" << fs::file_size(in) << " -> " << fs::file_size(out) << " байт)\n";
+}
+
+static int packArchive(const std::vector<std::string>& args, bool useFloat32, bool compress) {
+    SignalArchiveWriter::Options options;
+    options.codec       = compress ? ChunkCodec::SHUFFLE_ZLIB : ChunkCodec::RAW;
+    options.realType    = useFloat32 ? SampleType::FLOAT32   : SampleType::FLOAT64;
+    options.complexType = useFloat32 ? SampleType::COMPLEX64 : SampleType::COMPLEX128;
+
+    SignalArchiveWriter writer(args[0], options);
+    size_t count = 0;
+    uintmax_t inputBytes = 0;
+
+    for (size_t d = 1; d < args.size(); ++d) {
+        const fs::path dir(args[d]);
+        const std::string prefix = fs::path(dir).lexically_normal().filename().string();
+
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            const auto ext = entry.path().extension();
+            if (entry.is_regular_file() && (ext == ".csv" || ext == kSignalFileExtension))
+                files.push_back(entry.path());
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const auto& f : files) {
+            const std::string name = prefix + "/" + f.stem().string();
+            bool complex = false;
+            if (f.extension() == ".csv") {
+                complex = isComplexCSV(f.string());
+            } else {
+                complex = isComplexSampleType(SignalFile(f.string()).sampleType());
+            }
+
+            if (complex) {
+                writer.add(name, f.extension() == ".csv" ? readComplexCSV(f.string())
+                                                         : loadComplexSignalBinary(f.string()));
+            } else {
+                writer.add(name, f.extension() == ".csv" ? readSignalCSV(f.string())
+                                                         : loadSignalBinary(f.string()));
+            }
+            inputBytes += fs::file_size(f);
+            ++count;
+        }
+    }
+    writer.finalize();
+
+    std::cout << "Упаковано сигналов: " << count << " (" << inputBytes << " -> "
+              << fs::file_size(args[0]) << " байт) в " << args[0] << "\n";
+    return 0;
+}
+
+static int unpackArchive(const std::vector<std::string>& args) {
+    SignalArchive archive(args[0]);
+    const fs::path outDir(args[1]);
+
+    for (size_t i = 0; i < archive.size(); ++i) {
+        fs::path target = outDir / (archive.name(i) + ".csv");
+        fs::create_directories(target.parent_path());
+
+        if (isComplexSampleType(archive.sampleType(i))) {
+            writeComplexCSV(target.string(), archive.readComplex(i), 8);
+        } else {
+            writeSignalCSV(target.string(), archive.read(i));
+        }
+    }
+
+    std::cout << "Распаковано сигналов: " << archive.size() << " в " << outDir.string() << "\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    bool useFloat32 = false;
+    bool compress   = true;
+    enum class Mode { CONVERT, PACK, UNPACK } mode = Mode::CONVERT;
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "-h" || a == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (a == "--float32") {
+            useFloat32 = true;
+        } else if (a == "--no-compress") {
+            compress = false;
+        } else if (a == "--pack") {
+            mode = Mode::PACK;
+        } else if (a == "--unpack") {
+            mode = Mode::UNPACK;
+        } else {
+            positional.push_back(a);
+        }
+    }
+
+    if (mode != Mode::CONVERT) {
+        if (positional.size() < 2 || (mode == Mode::UNPACK && positional.size() != 2)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        try {
+            return mode == Mode::PACK ? packArchive(positional, useFloat32, compress)
+                                      : unpackArchive(positional);
+        } catch (const std::exception& e) {
+            std::cerr << "Ошибка: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    if (positional.size() != 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const fs::path input(positional[0]);
+    const fs::path output(positional[1]);
+
+    try {
+        if (!fs::is_directory(input)) {
+            if (output.has_parent_path())
+                fs::create_directories(output.parent_path());
+            convertFile(input, output, useFloat32);
+            return 0;
+        }
+
+        // Директория: CSV → .sig, если CSV есть; иначе .sig → CSV
+        std::vector<fs::path> csv, sig;
+        for (const auto& entry : fs::directory_iterator(input)) {
+            if (!entry.is_regular_file()) continue;
+            if (entry.path().extension() == ".csv") csv.push_back(entry.path());
+            else if (entry.path().extension() == kSignalFileExtension) sig.push_back(entry.path());
+        }
+
+        const bool toBinary = !csv.empty();
+        const auto& files = toBinary ? csv : sig;
+        if (files.empty()) {
+            std::cerr << "Нет файлов .csv или .sig в " << input.string() << "\n";
+            return 1;
+        }
+
+        fs::create_directories(output);
+        for (const auto& f : files) {
+            fs::path target = output / f.filename();
+            target.replace_extension(toBinary ? kSignalFileExtension : ".csv");
+            convertFile(f, target, useFloat32);
+        }
+        std::cout << "Преобразовано файлов: " << files.size() << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,13 +1,19 @@
 #include "signal_generator.h"
+#include "utils/csv_reader.h"
+#include "utils/csv_writer.h"
+#include "utils/signal_file.h"
+#include "utils/parallel.h"
+#include "utils/noise_engine.h"
 #include <cmath>
-#include <fstream>
-#include <sstream>
 #include <iostream>
 #include <stdexcept>
 
 SignalGenerator::SignalGenerator(unsigned int seed) : rng_(seed) {
 }
 
+SignalGenerator::SignalGenerator(const Xoshiro256& engine) : rng_(engine) {
+}
+
 SignalProcessor::Signal SignalGenerator::generateBasicSignal(SignalType type,
                                                              size_t length,
                                                              double amplitude,
@@ -79,22 +85,15 @@ SignalProcessor::Signal SignalGenerator::generateImpulseNoise(size_t length,
     switch (type) {
         case NoiseType::IMPULSE: {
             // Одиночные импульсы
-            for (size_t i = 0; i < length; ++i) {
-                if (uniform(rng_) < density) {
-                    noise[i] = amplitude * (uniform(rng_) > 0.5 ? 1.0 : -1.0);
-                }
-            }
+            NoiseEngine engine(rng_());
+            engine.addImpulses(noise, density, amplitude, amplitude);
             break;
         }
 
         case NoiseType::RANDOM_SPIKES: {
             // Случайные выбросы с различной амплитудой
-            for (size_t i = 0; i < length; ++i) {
-                if (uniform(rng_) < density) {
-                    double randomAmplitude = amplitude * (0.5 + 0.5 * uniform(rng_));
-                    noise[i] = randomAmplitude * (uniform(rng_) > 0.5 ? 1.0 : -1.0);
-                }
-            }
+            NoiseEngine engine(rng_());
+            engine.addImpulses(noise, density, 0.5 * amplitude, amplitude);
             break;
         }
 
@@ -147,87 +146,81 @@ SignalProcessor::Signal SignalGenerator::addImpulseNoise(const Signal& signal,
 }
 
 SignalProcessor::Signal SignalGenerator::generateWhiteNoise(size_t length, double variance) const {
-    Signal noise;
-    noise.reserve(length);
-
-    std::normal_distribution<double> normal(0.0, std::sqrt(variance));
-
-    for (size_t i = 0; i < length; ++i) {
-        noise.push_back(normal(rng_));
-    }
-
+    Signal noise(length);
+    NoiseEngine engine(rng_());
+    engine.fillGaussian(noise, 0.0, std::sqrt(variance));
     return noise;
 }
 
 std::vector<std::pair<SignalProcessor::Signal, SignalProcessor::Signal>>
-SignalGenerator::generateTestDataset(size_t signalLength, size_t numSignals, double frequencyScale) const {
+SignalGenerator::generateTestDataset(size_t signalLength, size_t numSignals, double frequencyScale,
+                                     size_t numThreads) const {
+    // Один вызов основного ГСЧ задаёт набор; сигнал i получает i-й поток
+    const auto streams = Xoshiro256::streams(Xoshiro256(rng_()), numSignals);
 
-    std::vector<std::pair<Signal, Signal>> dataset;
-    dataset.reserve(numSignals);
+    std::vector<std::pair<Signal, Signal>> dataset(numSignals);
+    parallelFor(numSignals, numThreads, [&](size_t i) {
+        dataset[i] = SignalGenerator(streams[i]).generateDatasetPair(i, signalLength, frequencyScale);
+    });
 
+    return dataset;
+}
+
+std::pair<SignalProcessor::Signal, SignalProcessor::Signal>
+SignalGenerator::generateDatasetPair(size_t index, size_t signalLength, double frequencyScale) const {
     // Различные типы основных сигналов
-    std::vector<SignalType> signalTypes;
-    signalTypes.push_back(SignalType::SINE);
-    signalTypes.push_back(SignalType::SQUARE);
-    signalTypes.push_back(SignalType::TRIANGLE);
-    signalTypes.push_back(SignalType::SAWTOOTH);
+    static constexpr SignalType signalTypes[] = {
+        SignalType::SINE, SignalType::SQUARE, SignalType::TRIANGLE, SignalType::SAWTOOTH
+    };
 
     // Различные типы эхо сигналов (для разнообразия)
-    std::vector<EchoType> echoTypes;
-    echoTypes.push_back(EchoType::RECTANGULAR);
-    echoTypes.push_back(EchoType::TRIANGULAR);
-    echoTypes.push_back(EchoType::GAUSSIAN);
-    echoTypes.push_back(EchoType::EXPONENTIAL);
-    echoTypes.push_back(EchoType::CHIRP);
+    static constexpr EchoType echoTypes[] = {
+        EchoType::RECTANGULAR, EchoType::TRIANGULAR, EchoType::GAUSSIAN,
+        EchoType::EXPONENTIAL, EchoType::CHIRP
+    };
 
     // Различные типы помех
-    std::vector<NoiseType> noiseTypes;
-    noiseTypes.push_back(NoiseType::IMPULSE);
-    noiseTypes.push_back(NoiseType::RANDOM_SPIKES);
-    noiseTypes.push_back(NoiseType::BURST);
-    noiseTypes.push_back(NoiseType::PERIODIC);
+    static constexpr NoiseType noiseTypes[] = {
+        NoiseType::IMPULSE, NoiseType::RANDOM_SPIKES, NoiseType::BURST, NoiseType::PERIODIC
+    };
 
+    constexpr size_t numSignalTypes = std::size(signalTypes);
     std::uniform_real_distribution<double> uniform(0.0, 1.0);
-
-    for (size_t i = 0; i < numSignals; ++i) {
-        Signal cleanSignal;
-
-        // Генерируем половину сигналов как основные типы, половину как эхо-сигналы
-        if (i % 2 == 0 && i / 2 < signalTypes.size()) {
-            // Основные сигналы
-            SignalType signalType = signalTypes[(i / 2) % signalTypes.size()];
-            double amplitude = 0.5 + 0.5 * uniform(rng_);
-            // Применяем масштабирование частоты (по умолчанию в 20 раз меньше)
-            double baseFreq = 0.05 + 0.15 * uniform(rng_); // Базовая частота от 0.05 до 0.2
-            double frequency = baseFreq * frequencyScale;
-            double phase = 2.0 * M_PI * uniform(rng_);
-            double dutyCycle = 0.3 + 0.4 * uniform(rng_); // Для квадратного сигнала
-
-            cleanSignal = generateBasicSignal(signalType, signalLength, amplitude,
-                                            frequency, phase, dutyCycle);
-        } else {
-            // Эхо сигналы (как было раньше)
-            EchoType echoType = echoTypes[i % echoTypes.size()];
-            double amplitude = 0.5 + 0.5 * uniform(rng_);
-            size_t echoDelay = 50 + static_cast<size_t>(100 * uniform(rng_));
-            double echoAttenuation = 0.3 + 0.4 * uniform(rng_);
-            double noiseLevel = 0.01 + 0.04 * uniform(rng_);
-
-            cleanSignal = generateEchoSignal(echoType, signalLength, amplitude,
-                                           echoDelay, echoAttenuation, noiseLevel);
-        }
-
-        // Добавляем импульсные помехи
-        NoiseType noiseType = noiseTypes[i % noiseTypes.size()];
-        double noiseDensity = 0.005 + 0.02 * uniform(rng_);
-        double noiseAmplitude = 1.0 + 2.0 * uniform(rng_);
-
-        Signal noisySignal = addImpulseNoise(cleanSignal, noiseType, noiseDensity, noiseAmplitude);
-
-        dataset.emplace_back(cleanSignal, noisySignal);
-    }
-
-    return dataset;
+    Signal cleanSignal;
+
+    // Генерируем половину сигналов как основные типы, половину как эхо-сигналы
+    if (index % 2 == 0 && index / 2 < numSignalTypes) {
+        // Основные сигналы
+        SignalType signalType = signalTypes[(index / 2) % numSignalTypes];
+        double amplitude = 0.5 + 0.5 * uniform(rng_);
+        // Применяем масштабирование частоты (по умолчанию в 20 раз меньше)
+        double baseFreq = 0.05 + 0.15 * uniform(rng_); // Базовая частота от 0.05 до 0.2
+        double frequency = baseFreq * frequencyScale;
+        double phase = 2.0 * M_PI * uniform(rng_);
+        double dutyCycle = 0.3 + 0.4 * uniform(rng_); // Для квадратного сигнала
+
+        cleanSignal = generateBasicSignal(signalType, signalLength, amplitude,
+                                          frequency, phase, dutyCycle);
+    } else {
+        // Эхо сигналы (как было раньше)
+        EchoType echoType = echoTypes[index % std::size(echoTypes)];
+        double amplitude = 0.5 + 0.5 * uniform(rng_);
+        size_t echoDelay = 50 + static_cast<size_t>(100 * uniform(rng_));
+        double echoAttenuation = 0.3 + 0.4 * uniform(rng_);
+        double noiseLevel = 0.01 + 0.04 * uniform(rng_);
+
+        cleanSignal = generateEchoSignal(echoType, signalLength, amplitude,
+                                         echoDelay, echoAttenuation, noiseLevel);
+    }
+
+    // Добавляем импульсные помехи
+    NoiseType noiseType = noiseTypes[index % std::size(noiseTypes)];
+    double noiseDensity = 0.005 + 0.02 * uniform(rng_);
+    double noiseAmplitude = 1.0 + 2.0 * uniform(rng_);
+
+    Signal noisySignal = addImpulseNoise(cleanSignal, noiseType, noiseDensity, noiseAmplitude);
+
+    return {std::move(cleanSignal), std::move(noisySignal)};
 }
 
 SignalProcessor::Signal SignalGenerator::generatePulse(EchoType type, size_t length, double amplitude) const {
@@ -252,150 +245,147 @@ SignalProcessor::Signal SignalGenerator::generateRectangularPulse(size_t length,
 }
 
 SignalProcessor::Signal SignalGenerator::generateTriangularPulse(size_t length, double amplitude) const {
-    Signal pulse;
-    pulse.reserve(length);
-
-    size_t halfLength = length / 2;
-
-    // Восходящая часть
-    for (size_t i = 0; i < halfLength; ++i) {
-        pulse.push_back(amplitude * static_cast<double>(i) / halfLength);
-    }
-
-    // Нисходящая часть
-    for (size_t i = halfLength; i < length; ++i) {
-        pulse.push_back(amplitude * static_cast<double>(length - 1 - i) / (length - halfLength));
+    Signal pulse(length);
+    for (size_t i = 0; i < length; ++i) {
+        pulse[i] = pulseSample(EchoType::TRIANGULAR, i, length, amplitude);
     }
-
     return pulse;
 }
 
 SignalProcessor::Signal SignalGenerator::generateGaussianPulse(size_t length, double amplitude) const {
-    Signal pulse;
-    pulse.reserve(length);
-
-    double sigma = static_cast<double>(length) / 6.0; // 3-sigma правило
-    double center = static_cast<double>(length - 1) / 2.0;
-
+    Signal pulse(length);
     for (size_t i = 0; i < length; ++i) {
-        double x = static_cast<double>(i) - center;
-        double value = amplitude * std::exp(-0.5 * (x * x) / (sigma * sigma));
-        pulse.push_back(value);
+        pulse[i] = pulseSample(EchoType::GAUSSIAN, i, length, amplitude);
     }
-
     return pulse;
 }
 
 SignalProcessor::Signal SignalGenerator::generateExponentialPulse(size_t length, double amplitude) const {
-    Signal pulse;
-    pulse.reserve(length);
-
-    double tau = static_cast<double>(length) / 3.0; // Постоянная времени
-
+    Signal pulse(length);
     for (size_t i = 0; i < length; ++i) {
-        double x = static_cast<double>(i);
-        double value = amplitude * std::exp(-x / tau);
-        pulse.push_back(value);
+        pulse[i] = pulseSample(EchoType::EXPONENTIAL, i, length, amplitude);
     }
-
     return pulse;
 }
 
 SignalProcessor::Signal SignalGenerator::generateChirpPulse(size_t length, double amplitude) const {
-    Signal pulse;
-    pulse.reserve(length);
+    Signal pulse(length);
+    for (size_t i = 0; i < length; ++i) {
+        pulse[i] = pulseSample(EchoType::CHIRP, i, length, amplitude);
+    }
+    return pulse;
+}
+
+double SignalGenerator::pulseSample(EchoType type, size_t i, size_t length, double amplitude) {
+    switch (type) {
+        case EchoType::TRIANGULAR: {
+            size_t halfLength = length / 2;
+            if (i < halfLength) {
+                // Восходящая часть
+                return amplitude * static_cast<double>(i) / halfLength;
+            }
+            // Нисходящая часть
+            return amplitude * static_cast<double>(length - 1 - i) / (length - halfLength);
+        }
+
+        case EchoType::GAUSSIAN: {
+            double sigma = static_cast<double>(length) / 6.0; // 3-sigma правило
+            double center = static_cast<double>(length - 1) / 2.0;
+            double x = static_cast<double>(i) - center;
+            return amplitude * std::exp(-0.5 * (x * x) / (sigma * sigma));
+        }
 
-    // ЛЧМ импульс с линейно изменяющейся частотой
-    double f0 = 0.1;  // Начальная частота (нормированная)
-    double f1 = 0.5;  // Конечная частота
-    double beta = (f1 - f0) / static_cast<double>(length);
+        case EchoType::EXPONENTIAL: {
+            double tau = static_cast<double>(length) / 3.0; // Постоянная времени
+            double x = static_cast<double>(i);
+            return amplitude * std::exp(-x / tau);
+        }
 
-    for (size_t i = 0; i < length; ++i) {
-        double t = static_cast<double>(i);
-        double instantFreq = f0 + beta * t;
-        double phase = 2.0 * M_PI * (f0 * t + 0.5 * beta * t * t);
+        case EchoType::CHIRP: {
+            // ЛЧМ импульс с линейно изменяющейся частотой
+            double f0 = 0.1;  // Начальная частота (нормированная)
+            double f1 = 0.5;  // Конечная частота
+            double beta = (f1 - f0) / static_cast<double>(length);
 
-        // Применяем оконную функцию Ханна для сглаживания краев
-        double window = 0.5 * (1.0 - std::cos(2.0 * M_PI * i / (length - 1)));
-        double value = amplitude * window * std::sin(phase);
+            double t = static_cast<double>(i);
+            double phase = 2.0 * M_PI * (f0 * t + 0.5 * beta * t * t);
 
-        pulse.push_back(value);
+            // Применяем оконную функцию Ханна для сглаживания краев
+            double window = 0.5 * (1.0 - std::cos(2.0 * M_PI * i / (length - 1)));
+            return amplitude * window * std::sin(phase);
+        }
+
+        case EchoType::RECTANGULAR:
+        default:
+            return amplitude;
     }
+}
 
-    return pulse;
+double SignalGenerator::basicSignalSample(SignalType type, double t, double amplitude,
+                                          double frequency, double phase, double dutyCycle) {
+    if (type != SignalType::SQUARE && type != SignalType::TRIANGLE && type != SignalType::SAWTOOTH) {
+        return amplitude * std::sin(2.0 * M_PI * frequency * t + phase);
+    }
+
+    double phase_t = std::fmod(2.0 * M_PI * frequency * t + phase, 2.0 * M_PI);
+    if (phase_t < 0) phase_t += 2.0 * M_PI;
+
+    switch (type) {
+        case SignalType::SQUARE:
+            return (phase_t < 2.0 * M_PI * dutyCycle) ? amplitude : -amplitude;
+
+        case SignalType::TRIANGLE:
+            if (phase_t < M_PI) {
+                // Восходящая часть: от -amplitude до +amplitude
+                return amplitude * (2.0 * phase_t / M_PI - 1.0);
+            }
+            // Нисходящая часть: от +amplitude до -amplitude
+            return amplitude * (3.0 - 2.0 * phase_t / M_PI);
+
+        default:
+            // Линейно возрастающий сигнал от -amplitude до +amplitude
+            return amplitude * (2.0 * phase_t / (2.0 * M_PI) - 1.0);
+    }
 }
 
 SignalProcessor::Signal SignalGenerator::generateSineSignal(size_t length, double amplitude,
                                                             double frequency, double phase) const {
-    Signal signal;
-    signal.reserve(length);
-
+    Signal signal(length);
     for (size_t i = 0; i < length; ++i) {
-        double t = static_cast<double>(i);
-        double value = amplitude * std::sin(2.0 * M_PI * frequency * t + phase);
-        signal.push_back(value);
+        signal[i] = basicSignalSample(SignalType::SINE, static_cast<double>(i),
+                                      amplitude, frequency, phase, 0.5);
     }
-
     return signal;
 }
 
 SignalProcessor::Signal SignalGenerator::generateSquareSignal(size_t length, double amplitude,
                                                               double frequency, double phase,
                                                               double dutyCycle) const {
-    Signal signal;
-    signal.reserve(length);
-
+    Signal signal(length);
     for (size_t i = 0; i < length; ++i) {
-        double t = static_cast<double>(i);
-        double phase_t = std::fmod(2.0 * M_PI * frequency * t + phase, 2.0 * M_PI);
-        if (phase_t < 0) phase_t += 2.0 * M_PI;
-
-        double value = (phase_t < 2.0 * M_PI * dutyCycle) ? amplitude : -amplitude;
-        signal.push_back(value);
+        signal[i] = basicSignalSample(SignalType::SQUARE, static_cast<double>(i),
+                                      amplitude, frequency, phase, dutyCycle);
     }
-
     return signal;
 }
 
 SignalProcessor::Signal SignalGenerator::generateTriangleSignal(size_t length, double amplitude,
                                                                 double frequency, double phase) const {
-    Signal signal;
-    signal.reserve(length);
-
+    Signal signal(length);
     for (size_t i = 0; i < length; ++i) {
-        double t = static_cast<double>(i);
-        double phase_t = std::fmod(2.0 * M_PI * frequency * t + phase, 2.0 * M_PI);
-        if (phase_t < 0) phase_t += 2.0 * M_PI;
-
-        double value;
-        if (phase_t < M_PI) {
-            // Восходящая часть: от -amplitude до +amplitude
-            value = amplitude * (2.0 * phase_t / M_PI - 1.0);
-        } else {
-            // Нисходящая часть: от +amplitude до -amplitude
-            value = amplitude * (3.0 - 2.0 * phase_t / M_PI);
-        }
-        signal.push_back(value);
+        signal[i] = basicSignalSample(SignalType::TRIANGLE, static_cast<double>(i),
+                                      amplitude, frequency, phase, 0.5);
     }
-
     return signal;
 }
 
 SignalProcessor::Signal SignalGenerator::generateSawtoothSignal(size_t length, double amplitude,
                                                                 double frequency, double phase) const {
-    Signal signal;
-    signal.reserve(length);
-
+    Signal signal(length);
     for (size_t i = 0; i < length; ++i) {
-        double t = static_cast<double>(i);
-        double phase_t = std::fmod(2.0 * M_PI * frequency * t + phase, 2.0 * M_PI);
-        if (phase_t < 0) phase_t += 2.0 * M_PI;
-
-        // Линейно возрастающий сигнал от -amplitude до +amplitude
-        double value = amplitude * (2.0 * phase_t / (2.0 * M_PI) - 1.0);
-        signal.push_back(value);
+        signal[i] = basicSignalSample(SignalType::SAWTOOTH, static_cast<double>(i),
+                                      amplitude, frequency, phase, 0.5);
     }
-
     return signal;
 }
 
@@ -403,12 +393,27 @@ std::vector<std::pair<SignalProcessor::Signal, SignalProcessor::Signal>>
 SignalGenerator::generateWienerTestDataset(size_t signalLength,
                                            double gaussianSNR_dB,
                                            double impulseDensity,
-                                           double impulseAmplitude) const {
-    std::vector<std::pair<Signal, Signal>> dataset;
-    dataset.reserve(8);
+                                           double impulseAmplitude,
+                                           size_t numThreads) const {
+    constexpr size_t numPairs = 8;
+    const auto streams = Xoshiro256::streams(Xoshiro256(rng_()), numPairs);
 
-    std::uniform_real_distribution<double> uniform(0.0, 1.0);
-    std::normal_distribution<double>       gaussNorm(0.0, 1.0);
+    std::vector<std::pair<Signal, Signal>> dataset(numPairs);
+    parallelFor(numPairs, numThreads, [&](size_t i) {
+        dataset[i] = SignalGenerator(streams[i]).generateWienerPair(
+            i, signalLength, gaussianSNR_dB, impulseDensity, impulseAmplitude);
+    });
+
+    return dataset;
+}
+
+std::pair<SignalProcessor::Signal, SignalProcessor::Signal>
+SignalGenerator::generateWienerPair(size_t index,
+                                    size_t signalLength,
+                                    double gaussianSNR_dB,
+                                    double impulseDensity,
+                                    double impulseAmplitude) const {
+    NoiseEngine engine(rng_());
 
     // Вспомогательная лямбда: RMS сигнала
     auto rmsOf = [](const Signal& s) -> double {
@@ -424,21 +429,16 @@ SignalGenerator::generateWienerTestDataset(size_t signalLength,
         sigPow /= static_cast<double>(clean.size());
         double snrLin   = std::pow(10.0, gaussianSNR_dB / 10.0);
         double noiseSig = std::sqrt(sigPow / snrLin);
-        std::normal_distribution<double> dist(0.0, noiseSig);
         Signal noisy = clean;
-        for (double& v : noisy) v += dist(rng_);
+        engine.addGaussian(noisy, noiseSig);
         return noisy;
     };
 
     // Вспомогательная лямбда: добавить импульсные выбросы
     auto addImpulses = [&](Signal noisy, double density, double ampScale) -> Signal {
+        // Случайный знак и амплитуда в диапазоне [1, 2]×ampScale×RMS
         double sigRms = rmsOf(noisy);
-        for (double& v : noisy) {
-            if (uniform(rng_) < density) {
-                double amp = (1.0 + uniform(rng_)) * ampScale * sigRms;
-                v += (gaussNorm(rng_) > 0.0 ? 1.0 : -1.0) * amp;
-            }
-        }
+        engine.addImpulses(noisy, density, ampScale * sigRms, 2.0 * ampScale * sigRms);
         return noisy;
     };
 
@@ -447,39 +447,39 @@ SignalGenerator::generateWienerTestDataset(size_t signalLength,
 
     // ── Сигнал 0: Медленный синус + гауссов белый шум ────────────────────────
     // Истинный сигнал: A·sin(2π·f·n), f = 0.005 (очень медленный)
-    {
+    if (index == 0) {
         Signal clean(N);
         const double f = 0.005, A = 1.0;
         for (size_t n = 0; n < N; ++n)
             clean[n] = A * std::sin(2.0 * PI * f * static_cast<double>(n));
-        dataset.emplace_back(clean, addGaussian(clean));
+        return {clean, addGaussian(clean)};
     }
 
     // ── Сигнал 1: Плавная экспоненциальная кривая + гауссов белый шум ────────
     // s[n] = A·exp(-n / τ),  τ = N/3
-    {
+    if (index == 1) {
         Signal clean(N);
         const double A = 1.0, tau = static_cast<double>(N) / 3.0;
         for (size_t n = 0; n < N; ++n)
             clean[n] = A * std::exp(-static_cast<double>(n) / tau);
-        dataset.emplace_back(clean, addGaussian(clean));
+        return {clean, addGaussian(clean)};
     }
 
     // ── Сигнал 2: Полиномиальный тренд (парабола) + гауссов белый шум ────────
     // s[n] = 1 - 4·(n/N - 0.5)²   — куполообразная парабола в [0, 1]
-    {
+    if (index == 2) {
         Signal clean(N);
         for (size_t n = 0; n < N; ++n) {
             double t = static_cast<double>(n) / static_cast<double>(N);
             clean[n] = 1.0 - 4.0 * (t - 0.5) * (t - 0.5);
         }
-        dataset.emplace_back(clean, addGaussian(clean));
+        return {clean, addGaussian(clean)};
     }
 
     // ── Сигнал 3: Сумма трёх медленных синусов + гауссов белый шум ───────────
     // s[n] = sin(2π·f1·n) + 0.5·sin(2π·f2·n) + 0.3·sin(2π·f3·n)
     // f1=0.004, f2=0.009, f3=0.015  — все существенно ниже f_Найквиста/2
-    {
+    if (index == 3) {
         Signal clean(N);
         const double f1 = 0.004, f2 = 0.009, f3 = 0.015;
         for (size_t n = 0; n < N; ++n) {
@@ -488,22 +488,22 @@ SignalGenerator::generateWienerTestDataset(size_t signalLength,
                      + 0.5 * std::sin(2.0*PI*f2*t)
                      + 0.3 * std::sin(2.0*PI*f3*t);
         }
-        dataset.emplace_back(clean, addGaussian(clean));
+        return {clean, addGaussian(clean)};
     }
 
     // ── Сигнал 4: Медленный синус + импульсные выбросы ───────────────────────
-    {
+    if (index == 4) {
         Signal clean(N);
         const double f = 0.006, A = 1.0;
         for (size_t n = 0; n < N; ++n)
             clean[n] = A * std::sin(2.0 * PI * f * static_cast<double>(n));
         Signal noisy = addImpulses(clean, impulseDensity, impulseAmplitude);
-        dataset.emplace_back(clean, noisy);
+        return {clean, noisy};
     }
 
     // ── Сигнал 5: Затухающая синусоида + импульсные выбросы ──────────────────
     // s[n] = A·exp(-n/τ)·sin(2π·f·n), f = 0.008, τ = N/4
-    {
+    if (index == 5) {
         Signal clean(N);
         const double f = 0.008, A = 1.0, tau = static_cast<double>(N) / 4.0;
         for (size_t n = 0; n < N; ++n) {
@@ -511,12 +511,12 @@ SignalGenerator::generateWienerTestDataset(size_t signalLength,
             clean[n] = A * std::exp(-t / tau) * std::sin(2.0 * PI * f * t);
         }
         Signal noisy = addImpulses(clean, impulseDensity, impulseAmplitude);
-        dataset.emplace_back(clean, noisy);
+        return {clean, noisy};
     }
 
     // ── Сигнал 6: Ступенчатая функция с плавными переходами + смешанный шум ──
     // Три ступени, переходы сглажены тангенсом (медленно меняющийся сигнал)
-    {
+    if (index == 6) {
         Signal clean(N);
         // Позиции переходов (относительные)
         const double pos1 = 0.30, pos2 = 0.65;
@@ -531,65 +531,44 @@ SignalGenerator::generateWienerTestDataset(size_t signalLength,
         // Смешанный шум: гауссов + редкие импульсы
         Signal noisy = addGaussian(clean);
         noisy = addImpulses(noisy, impulseDensity * 0.5, impulseAmplitude);
-        dataset.emplace_back(clean, noisy);
+        return {clean, noisy};
     }
 
     // ── Сигнал 7: Медленный линейный тренд + гауссов шум + редкие импульсы ───
     // s[n] = -1 + 2·n/(N-1)  — линейный рост от -1 до +1
-    {
+    if (index == 7) {
         Signal clean(N);
         for (size_t n = 0; n < N; ++n)
             clean[n] = -1.0 + 2.0 * static_cast<double>(n) / static_cast<double>(N - 1);
         Signal noisy = addGaussian(clean);
         noisy = addImpulses(noisy, impulseDensity * 0.5, impulseAmplitude);
-        dataset.emplace_back(clean, noisy);
+        return {clean, noisy};
     }
 
-    return dataset;
+    throw std::out_of_range("generateWienerPair: индекс сигнала вне диапазона [0, 7]");
 }
 
 void SignalGenerator::saveSignalToCSV(const Signal& signal, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file for writing: " + filename);
-    }
-
-    file << "Index,Value\n";
-    for (size_t i = 0; i < signal.size(); ++i) {
-        file << i << "," << signal[i] << "\n";
-    }
-
-    file.close();
+    // Кратчайшая точная запись отсчётов через буферизованный to_chars
+    writeSignalCSV(filename, signal);
 }
 
 SignalProcessor::Signal SignalGenerator::loadSignalFromCSV(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file for reading: " + filename);
-    }
+    // Файл отображается в память и разбирается без построчных аллокаций
+    return readSignalCSV(filename);
+}
 
-    Signal signal;
-    std::string line;
-
-    // Пропускаем заголовок
-    if (std::getline(file, line)) {
-        while (std::getline(file, line)) {
-            std::stringstream ss(line);
-            std::string indexStr, valueStr;
-
-            if (std::getline(ss, indexStr, ',') && std::getline(ss, valueStr)) {
-                try {
-                    double value = std::stod(valueStr);
-                    signal.push_back(value);
-                } catch (const std::exception& e) {
-                    std::cerr << "Error parsing line: " << line << std::endl;
-                }
-            }
-        }
+void SignalGenerator::saveSignal(const Signal& signal, const std::string& filename) {
+    if (isSignalFilePath(filename)) {
+        saveSignalBinary(signal, filename);
+    } else {
+        saveSignalToCSV(signal, filename);
     }
+}
 
-    file.close();
-    return signal;
+SignalProcessor::Signal SignalGenerator::loadSignal(const std::string& filename) {
+    return isSignalFilePath(filename) ? loadSignalBinary(filename)
+                                      : loadSignalFromCSV(filename);
 }
 
 std::string SignalGenerator::signalTypeToString(SignalType type) {
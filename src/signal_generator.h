@@ -2,6 +2,7 @@
 #define SIGNAL_GENERATOR_H
 
 #include "signal_processor.h"
+#include "utils/random.h"
 #include <random>
 
 /**
@@ -43,7 +44,7 @@ public:
     };
 
 private:
-    mutable std::mt19937 rng_;  // Генератор случайных чисел
+    mutable Xoshiro256 rng_;  // Генератор случайных чисел
 
 public:
     /**
@@ -52,6 +53,11 @@ public:
      */
     explicit SignalGenerator(unsigned int seed = std::random_device{}());
 
+    /**
+     * Конструктор с готовым состоянием ГСЧ (например, одним из Xoshiro256::streams)
+     */
+    explicit SignalGenerator(const Xoshiro256& engine);
+
     /**
      * Генерировать основной сигнал заданного типа
      * @param type Тип сигнала (синус, квадрат, треугольник)
@@ -123,15 +129,22 @@ public:
     Signal generateWhiteNoise(size_t length, double variance = 1.0) const;
 
     /**
-     * Генерировать тестовый набор данных
+     * Генерировать тестовый набор данных.
+     *
+     * Каждая пара генерируется из собственного потока ГСЧ (jump от одного
+     * значения основного генератора), поэтому результат не зависит от числа
+     * потоков.
+     *
      * @param signalLength Длина сигналов
      * @param numSignals Количество различных типов сигналов
      * @param frequencyScale Масштаб частоты (1.0 = по умолчанию, 0.05 = в 20 раз меньше)
+     * @param numThreads Число потоков (0 — по числу ядер)
      * @return Набор тестовых сигналов (clean, noisy)
      */
     std::vector<std::pair<Signal, Signal>> generateTestDataset(size_t signalLength = 1000,
                                                                size_t numSignals = 10,
-                                                               double frequencyScale = 0.05) const;
+                                                               double frequencyScale = 0.05,
+                                                               size_t numThreads = 0) const;
 
     /**
      * Генерировать специализированный набор сигналов для тестирования фильтра Винера.
@@ -154,13 +167,15 @@ public:
      * @param gaussianSNR_dB  SNR гауссова белого шума в дБ (по умолчанию 10)
      * @param impulseDensity  Плотность импульсных выбросов (доля отсчётов, по умолчанию 0.02)
      * @param impulseAmplitude Амплитуда выбросов в единицах RMS сигнала (по умолчанию 5.0)
+     * @param numThreads Число потоков (0 — по числу ядер); на результат не влияет
      * @return Вектор пар (чистый сигнал, зашумлённый сигнал)
      */
     std::vector<std::pair<Signal, Signal>> generateWienerTestDataset(
         size_t signalLength    = 1024,
         double gaussianSNR_dB  = 10.0,
         double impulseDensity  = 0.02,
-        double impulseAmplitude = 5.0) const;
+        double impulseAmplitude = 5.0,
+        size_t numThreads      = 0) const;
 
     /**
      * Сохранить сигнал в CSV файл
@@ -176,12 +191,54 @@ public:
      */
     static Signal loadSignalFromCSV(const std::string& filename);
 
+    /**
+     * Сохранить сигнал в CSV или бинарный контейнер (.sig) по расширению
+     * @param signal Сигнал для сохранения
+     * @param filename Имя файла
+     */
+    static void saveSignal(const Signal& signal, const std::string& filename);
+
+    /**
+     * Загрузить сигнал из CSV или бинарного контейнера (.sig) по расширению
+     * @param filename Имя файла
+     * @return Загруженный сигнал
+     */
+    static Signal loadSignal(const std::string& filename);
+
+    /**
+     * Значение основного сигнала в отсчёте t (то же, что generateBasicSignal()[t])
+     */
+    static double basicSignalSample(SignalType type, double t, double amplitude,
+                                    double frequency, double phase, double dutyCycle);
+
+    /**
+     * Значение i-го отсчёта импульса длиной length (то же, что generatePulse()[i])
+     */
+    static double pulseSample(EchoType type, size_t i, size_t length, double amplitude);
+
     /**
      * Получить строковое представление типа основного сигнала
      */
     static std::string signalTypeToString(SignalType type);
 
 private:
+    /**
+     * Пара (clean, noisy) с номером index из generateTestDataset
+     * (использует только rng_ этого генератора)
+     */
+    std::pair<Signal, Signal> generateDatasetPair(size_t index,
+                                                  size_t signalLength,
+                                                  double frequencyScale) const;
+
+    /**
+     * Пара с номером index (0..7) из generateWienerTestDataset
+     */
+    std::pair<Signal, Signal> generateWienerPair(size_t index,
+                                                 size_t signalLength,
+                                                 double gaussianSNR_dB,
+                                                 double impulseDensity,
+                                                 double impulseAmplitude) const;
+
     /**
      * Генерировать базовый импульс заданного типа
      * @param type Тип импульса
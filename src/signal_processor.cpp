@@ -6,16 +6,23 @@
 #include <cmath>
 
 std::pair<SignalProcessor::Signal, long long> SignalProcessor::measurePerformance(const Signal& input) {
-    auto start = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::steady_clock::now();
 
     Signal result = process(input);
 
-    auto end = std::chrono::high_resolution_clock::now();
+    auto end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
 
     return std::make_pair(result, duration.count());
 }
 
+std::pair<SignalProcessor::Signal, TimingStats>
+SignalProcessor::benchmark(const Signal& input, const TimingOptions& options) {
+    Signal result;
+    TimingStats stats = measureTiming([&] { result = process(input); }, options);
+    return std::make_pair(std::move(result), stats);
+}
+
 double SignalProcessor::mad(const std::vector<double>& values, double med) {
     std::vector<double> deviations;
     deviations.reserve(values.size());
@@ -102,4 +109,140 @@ double calculateCorrelation(const SignalProcessor::Signal& signal1, const Signal
     }
 
     return numerator / denominator;
-}
\ No newline at end of file
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Метрики качества за один проход (calculateQualityMetrics)
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+constexpr size_t kMetricsBlock = 256;   // 2 × 2 КиБ — помещается в L1
+constexpr size_t kMetricsLanes = 2;     // Независимые суммы (SSE2: 2 double); больше — вытеснение регистров
+
+/**
+ * Частичные суммы для диапазона отсчётов: a — чистый сигнал, b — обработанный
+ */
+struct MetricsMoments {
+    double count    = 0.0;
+    double meanA    = 0.0;
+    double meanB    = 0.0;
+    double m2A      = 0.0;   // Σ (a − meanA)²
+    double m2B      = 0.0;   // Σ (b − meanB)²
+    double cAB      = 0.0;   // Σ (a − meanA)(b − meanB)
+    double powerA   = 0.0;   // Σ a²
+    double errorSq  = 0.0;   // Σ (b − a)²
+    double peakA    = 0.0;   // max |a|
+    double maxError = 0.0;   // max |b − a|
+};
+
+/// Объединить моменты двух непересекающихся диапазонов
+MetricsMoments mergeMoments(const MetricsMoments& x, const MetricsMoments& y) {
+    MetricsMoments r;
+    r.count = x.count + y.count;
+    const double dA = y.meanA - x.meanA;
+    const double dB = y.meanB - x.meanB;
+    const double w  = x.count * y.count / r.count;
+    r.meanA    = x.meanA + dA * (y.count / r.count);
+    r.meanB    = x.meanB + dB * (y.count / r.count);
+    r.m2A      = x.m2A + y.m2A + dA * dA * w;
+    r.m2B      = x.m2B + y.m2B + dB * dB * w;
+    r.cAB      = x.cAB + y.cAB + dA * dB * w;
+    r.powerA   = x.powerA + y.powerA;
+    r.errorSq  = x.errorSq + y.errorSq;
+    r.peakA    = std::max(x.peakA, y.peakA);
+    r.maxError = std::max(x.maxError, y.maxError);
+    return r;
+}
+
+/// Моменты одного блока: средние, затем отклонения — оба обхода по данным в L1
+MetricsMoments blockMoments(const double* a, const double* b, size_t n) {
+    double sumA[kMetricsLanes] = {}, sumB[kMetricsLanes] = {};
+    size_t i = 0;
+    for (; i + kMetricsLanes <= n; i += kMetricsLanes) {
+        for (size_t l = 0; l < kMetricsLanes; ++l) {
+            sumA[l] += a[i + l];
+            sumB[l] += b[i + l];
+        }
+    }
+    for (size_t l = 0; i < n; ++i, ++l) {
+        sumA[l] += a[i];
+        sumB[l] += b[i];
+    }
+
+    MetricsMoments r;
+    r.count = static_cast<double>(n);
+    for (size_t l = 0; l < kMetricsLanes; ++l) {
+        r.meanA += sumA[l];
+        r.meanB += sumB[l];
+    }
+    r.meanA /= r.count;
+    r.meanB /= r.count;
+
+    double m2A[kMetricsLanes] = {}, m2B[kMetricsLanes] = {}, cAB[kMetricsLanes] = {};
+    double power[kMetricsLanes] = {}, errSq[kMetricsLanes] = {};
+    double peak[kMetricsLanes] = {}, maxErr[kMetricsLanes] = {};
+    auto step = [&](size_t l, double x, double y) {
+        const double da = x - r.meanA;
+        const double db = y - r.meanB;
+        const double e  = y - x;
+        m2A[l]    += da * da;
+        m2B[l]    += db * db;
+        cAB[l]    += da * db;
+        power[l]  += x * x;
+        errSq[l]  += e * e;
+        peak[l]   = std::max(peak[l], std::abs(x));
+        maxErr[l] = std::max(maxErr[l], std::abs(e));
+    };
+    i = 0;
+    for (; i + kMetricsLanes <= n; i += kMetricsLanes) {
+        for (size_t l = 0; l < kMetricsLanes; ++l) step(l, a[i + l], b[i + l]);
+    }
+    for (size_t l = 0; i < n; ++i, ++l) step(l, a[i], b[i]);
+
+    for (size_t l = 0; l < kMetricsLanes; ++l) {
+        r.m2A      += m2A[l];
+        r.m2B      += m2B[l];
+        r.cAB      += cAB[l];
+        r.powerA   += power[l];
+        r.errorSq  += errSq[l];
+        r.peakA    = std::max(r.peakA, peak[l]);
+        r.maxError = std::max(r.maxError, maxErr[l]);
+    }
+    return r;
+}
+
+/// Попарное объединение блоков: ошибка округления растёт как O(log N)
+MetricsMoments rangeMoments(const double* a, const double* b, size_t n) {
+    if (n <= kMetricsBlock) return blockMoments(a, b, n);
+    const size_t half = (n / kMetricsBlock + 1) / 2 * kMetricsBlock;
+    return mergeMoments(rangeMoments(a, b, half),
+                        rangeMoments(a + half, b + half, n - half));
+}
+
+} // namespace
+
+QualityMetrics calculateQualityMetrics(const SignalProcessor::Signal& clean,
+                                       const SignalProcessor::Signal& processed) {
+    QualityMetrics metrics;
+    if (clean.size() != processed.size() || clean.empty()) {
+        return metrics;
+    }
+
+    const MetricsMoments m = rangeMoments(clean.data(), processed.data(), clean.size());
+    const double n = static_cast<double>(clean.size());
+
+    metrics.mse      = m.errorSq / n;
+    metrics.maxError = m.maxError;
+
+    // Пороги вырожденных случаев — как в calculateSNR и calculateCorrelation
+    const double signalPower = m.powerA / n;
+    metrics.snr = metrics.mse < 1e-10 ? 100.0 : 10.0 * std::log10(signalPower / metrics.mse);
+    metrics.psnr = metrics.mse < 1e-10 ? 100.0
+                                       : 10.0 * std::log10(m.peakA * m.peakA / metrics.mse);
+
+    const double denominator = std::sqrt(m.m2A * m.m2B);
+    metrics.correlation = denominator < 1e-10 ? 0.0 : m.cAB / denominator;
+
+    return metrics;
+}
@@ -4,6 +4,9 @@
 #include <vector>
 #include <string>
 #include <chrono>
+#include <memory>
+
+#include "utils/timing.h"
 
 
 /**
@@ -25,11 +28,45 @@ public:
      */
     virtual Signal process(const Signal& input) = 0;
 
+    /**
+     * Применить фильтр, записав результат в output (прежнее содержимое
+     * заменяется, ёмкость по возможности переиспользуется). По умолчанию —
+     * output = process(input); фильтры, пишущие выход поотсчётно,
+     * переопределяют метод, чтобы цепочки (Pipeline) обходились без выделений.
+     * input и output не должны быть одним вектором.
+     */
+    virtual void processInto(const Signal& input, Signal& output) { output = process(input); }
+
     /**
      * Получить имя алгоритма
      */
     virtual std::string getName() const = 0;
 
+    /**
+     * Создать независимую копию алгоритма (параметры и внутреннее состояние).
+     * Используется при параллельном тестировании: у каждой задачи своя копия.
+     */
+    virtual std::unique_ptr<SignalProcessor> clone() const = 0;
+
+    /**
+     * Ширина окна w — число входных отсчётов, участвующих в вычислении одного
+     * выходного. Используется при оценке сложности O(N·w) (testScalability)
+     */
+    virtual size_t getWindowSize() const { return 1; }
+
+    /// getReach() фильтра, выход которого зависит от всего сигнала
+    static constexpr size_t kNonLocal = static_cast<size_t>(-1);
+
+    /**
+     * Радиус зависимости h: выходной отсчёт i определяется только входными
+     * [i − h, i + h] (у краёв сигнала — с тем же дополнением, что и при
+     * обработке целиком). Такой фильтр можно применять к участкам длинного
+     * сигнала с перекрытием h и получать тот же результат (BackgroundFilter).
+     * kNonLocal — фильтр использует оценки по всему сигналу или рекурсивное
+     * состояние (Винер, Калман, спектральное вычитание).
+     */
+    virtual size_t getReach() const { return kNonLocal; }
+
     /**
      * Измерить время выполнения обработки
      * @param input Входной сигнал
@@ -37,6 +74,15 @@ public:
      */
     std::pair<Signal, long long> measurePerformance(const Signal& input);
 
+    /**
+     * Измерить время обработки с прогревом, повторами и отбраковкой выбросов
+     * @param input Входной сигнал
+     * @param options Параметры замера (см. utils/timing.h)
+     * @return Пара: отфильтрованный сигнал и статистика времени (нс)
+     */
+    std::pair<Signal, TimingStats> benchmark(const Signal& input,
+                                             const TimingOptions& options = TimingOptions());
+
 protected:
     /**
      * Вычислить медианное абсолютное отклонение
@@ -94,4 +140,30 @@ double calculateMSE(const SignalProcessor::Signal& original, const SignalProcess
  */
 double calculateCorrelation(const SignalProcessor::Signal& signal1, const SignalProcessor::Signal& signal2);
 
+/**
+ * Метрики качества обработанного сигнала относительно чистого
+ */
+struct QualityMetrics {
+    double snr         = 0.0;   // SNR, дБ (как calculateSNR)
+    double mse         = 0.0;   // Среднеквадратичная ошибка
+    double correlation = 0.0;   // Коэффициент корреляции Пирсона
+    double psnr        = 0.0;   // Пиковое SNR: 10·log10(max|clean|² / MSE), дБ
+    double maxError    = 0.0;   // Максимальная абсолютная ошибка
+};
+
+/**
+ * Вычислить все метрики качества за один проход по сигналам.
+ *
+ * Сигналы обходятся блоками по 256 отсчётов (блок в L1, внутри — по две
+ * независимые суммы на величину); центральные моменты блоков объединяются
+ * попарно (Chan et al.), поэтому корреляция устойчива и при большом
+ * постоянном смещении. Результат совпадает с calculateSNR / calculateMSE /
+ * calculateCorrelation до ошибки округления, включая соглашения для
+ * вырожденных случаев; при разной длине или пустых сигналах — нули.
+ * @param clean Чистый (эталонный) сигнал
+ * @param processed Обработанный сигнал
+ */
+QualityMetrics calculateQualityMetrics(const SignalProcessor::Signal& clean,
+                                       const SignalProcessor::Signal& processed);
+
 #endif // SIGNAL_PROCESSOR_H
\ No newline at end of file
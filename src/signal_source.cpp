@@ -0,0 +1,232 @@
+#include "signal_source.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SignalSource
+// ─────────────────────────────────────────────────────────────────────────────
+
+size_t SignalSource::generateBlock(std::span<double> out) {
+    const size_t n = static_cast<size_t>(std::min<uint64_t>(out.size(), remaining()));
+    if (n == 0) return 0;
+    fill(out.first(n));
+    position_ += n;
+    return n;
+}
+
+SignalSource::Signal SignalSource::generateAll() {
+    Signal signal(static_cast<size_t>(remaining()));
+    generateBlock(signal);
+    return signal;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// BasicSignalSource
+// ─────────────────────────────────────────────────────────────────────────────
+
+BasicSignalSource::BasicSignalSource(SignalGenerator::SignalType type,
+                                     uint64_t length,
+                                     double amplitude,
+                                     double frequency,
+                                     double phase,
+                                     double dutyCycle)
+    : SignalSource(length), type_(type), amplitude_(amplitude),
+      frequency_(frequency), phase_(phase), dutyCycle_(dutyCycle) {
+}
+
+void BasicSignalSource::fill(std::span<double> out) {
+    const uint64_t start = position();
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = SignalGenerator::basicSignalSample(type_, static_cast<double>(start + i),
+                                                    amplitude_, frequency_, phase_, dutyCycle_);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// WhiteNoiseSource
+// ─────────────────────────────────────────────────────────────────────────────
+
+WhiteNoiseSource::WhiteNoiseSource(unsigned int seed, uint64_t length, double variance)
+    : SignalSource(length), noise_(Xoshiro256(seed)()), stddev_(std::sqrt(variance)) {
+}
+
+void WhiteNoiseSource::fill(std::span<double> out) {
+    noise_.fillGaussian(out, 0.0, stddev_);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// EchoSignalSource
+// ─────────────────────────────────────────────────────────────────────────────
+
+EchoSignalSource::EchoSignalSource(unsigned int seed,
+                                   SignalGenerator::EchoType type,
+                                   uint64_t length,
+                                   double amplitude,
+                                   size_t echoDelay,
+                                   double echoAttenuation,
+                                   double noiseLevel)
+    : SignalSource(length), type_(type), amplitude_(amplitude),
+      echoAttenuation_(echoAttenuation),
+      pulseLength_(std::max<uint64_t>(1, length / 10)),     // Как в generateEchoSignal
+      mainStart_(length / 20),
+      echoStart_(length / 20 + echoDelay),
+      hasEcho_(echoDelay < length && echoAttenuation > 0.0),
+      noiseStd_(noiseLevel > 0.0 ? noiseLevel : 0.0),
+      noise_(Xoshiro256(seed)()) {
+}
+
+void EchoSignalSource::fill(std::span<double> out) {
+    const uint64_t start = position();
+    const size_t   pulseLength = static_cast<size_t>(pulseLength_);
+
+    for (size_t i = 0; i < out.size(); ++i) {
+        const uint64_t n = start + i;
+        double value = 0.0;
+
+        if (n >= mainStart_ && n - mainStart_ < pulseLength_) {
+            value = SignalGenerator::pulseSample(type_, static_cast<size_t>(n - mainStart_),
+                                                 pulseLength, amplitude_);
+        }
+        if (hasEcho_ && n >= echoStart_ && n - echoStart_ < pulseLength_) {
+            value += SignalGenerator::pulseSample(type_, static_cast<size_t>(n - echoStart_),
+                                                  pulseLength, amplitude_) * echoAttenuation_;
+        }
+        out[i] = value;
+    }
+
+    // Фоновый шум — тот же поток, что у generateWhiteNoise в пакетной версии
+    if (noiseStd_ > 0.0) {
+        noise_.addGaussian(out, noiseStd_);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ImpulseNoiseSource
+// ─────────────────────────────────────────────────────────────────────────────
+
+ImpulseNoiseSource::ImpulseNoiseSource(unsigned int seed,
+                                       uint64_t length,
+                                       SignalGenerator::NoiseType type,
+                                       double density,
+                                       double amplitude,
+                                       size_t burstLength)
+    : SignalSource(length), type_(type), density_(density), amplitude_(amplitude),
+      burstLength_(burstLength), burstRemaining_(0),
+      period_(type == SignalGenerator::NoiseType::PERIODIC
+                  ? static_cast<uint64_t>(1.0 / density) : 0),
+      rng_(seed),
+      engine_(type == SignalGenerator::NoiseType::IMPULSE ||
+              type == SignalGenerator::NoiseType::RANDOM_SPIKES ? rng_() : 0),
+      uniform_(0.0, 1.0), normal_(0.0, 1.0) {
+}
+
+void ImpulseNoiseSource::fill(std::span<double> out) {
+    const uint64_t start = position();
+
+    // Порядок обращений к ГСЧ повторяет SignalGenerator::generateImpulseNoise
+    switch (type_) {
+        case SignalGenerator::NoiseType::IMPULSE:
+            std::fill(out.begin(), out.end(), 0.0);
+            engine_.addImpulses(out, density_, amplitude_, amplitude_);
+            break;
+
+        case SignalGenerator::NoiseType::RANDOM_SPIKES:
+            std::fill(out.begin(), out.end(), 0.0);
+            engine_.addImpulses(out, density_, 0.5 * amplitude_, amplitude_);
+            break;
+
+        case SignalGenerator::NoiseType::BURST:
+            for (double& v : out) {
+                if (burstRemaining_ == 0 && uniform_(rng_) < density_) {
+                    burstRemaining_ = burstLength_;
+                }
+                if (burstRemaining_ > 0) {
+                    v = amplitude_ * normal_(rng_);
+                    --burstRemaining_;
+                } else {
+                    v = 0.0;
+                }
+            }
+            break;
+
+        case SignalGenerator::NoiseType::PERIODIC:
+            for (size_t i = 0; i < out.size(); ++i) {
+                out[i] = 0.0;
+                if (period_ > 0 && (start + i) % period_ == 0) {
+                    out[i] = amplitude_ * (uniform_(rng_) > 0.5 ? 1.0 : -1.0);
+                }
+            }
+            break;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// FunctionSource
+// ─────────────────────────────────────────────────────────────────────────────
+
+FunctionSource::FunctionSource(uint64_t length, std::function<double(uint64_t)> sample)
+    : SignalSource(length), sample_(std::move(sample)) {
+}
+
+void FunctionSource::fill(std::span<double> out) {
+    const uint64_t start = position();
+    for (size_t i = 0; i < out.size(); ++i) out[i] = sample_(start + i);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SumSource
+// ─────────────────────────────────────────────────────────────────────────────
+
+static uint64_t commonLength(const std::vector<std::unique_ptr<SignalSource>>& sources) {
+    if (sources.empty()) {
+        throw std::invalid_argument("SumSource: список источников пуст");
+    }
+    for (const auto& s : sources) {
+        if (!s || s->remaining() != sources.front()->remaining()) {
+            throw std::invalid_argument("SumSource: источники должны иметь одинаковую длину");
+        }
+    }
+    return sources.front()->remaining();
+}
+
+SumSource::SumSource(std::vector<std::unique_ptr<SignalSource>> sources)
+    : SignalSource(commonLength(sources)), sources_(std::move(sources)) {
+}
+
+void SumSource::fill(std::span<double> out) {
+    sources_.front()->generateBlock(out);
+    if (sources_.size() == 1) return;
+
+    scratch_.resize(out.size());
+    for (size_t k = 1; k < sources_.size(); ++k) {
+        sources_[k]->generateBlock(scratch_);
+        for (size_t i = 0; i < out.size(); ++i) out[i] += scratch_[i];
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Запись в файл
+// ─────────────────────────────────────────────────────────────────────────────
+
+uint64_t writeSourceToFile(SignalSource& source,
+                           const std::string& filename,
+                           SampleType type,
+                           size_t blockSize) {
+    if (isComplexSampleType(type)) {
+        throw std::invalid_argument("writeSourceToFile: источник выдаёт вещественные отсчёты");
+    }
+
+    SignalFileWriter writer(filename, type);
+    std::vector<double> block(std::max<size_t>(1, blockSize));
+    uint64_t written = 0;
+
+    while (size_t n = source.generateBlock(block)) {
+        writer.append(std::span<const double>(block.data(), n));
+        written += n;
+    }
+
+    writer.finalize();
+    return written;
+}
@@ -0,0 +1,201 @@
+#ifndef SIGNAL_SOURCE_H
+#define SIGNAL_SOURCE_H
+
+#include "signal_generator.h"
+#include "utils/signal_file.h"
+#include "utils/noise_engine.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+/**
+ * Потоковый источник сигнала.
+ *
+ * Выдаёт сигнал заданной длины блоками через generateBlock(): фаза и
+ * состояние ГСЧ сохраняются между вызовами, поэтому память не зависит от
+ * длины сигнала (O(блок)), а результат совпадает с соответствующим
+ * пакетным генератором SignalGenerator с тем же seed.
+ */
+class SignalSource {
+public:
+    using Signal = SignalProcessor::Signal;
+
+    /** Размер блока по умолчанию (отсчётов) */
+    static constexpr size_t kDefaultBlockSize = 65536;
+
+    virtual ~SignalSource() = default;
+
+    /** Полная длина сигнала */
+    uint64_t length() const { return length_; }
+
+    /** Число уже выданных отсчётов */
+    uint64_t position() const { return position_; }
+
+    /** Число оставшихся отсчётов */
+    uint64_t remaining() const { return length_ - position_; }
+
+    /** Источник исчерпан */
+    bool done() const { return position_ >= length_; }
+
+    /**
+     * Заполнить начало out следующими отсчётами
+     * @return Число записанных отсчётов: min(out.size(), remaining()), 0 — конец
+     */
+    size_t generateBlock(std::span<double> out);
+
+    /** Выдать все оставшиеся отсчёты одним вектором */
+    Signal generateAll();
+
+protected:
+    explicit SignalSource(uint64_t length) : length_(length), position_(0) {}
+
+    /** Сгенерировать out.size() отсчётов, начиная с position() */
+    virtual void fill(std::span<double> out) = 0;
+
+private:
+    uint64_t length_;
+    uint64_t position_;
+};
+
+/**
+ * Основной сигнал (синус, меандр, треугольник, пила) —
+ * аналог SignalGenerator::generateBasicSignal
+ */
+class BasicSignalSource : public SignalSource {
+public:
+    BasicSignalSource(SignalGenerator::SignalType type,
+                      uint64_t length,
+                      double amplitude = 1.0,
+                      double frequency = 0.1,
+                      double phase = 0.0,
+                      double dutyCycle = 0.5);
+
+protected:
+    void fill(std::span<double> out) override;
+
+private:
+    SignalGenerator::SignalType type_;
+    double amplitude_;
+    double frequency_;
+    double phase_;
+    double dutyCycle_;
+};
+
+/**
+ * Гауссов белый шум — аналог SignalGenerator::generateWhiteNoise
+ */
+class WhiteNoiseSource : public SignalSource {
+public:
+    WhiteNoiseSource(unsigned int seed, uint64_t length, double variance = 1.0);
+
+protected:
+    void fill(std::span<double> out) override;
+
+private:
+    NoiseEngine noise_;
+    double      stddev_;
+};
+
+/**
+ * Эхо сигнал — аналог SignalGenerator::generateEchoSignal
+ * (импульс и его эхо вычисляются по отсчётам, без хранения импульса)
+ */
+class EchoSignalSource : public SignalSource {
+public:
+    EchoSignalSource(unsigned int seed,
+                     SignalGenerator::EchoType type,
+                     uint64_t length,
+                     double amplitude = 1.0,
+                     size_t echoDelay = 100,
+                     double echoAttenuation = 0.5,
+                     double noiseLevel = 0.01);
+
+protected:
+    void fill(std::span<double> out) override;
+
+private:
+    SignalGenerator::EchoType        type_;
+    double                           amplitude_;
+    double                           echoAttenuation_;
+    uint64_t                         pulseLength_;
+    uint64_t                         mainStart_;
+    uint64_t                         echoStart_;
+    bool                             hasEcho_;
+    double                           noiseStd_;
+    NoiseEngine                      noise_;
+};
+
+/**
+ * Импульсные помехи — аналог SignalGenerator::generateImpulseNoise.
+ * Пакет помех может пересекать границу блоков.
+ */
+class ImpulseNoiseSource : public SignalSource {
+public:
+    ImpulseNoiseSource(unsigned int seed,
+                       uint64_t length,
+                       SignalGenerator::NoiseType type = SignalGenerator::NoiseType::RANDOM_SPIKES,
+                       double density = 0.01,
+                       double amplitude = 2.0,
+                       size_t burstLength = 5);
+
+protected:
+    void fill(std::span<double> out) override;
+
+private:
+    SignalGenerator::NoiseType             type_;
+    double                                 density_;
+    double                                 amplitude_;
+    size_t                                 burstLength_;
+    size_t                                 burstRemaining_;   ///< Оставшиеся отсчёты текущего пакета
+    uint64_t                               period_;           ///< Для PERIODIC
+    Xoshiro256                             rng_;
+    NoiseEngine                            engine_;           ///< Для IMPULSE и RANDOM_SPIKES
+    std::uniform_real_distribution<double> uniform_;
+    std::normal_distribution<double>       normal_;
+};
+
+/**
+ * Сигнал, заданный формулой от номера отсчёта
+ */
+class FunctionSource : public SignalSource {
+public:
+    FunctionSource(uint64_t length, std::function<double(uint64_t)> sample);
+
+protected:
+    void fill(std::span<double> out) override;
+
+private:
+    std::function<double(uint64_t)> sample_;
+};
+
+/**
+ * Поотсчётная сумма нескольких источников одинаковой длины
+ * (например, чистый сигнал + импульсные помехи, аналог addImpulseNoise)
+ */
+class SumSource : public SignalSource {
+public:
+    /** @throws std::invalid_argument если список пуст или длины различаются */
+    explicit SumSource(std::vector<std::unique_ptr<SignalSource>> sources);
+
+protected:
+    void fill(std::span<double> out) override;
+
+private:
+    std::vector<std::unique_ptr<SignalSource>> sources_;
+    std::vector<double>                        scratch_;
+};
+
+/**
+ * Записать источник в бинарный контейнер .sig блоками
+ * @return Число записанных отсчётов
+ */
+uint64_t writeSourceToFile(SignalSource& source,
+                           const std::string& filename,
+                           SampleType type = SampleType::FLOAT64,
+                           size_t blockSize = SignalSource::kDefaultBlockSize);
+
+#endif // SIGNAL_SOURCE_H
@@ -1,5 +1,6 @@
 #include "spectral_subtraction_filter.h"
 #include "utils/fft.h"
+#include "utils/trace.h"
 
 #include <cmath>
 #include <stdexcept>
@@ -102,6 +103,7 @@ std::vector<double> SpectralSubtractionFilter::hannWindow(size_t n)
 
 SignalProcessor::Signal SpectralSubtractionFilter::process(const Signal& input)
 {
+    TRACE_SCOPE("SpectralSubtractionFilter::process");
     const size_t N       = input.size();
     const size_t fftSize = frameSize_;
     const size_t hop     = hopSize_;
@@ -78,6 +78,11 @@ public:
      */
     std::string getName() const override;
 
+    /** Независимая копия фильтра */
+    std::unique_ptr<SignalProcessor> clone() const override {
+        return std::make_unique<SpectralSubtractionFilter>(*this);
+    }
+
     /**
      * Установить параметры
      */
@@ -0,0 +1,51 @@
+#include "streaming_filter.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+void processLocalRange(SignalProcessor& filter, const SignalProcessor::Signal& input,
+                       size_t begin, size_t end,
+                       SignalProcessor::Signal& window, SignalProcessor::Signal& filtered,
+                       double* out) {
+    const size_t reach = filter.getReach();
+    const size_t lo    = begin > reach ? begin - reach : 0;
+    const size_t hi    = end + std::min(reach, input.size() - end);
+
+    const SignalProcessor::Signal* source = &input;
+    if (lo != 0 || hi != input.size()) {
+        window.assign(input.begin() + lo, input.begin() + hi);
+        source = &window;
+    }
+    filter.processInto(*source, filtered);
+    if (filtered.size() != source->size()) {
+        throw std::runtime_error("processLocalRange: local filter changed signal length");
+    }
+    std::copy(filtered.begin() + (begin - lo), filtered.begin() + (end - lo), out);
+}
+
+StreamingFilter::StreamingFilter(std::unique_ptr<SignalProcessor> filter)
+    : filter_(std::move(filter)) {
+    if (!filter_) throw std::invalid_argument("StreamingFilter: filter must not be null");
+    reach_ = filter_->getReach();
+}
+
+void StreamingFilter::push(std::span<const double> block, Signal& out) {
+    if (reach_ == SignalProcessor::kNonLocal) {
+        window_.assign(block.begin(), block.end());
+        filter_->processInto(window_, out);
+        return;
+    }
+    out.clear();
+    window_.insert(window_.end(), block.begin(), block.end());
+    if (window_.size() <= lead_ + reach_) return;
+
+    // Справа у окна h отсчётов контекста: выдаются [lead_, end)
+    const size_t end = window_.size() - reach_;
+    out.resize(end - lead_);
+    processLocalRange(*filter_, window_, lead_, end, scratch_, result_, out.data());
+
+    // Следующее окно начинается за h отсчётов до первого невыданного
+    const size_t keepFrom = end - std::min(end, reach_);
+    window_.erase(window_.begin(), window_.begin() + keepFrom);
+    lead_ = end - keepFrom;
+}
@@ -0,0 +1,64 @@
+#ifndef STREAMING_FILTER_H
+#define STREAMING_FILTER_H
+
+#include "signal_processor.h"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+
+/**
+ * Отфильтровать участок [begin, end) сигнала локальным фильтром
+ *
+ * Вход берётся с перекрытием h = getReach(): [begin − h, end + h) в пределах
+ * сигнала. Отсчёты перекрытия дают окну тот же контекст, что и при обработке
+ * целиком, поэтому результат совпадает с process(input) на [begin, end).
+ * Если участок с перекрытием — весь сигнал, он обрабатывается без копирования.
+ *
+ * @param window, filtered Рабочие буферы (ёмкость переиспользуется)
+ * @param out Сюда пишутся end − begin отсчётов
+ * @throws std::runtime_error если фильтр изменил длину сигнала
+ */
+void processLocalRange(SignalProcessor& filter, const SignalProcessor::Signal& input,
+                       size_t begin, size_t end,
+                       SignalProcessor::Signal& window, SignalProcessor::Signal& filtered,
+                       double* out);
+
+/**
+ * Фильтрация потока блоками произвольной длины
+ *
+ * Локальный фильтр (getReach() = h) каждый раз получает вместе с новым
+ * блоком h отсчётов до первого ещё не выданного и выдаёт только отсчёты с
+ * полным контекстом справа (processLocalRange, как участки BackgroundFilter):
+ * выход совпадает с process() всего потока, но запаздывает на h отсчётов.
+ * Нелокальный фильтр обрабатывает каждый блок как отдельный сигнал — на
+ * стыках блоков возможны переходные процессы.
+ *
+ * Память локального фильтра — O(h + длина блока) независимо от длины потока.
+ */
+class StreamingFilter {
+public:
+    using Signal = SignalProcessor::Signal;
+
+    /** @throws std::invalid_argument если filter пуст */
+    explicit StreamingFilter(std::unique_ptr<SignalProcessor> filter);
+
+    /** Обработать блок; out — готовые отсчёты выхода (может быть пустым) */
+    void push(std::span<const double> block, Signal& out);
+
+    /** Запаздывание выхода, отсчётов */
+    size_t latency() const { return reach_ == SignalProcessor::kNonLocal ? 0 : reach_; }
+
+    std::string name() const { return filter_->getName(); }
+
+private:
+    std::unique_ptr<SignalProcessor> filter_;
+    size_t reach_;
+    Signal window_;     ///< Вход, начиная за h отсчётов до первого невыданного
+    Signal scratch_;
+    Signal result_;
+    size_t lead_ = 0;   ///< Отсчётов окна до первого невыданного
+};
+
+#endif // STREAMING_FILTER_H
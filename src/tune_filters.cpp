@@ -0,0 +1,213 @@
+/**
+ * tune_filters — подбор гиперпараметров фильтров по корпусу сигналов
+ *
+ * Запуск:
+ *   ./build/tune_filters [опции] [DIR | dataset.sga]...
+ *
+ * DIR — директория с поддиректориями clean/ и noisy/ (пары — файлы с
+ * одинаковым именем, .csv или .sig). Без аргументов — весь корпус data/:
+ * data, data/extended, data/wiener, data/wiener_hq.
+ *
+ * Подбор — последовательным делением (parameter_tuner.h): каждая ступень
+ * оценивает выживших кандидатов на более длинных префиксах сигналов и
+ * оставляет лучшую 1/eta часть.
+ *
+ * Опции:
+ *   --filter NAME       пространство параметров (повторяется; по умолчанию все):
+ *                       median, wiener, robust_wiener, morphological, savgol,
+ *                       kalman, outlier
+ *   --metric M          snr | mse | corr | psnr (по умолчанию snr)
+ *   --eta N             доля выживших 1/N на ступени (по умолчанию 3)
+ *   --min-prefix N      длина префикса первой ступени (по умолчанию 256)
+ *   --exhaustive        полный перебор на сигналах целиком
+ *   --threads N         потоков (0 — по числу ядер)
+ *   --top K             строк в таблице (по умолчанию 5)
+ */
+
+#include "parameter_tuner.h"
+#include "signal_generator.h"
+#include "utils/signal_archive.h"
+#include "utils/signal_file.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static void printUsage(const char* prog) {
+    std::cout << "Использование: " << prog << " [опции] [DIR | dataset.sga]...\n\n"
+              << "Опции:\n"
+              << "  -h, --help         Показать эту справку\n"
+              << "  --filter NAME      Пространство параметров (повторяется; по умолчанию все)\n"
+              << "  --metric M         snr | mse | corr | psnr (по умолчанию snr)\n"
+              << "  --eta N            На ступени остаётся 1/N кандидатов (по умолчанию 3)\n"
+              << "  --min-prefix N     Длина префикса первой ступени (по умолчанию 256)\n"
+              << "  --exhaustive       Полный перебор на сигналах целиком\n"
+              << "  --threads N        Потоков (0 — по числу ядер)\n"
+              << "  --top K            Строк в таблице (по умолчанию 5)\n"
+              << "\nПространства: median, wiener, robust_wiener, morphological, savgol, kalman, outlier\n";
+}
+
+/// Пары (clean, noisy) из DIR/clean и DIR/noisy; бинарный .sig предпочтительнее CSV
+static void loadDirectory(const fs::path& dir, ParameterTuner::Dataset& dataset) {
+    const fs::path cleanDir = dir / "clean";
+    const fs::path noisyDir = dir / "noisy";
+    if (!fs::is_directory(cleanDir) || !fs::is_directory(noisyDir)) {
+        std::cerr << "Пропуск " << dir.string() << ": нет clean/ и noisy/\n";
+        return;
+    }
+
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::directory_iterator(cleanDir)) {
+        const fs::path& p = entry.path();
+        if (p.extension() == kSignalFileExtension) {
+            files.push_back(p.filename());
+        } else if (p.extension() == ".csv") {
+            fs::path sig = p;
+            sig.replace_extension(kSignalFileExtension);
+            if (!fs::exists(sig)) files.push_back(p.filename());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    for (const fs::path& name : files) {
+        if (!fs::exists(noisyDir / name)) continue;
+        try {
+            dataset.emplace_back(SignalGenerator::loadSignal((cleanDir / name).string()),
+                                 SignalGenerator::loadSignal((noisyDir / name).string()));
+        } catch (const std::exception& e) {
+            std::cerr << "Пропуск " << name.string() << ": " << e.what() << "\n";
+        }
+    }
+}
+
+static bool parseMetric(const std::string& name, TuningMetric& metric) {
+    if (name == "snr")  { metric = TuningMetric::SNR;         return true; }
+    if (name == "mse")  { metric = TuningMetric::MSE;         return true; }
+    if (name == "corr") { metric = TuningMetric::CORRELATION; return true; }
+    if (name == "psnr") { metric = TuningMetric::PSNR;        return true; }
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+    TuningOptions            options;
+    std::vector<std::string> filters, inputs;
+    size_t                   top = 5;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        try {
+            if (a == "-h" || a == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (a == "--filter" && hasValue) {
+                filters.push_back(argv[++i]);
+            } else if (a == "--metric" && hasValue) {
+                if (!parseMetric(argv[++i], options.metric)) throw std::invalid_argument(a);
+            } else if (a == "--eta" && hasValue) {
+                options.eta = std::stoul(argv[++i]);
+            } else if (a == "--min-prefix" && hasValue) {
+                options.minPrefix = std::stoul(argv[++i]);
+            } else if (a == "--exhaustive") {
+                options.eta = 1;
+            } else if (a == "--threads" && hasValue) {
+                options.numThreads = std::stoul(argv[++i]);
+            } else if (a == "--top" && hasValue) {
+                top = std::max<size_t>(1, std::stoul(argv[++i]));
+            } else if (a.rfind("--", 0) != 0) {
+                inputs.push_back(a);
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Неверное значение опции " << a << "\n";
+            return 1;
+        }
+    }
+
+    if (inputs.empty()) {
+        const std::string root(ROOT_PATH);
+        inputs = {root + "/data", root + "/data/extended", root + "/data/wiener",
+                  root + "/data/wiener_hq"};
+    }
+
+    ParameterTuner::Dataset dataset;
+    for (const std::string& input : inputs) {
+        if (isSignalArchivePath(input)) {
+            try {
+                for (auto& pair : SignalArchive(input).readPairs()) dataset.push_back(std::move(pair));
+            } catch (const std::exception& e) {
+                std::cerr << "Ошибка чтения архива " << input << ": " << e.what() << "\n";
+            }
+        } else {
+            loadDirectory(input, dataset);
+        }
+    }
+    if (dataset.empty()) {
+        std::cerr << "Нет пар сигналов для подбора\n";
+        return 1;
+    }
+
+    std::vector<ParameterSpace> spaces;
+    for (ParameterSpace& space : builtinParameterSpaces()) {
+        if (filters.empty() || std::find(filters.begin(), filters.end(), space.name()) != filters.end()) {
+            spaces.push_back(std::move(space));
+        }
+    }
+    if (spaces.empty()) {
+        std::cerr << "Неизвестный фильтр\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    size_t totalSamples = 0;
+    for (const auto& pair : dataset) totalSamples += pair.first.size();
+    std::cout << "Сигналов: " << dataset.size() << ", отсчётов: " << totalSamples
+              << (options.eta > 1 ? ", последовательное деление, eta = " + std::to_string(options.eta)
+                                  : std::string(", полный перебор"))
+              << "\n";
+
+    ParameterTuner tuner(std::move(dataset), options);
+    std::cout << std::fixed;
+
+    for (const ParameterSpace& space : spaces) {
+        const TuningResult result = tuner.tune(space);
+
+        std::cout << "\n=== " << space.name() << ": " << result.ranking.size() << " кандидатов ===\n";
+        size_t evaluations = 0;
+        long long elapsedNs = 0;
+        for (size_t r = 0; r < result.rungs.size(); ++r) {
+            const TuningRung& rung = result.rungs[r];
+            std::cout << "  ступень " << r << ": " << std::setw(4) << rung.candidates
+                      << " кандидатов, префикс " << std::setw(6) << rung.prefix
+                      << ", оценок " << std::setw(5) << rung.evaluations
+                      << " (из кэша " << rung.cacheHits << "), "
+                      << std::setprecision(1) << rung.elapsedNs / 1e6 << " мс\n";
+            evaluations += rung.evaluations;
+            elapsedNs   += rung.elapsedNs;
+        }
+        std::cout << "  всего: " << evaluations << " оценок, "
+                  << std::setprecision(1) << elapsedNs / 1e6 << " мс\n\n";
+
+        std::cout << "  " << std::left << std::setw(57) << "Параметры" << std::right
+                  << std::setw(12) << "SNR(дБ)" << std::setw(14) << "MSE"
+                  << std::setw(22) << "Корреляция" << "\n";
+        for (size_t i = 0; i < std::min(top, result.ranking.size()); ++i) {
+            const TuningCandidate& c = result.ranking[i];
+            std::cout << "  " << std::left << std::setw(48) << c.description << std::right
+                      << std::setprecision(2) << std::setw(10) << c.mean.snr
+                      << std::scientific << std::setprecision(3) << std::setw(14) << c.mean.mse
+                      << std::fixed << std::setprecision(4) << std::setw(12) << c.mean.correlation
+                      << (c.rung + 1 < result.rungs.size() ? "  (префикс " + std::to_string(c.prefix) + ")"
+                                                           : std::string())
+                      << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "alloc_tracker.h"
+
+#include <algorithm>
+
+#ifdef SIGNAL_ALLOC_TRACKING
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+#endif
+
+namespace {
+
+/// Счётчики потока; тривиальный тип — доступен из operator new без инициализации
+struct ThreadAllocState {
+    bool       active;
+    long long  live;
+    long long  peak;
+    AllocStats stats;
+};
+
+thread_local ThreadAllocState g_state{};
+
+} // namespace
+
+bool allocTrackingEnabled() {
+#ifdef SIGNAL_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocScope::AllocScope()
+    : outerActive_(g_state.active),
+      outerLive_(g_state.live),
+      outerPeak_(g_state.peak),
+      outer_(g_state.stats) {
+    g_state.active = true;
+    g_state.live   = 0;
+    g_state.peak   = 0;
+    g_state.stats  = AllocStats();
+}
+
+AllocScope::~AllocScope() {
+    const ThreadAllocState inner = g_state;
+
+    g_state.active = outerActive_;
+    g_state.live   = outerLive_;
+    g_state.peak   = outerPeak_;
+    g_state.stats  = outer_;
+
+    // Выделения внутренней области входят во внешнюю
+    if (outerActive_) {
+        g_state.peak  = std::max(g_state.peak, g_state.live + inner.peak);
+        g_state.live += inner.live;
+        g_state.stats.allocations   += inner.stats.allocations;
+        g_state.stats.deallocations += inner.stats.deallocations;
+        g_state.stats.bytes         += inner.stats.bytes;
+        g_state.stats.peakBytes      = static_cast<size_t>(std::max(0LL, g_state.peak));
+    }
+}
+
+AllocStats AllocScope::stats() const {
+    AllocStats s = g_state.stats;
+    s.peakBytes = static_cast<size_t>(std::max(0LL, g_state.peak));
+    return s;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Замена глобальных operator new / operator delete
+// ─────────────────────────────────────────────────────────────────────────────
+
+#ifdef SIGNAL_ALLOC_TRACKING
+
+namespace {
+
+void* trackedAlloc(std::size_t size) {
+    if (size == 0) size = 1;
+    void* p;
+    while ((p = std::malloc(size)) == nullptr) {
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+
+    if (g_state.active) {
+        g_state.stats.allocations++;
+        g_state.stats.bytes += size;
+        g_state.live += static_cast<long long>(malloc_usable_size(p));
+        g_state.peak  = std::max(g_state.peak, g_state.live);
+    }
+    return p;
+}
+
+void trackedFree(void* p) noexcept {
+    if (!p) return;
+    if (g_state.active) {
+        g_state.stats.deallocations++;
+        g_state.live -= static_cast<long long>(malloc_usable_size(p));
+    }
+    std::free(p);
+}
+
+} // namespace
+
+// Варианты с выравниванием и nothrow в libstdc++ сводятся к этим четырём
+// либо работают напрямую с aligned_alloc/free и не учитываются
+void* operator new(std::size_t size)   { return trackedAlloc(size); }
+void* operator new[](std::size_t size) { return trackedAlloc(size); }
+
+void operator delete(void* p) noexcept   { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept   { trackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { trackedFree(p); }
+
+#endif // SIGNAL_ALLOC_TRACKING
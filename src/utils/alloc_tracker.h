@@ -0,0 +1,58 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+/**
+ * Учёт выделений памяти кучи (по желанию, флаг сборки).
+ *
+ * При сборке с -DALLOC_TRACKING=ON (макрос SIGNAL_ALLOC_TRACKING) глобальные
+ * operator new / operator delete заменяются обёртками над malloc/free,
+ * которые считают выделения в текущем потоке, пока в нём открыт AllocScope.
+ * Без флага замены нет, allocTrackingEnabled() == false, а AllocScope
+ * возвращает нули — код замеров можно оставлять в программе.
+ *
+ * Пиковый объём — максимум «живых» байт, выделенных внутри области, по
+ * malloc_usable_size (он немного больше запрошенного). Освобождение памяти,
+ * выделенной до открытия области, уменьшает текущий объём, но не пик.
+ * Память, выделенная в одном потоке и освобождённая в другом, учитывается
+ * только в первом.
+ */
+
+#include <cstddef>
+
+/**
+ * Выделения за время жизни области
+ */
+struct AllocStats {
+    size_t allocations   = 0;   ///< Вызовы operator new
+    size_t deallocations = 0;   ///< Вызовы operator delete
+    size_t bytes         = 0;   ///< Запрошено байт суммарно
+    size_t peakBytes     = 0;   ///< Пик одновременно занятых байт
+};
+
+/** Учёт выделений собран в программу (SIGNAL_ALLOC_TRACKING) */
+bool allocTrackingEnabled();
+
+/**
+ * Область учёта выделений текущего потока
+ *
+ * Области можно вкладывать: выделения внутренней входят и во внешнюю.
+ */
+class AllocScope {
+public:
+    AllocScope();
+    ~AllocScope();
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+    /** Выделения с момента открытия области */
+    AllocStats stats() const;
+
+private:
+    bool        outerActive_;
+    long long   outerLive_;
+    long long   outerPeak_;
+    AllocStats  outer_;
+};
+
+#endif // ALLOC_TRACKER_H
@@ -0,0 +1,599 @@
+#include "bench_report.h"
+#include "alloc_tracker.h"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+// Задаются CMake для этого файла
+#ifndef BENCH_GIT_REVISION
+#define BENCH_GIT_REVISION "unknown"
+#endif
+#ifndef BENCH_BUILD_FLAGS
+#define BENCH_BUILD_FLAGS ""
+#endif
+
+namespace {
+
+/// Квантиль нормального распределения для двустороннего 95% ДИ
+constexpr double kZ95 = 1.96;
+
+/// Квантиль t-распределения для двустороннего 95% ДИ
+double tQuantile95(size_t dof) {
+    static constexpr double kTable[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    };
+    if (dof == 0) return 0.0;
+    return dof <= std::size(kTable) ? kTable[dof - 1] : kZ95;
+}
+
+std::string compilerVersion() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+    return "unknown";
+#endif
+}
+
+std::string cpuModelName() {
+    std::ifstream in("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(in, line)) {
+        // x86: "model name", ARM: "Model" / "Hardware"
+        if (line.rfind("model name", 0) == 0 || line.rfind("Model", 0) == 0 ||
+            line.rfind("Hardware", 0) == 0) {
+            const size_t colon = line.find(':');
+            if (colon == std::string::npos) continue;
+            const size_t start = line.find_first_not_of(" \t", colon + 1);
+            if (start != std::string::npos) return line.substr(start);
+        }
+    }
+    return "unknown";
+}
+
+/// Первая строка файла (пусто, если файла нет)
+std::string readFirstLine(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+std::vector<std::string> environmentWarnings() {
+    std::vector<std::string> warnings;
+
+#ifndef __OPTIMIZE__
+    warnings.push_back("сборка без оптимизации: время не отражает рабочую сборку");
+#endif
+    if (allocTrackingEnabled()) {
+        warnings.push_back("учёт выделений памяти (SIGNAL_ALLOC_TRACKING) замедляет operator new");
+    }
+
+    // Регулятор частоты: всё, кроме performance, меняет частоту под нагрузкой
+    std::vector<std::string> governors;
+    for (unsigned cpu = 0; ; ++cpu) {
+        const std::string governor = readFirstLine(
+            "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpufreq/scaling_governor");
+        if (governor.empty()) break;
+        if (governor != "performance" &&
+            std::find(governors.begin(), governors.end(), governor) == governors.end()) {
+            governors.push_back(governor);
+        }
+    }
+    for (const std::string& governor : governors) {
+        warnings.push_back("регулятор частоты \"" + governor +
+                           "\": частота плавает, нужен performance");
+    }
+
+    // Turbo Boost: частота зависит от температуры и числа занятых ядер
+    if (readFirstLine("/sys/devices/system/cpu/intel_pstate/no_turbo") == "0" ||
+        readFirstLine("/sys/devices/system/cpu/cpufreq/boost") == "1") {
+        warnings.push_back("Turbo Boost включён: частота зависит от нагрева и загрузки");
+    }
+    return warnings;
+}
+
+std::string utcTimestamp() {
+    const std::time_t now = std::time(nullptr);
+    std::tm tm{};
+    gmtime_r(&now, &tm);
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &tm);
+    return buf;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Запись JSON
+// ─────────────────────────────────────────────────────────────────────────────
+
+void appendString(std::string& out, const std::string& s) {
+    out += '"';
+    for (unsigned char c : s) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            case '\t': out += "\\t";  break;
+            default:
+                if (c < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += static_cast<char>(c);
+                }
+        }
+    }
+    out += '"';
+}
+
+void appendNumber(std::string& out, double value) {
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char buf[32];
+    const auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+void appendArray(std::string& out, const std::vector<double>& values) {
+    out += '[';
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i) out += ", ";
+        appendNumber(out, values[i]);
+    }
+    out += ']';
+}
+
+void appendKey(std::string& out, const char* indent, const char* key) {
+    out += indent;
+    appendString(out, key);
+    out += ": ";
+}
+
+void appendTiming(std::string& out, const TimingStats& t) {
+    out += "{\"samples\": ";
+    out += std::to_string(t.samples);
+    out += ", \"rejected\": ";
+    out += std::to_string(t.rejected);
+    const std::pair<const char*, double> fields[] = {
+        {"min_ns", t.minNs},   {"median_ns", t.medianNs}, {"mean_ns", t.meanNs},
+        {"p90_ns", t.p90Ns},   {"p99_ns", t.p99Ns},       {"max_ns", t.maxNs},
+        {"mad_ns", t.madNs},   {"relative_ci", t.relativeCI},
+    };
+    for (const auto& [key, value] : fields) {
+        out += ", ";
+        appendString(out, key);
+        out += ": ";
+        appendNumber(out, value);
+    }
+    out += '}';
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Чтение JSON
+// ─────────────────────────────────────────────────────────────────────────────
+
+using boost::property_tree::ptree;
+
+/// Число из узла; null — NaN
+double toDouble(const ptree& node) {
+    const std::string& s = node.data();
+    if (s == "null") return std::nan("");
+    double value = 0.0;
+    const auto res = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (res.ec != std::errc()) {
+        throw std::runtime_error("ожидалось число, получено \"" + s + "\"");
+    }
+    return value;
+}
+
+std::vector<double> toDoubles(const ptree& parent, const char* key) {
+    std::vector<double> values;
+    if (auto node = parent.get_child_optional(key)) {
+        for (const auto& item : *node) values.push_back(toDouble(item.second));
+    }
+    return values;
+}
+
+TimingStats toTiming(const ptree& node) {
+    TimingStats t;
+    t.samples    = node.get<size_t>("samples", 0);
+    t.rejected   = node.get<size_t>("rejected", 0);
+    auto field = [&](const char* key) {
+        auto child = node.get_child_optional(key);
+        return child ? toDouble(*child) : 0.0;
+    };
+    t.minNs      = field("min_ns");
+    t.medianNs   = field("median_ns");
+    t.meanNs     = field("mean_ns");
+    t.p90Ns      = field("p90_ns");
+    t.p99Ns      = field("p99_ns");
+    t.maxNs      = field("max_ns");
+    t.madNs      = field("mad_ns");
+    t.relativeCI = field("relative_ci");
+    return t;
+}
+
+/// Выровнять строку UTF-8 пробелами до width символов (setw считает байты)
+std::string padRight(const std::string& s, size_t width) {
+    const size_t chars = static_cast<size_t>(std::count_if(s.begin(), s.end(),
+        [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+    return chars >= width ? s : s + std::string(width - chars, ' ');
+}
+
+std::string padLeft(const std::string& s, size_t width) {
+    const size_t chars = static_cast<size_t>(std::count_if(s.begin(), s.end(),
+        [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+    return chars >= width ? s : std::string(width - chars, ' ') + s;
+}
+
+/// Среднее и СКО (несмещённое; 0 при n < 2)
+std::pair<double, double> meanAndStd(const std::vector<double>& values) {
+    if (values.empty()) return {0.0, 0.0};
+    double mean = 0.0;
+    for (double v : values) mean += v;
+    mean /= static_cast<double>(values.size());
+    if (values.size() < 2) return {mean, 0.0};
+    double var = 0.0;
+    for (double v : values) var += (v - mean) * (v - mean);
+    return {mean, std::sqrt(var / static_cast<double>(values.size() - 1))};
+}
+
+/**
+ * Логарифм медианы времени сигнала и полуширина его 95% ДИ
+ * @return {NaN, 0}, если времени нет
+ */
+std::pair<double, double> logMedianTime(const BenchEntry& entry, size_t signal) {
+    if (signal < entry.runMediansNs.size() && entry.runMediansNs[signal].size() >= 2) {
+        std::vector<double> logs;
+        for (double m : entry.runMediansNs[signal]) {
+            if (m > 0.0) logs.push_back(std::log(m));
+        }
+        if (logs.size() >= 2) {
+            const auto [mean, sd] = meanAndStd(logs);
+            const double n = static_cast<double>(logs.size());
+            return {mean, tQuantile95(logs.size() - 1) * sd / std::sqrt(n)};
+        }
+    }
+    if (signal >= entry.timings.size() || entry.timings[signal].medianNs <= 0.0) {
+        return {std::nan(""), 0.0};
+    }
+    // relativeCI — полуширина 95% ДИ медианы ≈ полуширина ДИ её логарифма
+    const TimingStats& t = entry.timings[signal];
+    return {std::log(t.medianNs), t.relativeCI};
+}
+
+} // namespace
+
+BenchEnvironment currentBenchEnvironment() {
+    BenchEnvironment env;
+    env.gitRevision     = BENCH_GIT_REVISION;
+    env.compiler        = compilerVersion();
+    env.buildFlags      = BENCH_BUILD_FLAGS;
+    env.cpuModel        = cpuModelName();
+    env.hardwareThreads = std::thread::hardware_concurrency();
+    env.allocTracking   = allocTrackingEnabled();
+    env.timestamp       = utcTimestamp();
+    env.warnings        = environmentWarnings();
+    return env;
+}
+
+const BenchEntry* BenchReport::find(const std::string& name) const {
+    for (const BenchEntry& entry : entries) {
+        if (entry.name == name) return &entry;
+    }
+    return nullptr;
+}
+
+void writeBenchJson(const std::string& filename, const BenchReport& report) {
+    std::string out;
+    out += "{\n";
+    appendKey(out, "  ", "benchmark");
+    appendString(out, report.benchmark);
+    out += ",\n";
+
+    const BenchEnvironment& env = report.environment;
+    appendKey(out, "  ", "environment");
+    out += "{\n";
+    const std::pair<const char*, const std::string*> strings[] = {
+        {"git_revision", &env.gitRevision}, {"compiler", &env.compiler},
+        {"build_flags", &env.buildFlags},   {"cpu_model", &env.cpuModel},
+        {"timestamp", &env.timestamp},
+    };
+    for (const auto& [key, value] : strings) {
+        appendKey(out, "    ", key);
+        appendString(out, *value);
+        out += ",\n";
+    }
+    appendKey(out, "    ", "hardware_threads");
+    out += std::to_string(env.hardwareThreads);
+    out += ",\n";
+    appendKey(out, "    ", "alloc_tracking");
+    out += env.allocTracking ? "true" : "false";
+    out += ",\n";
+    appendKey(out, "    ", "warnings");
+    out += '[';
+    for (size_t i = 0; i < env.warnings.size(); ++i) {
+        if (i) out += ", ";
+        appendString(out, env.warnings[i]);
+    }
+    out += "]\n  },\n";
+
+    appendKey(out, "  ", "signals");
+    out += '[';
+    for (size_t i = 0; i < report.signals.size(); ++i) {
+        if (i) out += ", ";
+        appendString(out, report.signals[i]);
+    }
+    out += "],\n";
+
+    appendKey(out, "  ", "entries");
+    out += "[\n";
+    for (size_t e = 0; e < report.entries.size(); ++e) {
+        const BenchEntry& entry = report.entries[e];
+        out += "    {\n";
+        appendKey(out, "      ", "name");
+        appendString(out, entry.name);
+        out += ",\n";
+        appendKey(out, "      ", "snr");
+        appendArray(out, entry.snr);
+        out += ",\n";
+        appendKey(out, "      ", "mse");
+        appendArray(out, entry.mse);
+        out += ",\n";
+        appendKey(out, "      ", "correlation");
+        appendArray(out, entry.correlation);
+        out += ",\n";
+        if (entry.hasAllocations) {
+            appendKey(out, "      ", "allocations");
+            appendNumber(out, entry.allocations);
+            out += ",\n";
+            appendKey(out, "      ", "peak_bytes");
+            appendNumber(out, entry.peakBytes);
+            out += ",\n";
+        }
+        if (!entry.runMediansNs.empty()) {
+            appendKey(out, "      ", "run_medians_ns");
+            out += '[';
+            for (size_t r = 0; r < entry.runMediansNs.size(); ++r) {
+                if (r) out += ", ";
+                appendArray(out, entry.runMediansNs[r]);
+            }
+            out += "],\n";
+        }
+        appendKey(out, "      ", "timings");
+        out += "[\n";
+        for (size_t s = 0; s < entry.timings.size(); ++s) {
+            out += "        ";
+            appendTiming(out, entry.timings[s]);
+            out += s + 1 < entry.timings.size() ? ",\n" : "\n";
+        }
+        out += "      ]\n";
+        out += e + 1 < report.entries.size() ? "    },\n" : "    }\n";
+    }
+    out += "  ]\n}\n";
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Не удалось создать файл: " + filename);
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    if (!file) {
+        throw std::runtime_error("Ошибка записи файла: " + filename);
+    }
+}
+
+BenchReport readBenchJson(const std::string& filename) {
+    ptree root;
+    try {
+        boost::property_tree::read_json(filename, root);
+    } catch (const boost::property_tree::json_parser_error& e) {
+        throw std::runtime_error("Ошибка разбора JSON " + filename + ": " + e.what());
+    }
+
+    BenchReport report;
+    try {
+        report.benchmark = root.get<std::string>("benchmark", "");
+
+        if (auto env = root.get_child_optional("environment")) {
+            BenchEnvironment& out = report.environment;
+            out.gitRevision     = env->get<std::string>("git_revision", "");
+            out.compiler        = env->get<std::string>("compiler", "");
+            out.buildFlags      = env->get<std::string>("build_flags", "");
+            out.cpuModel        = env->get<std::string>("cpu_model", "");
+            out.timestamp       = env->get<std::string>("timestamp", "");
+            out.hardwareThreads = env->get<unsigned>("hardware_threads", 0);
+            out.allocTracking   = env->get<bool>("alloc_tracking", false);
+            if (auto warnings = env->get_child_optional("warnings")) {
+                for (const auto& item : *warnings) out.warnings.push_back(item.second.data());
+            }
+        }
+
+        if (auto signals = root.get_child_optional("signals")) {
+            for (const auto& item : *signals) report.signals.push_back(item.second.data());
+        }
+
+        if (auto entries = root.get_child_optional("entries")) {
+            for (const auto& item : *entries) {
+                const ptree& node = item.second;
+                BenchEntry entry;
+                entry.name        = node.get<std::string>("name");
+                entry.snr         = toDoubles(node, "snr");
+                entry.mse         = toDoubles(node, "mse");
+                entry.correlation = toDoubles(node, "correlation");
+                if (auto timings = node.get_child_optional("timings")) {
+                    for (const auto& t : *timings) entry.timings.push_back(toTiming(t.second));
+                }
+                if (auto runs = node.get_child_optional("run_medians_ns")) {
+                    for (const auto& signal : *runs) {
+                        std::vector<double> medians;
+                        for (const auto& m : signal.second) medians.push_back(toDouble(m.second));
+                        entry.runMediansNs.push_back(std::move(medians));
+                    }
+                }
+                if (auto allocs = node.get_child_optional("allocations")) {
+                    entry.hasAllocations = true;
+                    entry.allocations    = toDouble(*allocs);
+                    if (auto peak = node.get_child_optional("peak_bytes")) {
+                        entry.peakBytes = toDouble(*peak);
+                    }
+                }
+                report.entries.push_back(std::move(entry));
+            }
+        }
+    } catch (const boost::property_tree::ptree_error& e) {
+        throw std::runtime_error("Неверная структура отчёта " + filename + ": " + e.what());
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error("Неверная структура отчёта " + filename + ": " + e.what());
+    }
+    return report;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Сравнение
+// ─────────────────────────────────────────────────────────────────────────────
+
+size_t BenchComparison::regressions() const {
+    return static_cast<size_t>(std::count_if(deltas.begin(), deltas.end(),
+        [](const BenchDelta& d) { return d.regressed(); }));
+}
+
+BenchComparison compareBenchReports(const BenchReport& baseline, const BenchReport& current,
+                                    const BenchThresholds& thresholds) {
+    BenchComparison cmp;
+    cmp.datasetMismatch = baseline.signals != current.signals;
+    cmp.cpuMismatch     = baseline.environment.cpuModel != current.environment.cpuModel;
+
+    for (const BenchEntry& base : baseline.entries) {
+        const BenchEntry* cur = current.find(base.name);
+        if (!cur) {
+            cmp.missing.push_back(base.name);
+            continue;
+        }
+
+        BenchDelta d;
+        d.name = base.name;
+
+        // Время: логарифмы отношений медиан по сигналам
+        std::vector<double> logRatios;
+        double measureVar = 0.0;
+        const size_t nt = std::min(base.timings.size(), cur->timings.size());
+        for (size_t s = 0; s < nt; ++s) {
+            const auto [logB, halfB] = logMedianTime(base, s);
+            const auto [logC, halfC] = logMedianTime(*cur, s);
+            if (std::isnan(logB) || std::isnan(logC)) continue;
+            logRatios.push_back(logC - logB);
+            measureVar += halfB * halfB + halfC * halfC;
+        }
+        d.signals = logRatios.size();
+        if (!logRatios.empty()) {
+            const double n = static_cast<double>(logRatios.size());
+            const auto [meanLog, stdLog] = meanAndStd(logRatios);
+            const double between = kZ95 * stdLog / std::sqrt(n);
+            const double measure = std::sqrt(measureVar) / n;
+            const double half    = std::sqrt(between * between + measure * measure);
+            d.timeRatio     = std::exp(meanLog);
+            d.timeRatioLow  = std::exp(meanLog - half);
+            d.timeRatioHigh = std::exp(meanLog + half);
+            d.slower        = d.timeRatioLow > 1.0 + thresholds.timeTolerance;
+        }
+
+        // SNR: разности по сигналам
+        std::vector<double> snrDiffs;
+        const size_t ns = std::min(base.snr.size(), cur->snr.size());
+        for (size_t s = 0; s < ns; ++s) {
+            const double diff = cur->snr[s] - base.snr[s];
+            if (std::isfinite(diff)) snrDiffs.push_back(diff);
+        }
+        if (!snrDiffs.empty()) {
+            const auto [meanDiff, stdDiff] = meanAndStd(snrDiffs);
+            d.snrDelta     = meanDiff;
+            d.snrDeltaHigh = meanDiff +
+                kZ95 * stdDiff / std::sqrt(static_cast<double>(snrDiffs.size()));
+            d.snrLoss      = d.snrDeltaHigh < -thresholds.snrTolerance;
+        }
+
+        // Выделения памяти считаются точно — любой рост есть регрессия
+        if (base.hasAllocations && cur->hasAllocations) {
+            d.allocDelta = cur->allocations - base.allocations;
+            d.moreAllocs = d.allocDelta > 1e-9;
+        }
+
+        cmp.deltas.push_back(std::move(d));
+    }
+
+    for (const BenchEntry& cur : current.entries) {
+        if (!baseline.find(cur.name)) cmp.added.push_back(cur.name);
+    }
+    return cmp;
+}
+
+std::string formatBenchComparison(const BenchComparison& comparison,
+                                  const BenchThresholds& thresholds) {
+    std::ostringstream out;
+
+    out << "=== СРАВНЕНИЕ С БАЗОВОЙ ЛИНИЕЙ ===\n";
+    out << "Допуски: время +" << std::fixed << std::setprecision(1)
+        << thresholds.timeTolerance * 100.0 << "%, SNR −"
+        << std::setprecision(2) << thresholds.snrTolerance << " дБ\n\n";
+
+    if (comparison.datasetMismatch) {
+        out << "ОШИБКА: наборы сигналов в отчётах различаются, сравнение некорректно\n\n";
+    }
+    if (comparison.cpuMismatch) {
+        out << "ВНИМАНИЕ: базовая линия снята на другом процессоре\n\n";
+    }
+
+    out << padRight("Конфигурация", 38) << padLeft("Время", 10) << padLeft("95% ДИ", 20)
+        << padLeft("Δ SNR(дБ)", 12) << padLeft("Δ выдел.", 10) << "  Итог\n";
+    out << std::string(100, '-') << "\n";
+
+    for (const BenchDelta& d : comparison.deltas) {
+        std::ostringstream ci;
+        ci << std::fixed << std::setprecision(3)
+           << "[" << d.timeRatioLow << ", " << d.timeRatioHigh << "]";
+
+        std::string verdict;
+        if (d.slower)     verdict += " медленнее";
+        if (d.snrLoss)    verdict += " SNR";
+        if (d.moreAllocs) verdict += " выделения";
+        if (verdict.empty()) verdict = " OK";
+
+        out << padRight(d.name, 38) << std::right << std::fixed
+            << std::setprecision(3) << std::setw(9) << d.timeRatio << "x"
+            << std::setw(20) << ci.str()
+            << std::showpos << std::setprecision(2) << std::setw(12) << d.snrDelta
+            << std::setprecision(1) << std::setw(10) << d.allocDelta << std::noshowpos
+            << " " << verdict << "\n";
+    }
+
+    for (const std::string& name : comparison.missing) {
+        out << "Нет в текущем отчёте: " << name << "\n";
+    }
+    for (const std::string& name : comparison.added) {
+        out << "Новая конфигурация:   " << name << "\n";
+    }
+
+    out << "\nРегрессий: " << comparison.regressions() << " из "
+        << comparison.deltas.size() << "\n";
+    return out.str();
+}
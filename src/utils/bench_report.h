@@ -0,0 +1,149 @@
+#ifndef BENCH_REPORT_H
+#define BENCH_REPORT_H
+
+/**
+ * Машиночитаемые результаты бенчмарков (JSON) и сравнение с базовой линией.
+ *
+ * Отчёт содержит окружение запуска (ревизия git, компилятор, флаги сборки,
+ * модель процессора) и для каждой конфигурации — метрики качества и полную
+ * статистику времени (TimingStats) по каждому сигналу.
+ *
+ * Сравнение сопоставляет сигналы по порядку. Для времени берётся среднее
+ * логарифмов отношений медиан current/baseline (геометрическое среднее
+ * отношений); его 95% ДИ складывается из разброса отношений между сигналами
+ * и неопределённости медиан каждого сигнала. Если бенчмарк повторялся
+ * несколькими прогонами (runMediansNs), неопределённость медианы оценивается
+ * по разбросу между прогонами (t-распределение) — он учитывает дрейф частоты
+ * и соседей по машине, которых не видно внутри одного прогона; иначе берётся
+ * ДИ медианы из TimingStats. Замедление значимо, если нижняя граница ДИ
+ * отношения превышает 1 + timeTolerance. Потеря SNR —
+ * аналогично по верхней границе ДИ средней разности SNR. Рост числа выделений
+ * памяти (подсчёт точный) считается регрессией при любом увеличении.
+ */
+
+#include "timing.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Окружение, в котором получены результаты
+ */
+struct BenchEnvironment {
+    std::string gitRevision;         ///< git describe на момент конфигурации сборки
+    std::string compiler;
+    std::string buildFlags;          ///< Тип сборки и флаги компилятора
+    std::string cpuModel;
+    unsigned    hardwareThreads = 0;
+    bool        allocTracking   = false;  ///< Сборка с SIGNAL_ALLOC_TRACKING
+    std::string timestamp;           ///< Время запуска, ISO 8601 UTC
+
+    /// Условия, искажающие замеры: сборка без оптимизации, регулятор частоты
+    /// не "performance", включённый Turbo Boost, учёт выделений памяти
+    std::vector<std::string> warnings;
+};
+
+/** Окружение текущей программы (вместе с предупреждениями о частоте процессора) */
+BenchEnvironment currentBenchEnvironment();
+
+/**
+ * Результаты одной конфигурации (алгоритм или цепочка) по всем сигналам
+ */
+struct BenchEntry {
+    std::string              name;
+    std::vector<double>      snr;          ///< SNR по сигналам, дБ
+    std::vector<double>      mse;
+    std::vector<double>      correlation;
+    std::vector<TimingStats> timings;      ///< Статистика времени по сигналам, нс
+
+    /// Медианы времени по сигналам в каждом из повторных прогонов, нс
+    /// (runMediansNs[signal][run]; пусто, если прогон был один)
+    std::vector<std::vector<double>> runMediansNs;
+
+    bool   hasAllocations = false;         ///< Выделения памяти подсчитаны
+    double allocations    = 0.0;           ///< Среднее число выделений на вызов
+    double peakBytes      = 0.0;           ///< Средний пик занятой памяти, байт
+};
+
+/**
+ * Отчёт бенчмарка
+ */
+struct BenchReport {
+    std::string              benchmark;    ///< Имя программы-источника
+    BenchEnvironment         environment;
+    std::vector<std::string> signals;      ///< Имена сигналов (порядок совпадает с BenchEntry)
+    std::vector<BenchEntry>  entries;
+
+    /** Конфигурация по имени (nullptr, если её нет) */
+    const BenchEntry* find(const std::string& name) const;
+};
+
+/**
+ * Записать отчёт в JSON. NaN и бесконечности пишутся как null
+ * @throws std::runtime_error если файл не удалось создать
+ */
+void writeBenchJson(const std::string& filename, const BenchReport& report);
+
+/**
+ * Прочитать отчёт, записанный writeBenchJson
+ * @throws std::runtime_error при ошибке чтения или разбора
+ */
+BenchReport readBenchJson(const std::string& filename);
+
+/**
+ * Допуски сравнения
+ */
+struct BenchThresholds {
+    double timeTolerance = 0.05;   ///< Допустимое замедление (доля медианы)
+    double snrTolerance  = 0.1;    ///< Допустимая потеря SNR, дБ
+};
+
+/**
+ * Сравнение одной конфигурации
+ */
+struct BenchDelta {
+    std::string name;
+    size_t      signals = 0;        ///< Сопоставленных сигналов
+    double timeRatio     = 1.0;     ///< Геометрическое среднее отношений медиан
+    double timeRatioLow  = 1.0;     ///< Границы 95% ДИ отношения
+    double timeRatioHigh = 1.0;
+    double snrDelta      = 0.0;     ///< Средняя разность SNR current − baseline, дБ
+    double snrDeltaHigh  = 0.0;     ///< Верхняя граница 95% ДИ разности
+    double allocDelta    = 0.0;     ///< Разность среднего числа выделений
+
+    bool slower    = false;         ///< Значимое замедление сверх допуска
+    bool snrLoss   = false;         ///< Значимая потеря SNR сверх допуска
+    bool moreAllocs = false;        ///< Выделений стало больше
+
+    bool regressed() const { return slower || snrLoss || moreAllocs; }
+};
+
+/**
+ * Итог сравнения отчётов
+ */
+struct BenchComparison {
+    std::vector<BenchDelta>  deltas;            ///< Конфигурации, есть в обоих отчётах
+    std::vector<std::string> missing;           ///< Есть только в базовой линии
+    std::vector<std::string> added;             ///< Есть только в текущем отчёте
+    bool datasetMismatch = false;               ///< Наборы сигналов различаются
+    bool cpuMismatch     = false;               ///< Базовая линия снята на другом процессоре
+
+    /** Число конфигураций с регрессией */
+    size_t regressions() const;
+
+    /** Сравнение не прошло: есть регрессии или наборы данных несопоставимы */
+    bool failed() const { return datasetMismatch || regressions() > 0; }
+};
+
+/**
+ * Сравнить текущие результаты с базовой линией
+ */
+BenchComparison compareBenchReports(const BenchReport& baseline, const BenchReport& current,
+                                    const BenchThresholds& thresholds = BenchThresholds());
+
+/** Текстовая таблица сравнения */
+std::string formatBenchComparison(const BenchComparison& comparison,
+                                  const BenchThresholds& thresholds = BenchThresholds());
+
+#endif // BENCH_REPORT_H
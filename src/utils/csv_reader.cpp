@@ -0,0 +1,125 @@
+#include "csv_reader.h"
+#include "mapped_file.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+/** Следующая строка без "\n" / "\r\n"; pos сдвигается на начало следующей */
+std::string_view nextLine(std::string_view text, size_t& pos) {
+    const char* begin = text.data() + pos;
+    const size_t rest = text.size() - pos;
+    const void* nl = std::memchr(begin, '\n', rest);
+    const size_t len = nl ? static_cast<size_t>(static_cast<const char*>(nl) - begin) : rest;
+    pos += nl ? len + 1 : len;
+    return std::string_view(begin, (len > 0 && begin[len - 1] == '\r') ? len - 1 : len);
+}
+
+/** Оценка числа строк для резервирования памяти */
+size_t countLines(std::string_view text) {
+    return static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1;
+}
+
+/**
+ * Разобрать число в начале поля (семантика std::stod: ведущие пробелы
+ * и знак '+' допустимы, хвост после числа игнорируется)
+ * @return false если в начале поля нет числа
+ */
+bool parseDouble(std::string_view field, double& value) {
+    const char* first = field.data();
+    const char* last  = first + field.size();
+    while (first != last && (*first == ' ' || *first == '\t')) ++first;
+    if (first != last && *first == '+') ++first;
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    return ec == std::errc() && ptr != first;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Вещественный сигнал "Index,Value"
+// ─────────────────────────────────────────────────────────────────────────────
+
+std::vector<double> parseSignalCSV(std::string_view text) {
+    TRACE_SCOPE("parseSignalCSV");
+    std::vector<double> signal;
+    if (text.empty()) return signal;
+
+    signal.reserve(countLines(text));
+
+    size_t pos = 0;
+    nextLine(text, pos); // заголовок
+
+    while (pos < text.size()) {
+        std::string_view line = nextLine(text, pos);
+
+        const size_t comma = line.find(',');
+        if (comma == std::string_view::npos || comma + 1 >= line.size()) continue;
+
+        double value = 0.0;
+        if (parseDouble(line.substr(comma + 1), value)) {
+            signal.push_back(value);
+        } else {
+            std::cerr << "Error parsing line: " << line << std::endl;
+        }
+    }
+
+    return signal;
+}
+
+std::vector<double> readSignalCSV(const std::string& filename) {
+    TRACE_SCOPE("readSignalCSV");
+    MappedFile file(filename);
+    return parseSignalCSV(file.view());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Комплексный сигнал "Re,Im"
+// ─────────────────────────────────────────────────────────────────────────────
+
+std::vector<std::complex<double>> parseComplexCSV(std::string_view text) {
+    TRACE_SCOPE("parseComplexCSV");
+    std::vector<std::complex<double>> result;
+    if (text.empty()) return result;
+
+    result.reserve(countLines(text));
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        std::string_view line = nextLine(text, pos);
+        if (line.empty() || line[0] == '#') continue;
+
+        const size_t comma = line.find(',');
+        std::string_view reField = line.substr(0, comma);
+
+        double re = 0.0, im = 0.0;
+        if (!parseDouble(reField, re)) {
+            throw std::invalid_argument("parseComplexCSV: не удалось разобрать строку: "
+                                        + std::string(line));
+        }
+
+        if (comma != std::string_view::npos && comma + 1 < line.size()) {
+            std::string_view imField = line.substr(comma + 1);
+            imField = imField.substr(0, imField.find(','));
+            if (!parseDouble(imField, im)) {
+                throw std::invalid_argument("parseComplexCSV: не удалось разобрать строку: "
+                                            + std::string(line));
+            }
+        }
+
+        result.emplace_back(re, im);
+    }
+
+    return result;
+}
+
+std::vector<std::complex<double>> readComplexCSV(const std::string& filename) {
+    TRACE_SCOPE("readComplexCSV");
+    MappedFile file(filename);
+    return parseComplexCSV(file.view());
+}
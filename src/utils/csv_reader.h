@@ -0,0 +1,48 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+/**
+ * Быстрое чтение сигналов из CSV.
+ *
+ * Файл отображается в память (MappedFile), числа разбираются
+ * std::from_chars прямо из буфера без построчных std::string,
+ * результат резервируется заранее по числу строк.
+ */
+
+#include <complex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Разобрать вещественный сигнал формата "Index,Value".
+ * Первая строка (заголовок) пропускается, индекс не разбирается.
+ * Строки без значения пропускаются молча, строки с нечисловым
+ * значением — с сообщением в std::cerr.
+ * @param text Содержимое CSV
+ * @return Значения второго столбца
+ */
+std::vector<double> parseSignalCSV(std::string_view text);
+
+/**
+ * Прочитать вещественный сигнал формата "Index,Value" из файла
+ * @throws std::runtime_error если файл не удалось открыть
+ */
+std::vector<double> readSignalCSV(const std::string& filename);
+
+/**
+ * Разобрать комплексный сигнал формата "Re,Im".
+ * Пустые строки и строки, начинающиеся с '#', пропускаются;
+ * строка из одного столбца трактуется как (Re, 0).
+ * @throws std::invalid_argument при нечисловом поле
+ */
+std::vector<std::complex<double>> parseComplexCSV(std::string_view text);
+
+/**
+ * Прочитать комплексный сигнал формата "Re,Im" из файла
+ * @throws std::runtime_error если файл не удалось открыть
+ * @throws std::invalid_argument при нечисловом поле
+ */
+std::vector<std::complex<double>> readComplexCSV(const std::string& filename);
+
+#endif // CSV_READER_H
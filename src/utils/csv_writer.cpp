@@ -0,0 +1,228 @@
+#include "csv_writer.h"
+#include "parallel.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr size_t kMaxNumberChars   = 32;      // "-1.2345678901234567e-308" с запасом
+constexpr size_t kParallelBlock    = 65536;   // отсчётов на блок форматирования
+constexpr size_t kMaxFixedChars    = 352;     // %.Nf для |x| до 1e308 плюс знаки
+constexpr size_t kTypicalLineChars = 32;      // начальная оценка длины строки
+
+/**
+ * Отформатировать строки [begin, end) в out, formatLine(char*, i) → конец строки
+ *
+ * Буфер рассчитывается на типичную строку, а не на худший случай
+ * (maxLineChars у формата %.Nf — сотни байт), и растёт вдвое, когда
+ * места остаётся меньше чем на одну строку худшего случая.
+ */
+template<typename FormatLine>
+void formatBlock(std::string& out, size_t begin, size_t end, size_t maxLineChars,
+                 FormatLine&& formatLine) {
+    out.resize(std::max(out.capacity(), (end - begin) * kTypicalLineChars + maxLineChars));
+    size_t used = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (out.size() - used < maxLineChars) out.resize(2 * out.size());
+        used = static_cast<size_t>(formatLine(out.data() + used, i) - out.data());
+    }
+    out.resize(used);
+}
+
+/**
+ * Записать строки [0, count) блоками; при нескольких потоках блоки
+ * форматируются параллельно и пишутся по порядку
+ */
+template<typename FormatLine>
+void writeLines(CsvWriter& writer, size_t count, size_t maxLineChars, size_t numThreads,
+                FormatLine&& formatLine) {
+    const size_t blocks  = (count + kParallelBlock - 1) / kParallelBlock;
+    const size_t threads = std::min(resolveThreadCount(numThreads), blocks);
+
+    if (threads <= 1) {
+        std::string block;
+        for (size_t b = 0; b < blocks; ++b) {
+            const size_t begin = b * kParallelBlock;
+            formatBlock(block, begin, std::min(count, begin + kParallelBlock),
+                        maxLineChars, formatLine);
+            writer.writeText(block);
+        }
+        return;
+    }
+
+    // Порциями по threads блоков, чтобы не держать весь файл в памяти
+    std::vector<std::string> parts(threads);
+    for (size_t first = 0; first < blocks; first += threads) {
+        const size_t n = std::min(threads, blocks - first);
+        parallelFor(n, threads, [&](size_t k) {
+            const size_t begin = (first + k) * kParallelBlock;
+            formatBlock(parts[k], begin, std::min(count, begin + kParallelBlock),
+                        maxLineChars, formatLine);
+        });
+        for (size_t k = 0; k < n; ++k) writer.writeText(parts[k]);
+    }
+}
+
+char* putIndex(char* p, uint64_t v) {
+    return std::to_chars(p, p + kMaxNumberChars, v).ptr;
+}
+
+char* putDouble(char* p, double v) {
+    return std::to_chars(p, p + kMaxNumberChars, v).ptr;
+}
+
+char* putFixed(char* p, double v, int precision) {
+    return std::to_chars(p, p + kMaxFixedChars, v, std::chars_format::fixed, precision).ptr;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CsvWriter
+// ─────────────────────────────────────────────────────────────────────────────
+
+CsvWriter::CsvWriter(const std::string& filename, size_t bufferSize)
+    : fd_(-1), filename_(filename), buffer_(std::max(bufferSize, kMaxFixedChars)), used_(0)
+{
+    fd_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot open file for writing: " + filename);
+    }
+}
+
+CsvWriter::~CsvWriter() {
+    if (fd_ >= 0) {
+        try {
+            close();
+        } catch (...) {
+            // деструктор не должен бросать исключения
+        }
+    }
+}
+
+void CsvWriter::writeAll(const char* data, size_t bytes) {
+    while (bytes > 0) {
+        const ssize_t n = ::write(fd_, data, bytes);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Error writing file: " + filename_);
+        }
+        data  += n;
+        bytes -= static_cast<size_t>(n);
+    }
+}
+
+char* CsvWriter::reserve(size_t n) {
+    if (buffer_.size() - used_ < n) flush();
+    return buffer_.data() + used_;
+}
+
+void CsvWriter::flush() {
+    if (used_ > 0) {
+        writeAll(buffer_.data(), used_);
+        used_ = 0;
+    }
+}
+
+void CsvWriter::close() {
+    if (fd_ < 0) return;
+    try {
+        flush();
+    } catch (...) {
+        ::close(fd_);
+        fd_ = -1;
+        throw;
+    }
+    const int rc = ::close(fd_);
+    fd_ = -1;
+    if (rc != 0) {
+        throw std::runtime_error("Error writing file: " + filename_);
+    }
+}
+
+CsvWriter& CsvWriter::writeText(std::string_view text) {
+    if (text.size() > buffer_.size() - used_) {
+        flush();
+        // Крупные блоки пишутся напрямую, минуя буфер
+        if (text.size() >= buffer_.size()) {
+            writeAll(text.data(), text.size());
+            return *this;
+        }
+    }
+    std::memcpy(buffer_.data() + used_, text.data(), text.size());
+    used_ += text.size();
+    return *this;
+}
+
+CsvWriter& CsvWriter::writeChar(char c) {
+    *reserve(1) = c;
+    ++used_;
+    return *this;
+}
+
+CsvWriter& CsvWriter::writeIndex(uint64_t value) {
+    char* p = reserve(kMaxNumberChars);
+    used_ += static_cast<size_t>(putIndex(p, value) - p);
+    return *this;
+}
+
+CsvWriter& CsvWriter::writeDouble(double value) {
+    char* p = reserve(kMaxNumberChars);
+    used_ += static_cast<size_t>(putDouble(p, value) - p);
+    return *this;
+}
+
+CsvWriter& CsvWriter::writeFixed(double value, int precision) {
+    char* p = reserve(kMaxFixedChars);
+    used_ += static_cast<size_t>(putFixed(p, value, precision) - p);
+    return *this;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Сигналы
+// ─────────────────────────────────────────────────────────────────────────────
+
+void writeSignalCSV(const std::string& filename, const std::vector<double>& signal,
+                    size_t numThreads) {
+    CsvWriter writer(filename);
+    writer.writeText("Index,Value\n");
+
+    writeLines(writer, signal.size(), 2 * kMaxNumberChars + 2, numThreads,
+               [&signal](char* p, size_t i) {
+                   p = putIndex(p, i);
+                   *p++ = ',';
+                   p = putDouble(p, signal[i]);
+                   *p++ = '\n';
+                   return p;
+               });
+
+    writer.close();
+}
+
+void writeComplexCSV(const std::string& filename,
+                     const std::vector<std::complex<double>>& signal,
+                     int precision, size_t numThreads) {
+    if (precision < 0 || precision > 17) {
+        throw std::invalid_argument("writeComplexCSV: точность должна быть в диапазоне [0, 17]");
+    }
+
+    CsvWriter writer(filename);
+
+    writeLines(writer, signal.size(), 2 * kMaxFixedChars + 2, numThreads,
+               [&signal, precision](char* p, size_t i) {
+                   p = putFixed(p, signal[i].real(), precision);
+                   *p++ = ',';
+                   p = putFixed(p, signal[i].imag(), precision);
+                   *p++ = '\n';
+                   return p;
+               });
+
+    writer.close();
+}
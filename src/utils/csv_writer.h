@@ -0,0 +1,88 @@
+#ifndef CSV_WRITER_H
+#define CSV_WRITER_H
+
+/**
+ * Быстрая запись CSV.
+ *
+ * Значения форматируются std::to_chars в большой буфер, который сбрасывается
+ * в файл одним системным вызовом write. Вещественные числа пишутся в
+ * кратчайшей форме, однозначно восстанавливающей double при чтении.
+ * Для длинных сигналов форматирование выполняется блоками в нескольких
+ * потоках, блоки записываются по порядку.
+ */
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CsvWriter {
+public:
+    static constexpr size_t kDefaultBufferSize = size_t(1) << 20;   // 1 МиБ
+
+    /**
+     * Создать (перезаписать) файл
+     * @throws std::runtime_error если файл не удалось создать
+     */
+    explicit CsvWriter(const std::string& filename, size_t bufferSize = kDefaultBufferSize);
+
+    /** Сбрасывает буфер и закрывает файл (ошибки игнорируются) */
+    ~CsvWriter();
+
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+
+    /** Дописать текст как есть */
+    CsvWriter& writeText(std::string_view text);
+
+    /** Дописать символ */
+    CsvWriter& writeChar(char c);
+
+    /** Целое без знака (индекс) */
+    CsvWriter& writeIndex(uint64_t value);
+
+    /** Вещественное число, кратчайшая точная запись */
+    CsvWriter& writeDouble(double value);
+
+    /** Вещественное число с фиксированным числом знаков после точки (как std::fixed) */
+    CsvWriter& writeFixed(double value, int precision);
+
+    /** Записать буфер в файл */
+    void flush();
+
+    /**
+     * Сбросить буфер и закрыть файл
+     * @throws std::runtime_error при ошибке записи
+     */
+    void close();
+
+private:
+    int               fd_;
+    std::string       filename_;
+    std::vector<char> buffer_;
+    size_t            used_;
+
+    /** Гарантировать n свободных байт в буфере */
+    char* reserve(size_t n);
+    void writeAll(const char* data, size_t bytes);
+};
+
+/**
+ * Записать вещественный сигнал в формате "Index,Value"
+ * @param numThreads Потоки форматирования (0 — по числу ядер)
+ * @throws std::runtime_error если файл не удалось создать
+ */
+void writeSignalCSV(const std::string& filename, const std::vector<double>& signal,
+                    size_t numThreads = 0);
+
+/**
+ * Записать комплексный сигнал в формате "Re,Im" с фиксированной точностью
+ * (совпадает с выводом std::fixed << std::setprecision(precision))
+ */
+void writeComplexCSV(const std::string& filename,
+                     const std::vector<std::complex<double>>& signal,
+                     int precision = 8, size_t numThreads = 0);
+
+#endif // CSV_WRITER_H
@@ -19,6 +19,8 @@
 #include <cmath>
 #include <stdexcept>
 
+#include "trace.h"
+
 using Complex = std::complex<double>;
 using CVector = std::vector<Complex>;
 
@@ -44,6 +46,7 @@ inline size_t nextPow2(size_t n) {
  */
 inline void fft_inplace(CVector& a, bool inv = false)
 {
+    TRACE_SCOPE("fft_inplace");
     const size_t n = a.size();
     if (!isPow2(n))
         throw std::invalid_argument("fft_inplace: size must be power of 2");
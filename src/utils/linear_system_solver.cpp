@@ -1,4 +1,5 @@
 #include "linear_system_solver.h"
+#include "trace.h"
 
 namespace ublas = boost::numeric::ublas;
 // ─────────────────────────────────────────────────────────────────────────────
@@ -8,6 +9,7 @@ ublas::vector<double> solveLinearSystem(
     ublas::matrix<double>  A,
     ublas::vector<double>  b
 ) {
+    TRACE_SCOPE("solveLinearSystem");
     using namespace boost::numeric::ublas;
 
     const size_t M = A.size1();
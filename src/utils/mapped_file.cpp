@@ -0,0 +1,125 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::align_val_t kBufferAlignment{64};
+constexpr size_t kReadBlockSize = size_t(1) << 20; // 1 МиБ
+
+char* allocateAligned(size_t bytes) {
+    return static_cast<char*>(::operator new(bytes == 0 ? 1 : bytes, kBufferAlignment));
+}
+
+} // namespace
+
+MappedFile::MappedFile(const std::string& filename, Access access)
+    : data_(""), size_(0), mapping_(nullptr), ownedBuffer_(nullptr)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + filename);
+    }
+
+    // ── Основной путь: отображение обычного непустого файла ─────────────────
+    if (S_ISREG(info.st_mode) && info.st_size > 0) {
+        const size_t length = static_cast<size_t>(info.st_size);
+        void* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            ::madvise(addr, length,
+                      access == Access::SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM);
+            mapping_ = addr;
+            data_    = static_cast<const char*>(addr);
+            size_    = length;
+            ::close(fd);
+            return;
+        }
+    }
+
+    // ── Запасной путь: чтение крупными блоками ──────────────────────────────
+    try {
+        readIntoBuffer(fd, filename);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, "")),
+      size_(std::exchange(other.size_, 0)),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      ownedBuffer_(std::exchange(other.ownedBuffer_, nullptr))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_        = std::exchange(other.data_, "");
+        size_        = std::exchange(other.size_, 0);
+        mapping_     = std::exchange(other.mapping_, nullptr);
+        ownedBuffer_ = std::exchange(other.ownedBuffer_, nullptr);
+    }
+    return *this;
+}
+
+void MappedFile::readIntoBuffer(int fd, const std::string& filename) {
+    std::vector<char> chunks;
+    chunks.reserve(kReadBlockSize);
+
+    size_t used = 0;
+    for (;;) {
+        if (chunks.size() < used + kReadBlockSize) {
+            chunks.resize(used + kReadBlockSize);
+        }
+        const ssize_t n = ::read(fd, chunks.data() + used, kReadBlockSize);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Error reading file: " + filename);
+        }
+        if (n == 0) break;
+        used += static_cast<size_t>(n);
+    }
+
+    ownedBuffer_ = allocateAligned(used);
+    if (used > 0) {
+        std::memcpy(ownedBuffer_, chunks.data(), used);
+    }
+    data_ = ownedBuffer_;
+    size_ = used;
+}
+
+void MappedFile::release() noexcept {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, size_);
+        mapping_ = nullptr;
+    }
+    if (ownedBuffer_ != nullptr) {
+        ::operator delete(ownedBuffer_, kBufferAlignment);
+        ownedBuffer_ = nullptr;
+    }
+    data_ = "";
+    size_ = 0;
+}
@@ -0,0 +1,59 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+/**
+ * Отображение файла в память только для чтения (POSIX mmap).
+ *
+ * Если файл нельзя отобразить (пустой файл, канал, спецфайл),
+ * содержимое читается крупными блоками в собственный буфер.
+ * В обоих случаях начало данных выровнено минимум на 64 байта.
+ */
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+class MappedFile {
+public:
+    /**
+     * Ожидаемый характер доступа (подсказка ядру через madvise)
+     */
+    enum class Access {
+        SEQUENTIAL,     // Однократный последовательный проход (парсинг CSV)
+        RANDOM          // Произвольный доступ (архивы, бинарные контейнеры)
+    };
+
+    /**
+     * Открыть и отобразить файл
+     * @param filename Имя файла
+     * @param access Характер доступа
+     * @throws std::runtime_error если файл не удалось открыть
+     */
+    explicit MappedFile(const std::string& filename, Access access = Access::SEQUENTIAL);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+
+    /** true — данные отображены через mmap, false — прочитаны в буфер */
+    bool isMapped() const { return mapping_ != nullptr; }
+
+private:
+    const char* data_;   ///< Начало данных (mmap или ownedBuffer_)
+    size_t      size_;   ///< Размер данных в байтах
+    void*       mapping_;     ///< Адрес отображения (nullptr при чтении в буфер)
+    char*       ownedBuffer_; ///< Выровненный буфер для запасного пути чтения
+
+    void readIntoBuffer(int fd, const std::string& filename);
+    void release() noexcept;
+};
+
+#endif // MAPPED_FILE_H
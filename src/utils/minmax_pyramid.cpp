@@ -0,0 +1,117 @@
+#include "minmax_pyramid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace {
+
+constexpr MinMaxPyramid::Range kEmptyRange{std::numeric_limits<float>::infinity(),
+                                           -std::numeric_limits<float>::infinity()};
+
+inline void merge(MinMaxPyramid::Range& r, const MinMaxPyramid::Range& other) {
+    r.min = std::min(r.min, other.min);
+    r.max = std::max(r.max, other.max);
+}
+
+} // namespace
+
+MinMaxPyramid::MinMaxPyramid(std::vector<double> samples)
+    : samples_(std::move(samples)) {
+    // Уровень 0 — только полные блоки: хвост короче kLeafSize
+    // просматривается по исходным отсчётам
+    std::vector<Range> level(samples_.size() / kLeafSize);
+    for (size_t b = 0; b < level.size(); ++b) {
+        Range r = kEmptyRange;
+        scan(b * kLeafSize, (b + 1) * kLeafSize, r);
+        level[b] = r;
+    }
+
+    while (!level.empty()) {
+        std::vector<Range> next(level.size() / 2);
+        for (size_t b = 0; b < next.size(); ++b) {
+            next[b] = level[2 * b];
+            merge(next[b], level[2 * b + 1]);
+        }
+        levels_.push_back(std::move(level));
+        level = std::move(next);
+    }
+}
+
+void MinMaxPyramid::scan(size_t first, size_t last, Range& r) const {
+    for (size_t i = first; i < last; ++i) {
+        const float v = static_cast<float>(samples_[i]);
+        // Сравнения с NaN ложны — NaN не меняет экстремумов
+        if (v < r.min) r.min = v;
+        if (v > r.max) r.max = v;
+    }
+}
+
+MinMaxPyramid::Range MinMaxPyramid::range(size_t first, size_t last) const {
+    Range r = kEmptyRange;
+    last = std::min(last, samples_.size());
+    if (first >= last) return r;
+
+    // Блоки нулевого уровня, целиком лежащие в [first, last)
+    size_t lo = (first + kLeafSize - 1) / kLeafSize;
+    size_t hi = last / kLeafSize;
+    if (lo >= hi) {
+        scan(first, last, r);
+        return r;
+    }
+    scan(first, lo * kLeafSize, r);
+    scan(hi * kLeafSize, last, r);
+
+    // Подъём по уровням, как в дереве отрезков: нечётные края берутся
+    // блоком текущего уровня, остальное — уровнем выше
+    for (size_t k = 0; lo < hi; ++k) {
+        const std::vector<Range>& level = levels_[k];
+        if (lo & 1) merge(r, level[lo++]);
+        if (hi & 1) merge(r, level[--hi]);
+        lo >>= 1;
+        hi >>= 1;
+    }
+    return r;
+}
+
+void MinMaxPyramid::decimate(size_t first, size_t last, size_t columns,
+                             std::vector<Point>& out) const {
+    out.clear();
+    last = std::min(last, samples_.size());
+    if (first >= last) return;
+    columns = std::max<size_t>(columns, 1);
+
+    const size_t count = last - first;
+    if (count <= 2 * columns) {
+        out.reserve(count);
+        for (size_t i = first; i < last; ++i) {
+            if (!std::isnan(samples_[i])) out.push_back({static_cast<double>(i), samples_[i]});
+        }
+        return;
+    }
+
+    out.reserve(2 * columns);
+    const double step = static_cast<double>(count) / static_cast<double>(columns);
+    for (size_t c = 0; c < columns; ++c) {
+        const size_t lo = first + static_cast<size_t>(c * step);
+        const size_t hi = c + 1 == columns ? last : first + static_cast<size_t>((c + 1) * step);
+        const Range r = range(lo, hi);
+        if (r.min > r.max) continue;   // Только NaN
+
+        const double x = 0.5 * static_cast<double>(lo + hi - 1);
+        if (c % 2 == 0) {
+            out.push_back({x, r.min});
+            out.push_back({x, r.max});
+        } else {
+            out.push_back({x, r.max});
+            out.push_back({x, r.min});
+        }
+    }
+}
+
+size_t MinMaxPyramid::memoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& level : levels_) bytes += level.size() * sizeof(Range);
+    return bytes;
+}
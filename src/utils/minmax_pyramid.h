@@ -0,0 +1,82 @@
+#ifndef MINMAX_PYRAMID_H
+#define MINMAX_PYRAMID_H
+
+/**
+ * Пирамида минимумов/максимумов для отрисовки длинных сигналов.
+ *
+ * Рисовать все 10⁷ отсчётов записи бессмысленно: на экране около двух
+ * тысяч столбцов пикселей, и в каждый попадают тысячи отсчётов. Достаточно
+ * для каждого столбца знать минимум и максимум его отсчётов — такая кривая
+ * выглядит так же, как полная (огибающая и все выбросы сохраняются).
+ *
+ * Уровень 0 пирамиды — (min, max) блоков по kLeafSize отсчётов, каждый
+ * следующий уровень объединяет пары блоков предыдущего. Экстремумы любого
+ * отрезка [first, last) находятся за O(kLeafSize + log N): неполные блоки по
+ * краям — по исходным отсчётам, остальное — не более чем двумя блоками на
+ * уровень. Пирамида занимает ~N/kLeafSize пар float поверх самих отсчётов.
+ *
+ * NaN при поиске экстремумов и прореживании пропускаются: отсчёты, ещё не
+ * посчитанные фоновым фильтром (BackgroundFilter), просто не рисуются.
+ */
+
+#include <cstddef>
+#include <vector>
+
+class MinMaxPyramid {
+public:
+    /// Отсчётов в блоке нулевого уровня
+    static constexpr size_t kLeafSize = 8;
+
+    struct Range {
+        float min;
+        float max;
+    };
+
+    /// Вершина прорежённой кривой: номер отсчёта (дробный — середина столбца) и значение
+    struct Point {
+        double index;
+        double value;
+    };
+
+    MinMaxPyramid() = default;
+
+    /** Построить по отсчётам (копируются — пирамида от них не зависит) */
+    explicit MinMaxPyramid(std::vector<double> samples);
+
+    const std::vector<double>& samples() const { return samples_; }
+    size_t size() const { return samples_.size(); }
+    bool empty() const { return samples_.empty(); }
+
+    /** Число уровней над исходными отсчётами */
+    size_t levels() const { return levels_.size(); }
+
+    /**
+     * Экстремумы отсчётов [first, last)
+     * Для пустого отрезка (или только NaN) — {+inf, −inf}
+     */
+    Range range(size_t first, size_t last) const;
+
+    /**
+     * Кривая отсчётов [first, last), прорежённая до columns столбцов
+     *
+     * Если отсчётов не больше 2·columns — они возвращаются как есть (кроме NaN). Иначе
+     * отрезок делится на columns столбцов и для каждого выдаются две вершины
+     * в его середине: минимум и максимум (в соседних столбцах — в обратном
+     * порядке, чтобы ломаная соединяла максимум с максимумом и минимум с
+     * минимумом, а не пересекала огибающую). Итого не более 2·columns вершин.
+     *
+     * @param out Результат (очищается; ёмкость переиспользуется)
+     */
+    void decimate(size_t first, size_t last, size_t columns, std::vector<Point>& out) const;
+
+    /** Память пирамиды без исходных отсчётов, байт */
+    size_t memoryBytes() const;
+
+private:
+    void scan(size_t first, size_t last, Range& r) const;
+
+    std::vector<double>             samples_;
+    std::vector<std::vector<Range>> levels_;
+};
+
+#endif // MINMAX_PYRAMID_H
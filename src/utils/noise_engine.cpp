@@ -0,0 +1,209 @@
+#include "noise_engine.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+/// Равномерное на [1, 2) из старших 52 бит — без преобразования int → double
+inline double unitInterval12(uint64_t bits) {
+    return std::bit_cast<double>((bits >> 12) | 0x3ff0000000000000ULL);
+}
+
+inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * Таблицы зиккурата для N(0, 1), 128 слоёв (Doornik, "An Improved Ziggurat
+ * Method to Generate Normal Random Samples", 2005)
+ */
+struct ZigguratTables {
+    static constexpr int    kLayers = 128;
+    static constexpr double kR      = 3.442619855899;           // Начало хвоста
+    static constexpr double kV      = 9.91256303526217e-3;      // Площадь слоя
+
+    double x[kLayers + 1];
+    double ratio[kLayers];      ///< x[i+1] / x[i] — порог быстрого пути
+
+    ZigguratTables() {
+        double f = std::exp(-0.5 * kR * kR);
+        x[0] = kV / f;          // Нижний слой вместе с хвостом
+        x[1] = kR;
+        x[kLayers] = 0.0;
+        for (int i = 2; i < kLayers; ++i) {
+            x[i] = std::sqrt(-2.0 * std::log(kV / x[i - 1] + f));
+            f = std::exp(-0.5 * x[i] * x[i]);
+        }
+        for (int i = 0; i < kLayers; ++i) ratio[i] = x[i + 1] / x[i];
+    }
+};
+
+const ZigguratTables& zigguratTables() {
+    static const ZigguratTables tables;
+    return tables;
+}
+
+/// u ∈ [-1, 1) из старших 52 бит
+inline double signedUnit(uint64_t bits) {
+    return 2.0 * unitInterval12(bits) - 3.0;
+}
+
+/// u ∈ (0, 1] из старших 52 бит
+inline double openUnit(uint64_t bits) {
+    return 2.0 - unitInterval12(bits);
+}
+
+} // namespace
+
+NoiseEngine::NoiseEngine(uint64_t seed)
+    : pos_(kBufferSize)
+{
+    Xoshiro256 base(seed);
+    auto lanes = Xoshiro256::streams(base, kLanes);
+    for (size_t l = 0; l < kLanes; ++l) {
+        // Начальное состояние дорожки — четыре первых значения её jump-потока
+        Xoshiro256& lane = lanes[l];
+        s0_[l] = lane();
+        s1_[l] = lane();
+        s2_[l] = lane();
+        s3_[l] = lane();
+        if ((s0_[l] | s1_[l] | s2_[l] | s3_[l]) == 0) s0_[l] = 1;
+    }
+
+    base.longJump();
+    aux_ = base;
+}
+
+void NoiseEngine::refill() {
+    for (size_t r = 0; r < kRows; ++r) {
+        uint64_t* row = buffer_ + r * kLanes;
+        // Цикл по дорожкам без зависимостей между итерациями — векторизуется
+        for (size_t l = 0; l < kLanes; ++l) {
+            const uint64_t s1 = s1_[l];
+            const uint64_t x5 = (s1 << 2) + s1;
+            const uint64_t rot = rotl(x5, 7);
+            row[l] = (rot << 3) + rot;
+
+            const uint64_t t = s1 << 17;
+            s2_[l] ^= s0_[l];
+            s3_[l] ^= s1;
+            s1_[l] = s1 ^ s2_[l];
+            s0_[l] ^= s3_[l];
+            s2_[l] ^= t;
+            s3_[l] = rotl(s3_[l], 45);
+        }
+    }
+    pos_ = 0;
+}
+
+void NoiseEngine::nextRaw(uint64_t* out, size_t n) {
+    while (n > 0) {
+        if (pos_ == kBufferSize) refill();
+        const size_t take = std::min(n, kBufferSize - pos_);
+        std::memcpy(out, buffer_ + pos_, take * sizeof(uint64_t));
+        pos_ += take;
+        out  += take;
+        n    -= take;
+    }
+}
+
+void NoiseEngine::fillUniform(std::span<double> out, double lo, double hi) {
+    alignas(64) uint64_t raw[kChunk];
+    const double scale = hi - lo;
+    const double base  = lo - scale;     // (x - 1)·scale + lo, x ∈ [1, 2)
+
+    for (size_t i = 0; i < out.size(); i += kChunk) {
+        const size_t n = std::min(kChunk, out.size() - i);
+        nextRaw(raw, n);
+        double* dst = out.data() + i;
+        for (size_t k = 0; k < n; ++k) dst[k] = base + scale * unitInterval12(raw[k]);
+    }
+}
+
+void NoiseEngine::gaussianChunk(double* out, size_t n) {
+    const ZigguratTables& zig = zigguratTables();
+    alignas(64) uint64_t raw[kChunk];
+    nextRaw(raw, n);
+
+    // Быстрый путь (~99% отсчётов): одно значение дорожки на отсчёт,
+    // младшие 7 бит — слой, старшие 52 — координата внутри слоя
+    for (size_t k = 0; k < n; ++k) {
+        const unsigned layer = static_cast<unsigned>(raw[k] & 0x7f);
+        const double   u     = signedUnit(raw[k]);
+        out[k] = (std::fabs(u) < zig.ratio[layer]) ? u * zig.x[layer]
+                                                   : slowGaussian(layer, u);
+    }
+}
+
+double NoiseEngine::slowGaussian(unsigned layer, double u) {
+    const ZigguratTables& zig = zigguratTables();
+
+    // Повторные попытки берут значения из aux_, поэтому основной поток
+    // расходует ровно одно значение на отсчёт
+    for (;;) {
+        if (std::fabs(u) < zig.ratio[layer]) return u * zig.x[layer];
+
+        if (layer == 0) {
+            // Хвост |x| > R (Marsaglia, 1964)
+            double x, y;
+            do {
+                x = std::log(openUnit(aux_())) / ZigguratTables::kR;
+                y = std::log(openUnit(aux_()));
+            } while (-2.0 * y < x * x);
+            return (u < 0.0) ? x - ZigguratTables::kR : ZigguratTables::kR - x;
+        }
+
+        // Клин между прямоугольниками слоёв
+        const double x  = u * zig.x[layer];
+        const double f0 = std::exp(-0.5 * (zig.x[layer] * zig.x[layer] - x * x));
+        const double f1 = std::exp(-0.5 * (zig.x[layer + 1] * zig.x[layer + 1] - x * x));
+        if (f1 + (unitInterval12(aux_()) - 1.0) * (f0 - f1) < 1.0) return x;
+
+        const uint64_t bits = aux_();
+        layer = static_cast<unsigned>(bits & 0x7f);
+        u     = signedUnit(bits);
+    }
+}
+
+void NoiseEngine::fillGaussian(std::span<double> out, double mean, double stddev) {
+    for (size_t i = 0; i < out.size(); i += kChunk) {
+        const size_t n = std::min(kChunk, out.size() - i);
+        double* dst = out.data() + i;
+        gaussianChunk(dst, n);
+        for (size_t k = 0; k < n; ++k) dst[k] = mean + stddev * dst[k];
+    }
+}
+
+void NoiseEngine::addGaussian(std::span<double> inout, double stddev) {
+    alignas(64) double g[kChunk];
+    for (size_t i = 0; i < inout.size(); i += kChunk) {
+        const size_t n = std::min(kChunk, inout.size() - i);
+        gaussianChunk(g, n);
+        double* dst = inout.data() + i;
+        for (size_t k = 0; k < n; ++k) dst[k] += stddev * g[k];
+    }
+}
+
+void NoiseEngine::addImpulses(std::span<double> inout, double density,
+                              double minAmplitude, double maxAmplitude) {
+    alignas(64) uint64_t raw[kChunk];
+    // u = m·2⁻⁵², m — старшие 52 бита; u < density  ⇔  m < density·2⁵²
+    const uint64_t limit = static_cast<uint64_t>(std::clamp(density, 0.0, 1.0) * 0x1.0p52);
+    const double   span  = maxAmplitude - minAmplitude;
+
+    for (size_t i = 0; i < inout.size(); i += kChunk) {
+        const size_t n = std::min(kChunk, inout.size() - i);
+        nextRaw(raw, n);
+        double* dst = inout.data() + i;
+        for (size_t k = 0; k < n; ++k) {
+            if ((raw[k] >> 12) < limit) {
+                const uint64_t bits = aux_();
+                const double amp = minAmplitude + span * (unitInterval12(bits) - 1.0);
+                dst[k] += (bits & 1) ? amp : -amp;
+            }
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef NOISE_ENGINE_H
+#define NOISE_ENGINE_H
+
+/**
+ * Быстрая генерация шума целыми буферами.
+ *
+ * Восемь независимых потоков xoshiro256** (jump-разнесённых от одного seed)
+ * хранятся в виде структуры массивов: шаг всех потоков — один цикл по
+ * дорожкам без зависимостей, который компилятор векторизует. Равномерные
+ * числа получаются из битов без целочисленно-вещественного преобразования,
+ * гауссовы — методом зиккурата (одно значение дорожки на отсчёт; редкие
+ * отказы дополняются из отдельного скалярного потока).
+ *
+ * Последовательность значений зависит только от seed и не зависит от того,
+ * какими порциями её запрашивают: fillGaussian(a) + fillGaussian(b) даёт то же,
+ * что fillGaussian(a + b). Поэтому движок подходит и для пакетной, и для
+ * потоковой (поблочной) генерации.
+ */
+
+#include "random.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+class NoiseEngine {
+public:
+    /** Число независимых дорожек ГСЧ */
+    static constexpr size_t kLanes = 8;
+
+    explicit NoiseEngine(uint64_t seed = 0);
+
+    /** Равномерный шум на [lo, hi) */
+    void fillUniform(std::span<double> out, double lo = 0.0, double hi = 1.0);
+
+    /** Гауссов шум N(mean, stddev²) */
+    void fillGaussian(std::span<double> out, double mean = 0.0, double stddev = 1.0);
+
+    /** Прибавить гауссов шум N(0, stddev²) */
+    void addGaussian(std::span<double> inout, double stddev);
+
+    /**
+     * Прибавить случайные выбросы: каждый отсчёт с вероятностью density
+     * получает ±A, A равномерно на [minAmplitude, maxAmplitude], знак случаен
+     */
+    void addImpulses(std::span<double> inout, double density,
+                     double minAmplitude, double maxAmplitude);
+
+private:
+    static constexpr size_t kRows       = 64;                 ///< Шагов на одно пополнение
+    static constexpr size_t kBufferSize = kRows * kLanes;     ///< 512 значений
+    static constexpr size_t kChunk      = 512;                ///< Отсчётов на блок преобразования
+
+    alignas(64) uint64_t s0_[kLanes];
+    alignas(64) uint64_t s1_[kLanes];
+    alignas(64) uint64_t s2_[kLanes];
+    alignas(64) uint64_t s3_[kLanes];
+
+    alignas(64) uint64_t buffer_[kBufferSize];
+    size_t               pos_;
+
+    Xoshiro256 aux_;            ///< Редкие значения (отказы зиккурата, параметры выбросов)
+
+    /** Заполнить buffer_ новыми значениями всех дорожек */
+    void refill();
+
+    /** Следующие n сырых 64-битных значений */
+    void nextRaw(uint64_t* out, size_t n);
+
+    /** Сгенерировать n гауссовых N(0, 1) в out (n ≤ kChunk) */
+    void gaussianChunk(double* out, size_t n);
+
+    /** Медленный путь зиккурата: клин, хвост и повторные попытки */
+    double slowGaussian(unsigned layer, double u);
+};
+
+#endif // NOISE_ENGINE_H
@@ -0,0 +1,161 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/**
+ * Простейший параллельный цикл на std::thread.
+ *
+ * Итерации раздаются потокам динамически (атомарный счётчик), поэтому
+ * неравномерная стоимость итераций не приводит к простою.
+ * Первое исключение из тела цикла пробрасывается в вызывающий поток.
+ *
+ * Для замеров времени рабочие потоки можно закрепить за ядрами
+ * (parallelForWorkers с pinThreads = true): поток не мигрирует между
+ * ядрами и не делит ядро с соседним рабочим.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Число потоков по умолчанию
+ * @param requested Запрошенное число (0 — по числу ядер)
+ */
+inline size_t resolveThreadCount(size_t requested) {
+    if (requested > 0) return requested;
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+/**
+ * Ядра, на которых процессу разрешено выполняться (номера CPU по порядку).
+ * Без поддержки привязки — пустой список.
+ */
+inline std::vector<int> availableCpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+#endif
+    return cpus;
+}
+
+/**
+ * Закрепить текущий поток за ядром cpu на время жизни объекта;
+ * деструктор восстанавливает прежнюю маску. Ядро может быть и вне маски
+ * процесса (например, изолированное через isolcpus).
+ */
+class ScopedThreadPin {
+public:
+    explicit ScopedThreadPin(int cpu) {
+#ifdef __linux__
+        if (cpu < 0 || cpu >= CPU_SETSIZE) return;
+        if (pthread_getaffinity_np(pthread_self(), sizeof(saved_), &saved_) != 0) return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pinned_ = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)cpu;
+#endif
+    }
+
+    ~ScopedThreadPin() {
+#ifdef __linux__
+        if (pinned_) pthread_setaffinity_np(pthread_self(), sizeof(saved_), &saved_);
+#endif
+    }
+
+    ScopedThreadPin(const ScopedThreadPin&) = delete;
+    ScopedThreadPin& operator=(const ScopedThreadPin&) = delete;
+
+    /** Закрепление удалось */
+    bool pinned() const { return pinned_; }
+
+private:
+    bool pinned_ = false;
+#ifdef __linux__
+    cpu_set_t saved_;
+#endif
+};
+
+/**
+ * Выполнить fn(worker, i) для i ∈ [0, count)
+ * @param count Число итераций
+ * @param numThreads Число потоков (0 — по числу ядер)
+ * @param pinThreads Закрепить рабочий поток w за w-м доступным ядром
+ *                   (по модулю их числа)
+ * @param fn Тело цикла, вызывается как fn(size_t worker, size_t i),
+ *           worker ∈ [0, числа потоков) — для данных, своих у каждого потока
+ */
+template<typename Fn>
+void parallelForWorkers(size_t count, size_t numThreads, bool pinThreads, Fn&& fn) {
+    if (count == 0) return;
+
+    const size_t workers = std::min(resolveThreadCount(numThreads), count);
+    const std::vector<int> cpus = pinThreads ? availableCpus() : std::vector<int>();
+    auto cpuFor = [&cpus](size_t worker) {
+        return cpus.empty() ? -1 : cpus[worker % cpus.size()];
+    };
+
+    if (workers == 1) {
+        ScopedThreadPin pin(cpuFor(0));
+        for (size_t i = 0; i < count; ++i) fn(size_t(0), i);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr  error;
+    std::mutex          errorMutex;
+
+    auto worker = [&](size_t w) {
+        ScopedThreadPin pin(cpuFor(w));
+        for (;;) {
+            const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count) return;
+            try {
+                fn(w, i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+                next.store(count, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t t = 1; t < workers; ++t) threads.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : threads) th.join();
+
+    if (error) std::rethrow_exception(error);
+}
+
+/**
+ * Выполнить fn(i) для i ∈ [0, count)
+ * @param count Число итераций
+ * @param numThreads Число потоков (0 — по числу ядер)
+ * @param fn Тело цикла, вызывается как fn(size_t i)
+ */
+template<typename Fn>
+void parallelFor(size_t count, size_t numThreads, Fn&& fn) {
+    parallelForWorkers(count, numThreads, false, [&fn](size_t, size_t i) { fn(i); });
+}
+
+#endif // PARALLEL_H
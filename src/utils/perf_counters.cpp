@@ -0,0 +1,179 @@
+#include "perf_counters.h"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdint>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char* perfEventName(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::CYCLES:        return "Cycles";
+        case PerfEvent::INSTRUCTIONS:  return "Instructions";
+        case PerfEvent::L1D_MISSES:    return "L1D_Misses";
+        case PerfEvent::LLC_MISSES:    return "LLC_Misses";
+        case PerfEvent::BRANCH_MISSES: return "Branch_Misses";
+        case PerfEvent::COUNT:         break;
+    }
+    return "Unknown";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// PerfCounterValues
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool PerfCounterValues::any() const {
+    for (bool v : valid) {
+        if (v) return true;
+    }
+    return false;
+}
+
+double PerfCounterValues::ipc() const {
+    if (!has(PerfEvent::CYCLES) || !has(PerfEvent::INSTRUCTIONS)) return 0.0;
+    const double cycles = get(PerfEvent::CYCLES);
+    return cycles > 0.0 ? get(PerfEvent::INSTRUCTIONS) / cycles : 0.0;
+}
+
+PerfCounterValues& PerfCounterValues::operator+=(const PerfCounterValues& other) {
+    for (size_t i = 0; i < kPerfEventCount; ++i) {
+        values[i] += other.values[i];
+        valid[i] = valid[i] && other.valid[i];
+    }
+    return *this;
+}
+
+PerfCounterValues& PerfCounterValues::operator/=(double divisor) {
+    if (divisor > 0.0) {
+        for (double& v : values) v /= divisor;
+    }
+    return *this;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// PerfCounters
+// ─────────────────────────────────────────────────────────────────────────────
+
+#ifdef __linux__
+
+namespace {
+
+struct EventConfig {
+    uint32_t type;
+    uint64_t config;
+};
+
+EventConfig eventConfig(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::CYCLES:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+        case PerfEvent::INSTRUCTIONS:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+        case PerfEvent::L1D_MISSES:
+            return {PERF_TYPE_HW_CACHE,
+                    PERF_COUNT_HW_CACHE_L1D |
+                    (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+        case PerfEvent::LLC_MISSES:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+        case PerfEvent::BRANCH_MISSES:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+        case PerfEvent::COUNT:
+            break;
+    }
+    return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+}
+
+int openEvent(PerfEvent event) {
+    const EventConfig ec = eventConfig(event);
+
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = ec.type;
+    attr.config         = ec.config;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // pid = 0, cpu = -1: текущий поток на любом ядре
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+    int lastErrno = 0;
+    for (size_t i = 0; i < kPerfEventCount; ++i) {
+        fds_[i] = openEvent(static_cast<PerfEvent>(i));
+        if (fds_[i] < 0) lastErrno = errno;
+    }
+    if (!available()) {
+        error_ = std::string("perf_event_open: ") + std::strerror(lastErrno);
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+bool PerfCounters::available() const {
+    for (int fd : fds_) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+void PerfCounters::start() {
+    for (int fd : fds_) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+PerfCounterValues PerfCounters::stop() {
+    for (int fd : fds_) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    PerfCounterValues result;
+    for (size_t i = 0; i < kPerfEventCount; ++i) {
+        if (fds_[i] < 0) continue;
+
+        // value, time_enabled, time_running
+        uint64_t data[3] = {0, 0, 0};
+        if (read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        if (data[2] == 0) continue;   // счётчик так и не получил аппаратный регистр
+
+        result.values[i] = static_cast<double>(data[0]) *
+                           (static_cast<double>(data[1]) / static_cast<double>(data[2]));
+        result.valid[i] = true;
+    }
+    return result;
+}
+
+#else // !__linux__
+
+PerfCounters::PerfCounters() : error_("аппаратные счётчики поддерживаются только в Linux") {
+    fds_.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+bool PerfCounters::available() const { return false; }
+
+void PerfCounters::start() {}
+
+PerfCounterValues PerfCounters::stop() { return PerfCounterValues(); }
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+/**
+ * Аппаратные счётчики производительности (Linux perf_event_open).
+ *
+ * Счётчики открываются для вызывающего потока и считают только
+ * пользовательский код (exclude_kernel), поэтому работают при
+ * perf_event_paranoid ≤ 2 без прав root. Каждое событие открывается
+ * отдельно: если какое-то из них не поддерживается (виртуальная машина,
+ * контейнер, другая архитектура), остальные продолжают работать. При
+ * мультиплексировании значения масштабируются на долю времени, в течение
+ * которой счётчик был активен.
+ *
+ * На других платформах и при запрете perf_event_open available() == false,
+ * а stop() возвращает значения без единого действительного счётчика.
+ */
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+/**
+ * Измеряемые события
+ */
+enum class PerfEvent {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES,       ///< Промахи чтения L1 данных
+    LLC_MISSES,       ///< Промахи последнего уровня кэша
+    BRANCH_MISSES,    ///< Неверно предсказанные переходы
+    COUNT
+};
+
+constexpr size_t kPerfEventCount = static_cast<size_t>(PerfEvent::COUNT);
+
+/** Короткое имя события для отчётов ("Cycles", "LLC_Misses", ...) */
+const char* perfEventName(PerfEvent event);
+
+/**
+ * Показания счётчиков. Недоступное событие помечено valid[i] == false
+ */
+struct PerfCounterValues {
+    std::array<double, kPerfEventCount> values{};
+    std::array<bool, kPerfEventCount>   valid{};
+
+    bool   has(PerfEvent e) const { return valid[static_cast<size_t>(e)]; }
+    double get(PerfEvent e) const { return values[static_cast<size_t>(e)]; }
+
+    /** Есть хотя бы одно действительное событие */
+    bool any() const;
+
+    /** Инструкций за такт (0, если циклы или инструкции недоступны) */
+    double ipc() const;
+
+    /** Сложить показания; событие действительно, если действительно в обоих */
+    PerfCounterValues& operator+=(const PerfCounterValues& other);
+
+    /** Разделить все значения (например, на число вызовов) */
+    PerfCounterValues& operator/=(double divisor);
+};
+
+/**
+ * Набор счётчиков текущего потока
+ *
+ * Объект привязан к потоку, в котором создан: start()/stop() нужно вызывать
+ * из него же.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /** Удалось открыть хотя бы один счётчик */
+    bool available() const;
+
+    /** Причина недоступности (пусто, если всё открылось) */
+    const std::string& error() const { return error_; }
+
+    /** Обнулить и запустить счётчики */
+    void start();
+
+    /** Остановить счётчики и вернуть показания с момента start() */
+    PerfCounterValues stop();
+
+private:
+    std::array<int, kPerfEventCount> fds_;
+    std::string                      error_;
+};
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,122 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+/**
+ * Генератор псевдослучайных чисел xoshiro256** с переходом вперёд.
+ *
+ * jump() сдвигает состояние на 2^128 шагов, longJump() — на 2^192, поэтому
+ * из одного seed получаются непересекающиеся независимые потоки: поток i —
+ * базовое состояние после i вызовов jump(). Это позволяет генерировать
+ * сигналы набора параллельно с одинаковым результатом при любом числе
+ * потоков.
+ *
+ * Удовлетворяет требованиям UniformRandomBitGenerator и используется
+ * со стандартными распределениями <random>.
+ */
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /** Состояние заполняется из seed через splitmix64 (никогда не нулевое) */
+    explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t value) {
+        for (auto& word : s_) word = splitmix64(value);
+    }
+
+    result_type operator()() {
+        const uint64_t result = std::rotl(s_[1] * 5, 7) * 9;
+        const uint64_t t = s_[1] << 17;
+
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = std::rotl(s_[3], 45);
+
+        return result;
+    }
+
+    /** Пропустить n значений */
+    void discard(unsigned long long n) {
+        while (n--) (*this)();
+    }
+
+    /** Эквивалентно 2^128 вызовам operator() */
+    void jump() {
+        static constexpr uint64_t kJump[] = {
+            0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+            0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+        };
+        applyJump(kJump);
+    }
+
+    /** Эквивалентно 2^192 вызовам operator() */
+    void longJump() {
+        static constexpr uint64_t kLongJump[] = {
+            0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+            0x77710069854ee241ULL, 0x39109bb02acbe635ULL
+        };
+        applyJump(kLongJump);
+    }
+
+    friend bool operator==(const Xoshiro256& a, const Xoshiro256& b) {
+        return a.s_[0] == b.s_[0] && a.s_[1] == b.s_[1] &&
+               a.s_[2] == b.s_[2] && a.s_[3] == b.s_[3];
+    }
+
+    /**
+     * count независимых потоков: base, base после jump(), после двух jump() и т.д.
+     */
+    static std::vector<Xoshiro256> streams(Xoshiro256 base, size_t count) {
+        std::vector<Xoshiro256> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            result.push_back(base);
+            base.jump();
+        }
+        return result;
+    }
+
+private:
+    uint64_t s_[4];
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    void applyJump(const uint64_t (&poly)[4]) {
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (uint64_t word : poly) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (uint64_t(1) << b)) {
+                    t[0] ^= s_[0];
+                    t[1] ^= s_[1];
+                    t[2] ^= s_[2];
+                    t[3] ^= s_[3];
+                }
+                (*this)();
+            }
+        }
+        s_[0] = t[0];
+        s_[1] = t[1];
+        s_[2] = t[2];
+        s_[3] = t[3];
+    }
+};
+
+#endif // RANDOM_H
@@ -0,0 +1,75 @@
+#ifndef SCROLL_RING_H
+#define SCROLL_RING_H
+
+/**
+ * Разметка «зеркального» кольцевого буфера для прокручиваемой кривой.
+ *
+ * Буфер из 2·N ячеек (N — отсчётов на ширину окна); отсчёт с номером t
+ * хранится дважды — в ячейках t mod N и t mod N + N. Поэтому последние
+ * min(t, N) отсчётов всегда лежат подряд и рисуются одним вызовом
+ * glDrawArrays(first(), visible()) без шва на границе кольца, а при
+ * добавлении блока в буфер пишутся только новые отсчёты (не более четырёх
+ * непрерывных отрезков на блок).
+ *
+ * Сам буфер здесь не хранится — только номера ячеек; запись выполняет
+ * вызывающий (в SignalVisualizer — glBufferSubData в VBO).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+class ScrollRing {
+public:
+    explicit ScrollRing(size_t capacity = 1) : capacity_(capacity) {
+        if (capacity == 0) throw std::invalid_argument("ScrollRing: capacity must be positive");
+    }
+
+    /** N — отсчётов на ширину окна (ячеек в буфере — 2·N) */
+    size_t capacity() const { return capacity_; }
+
+    /** Отсчётов добавлено за всё время */
+    uint64_t total() const { return total_; }
+
+    /** Видимых отсчётов: min(total, N) */
+    size_t visible() const { return static_cast<size_t>(std::min<uint64_t>(total_, capacity_)); }
+
+    /** Ячейка самого старого видимого отсчёта; видимые — [first(), first() + visible()) */
+    size_t first() const { return total_ < capacity_ ? 0 : static_cast<size_t>(total_ % capacity_); }
+
+    /** Ячейка самого нового отсчёта (при total() > 0) */
+    size_t newest() const { return first() + visible() - 1; }
+
+    /**
+     * Добавить count отсчётов блока
+     *
+     * Для каждого непрерывного отрезка ячеек вызывается
+     * write(cell, index, n): отсчёты блока [index, index + n) пишутся в
+     * ячейки [cell, cell + n). Из блока длиннее N пишутся только последние N.
+     */
+    template<typename Write>
+    void append(size_t count, Write&& write) {
+        const size_t skip = count > capacity_ ? count - capacity_ : 0;
+        size_t index = skip;
+        size_t left  = count - skip;
+        size_t cell  = static_cast<size_t>((total_ + skip) % capacity_);
+        while (left > 0) {
+            const size_t n = std::min(left, capacity_ - cell);
+            write(cell, index, n);
+            write(cell + capacity_, index, n);
+            index += n;
+            left  -= n;
+            cell   = 0;
+        }
+        total_ += count;
+    }
+
+    void reset() { total_ = 0; }
+
+private:
+    size_t   capacity_;
+    uint64_t total_ = 0;
+};
+
+#endif // SCROLL_RING_H
@@ -0,0 +1,490 @@
+#include "signal_archive.h"
+#include "parallel.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+namespace {
+
+constexpr char     kMagic[4]     = {'D', 'S', 'A', 'R'};
+constexpr uint16_t kVersion      = 1;
+constexpr uint64_t kChunkAlign   = 64;
+constexpr size_t   kMaxNameBytes = sizeof(ArchiveEntryRecord::name) - 1;
+
+/** Разрядность компоненты для перестановки байтов */
+size_t shuffleWidth(SampleType type) {
+    return (type == SampleType::FLOAT32 || type == SampleType::COMPLEX64) ? 4 : 8;
+}
+
+/** Перестановка байтов: все k-е байты элементов подряд */
+void shuffleBytes(const char* src, char* dst, size_t bytes, size_t width) {
+    const size_t n = bytes / width;
+    for (size_t b = 0; b < width; ++b) {
+        char* out = dst + b * n;
+        for (size_t i = 0; i < n; ++i) out[i] = src[i * width + b];
+    }
+    std::memcpy(dst + n * width, src + n * width, bytes - n * width);
+}
+
+void unshuffleBytes(const char* src, char* dst, size_t bytes, size_t width) {
+    const size_t n = bytes / width;
+    for (size_t b = 0; b < width; ++b) {
+        const char* in = src + b * n;
+        for (size_t i = 0; i < n; ++i) dst[i * width + b] = in[i];
+    }
+    std::memcpy(dst + n * width, src + n * width, bytes - n * width);
+}
+
+/** Закодированный блок, готовый к записи */
+struct EncodedChunk {
+    std::vector<char> data;
+    uint64_t          rawBytes;
+    uint64_t          checksum;
+    ChunkCodec        codec;
+};
+
+EncodedChunk encodeChunk(const char* src, size_t bytes, SampleType type,
+                         ChunkCodec codec, int level) {
+    EncodedChunk chunk{{}, bytes, signalChecksum(src, bytes), ChunkCodec::RAW};
+
+    if (codec != ChunkCodec::RAW && bytes > 0) {
+        std::vector<char> shuffled;
+        const char* input = src;
+        if (codec == ChunkCodec::SHUFFLE_ZLIB) {
+            shuffled.resize(bytes);
+            shuffleBytes(src, shuffled.data(), bytes, shuffleWidth(type));
+            input = shuffled.data();
+        }
+
+        uLongf packedSize = compressBound(static_cast<uLong>(bytes));
+        chunk.data.resize(packedSize);
+        const int rc = compress2(reinterpret_cast<Bytef*>(chunk.data.data()), &packedSize,
+                                 reinterpret_cast<const Bytef*>(input),
+                                 static_cast<uLong>(bytes), level);
+        if (rc != Z_OK) {
+            throw std::runtime_error("SignalArchiveWriter: ошибка zlib при сжатии блока");
+        }
+
+        // Несжимаемые данные храним как есть
+        if (packedSize < bytes) {
+            chunk.data.resize(packedSize);
+            chunk.codec = codec;
+            return chunk;
+        }
+    }
+
+    chunk.data.assign(src, src + bytes);
+    chunk.codec = ChunkCodec::RAW;
+    return chunk;
+}
+
+} // namespace
+
+bool isSignalArchivePath(const std::string& filename) {
+    const std::string ext(kSignalArchiveExtension);
+    return filename.size() > ext.size() &&
+           filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SignalArchive
+// ─────────────────────────────────────────────────────────────────────────────
+
+SignalArchive::SignalArchive(const std::string& filename)
+    : file_(filename, MappedFile::Access::RANDOM)
+{
+    SignalArchiveHeader header{};
+    if (file_.size() < sizeof(header)) {
+        throw std::runtime_error("SignalArchive: файл слишком мал: " + filename);
+    }
+    std::memcpy(&header, file_.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("SignalArchive: не архив сигналов: " + filename);
+    }
+    if (header.version != kVersion || header.headerSize != sizeof(header)) {
+        throw std::runtime_error("SignalArchive: неподдерживаемая версия формата: " + filename);
+    }
+
+    const uint64_t expectedToc = header.entryCount * sizeof(ArchiveEntryRecord) +
+                                 header.chunkCount * sizeof(ArchiveChunkRecord);
+    if (header.tocBytes != expectedToc ||
+        header.tocOffset > file_.size() ||
+        header.tocBytes > file_.size() - header.tocOffset) {
+        throw std::runtime_error("SignalArchive: файл повреждён или обрезан: " + filename);
+    }
+
+    const char* toc = file_.data() + header.tocOffset;
+    if (signalChecksum(toc, static_cast<size_t>(header.tocBytes)) != header.tocChecksum) {
+        throw std::runtime_error("SignalArchive: контрольная сумма оглавления не совпадает: " + filename);
+    }
+
+    entries_.resize(header.entryCount);
+    chunks_.resize(header.chunkCount);
+    std::memcpy(entries_.data(), toc, entries_.size() * sizeof(ArchiveEntryRecord));
+    std::memcpy(chunks_.data(), toc + entries_.size() * sizeof(ArchiveEntryRecord),
+                chunks_.size() * sizeof(ArchiveChunkRecord));
+
+    chunkTypes_.assign(chunks_.size(), SampleType::FLOAT64);
+    for (const auto& e : entries_) {
+        if (static_cast<uint64_t>(e.firstChunk) + e.chunkCount > chunks_.size() ||
+            e.sampleType < static_cast<uint8_t>(SampleType::FLOAT32) ||
+            e.sampleType > static_cast<uint8_t>(SampleType::COMPLEX128)) {
+            throw std::runtime_error("SignalArchive: некорректное оглавление: " + filename);
+        }
+        uint64_t raw = 0;
+        for (uint32_t c = 0; c < e.chunkCount; ++c) {
+            raw += chunks_[e.firstChunk + c].rawBytes;
+            chunkTypes_[e.firstChunk + c] = static_cast<SampleType>(e.sampleType);
+        }
+        if (raw != e.length * sampleTypeSize(static_cast<SampleType>(e.sampleType))) {
+            throw std::runtime_error("SignalArchive: некорректное оглавление: " + filename);
+        }
+    }
+    for (const auto& c : chunks_) {
+        if (c.offset > header.tocOffset || c.storedBytes > header.tocOffset - c.offset ||
+            c.codec > static_cast<uint8_t>(ChunkCodec::SHUFFLE_ZLIB)) {
+            throw std::runtime_error("SignalArchive: некорректное оглавление: " + filename);
+        }
+    }
+}
+
+std::string SignalArchive::name(size_t index) const {
+    const auto& e = entries_.at(index);
+    return std::string(e.name, strnlen(e.name, sizeof(e.name)));
+}
+
+size_t SignalArchive::find(const std::string& name) const {
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (this->name(i) == name) return i;
+    }
+    return entries_.size();
+}
+
+void SignalArchive::decodeChunk(size_t chunkIndex, char* dst) const {
+    const ArchiveChunkRecord& c = chunks_[chunkIndex];
+    const char* src = file_.data() + c.offset;
+    const auto codec = static_cast<ChunkCodec>(c.codec);
+
+    if (codec == ChunkCodec::RAW) {
+        if (c.storedBytes != c.rawBytes) {
+            throw std::runtime_error("SignalArchive: повреждён блок " + std::to_string(chunkIndex));
+        }
+        std::memcpy(dst, src, c.rawBytes);
+    } else {
+        std::vector<char> packed;
+        char* out = dst;
+        if (codec == ChunkCodec::SHUFFLE_ZLIB) {
+            packed.resize(c.rawBytes);
+            out = packed.data();
+        }
+
+        uLongf outSize = static_cast<uLongf>(c.rawBytes);
+        const int rc = uncompress(reinterpret_cast<Bytef*>(out), &outSize,
+                                  reinterpret_cast<const Bytef*>(src),
+                                  static_cast<uLong>(c.storedBytes));
+        if (rc != Z_OK || outSize != c.rawBytes) {
+            throw std::runtime_error("SignalArchive: ошибка распаковки блока " +
+                                     std::to_string(chunkIndex));
+        }
+
+        if (codec == ChunkCodec::SHUFFLE_ZLIB) {
+            unshuffleBytes(packed.data(), dst, static_cast<size_t>(c.rawBytes),
+                           shuffleWidth(chunkTypes_[chunkIndex]));
+        }
+    }
+
+    if (signalChecksum(dst, static_cast<size_t>(c.rawBytes)) != c.checksum) {
+        throw std::runtime_error("SignalArchive: контрольная сумма блока " +
+                                 std::to_string(chunkIndex) + " не совпадает");
+    }
+}
+
+void SignalArchive::decodeEntry(size_t index, char* dst, size_t numThreads) const {
+    const auto& e = entries_.at(index);
+    std::vector<size_t> offsets(e.chunkCount);
+    size_t pos = 0;
+    for (uint32_t c = 0; c < e.chunkCount; ++c) {
+        offsets[c] = pos;
+        pos += static_cast<size_t>(chunks_[e.firstChunk + c].rawBytes);
+    }
+    parallelFor(e.chunkCount, numThreads, [&](size_t c) {
+        decodeChunk(e.firstChunk + c, dst + offsets[c]);
+    });
+}
+
+std::vector<double> SignalArchive::read(size_t index, size_t numThreads) const {
+    const SampleType type = sampleType(index);
+    if (isComplexSampleType(type)) {
+        throw std::runtime_error("SignalArchive::read: сигнал " + name(index) + " комплексный");
+    }
+
+    std::vector<double> out(length(index));
+    if (type == SampleType::FLOAT64) {
+        decodeEntry(index, reinterpret_cast<char*>(out.data()), numThreads);
+    } else {
+        std::vector<float> tmp(out.size());
+        decodeEntry(index, reinterpret_cast<char*>(tmp.data()), numThreads);
+        std::copy(tmp.begin(), tmp.end(), out.begin());
+    }
+    return out;
+}
+
+std::vector<std::complex<double>> SignalArchive::readComplex(size_t index, size_t numThreads) const {
+    const SampleType type = sampleType(index);
+    const size_t n = length(index);
+    std::vector<std::complex<double>> out(n);
+
+    switch (type) {
+        case SampleType::COMPLEX128:
+            decodeEntry(index, reinterpret_cast<char*>(out.data()), numThreads);
+            break;
+        case SampleType::COMPLEX64: {
+            std::vector<std::complex<float>> tmp(n);
+            decodeEntry(index, reinterpret_cast<char*>(tmp.data()), numThreads);
+            for (size_t i = 0; i < n; ++i) out[i] = {tmp[i].real(), tmp[i].imag()};
+            break;
+        }
+        default: {
+            auto real = read(index, numThreads);
+            for (size_t i = 0; i < n; ++i) out[i] = {real[i], 0.0};
+            break;
+        }
+    }
+    return out;
+}
+
+std::vector<std::vector<double>> SignalArchive::readMany(const std::vector<size_t>& indices,
+                                                         size_t numThreads) const {
+    std::vector<std::vector<double>> out(indices.size());
+    std::vector<std::vector<float>>  staging(indices.size());
+
+    // Задание на декодирование одного блока
+    struct Job { size_t chunk; char* dst; };
+    std::vector<Job> jobs;
+
+    for (size_t k = 0; k < indices.size(); ++k) {
+        const size_t idx = indices[k];
+        const SampleType type = sampleType(idx);
+        if (isComplexSampleType(type)) {
+            throw std::runtime_error("SignalArchive::readMany: сигнал " + name(idx) + " комплексный");
+        }
+
+        out[k].resize(length(idx));
+        char* base = reinterpret_cast<char*>(out[k].data());
+        if (type == SampleType::FLOAT32) {
+            staging[k].resize(length(idx));
+            base = reinterpret_cast<char*>(staging[k].data());
+        }
+
+        const auto& e = entries_[idx];
+        size_t pos = 0;
+        for (uint32_t c = 0; c < e.chunkCount; ++c) {
+            jobs.push_back({e.firstChunk + c, base + pos});
+            pos += static_cast<size_t>(chunks_[e.firstChunk + c].rawBytes);
+        }
+    }
+
+    parallelFor(jobs.size(), numThreads, [&](size_t j) {
+        decodeChunk(jobs[j].chunk, jobs[j].dst);
+    });
+
+    for (size_t k = 0; k < indices.size(); ++k) {
+        if (!staging[k].empty()) std::copy(staging[k].begin(), staging[k].end(), out[k].begin());
+    }
+    return out;
+}
+
+std::vector<std::pair<std::vector<double>, std::vector<double>>>
+SignalArchive::readPairs(size_t numThreads) const {
+    // Сопоставляем "clean/<x>" и "noisy/<x>"
+    std::map<std::string, std::pair<size_t, size_t>> byName;
+    const size_t none = entries_.size();
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        const std::string n = name(i);
+        if (n.rfind("clean/", 0) == 0) {
+            byName.try_emplace(n.substr(6), none, none).first->second.first = i;
+        } else if (n.rfind("noisy/", 0) == 0) {
+            byName.try_emplace(n.substr(6), none, none).first->second.second = i;
+        }
+    }
+
+    std::vector<size_t> indices;
+    for (const auto& [key, p] : byName) {
+        if (p.first != none && p.second != none) {
+            indices.push_back(p.first);
+            indices.push_back(p.second);
+        }
+    }
+
+    auto signals = readMany(indices, numThreads);
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> pairs;
+    pairs.reserve(signals.size() / 2);
+    for (size_t k = 0; k + 1 < signals.size(); k += 2) {
+        pairs.emplace_back(std::move(signals[k]), std::move(signals[k + 1]));
+    }
+    return pairs;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SignalArchiveWriter
+// ─────────────────────────────────────────────────────────────────────────────
+
+SignalArchiveWriter::SignalArchiveWriter(const std::string& filename)
+    : SignalArchiveWriter(filename, Options{})
+{
+}
+
+SignalArchiveWriter::SignalArchiveWriter(const std::string& filename, const Options& options)
+    : filename_(filename), options_(options), offset_(sizeof(SignalArchiveHeader)),
+      finalized_(false)
+{
+    if (options_.chunkSamples == 0) {
+        throw std::invalid_argument("SignalArchiveWriter: chunkSamples должно быть > 0");
+    }
+
+    file_.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + filename);
+    }
+
+    const char zeros[sizeof(SignalArchiveHeader)] = {};
+    file_.write(zeros, sizeof(zeros));
+}
+
+SignalArchiveWriter::~SignalArchiveWriter() {
+    if (!finalized_) {
+        try {
+            finalize();
+        } catch (...) {
+            // деструктор не должен бросать исключения
+        }
+    }
+}
+
+void SignalArchiveWriter::addRaw(const std::string& name, SampleType type, uint64_t length,
+                                 const char* bytes, size_t totalBytes) {
+    if (name.empty() || name.size() > kMaxNameBytes) {
+        throw std::invalid_argument("SignalArchiveWriter: недопустимое имя сигнала: " + name);
+    }
+    for (const auto& e : entries_) {
+        if (strncmp(e.name, name.c_str(), sizeof(e.name)) == 0) {
+            throw std::invalid_argument("SignalArchiveWriter: повторное имя сигнала: " + name);
+        }
+    }
+
+    const size_t chunkBytes = options_.chunkSamples * sampleTypeSize(type);
+    const size_t numChunks  = (totalBytes + chunkBytes - 1) / chunkBytes;
+
+    // Сжатие блоков параллельно, запись — последовательно
+    std::vector<EncodedChunk> encoded(numChunks);
+    parallelFor(numChunks, options_.numThreads, [&](size_t c) {
+        const size_t begin = c * chunkBytes;
+        const size_t n = std::min(chunkBytes, totalBytes - begin);
+        encoded[c] = encodeChunk(bytes + begin, n, type, options_.codec, options_.level);
+    });
+
+    ArchiveEntryRecord entry{};
+    std::memcpy(entry.name, name.data(), name.size());
+    entry.length     = length;
+    entry.firstChunk = static_cast<uint32_t>(chunks_.size());
+    entry.chunkCount = static_cast<uint32_t>(numChunks);
+    entry.sampleType = static_cast<uint8_t>(type);
+
+    static const char padding[kChunkAlign] = {};
+    for (const auto& chunk : encoded) {
+        const uint64_t pad = (kChunkAlign - offset_ % kChunkAlign) % kChunkAlign;
+        file_.write(padding, static_cast<std::streamsize>(pad));
+        offset_ += pad;
+
+        ArchiveChunkRecord record{};
+        record.offset      = offset_;
+        record.storedBytes = chunk.data.size();
+        record.rawBytes    = chunk.rawBytes;
+        record.checksum    = chunk.checksum;
+        record.codec       = static_cast<uint8_t>(chunk.codec);
+        chunks_.push_back(record);
+
+        file_.write(chunk.data.data(), static_cast<std::streamsize>(chunk.data.size()));
+        offset_ += chunk.data.size();
+    }
+
+    if (!file_) {
+        throw std::runtime_error("Error writing file: " + filename_);
+    }
+    entries_.push_back(entry);
+}
+
+void SignalArchiveWriter::add(const std::string& name, const std::vector<double>& signal) {
+    if (options_.realType == SampleType::FLOAT32) {
+        std::vector<float> narrow(signal.begin(), signal.end());
+        addRaw(name, SampleType::FLOAT32, signal.size(),
+               reinterpret_cast<const char*>(narrow.data()), narrow.size() * sizeof(float));
+    } else {
+        addRaw(name, SampleType::FLOAT64, signal.size(),
+               reinterpret_cast<const char*>(signal.data()), signal.size() * sizeof(double));
+    }
+}
+
+void SignalArchiveWriter::add(const std::string& name,
+                              const std::vector<std::complex<double>>& signal) {
+    if (options_.complexType == SampleType::COMPLEX64) {
+        std::vector<std::complex<float>> narrow(signal.size());
+        for (size_t i = 0; i < signal.size(); ++i) {
+            narrow[i] = {static_cast<float>(signal[i].real()), static_cast<float>(signal[i].imag())};
+        }
+        addRaw(name, SampleType::COMPLEX64, signal.size(),
+               reinterpret_cast<const char*>(narrow.data()),
+               narrow.size() * sizeof(std::complex<float>));
+    } else {
+        addRaw(name, SampleType::COMPLEX128, signal.size(),
+               reinterpret_cast<const char*>(signal.data()),
+               signal.size() * sizeof(std::complex<double>));
+    }
+}
+
+void SignalArchiveWriter::addPairs(
+    const std::vector<std::pair<std::vector<double>, std::vector<double>>>& pairs,
+    const std::string& prefix)
+{
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        std::string id = std::to_string(i);
+        id = prefix + std::string(id.size() < 6 ? 6 - id.size() : 0, '0') + id;
+        add("clean/" + id, pairs[i].first);
+        add("noisy/" + id, pairs[i].second);
+    }
+}
+
+void SignalArchiveWriter::finalize() {
+    if (finalized_) return;
+    finalized_ = true;
+
+    std::vector<char> toc(entries_.size() * sizeof(ArchiveEntryRecord) +
+                          chunks_.size() * sizeof(ArchiveChunkRecord));
+    std::memcpy(toc.data(), entries_.data(), entries_.size() * sizeof(ArchiveEntryRecord));
+    std::memcpy(toc.data() + entries_.size() * sizeof(ArchiveEntryRecord), chunks_.data(),
+                chunks_.size() * sizeof(ArchiveChunkRecord));
+
+    SignalArchiveHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version     = kVersion;
+    header.headerSize  = sizeof(SignalArchiveHeader);
+    header.entryCount  = static_cast<uint32_t>(entries_.size());
+    header.chunkCount  = static_cast<uint32_t>(chunks_.size());
+    header.tocOffset   = offset_;
+    header.tocBytes    = toc.size();
+    header.tocChecksum = signalChecksum(toc.data(), toc.size());
+
+    file_.write(toc.data(), static_cast<std::streamsize>(toc.size()));
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_.close();
+    if (!file_) {
+        throw std::runtime_error("Error writing file: " + filename_);
+    }
+}
@@ -0,0 +1,204 @@
+#ifndef SIGNAL_ARCHIVE_H
+#define SIGNAL_ARCHIVE_H
+
+/**
+ * Архив сигналов (.sga): много именованных сигналов в одном файле.
+ *
+ * Формат файла:
+ *   [0, 64)            — заголовок SignalArchiveHeader
+ *   [64, tocOffset)    — блоки (chunks) данных, каждый выровнен на 64 байта
+ *   [tocOffset, ...)   — оглавление: ArchiveEntryRecord[entryCount],
+ *                        затем ArchiveChunkRecord[chunkCount]
+ *
+ * Каждый сигнал разбит на блоки фиксированного числа отсчётов; блок
+ * хранится как есть либо сжатым zlib (опционально с перестановкой байтов
+ * по разрядам, что заметно улучшает сжатие чисел с плавающей точкой).
+ * Блоки декодируются независимо, поэтому возможны произвольный доступ
+ * к любому сигналу и параллельное декодирование.
+ *
+ * Наборы (clean, noisy) хранятся как пары "clean/<имя>" и "noisy/<имя>".
+ */
+
+#include "mapped_file.h"
+#include "signal_file.h"
+
+#include <complex>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Способ хранения блока
+ */
+enum class ChunkCodec : uint8_t {
+    RAW          = 0,   // Без сжатия
+    ZLIB         = 1,   // zlib (deflate)
+    SHUFFLE_ZLIB = 2    // Перестановка байтов по разрядам + zlib
+};
+
+struct SignalArchiveHeader {
+    char     magic[4];          ///< "DSAR"
+    uint16_t version;
+    uint16_t headerSize;        ///< sizeof(SignalArchiveHeader)
+    uint32_t entryCount;        ///< Число сигналов
+    uint32_t chunkCount;        ///< Общее число блоков
+    uint64_t tocOffset;         ///< Смещение оглавления
+    uint64_t tocBytes;          ///< Размер оглавления
+    uint64_t tocChecksum;       ///< FNV-1a 64 по оглавлению
+    uint64_t reserved[3];
+};
+
+struct ArchiveEntryRecord {
+    char     name[96];          ///< Имя сигнала (с завершающим нулём)
+    uint64_t length;            ///< Число отсчётов
+    uint32_t firstChunk;        ///< Индекс первого блока
+    uint32_t chunkCount;        ///< Число блоков
+    uint8_t  sampleType;        ///< SampleType
+    uint8_t  reserved0[7];
+    uint64_t reserved1;
+};
+
+struct ArchiveChunkRecord {
+    uint64_t offset;            ///< Смещение блока от начала файла
+    uint64_t storedBytes;       ///< Размер в файле
+    uint64_t rawBytes;          ///< Размер после декодирования
+    uint64_t checksum;          ///< FNV-1a 64 по декодированным байтам
+    uint8_t  codec;             ///< ChunkCodec
+    uint8_t  reserved[7];
+};
+
+static_assert(sizeof(SignalArchiveHeader) == 64, "SignalArchiveHeader must be 64 bytes");
+static_assert(sizeof(ArchiveEntryRecord) == 128, "ArchiveEntryRecord must be 128 bytes");
+static_assert(sizeof(ArchiveChunkRecord) == 40, "ArchiveChunkRecord must be 40 bytes");
+
+/** Расширение файлов архива */
+inline constexpr const char* kSignalArchiveExtension = ".sga";
+
+/** Имя файла оканчивается на ".sga" */
+bool isSignalArchivePath(const std::string& filename);
+
+/**
+ * Архив, отображённый в память (только чтение)
+ */
+class SignalArchive {
+public:
+    /**
+     * Открыть архив и прочитать оглавление
+     * @throws std::runtime_error при ошибке открытия или повреждённом оглавлении
+     */
+    explicit SignalArchive(const std::string& filename);
+
+    /** Число сигналов */
+    size_t size() const { return entries_.size(); }
+
+    /** Имя сигнала */
+    std::string name(size_t index) const;
+
+    /** Число отсчётов сигнала */
+    size_t length(size_t index) const { return static_cast<size_t>(entries_.at(index).length); }
+
+    /** Тип хранимых отсчётов */
+    SampleType sampleType(size_t index) const {
+        return static_cast<SampleType>(entries_.at(index).sampleType);
+    }
+
+    /**
+     * Найти сигнал по имени
+     * @return Индекс или size() если не найден
+     */
+    size_t find(const std::string& name) const;
+
+    /**
+     * Декодировать вещественный сигнал
+     * @param numThreads Потоки для декодирования блоков (0 — по числу ядер)
+     * @throws std::runtime_error для комплексных данных или при ошибке блока
+     */
+    std::vector<double> read(size_t index, size_t numThreads = 1) const;
+
+    /** Декодировать сигнал как комплексный (вещественные дополняются нулём) */
+    std::vector<std::complex<double>> readComplex(size_t index, size_t numThreads = 1) const;
+
+    /**
+     * Декодировать несколько вещественных сигналов параллельно
+     * (потоки распределяются по всем блокам всех сигналов)
+     */
+    std::vector<std::vector<double>> readMany(const std::vector<size_t>& indices,
+                                              size_t numThreads = 0) const;
+
+    /**
+     * Все пары (clean, noisy) с совпадающими именами "clean/<x>" и "noisy/<x>",
+     * упорядоченные по имени
+     */
+    std::vector<std::pair<std::vector<double>, std::vector<double>>>
+    readPairs(size_t numThreads = 0) const;
+
+private:
+    MappedFile                      file_;
+    std::vector<ArchiveEntryRecord> entries_;
+    std::vector<ArchiveChunkRecord> chunks_;
+    std::vector<SampleType>         chunkTypes_;    ///< Тип отсчёта каждого блока
+
+    /** Декодировать блок в dst (ровно rawBytes байт) */
+    void decodeChunk(size_t chunkIndex, char* dst) const;
+
+    /** Декодировать сигнал в байты хранимого типа */
+    void decodeEntry(size_t index, char* dst, size_t numThreads) const;
+};
+
+/**
+ * Запись архива: сигналы добавляются по одному, блоки каждого сигнала
+ * сжимаются параллельно; оглавление пишется в finalize()
+ */
+class SignalArchiveWriter {
+public:
+    struct Options {
+        ChunkCodec codec        = ChunkCodec::SHUFFLE_ZLIB;
+        int        level        = 6;        ///< Уровень сжатия zlib (1..9)
+        size_t     chunkSamples = 65536;    ///< Отсчётов в блоке
+        SampleType realType     = SampleType::FLOAT64;
+        SampleType complexType  = SampleType::COMPLEX128;
+        size_t     numThreads   = 0;        ///< 0 — по числу ядер
+    };
+
+    /** @throws std::runtime_error если файл не удалось создать */
+    explicit SignalArchiveWriter(const std::string& filename);
+    SignalArchiveWriter(const std::string& filename, const Options& options);
+
+    /** Вызывает finalize(), если он ещё не был вызван */
+    ~SignalArchiveWriter();
+
+    SignalArchiveWriter(const SignalArchiveWriter&) = delete;
+    SignalArchiveWriter& operator=(const SignalArchiveWriter&) = delete;
+
+    /**
+     * Добавить вещественный сигнал
+     * @throws std::invalid_argument если имя пустое, длиннее 95 символов или повторяется
+     */
+    void add(const std::string& name, const std::vector<double>& signal);
+
+    /** Добавить комплексный сигнал */
+    void add(const std::string& name, const std::vector<std::complex<double>>& signal);
+
+    /** Добавить пары как "clean/<prefix>NNNNNN" и "noisy/<prefix>NNNNNN" */
+    void addPairs(const std::vector<std::pair<std::vector<double>, std::vector<double>>>& pairs,
+                  const std::string& prefix = "signal_");
+
+    /** Записать оглавление, заголовок и закрыть файл */
+    void finalize();
+
+private:
+    std::ofstream                   file_;
+    std::string                     filename_;
+    Options                         options_;
+    uint64_t                        offset_;
+    std::vector<ArchiveEntryRecord> entries_;
+    std::vector<ArchiveChunkRecord> chunks_;
+    bool                            finalized_;
+
+    void addRaw(const std::string& name, SampleType type, uint64_t length,
+                const char* bytes, size_t totalBytes);
+};
+
+#endif // SIGNAL_ARCHIVE_H
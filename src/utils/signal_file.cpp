@@ -0,0 +1,367 @@
+#include "signal_file.h"
+#include "csv_reader.h"
+#include "csv_writer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+static_assert(std::endian::native == std::endian::little,
+              "Signal container is defined as little-endian");
+
+namespace {
+
+constexpr char     kMagic[4]       = {'D', 'S', 'I', 'G'};
+constexpr uint16_t kVersion        = 1;
+constexpr uint64_t kPayloadAlign   = 64;
+constexpr uint64_t kFnvPrime       = 0x100000001b3ULL;
+constexpr size_t   kConvertBlock   = 16384;   // отсчётов на один блок преобразования
+
+/** Значение отсчёта index как complex<double> (канал уже учтён в index) */
+std::complex<double> sampleAt(const char* payload, SampleType type, size_t index) {
+    switch (type) {
+        case SampleType::FLOAT32: {
+            float v;
+            std::memcpy(&v, payload + index * sizeof(float), sizeof(float));
+            return {v, 0.0};
+        }
+        case SampleType::FLOAT64: {
+            double v;
+            std::memcpy(&v, payload + index * sizeof(double), sizeof(double));
+            return {v, 0.0};
+        }
+        case SampleType::COMPLEX64: {
+            std::complex<float> v;
+            std::memcpy(&v, payload + index * sizeof(v), sizeof(v));
+            return {v.real(), v.imag()};
+        }
+        case SampleType::COMPLEX128: {
+            std::complex<double> v;
+            std::memcpy(&v, payload + index * sizeof(v), sizeof(v));
+            return v;
+        }
+    }
+    return {};
+}
+
+bool isValidSampleType(uint8_t raw) {
+    return raw >= static_cast<uint8_t>(SampleType::FLOAT32) &&
+           raw <= static_cast<uint8_t>(SampleType::COMPLEX128);
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Вспомогательные функции
+// ─────────────────────────────────────────────────────────────────────────────
+
+size_t sampleTypeSize(SampleType type) {
+    switch (type) {
+        case SampleType::FLOAT32:    return sizeof(float);
+        case SampleType::FLOAT64:    return sizeof(double);
+        case SampleType::COMPLEX64:  return sizeof(std::complex<float>);
+        case SampleType::COMPLEX128: return sizeof(std::complex<double>);
+    }
+    throw std::invalid_argument("sampleTypeSize: неизвестный тип отсчёта");
+}
+
+bool isComplexSampleType(SampleType type) {
+    return type == SampleType::COMPLEX64 || type == SampleType::COMPLEX128;
+}
+
+std::string sampleTypeToString(SampleType type) {
+    switch (type) {
+        case SampleType::FLOAT32:    return "float32";
+        case SampleType::FLOAT64:    return "float64";
+        case SampleType::COMPLEX64:  return "complex64";
+        case SampleType::COMPLEX128: return "complex128";
+    }
+    return "unknown";
+}
+
+bool isSignalFilePath(const std::string& filename) {
+    const std::string ext(kSignalFileExtension);
+    return filename.size() > ext.size() &&
+           filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+uint64_t signalChecksum(const void* data, size_t bytes, uint64_t seed) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+
+    const size_t words = bytes / sizeof(uint64_t);
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t w;
+        std::memcpy(&w, p + i * sizeof(uint64_t), sizeof(uint64_t));
+        hash = (hash ^ w) * kFnvPrime;
+    }
+    for (size_t i = words * sizeof(uint64_t); i < bytes; ++i) {
+        hash = (hash ^ p[i]) * kFnvPrime;
+    }
+    return hash;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SignalFile
+// ─────────────────────────────────────────────────────────────────────────────
+
+SignalFile::SignalFile(const std::string& filename, bool verifyChecksum)
+    : file_(filename, MappedFile::Access::RANDOM), header_{}, payload_(nullptr)
+{
+    if (file_.size() < sizeof(SignalFileHeader)) {
+        throw std::runtime_error("SignalFile: файл слишком мал: " + filename);
+    }
+    std::memcpy(&header_, file_.data(), sizeof(SignalFileHeader));
+
+    if (std::memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("SignalFile: не контейнер сигнала: " + filename);
+    }
+    if (header_.version != kVersion || header_.headerSize != sizeof(SignalFileHeader)) {
+        throw std::runtime_error("SignalFile: неподдерживаемая версия формата: " + filename);
+    }
+    if (!isValidSampleType(header_.sampleType) || header_.channels == 0) {
+        throw std::runtime_error("SignalFile: некорректный заголовок: " + filename);
+    }
+
+    const uint64_t expectedBytes =
+        header_.length * header_.channels * sampleTypeSize(sampleType());
+    if (header_.payloadBytes != expectedBytes ||
+        header_.payloadOffset % kPayloadAlign != 0 ||
+        header_.payloadOffset > file_.size() ||
+        header_.payloadBytes > file_.size() - header_.payloadOffset) {
+        throw std::runtime_error("SignalFile: файл повреждён или обрезан: " + filename);
+    }
+
+    payload_ = file_.data() + header_.payloadOffset;
+
+    if (verifyChecksum &&
+        signalChecksum(payload_, static_cast<size_t>(header_.payloadBytes)) != header_.checksum) {
+        throw std::runtime_error("SignalFile: контрольная сумма не совпадает: " + filename);
+    }
+}
+
+std::vector<double> SignalFile::toReal(size_t channel) const {
+    if (isComplexSampleType(sampleType())) {
+        throw std::runtime_error("SignalFile::toReal: данные комплексные");
+    }
+    if (channel >= channels()) {
+        throw std::out_of_range("SignalFile::toReal: нет канала " + std::to_string(channel));
+    }
+
+    const size_t n = length();
+    const size_t ch = channels();
+    std::vector<double> out(n);
+
+    if (sampleType() == SampleType::FLOAT64) {
+        auto s = samples<double>();
+        if (ch == 1) {
+            std::copy(s.begin(), s.end(), out.begin());
+        } else {
+            for (size_t i = 0; i < n; ++i) out[i] = s[i * ch + channel];
+        }
+    } else {
+        auto s = samples<float>();
+        for (size_t i = 0; i < n; ++i) out[i] = s[i * ch + channel];
+    }
+    return out;
+}
+
+std::vector<std::complex<double>> SignalFile::toComplex(size_t channel) const {
+    if (channel >= channels()) {
+        throw std::out_of_range("SignalFile::toComplex: нет канала " + std::to_string(channel));
+    }
+
+    const size_t n = length();
+    const size_t ch = channels();
+    std::vector<std::complex<double>> out(n);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = sampleAt(payload_, sampleType(), i * ch + channel);
+    }
+    return out;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SignalFileWriter
+// ─────────────────────────────────────────────────────────────────────────────
+
+SignalFileWriter::SignalFileWriter(const std::string& filename, SampleType type,
+                                   uint32_t channels, double sampleRate)
+    : filename_(filename), type_(type), channels_(channels), sampleRate_(sampleRate),
+      valuesWritten_(0), framesWritten_(0), checksum_(signalChecksum(nullptr, 0)),
+      tail_{}, tailSize_(0), finalized_(false)
+{
+    if (channels == 0) {
+        throw std::invalid_argument("SignalFileWriter: число каналов должно быть > 0");
+    }
+
+    file_.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + filename);
+    }
+
+    // Место под заголовок; данные начинаются с 64-го байта
+    const char zeros[sizeof(SignalFileHeader)] = {};
+    file_.write(zeros, sizeof(zeros));
+}
+
+SignalFileWriter::~SignalFileWriter() {
+    if (!finalized_) {
+        try {
+            finalize();
+        } catch (...) {
+            // деструктор не должен бросать исключения
+        }
+    }
+}
+
+void SignalFileWriter::writePayload(const void* data, size_t bytes) {
+    file_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    if (!file_) {
+        throw std::runtime_error("Error writing file: " + filename_);
+    }
+
+    // Контрольная сумма считается по 8-байтовым словам всего потока данных,
+    // поэтому неполное слово на границе блоков переносится в следующий вызов
+    const auto* p = static_cast<const unsigned char*>(data);
+    if (tailSize_ > 0) {
+        const size_t take = std::min(bytes, sizeof(tail_) - tailSize_);
+        std::memcpy(tail_ + tailSize_, p, take);
+        tailSize_ += take;
+        p += take;
+        bytes -= take;
+        if (tailSize_ < sizeof(tail_)) return;
+        checksum_ = signalChecksum(tail_, sizeof(tail_), checksum_);
+        tailSize_ = 0;
+    }
+
+    const size_t whole = bytes - bytes % sizeof(uint64_t);
+    checksum_ = signalChecksum(p, whole, checksum_);
+    tailSize_ = bytes - whole;
+    std::memcpy(tail_, p + whole, tailSize_);
+}
+
+void SignalFileWriter::append(std::span<const double> samples) {
+    if (isComplexSampleType(type_)) {
+        throw std::invalid_argument("SignalFileWriter: вещественные данные в комплексный контейнер");
+    }
+    if (samples.size() % channels_ != 0) {
+        throw std::invalid_argument("SignalFileWriter: число отсчётов не кратно числу каналов");
+    }
+
+    if (type_ == SampleType::FLOAT64) {
+        writePayload(samples.data(), samples.size_bytes());
+    } else {
+        for (size_t pos = 0; pos < samples.size(); pos += kConvertBlock) {
+            const size_t n = std::min(kConvertBlock, samples.size() - pos);
+            scratch_.resize(n * sizeof(float));
+            auto* dst = reinterpret_cast<float*>(scratch_.data());
+            for (size_t i = 0; i < n; ++i) dst[i] = static_cast<float>(samples[pos + i]);
+            writePayload(dst, n * sizeof(float));
+        }
+    }
+
+    valuesWritten_ += samples.size();
+    framesWritten_  = valuesWritten_ / channels_;
+}
+
+void SignalFileWriter::append(std::span<const std::complex<double>> samples) {
+    if (!isComplexSampleType(type_)) {
+        throw std::invalid_argument("SignalFileWriter: комплексные данные в вещественный контейнер");
+    }
+    if (samples.size() % channels_ != 0) {
+        throw std::invalid_argument("SignalFileWriter: число отсчётов не кратно числу каналов");
+    }
+
+    if (type_ == SampleType::COMPLEX128) {
+        writePayload(samples.data(), samples.size_bytes());
+    } else {
+        for (size_t pos = 0; pos < samples.size(); pos += kConvertBlock) {
+            const size_t n = std::min(kConvertBlock, samples.size() - pos);
+            scratch_.resize(n * sizeof(std::complex<float>));
+            auto* dst = reinterpret_cast<std::complex<float>*>(scratch_.data());
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = std::complex<float>(static_cast<float>(samples[pos + i].real()),
+                                             static_cast<float>(samples[pos + i].imag()));
+            }
+            writePayload(dst, n * sizeof(std::complex<float>));
+        }
+    }
+
+    valuesWritten_ += samples.size();
+    framesWritten_  = valuesWritten_ / channels_;
+}
+
+void SignalFileWriter::finalize() {
+    if (finalized_) return;
+    finalized_ = true;
+
+    checksum_ = signalChecksum(tail_, tailSize_, checksum_);
+    tailSize_ = 0;
+
+    SignalFileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version       = kVersion;
+    header.headerSize    = sizeof(SignalFileHeader);
+    header.sampleType    = static_cast<uint8_t>(type_);
+    header.channels      = channels_;
+    header.length        = framesWritten_;
+    header.sampleRate    = sampleRate_;
+    header.payloadOffset = sizeof(SignalFileHeader);
+    header.payloadBytes  = valuesWritten_ * sampleTypeSize(type_);
+    header.checksum      = checksum_;
+
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_.close();
+    if (!file_) {
+        throw std::runtime_error("Error writing file: " + filename_);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Удобные функции
+// ─────────────────────────────────────────────────────────────────────────────
+
+void saveSignalBinary(const std::vector<double>& signal, const std::string& filename,
+                      SampleType type, double sampleRate) {
+    SignalFileWriter writer(filename, type, 1, sampleRate);
+    writer.append(std::span<const double>(signal));
+    writer.finalize();
+}
+
+void saveComplexSignalBinary(const std::vector<std::complex<double>>& signal,
+                             const std::string& filename,
+                             SampleType type, double sampleRate) {
+    SignalFileWriter writer(filename, type, 1, sampleRate);
+    writer.append(std::span<const std::complex<double>>(signal));
+    writer.finalize();
+}
+
+std::vector<double> loadSignalBinary(const std::string& filename) {
+    return SignalFile(filename).toReal();
+}
+
+std::vector<std::complex<double>> loadComplexSignalBinary(const std::string& filename) {
+    return SignalFile(filename).toComplex();
+}
+
+void convertCSVToBinary(const std::string& csvFile, const std::string& binFile,
+                        bool complex, SampleType type) {
+    if (complex) {
+        saveComplexSignalBinary(readComplexCSV(csvFile), binFile, type);
+    } else {
+        saveSignalBinary(readSignalCSV(csvFile), binFile, type);
+    }
+}
+
+void convertBinaryToCSV(const std::string& binFile, const std::string& csvFile) {
+    SignalFile in(binFile);
+
+    if (isComplexSampleType(in.sampleType())) {
+        // Формат DopplerNipFilter::saveToCSV
+        writeComplexCSV(csvFile, in.toComplex(), 8);
+    } else {
+        // Формат SignalGenerator::saveSignalToCSV
+        writeSignalCSV(csvFile, in.toReal());
+    }
+}
@@ -0,0 +1,223 @@
+#ifndef SIGNAL_FILE_H
+#define SIGNAL_FILE_H
+
+/**
+ * Бинарный контейнер сигналов (.sig).
+ *
+ * Формат файла:
+ *   [0, 64)              — заголовок SignalFileHeader (little-endian)
+ *   [payloadOffset, ...) — отсчёты, каналы чередуются по кадрам
+ *                          (s0c0, s0c1, ..., s1c0, s1c1, ...)
+ *
+ * Смещение данных кратно 64 байтам, поэтому после mmap отсчёты
+ * доступны без копирования через std::span нужного типа.
+ * Контрольная сумма — FNV-1a (64 бит) по словам данных.
+ */
+
+#include "mapped_file.h"
+
+#include <complex>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Тип отсчёта
+ */
+enum class SampleType : uint8_t {
+    FLOAT32    = 1,     // float
+    FLOAT64    = 2,     // double
+    COMPLEX64  = 3,     // std::complex<float>
+    COMPLEX128 = 4      // std::complex<double>
+};
+
+/** Размер одного отсчёта в байтах */
+size_t sampleTypeSize(SampleType type);
+
+/** Комплексный ли тип отсчёта */
+bool isComplexSampleType(SampleType type);
+
+/** Строковое имя типа ("float32", "float64", "complex64", "complex128") */
+std::string sampleTypeToString(SampleType type);
+
+/**
+ * Заголовок контейнера (ровно 64 байта)
+ */
+struct SignalFileHeader {
+    char     magic[4];          ///< "DSIG"
+    uint16_t version;           ///< Версия формата
+    uint16_t headerSize;        ///< sizeof(SignalFileHeader)
+    uint8_t  sampleType;        ///< SampleType
+    uint8_t  reserved0[3];
+    uint32_t channels;          ///< Число каналов
+    uint64_t length;            ///< Число кадров (отсчётов на канал)
+    double   sampleRate;        ///< Частота дискретизации, Гц (0 — не задана)
+    uint64_t payloadOffset;     ///< Смещение данных от начала файла
+    uint64_t payloadBytes;      ///< Размер данных в байтах
+    uint64_t checksum;          ///< FNV-1a 64 по данным
+    uint64_t reserved1;
+};
+
+static_assert(sizeof(SignalFileHeader) == 64, "SignalFileHeader must be 64 bytes");
+
+/** Расширение файлов контейнера */
+inline constexpr const char* kSignalFileExtension = ".sig";
+
+/** Имя файла оканчивается на ".sig" */
+bool isSignalFilePath(const std::string& filename);
+
+/** Контрольная сумма FNV-1a 64 по 8-байтовым словам (хвост — побайтно) */
+uint64_t signalChecksum(const void* data, size_t bytes, uint64_t seed = 0xcbf29ce484222325ULL);
+
+/**
+ * Контейнер, отображённый в память (только чтение)
+ */
+class SignalFile {
+public:
+    /**
+     * Открыть контейнер
+     * @param filename Имя файла
+     * @param verifyChecksum Проверять контрольную сумму данных
+     * @throws std::runtime_error при ошибке открытия или повреждённом файле
+     */
+    explicit SignalFile(const std::string& filename, bool verifyChecksum = true);
+
+    const SignalFileHeader& header() const { return header_; }
+    SampleType sampleType() const { return static_cast<SampleType>(header_.sampleType); }
+    size_t length() const { return static_cast<size_t>(header_.length); }
+    size_t channels() const { return header_.channels; }
+    double sampleRate() const { return header_.sampleRate; }
+
+    /**
+     * Отсчёты без копирования (все каналы, чередование по кадрам)
+     * @throws std::runtime_error если T не соответствует типу отсчёта
+     */
+    template<typename T>
+    std::span<const T> samples() const {
+        if (sizeof(T) != sampleTypeSize(sampleType()) || !matches<T>()) {
+            throw std::runtime_error("SignalFile: запрошенный тип не совпадает с " +
+                                     sampleTypeToString(sampleType()));
+        }
+        return std::span<const T>(reinterpret_cast<const T*>(payload_),
+                                  length() * channels());
+    }
+
+    /**
+     * Вещественный канал с преобразованием в double
+     * @throws std::runtime_error для комплексных данных
+     */
+    std::vector<double> toReal(size_t channel = 0) const;
+
+    /** Канал в виде complex<double> (вещественные данные дополняются нулём) */
+    std::vector<std::complex<double>> toComplex(size_t channel = 0) const;
+
+private:
+    MappedFile       file_;
+    SignalFileHeader header_;
+    const char*      payload_;
+
+    template<typename T>
+    bool matches() const {
+        switch (sampleType()) {
+            case SampleType::FLOAT32:    return std::is_same_v<T, float>;
+            case SampleType::FLOAT64:    return std::is_same_v<T, double>;
+            case SampleType::COMPLEX64:  return std::is_same_v<T, std::complex<float>>;
+            case SampleType::COMPLEX128: return std::is_same_v<T, std::complex<double>>;
+        }
+        return false;
+    }
+};
+
+/**
+ * Потоковая запись контейнера: данные дописываются блоками,
+ * длина и контрольная сумма фиксируются в finalize()
+ */
+class SignalFileWriter {
+public:
+    /**
+     * @param filename Имя файла
+     * @param type Тип хранимых отсчётов
+     * @param channels Число каналов
+     * @param sampleRate Частота дискретизации (0 — не задана)
+     * @throws std::runtime_error если файл не удалось создать
+     */
+    SignalFileWriter(const std::string& filename, SampleType type,
+                     uint32_t channels = 1, double sampleRate = 0.0);
+
+    /** Вызывает finalize(), если он ещё не был вызван */
+    ~SignalFileWriter();
+
+    SignalFileWriter(const SignalFileWriter&) = delete;
+    SignalFileWriter& operator=(const SignalFileWriter&) = delete;
+
+    /**
+     * Дописать вещественные отсчёты (число значений кратно числу каналов)
+     * @throws std::invalid_argument для комплексного контейнера
+     */
+    void append(std::span<const double> samples);
+
+    /** Дописать комплексные отсчёты (вещественный контейнер не допускается) */
+    void append(std::span<const std::complex<double>> samples);
+
+    /** Записать заголовок и закрыть файл */
+    void finalize();
+
+    /** Число записанных кадров */
+    size_t length() const { return static_cast<size_t>(framesWritten_); }
+
+private:
+    std::ofstream file_;
+    std::string   filename_;
+    SampleType    type_;
+    uint32_t      channels_;
+    double        sampleRate_;
+    uint64_t      valuesWritten_;   ///< Записано отсчётов (все каналы)
+    uint64_t      framesWritten_;
+    uint64_t      checksum_;
+    unsigned char tail_[8];         ///< Неполное слово контрольной суммы
+    size_t        tailSize_;
+    std::vector<char> scratch_;     ///< Буфер преобразования типа
+    bool          finalized_;
+
+    void writePayload(const void* data, size_t bytes);
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Удобные функции
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** Сохранить вещественный сигнал в контейнер */
+void saveSignalBinary(const std::vector<double>& signal, const std::string& filename,
+                      SampleType type = SampleType::FLOAT64, double sampleRate = 0.0);
+
+/** Сохранить комплексный сигнал в контейнер */
+void saveComplexSignalBinary(const std::vector<std::complex<double>>& signal,
+                             const std::string& filename,
+                             SampleType type = SampleType::COMPLEX128,
+                             double sampleRate = 0.0);
+
+/** Загрузить вещественный сигнал (канал 0) */
+std::vector<double> loadSignalBinary(const std::string& filename);
+
+/** Загрузить комплексный сигнал (канал 0) */
+std::vector<std::complex<double>> loadComplexSignalBinary(const std::string& filename);
+
+/**
+ * Преобразовать CSV в контейнер.
+ * "Index,Value" → вещественный, "Re,Im" → комплексный.
+ * @param complex Входной файл в формате "Re,Im"
+ */
+void convertCSVToBinary(const std::string& csvFile, const std::string& binFile,
+                        bool complex, SampleType type);
+
+/**
+ * Преобразовать контейнер в CSV: вещественный — "Index,Value",
+ * комплексный — "Re,Im" (формат DopplerNipFilter)
+ */
+void convertBinaryToCSV(const std::string& binFile, const std::string& csvFile);
+
+#endif // SIGNAL_FILE_H
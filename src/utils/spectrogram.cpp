@@ -0,0 +1,62 @@
+#include "spectrogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+Spectrogram::Spectrogram(Options options)
+    : options_(options) {
+    if (!fft_impl::isPow2(options_.frameSize) || options_.frameSize < 2) {
+        throw std::invalid_argument("Spectrogram: frameSize must be a power of two >= 2");
+    }
+    if (options_.hop == 0 || options_.hop > options_.frameSize) {
+        throw std::invalid_argument("Spectrogram: hop must be in [1, frameSize]");
+    }
+
+    // Периодическое окно Ханна: для STFT с перекрытием оно точнее симметричного
+    const size_t n = options_.frameSize;
+    window_.resize(n);
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        window_[i] = 0.5 * (1.0 - std::cos(2.0 * M_PI * static_cast<double>(i) / static_cast<double>(n)));
+        sum += window_[i];
+    }
+    scale_ = 4.0 / (sum * sum);
+
+    spectrum_.resize(n);
+    column_.resize(bins());
+    pending_.reserve(n);
+}
+
+size_t Spectrogram::push(std::span<const double> samples, const std::function<void(Column)>& onColumn) {
+    const size_t n = options_.frameSize;
+    size_t columns = 0;
+    size_t offset  = 0;
+    while (offset < samples.size()) {
+        const size_t take = std::min(samples.size() - offset, n - pending_.size());
+        pending_.insert(pending_.end(), samples.begin() + offset, samples.begin() + offset + take);
+        offset += take;
+
+        if (pending_.size() < n) break;
+        computeColumn();
+        if (onColumn) onColumn(Column(column_));
+        ++columns;
+
+        // Следующий кадр начинается через hop отсчётов
+        pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(options_.hop));
+    }
+    return columns;
+}
+
+void Spectrogram::computeColumn() {
+    TRACE_SCOPE("Spectrogram::column");
+    const size_t n = options_.frameSize;
+    for (size_t i = 0; i < n; ++i) spectrum_[i] = Complex(pending_[i] * window_[i], 0.0);
+    fft_impl::fft_inplace(spectrum_);
+
+    const double floorPower = std::pow(10.0, options_.floorDb / 10.0);
+    for (size_t k = 0; k < column_.size(); ++k) {
+        const double power = std::max(std::norm(spectrum_[k]) * scale_, floorPower);
+        column_[k] = static_cast<float>(10.0 * std::log10(power));
+    }
+}
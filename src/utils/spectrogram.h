@@ -0,0 +1,67 @@
+#ifndef SPECTROGRAM_H
+#define SPECTROGRAM_H
+
+/**
+ * Потоковая спектрограмма (STFT) для водопада.
+ *
+ * Отсчёты подаются блоками произвольной длины; каждые hop отсчётов, как
+ * только накоплен кадр из frameSize отсчётов, выдаётся столбец — спектр
+ * мощности кадра с окном Ханна в дБ, frameSize/2 + 1 бинов от нуля до
+ * частоты Найквиста. Нормировка: синус амплитуды A в центре бина даёт
+ * 20·log10(A) дБ. Уровни ниже floorDb обрезаются.
+ *
+ * Память — O(frameSize) независимо от длины потока.
+ */
+
+#include "fft.h"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+/**
+ * Параметры спектрограммы
+ */
+struct SpectrogramOptions {
+    size_t frameSize = 256;      ///< Отсчётов в кадре (степень двойки)
+    size_t hop       = 128;      ///< Сдвиг между соседними кадрами (1..frameSize)
+    double floorDb   = -120.0;   ///< Нижний предел уровня, дБ
+};
+
+class Spectrogram {
+public:
+    using Options = SpectrogramOptions;
+    using Column  = std::span<const float>;
+
+    /** @throws std::invalid_argument если frameSize не степень двойки или hop вне [1, frameSize] */
+    explicit Spectrogram(Options options = Options());
+
+    /** Бинов в столбце: frameSize/2 + 1 */
+    size_t bins() const { return options_.frameSize / 2 + 1; }
+
+    const Options& options() const { return options_; }
+
+    /**
+     * Добавить отсчёты
+     * @param onColumn Вызывается для каждого готового столбца (bins() значений, дБ);
+     *                 столбец действителен только во время вызова
+     * @return Число выданных столбцов
+     */
+    size_t push(std::span<const double> samples, const std::function<void(Column)>& onColumn);
+
+    /** Забыть накопленные отсчёты */
+    void reset() { pending_.clear(); }
+
+private:
+    void computeColumn();
+
+    Options             options_;
+    std::vector<double> window_;
+    double              scale_;     ///< 4 / (Σw)²: синус → A² в своём бине
+    std::vector<double> pending_;   ///< Отсчёты, ещё не покрытые кадром целиком
+    CVector             spectrum_;
+    std::vector<float>  column_;
+};
+
+#endif // SPECTROGRAM_H
@@ -0,0 +1,84 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+/**
+ * Кольцевая очередь без блокировок: один поток-писатель, один поток-читатель.
+ *
+ * Ёмкость округляется вверх до степени двойки. Индексы записи и чтения лежат
+ * на разных строках кэша; каждая сторона держит копию чужого индекса и
+ * перечитывает его (acquire) только когда очередь по копии кажется полной
+ * или пустой — в установившемся режиме строка соседа не дёргается на каждой
+ * операции.
+ *
+ * tryPush/tryPop не ждут: ожидание (и его учёт) — забота вызывающего.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+template<typename T>
+class SpscQueue {
+public:
+    /** @param capacity Наименьшая допустимая ёмкость (не меньше 1) */
+    explicit SpscQueue(size_t capacity)
+        : capacity_(roundUpPow2(capacity < 1 ? 1 : capacity)),
+          mask_(capacity_ - 1),
+          slots_(std::make_unique<T[]>(capacity_)) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t capacity() const { return capacity_; }
+
+    /** Писатель: переместить value в очередь; false — очередь полна (value не тронут) */
+    bool tryPush(T& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == capacity_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == capacity_) return false;
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Читатель: извлечь элемент в value; false — очередь пуста */
+    bool tryPop(T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) return false;
+        }
+        value = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Число элементов (приблизительно, если другая сторона работает) */
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+private:
+    static size_t roundUpPow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    static constexpr size_t kCacheLine = 64;
+
+    const size_t         capacity_;
+    const size_t         mask_;
+    std::unique_ptr<T[]> slots_;
+
+    alignas(kCacheLine) std::atomic<size_t> head_{0};   ///< Пишет читатель
+    size_t                                  tailCache_ = 0;
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};   ///< Пишет писатель
+    size_t                                  headCache_ = 0;
+};
+
+#endif // SPSC_QUEUE_H
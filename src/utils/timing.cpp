@@ -0,0 +1,116 @@
+#include "timing.h"
+#include "median.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+/// σ̂ = kMadScale · MAD для нормального распределения
+constexpr double kMadScale = 1.4826;
+
+/// Полуширина 95% ДИ медианы: 1.96 · √(π/2) · σ̂ / √n
+constexpr double kMedianCI = 1.96 * 1.2533;
+
+/// Значение p-го квантиля (0 ≤ p ≤ 1) отсортированного массива, линейная интерполяция
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const double pos  = p * static_cast<double>(sorted.size() - 1);
+    const size_t lo   = static_cast<size_t>(pos);
+    const size_t hi   = std::min(lo + 1, sorted.size() - 1);
+    const double frac = pos - static_cast<double>(lo);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+}
+
+double medianAbsoluteDeviation(const std::vector<double>& values, double med) {
+    std::vector<double> dev(values.size());
+    for (size_t i = 0; i < values.size(); ++i) dev[i] = std::abs(values[i] - med);
+    return median(dev);
+}
+
+double relativeMedianCI(double med, double mad, size_t n) {
+    if (med <= 0.0 || n == 0) return 0.0;
+    return kMedianCI * kMadScale * mad / std::sqrt(static_cast<double>(n)) / med;
+}
+
+} // namespace
+
+TimingStats summarizeTimings(std::vector<double> samplesNs, double outlierThreshold) {
+    TimingStats stats;
+    if (samplesNs.empty()) return stats;
+
+    std::sort(samplesNs.begin(), samplesNs.end());
+
+    // Отбраковка медленных выбросов: время может только «добавиться»
+    // (вытеснение, прерывание), поэтому порог односторонний
+    if (outlierThreshold > 0.0) {
+        const double med = percentile(samplesNs, 0.5);
+        const double mad = medianAbsoluteDeviation(samplesNs, med);
+        if (mad > 0.0) {
+            const double limit = med + outlierThreshold * kMadScale * mad;
+            const auto keep = std::upper_bound(samplesNs.begin(), samplesNs.end(), limit);
+            stats.rejected = static_cast<size_t>(samplesNs.end() - keep);
+            samplesNs.erase(keep, samplesNs.end());
+        }
+    }
+
+    stats.samples  = samplesNs.size();
+    stats.minNs    = samplesNs.front();
+    stats.maxNs    = samplesNs.back();
+    stats.medianNs = percentile(samplesNs, 0.5);
+    stats.p90Ns    = percentile(samplesNs, 0.9);
+    stats.p99Ns    = percentile(samplesNs, 0.99);
+    stats.meanNs   = std::accumulate(samplesNs.begin(), samplesNs.end(), 0.0) /
+                     static_cast<double>(samplesNs.size());
+    stats.madNs    = medianAbsoluteDeviation(samplesNs, stats.medianNs);
+    stats.relativeCI = relativeMedianCI(stats.medianNs, stats.madNs, stats.samples);
+    return stats;
+}
+
+TimingStats measureTiming(const std::function<void()>& fn, const TimingOptions& options) {
+    using Clock = std::chrono::steady_clock;
+
+    for (size_t i = 0; i < options.warmupRuns; ++i) fn();
+
+    const double minTotalNs = options.minTotalSeconds * 1e9;
+    const double maxTotalNs = options.maxTotalSeconds * 1e9;
+    const size_t maxReps    = std::max<size_t>(1, options.maxRepetitions);
+    const size_t minReps    = std::clamp<size_t>(options.minRepetitions, 1, maxReps);
+
+    std::vector<double> samples;
+    samples.reserve(std::min<size_t>(maxReps, 1024));
+    double totalNs   = 0.0;
+    size_t nextCheck = minReps;   // ДИ пересчитывается с геометрическим шагом
+
+    while (samples.size() < maxReps) {
+        const auto start = Clock::now();
+        fn();
+        const auto end = Clock::now();
+
+        const double ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        samples.push_back(ns);
+        totalNs += ns;
+
+        const size_t n = samples.size();
+        if (n < minReps) continue;
+        if (totalNs >= maxTotalNs) break;
+        if (totalNs < minTotalNs) continue;
+        if (options.targetRelativeCI <= 0.0) break;
+
+        if (n >= nextCheck) {
+            std::vector<double> sorted(samples);
+            std::sort(sorted.begin(), sorted.end());
+            const double med = percentile(sorted, 0.5);
+            if (relativeMedianCI(med, medianAbsoluteDeviation(sorted, med), n) <=
+                options.targetRelativeCI) {
+                break;
+            }
+            nextCheck = n + std::max<size_t>(1, n / 4);
+        }
+    }
+
+    return summarizeTimings(std::move(samples), options.outlierThreshold);
+}
@@ -0,0 +1,100 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+/**
+ * Статистически устойчивый замер времени выполнения.
+ *
+ * Одиночный «холодный» замер короткой функции почти ничего не говорит:
+ * первый вызов платит за промахи кэша и выделение памяти, а отдельные
+ * запуски прерываются планировщиком. Поэтому:
+ *   1. несколько прогревочных вызовов не учитываются;
+ *   2. функция повторяется, пока не набрано minRepetitions вызовов и
+ *      minTotalSeconds общего времени, а затем — пока 95%-й доверительный
+ *      интервал медианы не сузится до targetRelativeCI (или не исчерпан лимит);
+ *   3. каждый вызов измеряется steady_clock с точностью до наносекунд;
+ *   4. выбросы вверх (вытеснение, прерывания) отбрасываются по порогу
+ *      медиана + k·σ̂, σ̂ = 1.4826·MAD.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * Параметры замера
+ */
+struct TimingOptions {
+    size_t warmupRuns       = 1;      ///< Прогревочные вызовы (не учитываются)
+    size_t minRepetitions   = 5;      ///< Минимум учитываемых вызовов
+    size_t maxRepetitions   = 1000;   ///< Максимум учитываемых вызовов
+    double minTotalSeconds  = 0.01;   ///< Минимальное суммарное время замеров
+    double maxTotalSeconds  = 0.5;    ///< Предел суммарного времени замеров
+    double targetRelativeCI = 0.02;   ///< Полуширина 95% ДИ медианы / медиана (0 — не проверять)
+    double outlierThreshold = 5.0;    ///< k для отбраковки выбросов (0 — не отбраковывать)
+
+    /** Один холодный вызов без повторов — прежнее поведение measurePerformance */
+    static TimingOptions singleShot() {
+        TimingOptions o;
+        o.warmupRuns = 0;
+        o.minRepetitions = o.maxRepetitions = 1;
+        o.minTotalSeconds = o.targetRelativeCI = o.outlierThreshold = 0.0;
+        return o;
+    }
+};
+
+/**
+ * Итоги замера, наносекунды
+ */
+struct TimingStats {
+    size_t samples    = 0;      ///< Учтённые вызовы (после отбраковки)
+    size_t rejected   = 0;      ///< Отброшенные выбросы
+    double minNs      = 0.0;
+    double medianNs   = 0.0;
+    double meanNs     = 0.0;
+    double p90Ns      = 0.0;
+    double p99Ns      = 0.0;
+    double maxNs      = 0.0;
+    double madNs      = 0.0;    ///< Медианное абсолютное отклонение (без масштаба 1.4826)
+    double relativeCI = 0.0;    ///< Полуширина 95% ДИ медианы / медиана
+};
+
+/**
+ * Посчитать статистику по сырым замерам
+ * @param samplesNs Времена вызовов, нс
+ * @param outlierThreshold k для отбраковки медиана + k·1.4826·MAD (0 — без неё)
+ */
+TimingStats summarizeTimings(std::vector<double> samplesNs, double outlierThreshold = 5.0);
+
+/**
+ * Замерить fn по правилам TimingOptions
+ */
+TimingStats measureTiming(const std::function<void()>& fn,
+                          const TimingOptions& options = TimingOptions());
+
+/**
+ * Барьер оптимизатора: значение считается прочитанным, поэтому его
+ * вычисление не может быть удалено или вынесено из цикла замера
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * Барьер оптимизатора: все записи в память считаются наблюдаемыми
+ */
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+#endif // TIMING_H
@@ -0,0 +1,256 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+constexpr size_t kChunkEvents        = 4096;
+constexpr size_t kMaxChunksPerThread = 256;   // ≈ 1 млн событий на дорожку
+
+struct TraceEvent {
+    const char* name;
+    uint64_t    startNs;
+    uint64_t    durationNs;
+};
+
+/// Блок событий; count публикуется с release — читатель видит готовые события
+struct TraceChunk {
+    std::array<TraceEvent, kChunkEvents> events;
+    std::atomic<size_t>      count{0};
+    std::atomic<TraceChunk*> next{nullptr};
+};
+
+/// Буфер дорожки: пишет только поток-владелец
+struct ThreadBuffer {
+    uint32_t          id = 0;
+    std::string       name;                 ///< Под мьютексом реестра
+    TraceChunk        head;
+    TraceChunk*       tail   = &head;
+    size_t            chunks = 1;
+    std::atomic<bool> inUse{true};
+
+    ~ThreadBuffer() { releaseChunks(); }
+
+    /// Удалить все блоки, кроме первого, и обнулить счётчики
+    void releaseChunks() {
+        TraceChunk* chunk = head.next.exchange(nullptr);
+        while (chunk) {
+            TraceChunk* next = chunk->next.load();
+            delete chunk;
+            chunk = next;
+        }
+        head.count.store(0);
+        tail   = &head;
+        chunks = 1;
+    }
+};
+
+struct TraceRegistry {
+    std::mutex                                 mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::atomic<size_t>                        dropped{0};
+};
+
+/// Не разрушается при выходе: деструкторы thread_local могут сработать позже
+TraceRegistry& registry() {
+    static TraceRegistry* instance = new TraceRegistry;
+    return *instance;
+}
+
+/// Освобождает буфер при завершении потока
+struct ThreadHandle {
+    ThreadBuffer* buffer = nullptr;
+    ~ThreadHandle() {
+        if (buffer) buffer->inUse.store(false, std::memory_order_release);
+    }
+};
+
+thread_local ThreadHandle g_handle;
+
+ThreadBuffer& localBuffer() {
+    if (g_handle.buffer) return *g_handle.buffer;
+
+    TraceRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& buffer : reg.buffers) {
+        bool expected = false;
+        if (buffer->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            g_handle.buffer = buffer.get();
+            return *buffer;
+        }
+    }
+    auto buffer  = std::make_unique<ThreadBuffer>();
+    buffer->id   = static_cast<uint32_t>(reg.buffers.size() + 1);
+    buffer->name = "thread " + std::to_string(buffer->id);
+    g_handle.buffer = buffer.get();
+    reg.buffers.push_back(std::move(buffer));
+    return *g_handle.buffer;
+}
+
+void appendString(std::string& out, const std::string& s) {
+    out += '"';
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+/// Наносекунды → микросекунды (единица формата) с точностью до нс
+void appendMicros(std::string& out, uint64_t ns) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    out += buf;
+}
+
+} // namespace
+
+std::atomic<bool> trace_detail::active{false};
+
+void trace_detail::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& buffer = localBuffer();
+    TraceChunk* chunk = buffer.tail;
+    size_t n = chunk->count.load(std::memory_order_relaxed);
+
+    if (n == kChunkEvents) {
+        if (buffer.chunks >= kMaxChunksPerThread) {
+            registry().dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        TraceChunk* fresh = new TraceChunk;
+        chunk->next.store(fresh, std::memory_order_release);
+        buffer.tail = fresh;
+        ++buffer.chunks;
+        chunk = fresh;
+        n = 0;
+    }
+
+    chunk->events[n] = {name, startNs, endNs - startNs};
+    chunk->count.store(n + 1, std::memory_order_release);
+}
+
+bool traceCompiledIn() {
+#ifdef SIGNAL_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void traceStart() {
+    TraceRegistry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (auto& buffer : reg.buffers) buffer->releaseChunks();
+    }
+    reg.dropped.store(0);
+    trace_detail::active.store(true);
+}
+
+void traceStop() {
+    trace_detail::active.store(false);
+}
+
+bool traceActive() {
+    return trace_detail::active.load(std::memory_order_relaxed);
+}
+
+void traceSetThreadName(const std::string& name) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+std::vector<TraceRecord> traceSnapshot() {
+    std::vector<TraceRecord> records;
+    TraceRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    for (const auto& buffer : reg.buffers) {
+        const size_t first = records.size();
+        for (const TraceChunk* chunk = &buffer->head; chunk;
+             chunk = chunk->next.load(std::memory_order_acquire)) {
+            const size_t n = chunk->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < n; ++i) {
+                const TraceEvent& e = chunk->events[i];
+                records.push_back({e.name, buffer->id, e.startNs, e.durationNs});
+            }
+        }
+        // Внутри потока события пишутся по завершении — внешняя область
+        // оказывается после вложенных; упорядочиваем по началу, при равенстве
+        // внешняя (более длинная) — раньше
+        std::sort(records.begin() + static_cast<std::ptrdiff_t>(first), records.end(),
+                  [](const TraceRecord& a, const TraceRecord& b) {
+                      if (a.startNs != b.startNs) return a.startNs < b.startNs;
+                      return a.durationNs > b.durationNs;
+                  });
+    }
+    return records;
+}
+
+size_t traceDroppedEvents() {
+    return registry().dropped.load();
+}
+
+void writeChromeTrace(const std::string& filename) {
+    const std::vector<TraceRecord> records = traceSnapshot();
+
+    uint64_t origin = UINT64_MAX;
+    for (const TraceRecord& r : records) origin = std::min(origin, r.startNs);
+
+    std::string out;
+    out.reserve(128 + records.size() * 96);
+    out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    {
+        TraceRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+               "\"args\":{\"name\":\"echo_filters\"}}";
+        for (const auto& buffer : reg.buffers) {
+            out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+            out += std::to_string(buffer->id);
+            out += ",\"args\":{\"name\":";
+            appendString(out, buffer->name);
+            out += "}}";
+        }
+    }
+
+    for (const TraceRecord& r : records) {
+        out += ",\n{\"name\":";
+        appendString(out, r.name);
+        out += ",\"cat\":\"signal\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+        out += std::to_string(r.threadId);
+        out += ",\"ts\":";
+        appendMicros(out, r.startNs - origin);
+        out += ",\"dur\":";
+        appendMicros(out, r.durationNs);
+        out += '}';
+    }
+    out += "\n]}\n";
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Не удалось создать файл: " + filename);
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    if (!file) {
+        throw std::runtime_error("Ошибка записи файла: " + filename);
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/**
+ * Трассировка этапов обработки (по желанию, флаг сборки).
+ *
+ * TRACE_SCOPE("Имя") открывает область до конца блока; при сборке с
+ * -DTRACING=ON (макрос SIGNAL_TRACING) её начало и длительность пишутся в
+ * буфер текущего потока, без флага макрос раскрывается в пустой оператор.
+ * Имя — строковый литерал: хранится только указатель.
+ *
+ * Запись идёт только между traceStart() и traceStop(). Буфер потока —
+ * список блоков событий, в который пишет лишь сам поток (без блокировок);
+ * мьютекс берётся один раз при первой записи из нового потока. Буферы
+ * завершившихся потоков переиспользуются новыми — число дорожек равно
+ * наибольшему числу одновременно работавших потоков.
+ *
+ * writeChromeTrace() сохраняет события в формате Chrome Trace Event (JSON),
+ * который открывается в Perfetto (ui.perfetto.dev, офлайн) и chrome://tracing:
+ * вложенные области одного потока показываются как стек.
+ *
+ * traceStart(), traceSnapshot() и writeChromeTrace() нельзя вызывать, пока
+ * другие потоки пишут события: сначала traceStop() и завершение обработки.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Записанное событие (копия для анализа и тестов)
+ */
+struct TraceRecord {
+    std::string name;
+    uint32_t    threadId   = 0;   ///< Номер дорожки (буфера потока), с 1
+    uint64_t    startNs    = 0;   ///< steady_clock, нс
+    uint64_t    durationNs = 0;
+};
+
+/** Трассировка собрана в программу (SIGNAL_TRACING) */
+bool traceCompiledIn();
+
+/** Очистить записанные события и начать запись */
+void traceStart();
+
+/** Остановить запись (события сохраняются до следующего traceStart) */
+void traceStop();
+
+/** Идёт запись */
+bool traceActive();
+
+/** Имя дорожки текущего потока в трассе (по умолчанию "thread N") */
+void traceSetThreadName(const std::string& name);
+
+/** Все записанные события, упорядоченные по дорожке и времени начала */
+std::vector<TraceRecord> traceSnapshot();
+
+/** Событий отброшено из-за переполнения буферов */
+size_t traceDroppedEvents();
+
+/**
+ * Сохранить события в JSON формата Chrome Trace Event
+ * @throws std::runtime_error если файл не удалось создать
+ */
+void writeChromeTrace(const std::string& filename);
+
+namespace trace_detail {
+
+extern std::atomic<bool> active;
+
+inline uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+} // namespace trace_detail
+
+/**
+ * Область трассы: событие записывается в деструкторе
+ *
+ * Обычно создаётся макросом TRACE_SCOPE; прямое использование пишет
+ * события и без SIGNAL_TRACING.
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name)
+        : name_(trace_detail::active.load(std::memory_order_relaxed) ? name : nullptr),
+          startNs_(name_ ? trace_detail::nowNs() : 0) {}
+
+    ~TraceSpan() {
+        if (name_) trace_detail::record(name_, startNs_, trace_detail::nowNs());
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name_;
+    uint64_t    startNs_;
+};
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#ifdef SIGNAL_TRACING
+#define TRACE_SCOPE(name) TraceSpan TRACE_CONCAT(traceSpan_, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,63 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+/**
+ * Передача последнего значения между двумя потоками без блокировок.
+ *
+ * Писатель заполняет свой буфер (back) и публикует его, читатель забирает
+ * последнее опубликованное значение (front). Третий, средний буфер — место
+ * обмена: публикация меняет back и средний местами, получение — front и
+ * средний. Ни одна сторона не ждёт другую и не видит буфер, который в этот
+ * момент пишется; промежуточные публикации, которые читатель не успел
+ * забрать, заменяются более новыми.
+ *
+ * В отличие от SpscQueue здесь важен только последний снимок (ход фоновых
+ * вычислений для кадра отрисовки), а не каждый элемент.
+ *
+ * Буфер, возвращённый writeBuffer() после publish(), содержит одно из
+ * прежних значений — писатель может обновлять его частично.
+ */
+
+#include <atomic>
+#include <cstdint>
+
+template<typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /** Писатель: буфер для заполнения */
+    T& writeBuffer() { return slots_[back_]; }
+
+    /** Писатель: опубликовать writeBuffer() */
+    void publish() {
+        back_ = middle_.exchange(static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel) & kIndex;
+    }
+
+    /**
+     * Читатель: забрать последнюю публикацию
+     * @return true — readBuffer() обновился
+     */
+    bool update() {
+        if (!(middle_.load(std::memory_order_relaxed) & kFresh)) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndex;
+        return true;
+    }
+
+    /** Читатель: последнее забранное значение */
+    const T& readBuffer() const { return slots_[front_]; }
+    T& readBuffer() { return slots_[front_]; }
+
+private:
+    static constexpr uint8_t kIndex = 0x3;
+    static constexpr uint8_t kFresh = 0x4;   ///< Средний буфер ещё не забран читателем
+
+    T                    slots_[3];
+    uint8_t              back_   = 0;   ///< Только писатель
+    std::atomic<uint8_t> middle_{1};
+    uint8_t              front_  = 2;   ///< Только читатель
+};
+
+#endif // TRIPLE_BUFFER_H
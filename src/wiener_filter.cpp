@@ -1,5 +1,6 @@
 #include "wiener_filter.h"
 #include "utils/linear_system_solver.h"
+#include "utils/trace.h"
 
 #include <stdexcept>
 #include <cmath>
@@ -62,6 +63,7 @@ std::vector<double> WienerFilter::getWeights() const
 
 SignalProcessor::Signal WienerFilter::process(const Signal& input)
 {
+    TRACE_SCOPE("WienerFilter::process");
     const size_t N = input.size();
     if (N == 0)
         return Signal();
@@ -82,6 +84,7 @@ SignalProcessor::Signal WienerFilter::process(const Signal& input)
     weights_ = solveLinearSystem(R, p);
 
     // 5. Применяем фильтр: y[n] = wᵀ · x[n]
+    TRACE_SCOPE("WienerFilter::fir");
     Signal output(N, 0.0);
     for (size_t n = 0; n < N; ++n) {
         double y = 0.0;
@@ -103,6 +106,7 @@ SignalProcessor::Signal WienerFilter::process(const Signal& input)
 ublas::matrix<double>
 WienerFilter::buildCorrelationMatrix(const Signal& x) const
 {
+    TRACE_SCOPE("WienerFilter::buildCorrelationMatrix");
     const size_t N = x.size();
     const size_t M = filterOrder_;
 
@@ -112,9 +116,12 @@ WienerFilter::buildCorrelationMatrix(const Signal& x) const
     const size_t start = (N > M) ? (M - 1) : 0;
     const size_t K     = (N > start) ? (N - start) : 1;
 
+    // При N ≤ M суммирование идёт с n = 0: недоступные задержки x[n-i], n < i,
+    // считаются нулевыми
     for (size_t n = start; n < N; ++n) {
-        for (size_t i = 0; i < M; ++i) {
-            for (size_t j = 0; j < M; ++j) {
+        const size_t lags = std::min(M, n + 1);
+        for (size_t i = 0; i < lags; ++i) {
+            for (size_t j = 0; j < lags; ++j) {
                 R(i, j) += x[n - i] * x[n - j];
             }
         }
@@ -139,6 +146,7 @@ ublas::vector<double>
 WienerFilter::buildCrossCorrelationVector(const Signal& x,
                                            const Signal& d) const
 {
+    TRACE_SCOPE("WienerFilter::buildCrossCorrelationVector");
     const size_t N = x.size();
     const size_t M = filterOrder_;
 
@@ -148,7 +156,8 @@ WienerFilter::buildCrossCorrelationVector(const Signal& x,
     const size_t K     = (N > start) ? (N - start) : 1;
 
     for (size_t n = start; n < N; ++n) {
-        for (size_t i = 0; i < M; ++i) {
+        const size_t lags = std::min(M, n + 1);
+        for (size_t i = 0; i < lags; ++i) {
             p(i) += d[n] * x[n - i];
         }
     }
@@ -165,6 +174,7 @@ WienerFilter::buildCrossCorrelationVector(const Signal& x,
 
 SignalProcessor::Signal WienerFilter::estimateDesired(const Signal& x) const
 {
+    TRACE_SCOPE("WienerFilter::estimateDesired");
     const size_t N    = x.size();
     const size_t half = desiredWindow_ / 2;
     Signal d(N, 0.0);
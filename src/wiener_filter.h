@@ -51,6 +51,14 @@ public:
      */
     std::string getName() const override;
 
+    /** Независимая копия фильтра */
+    std::unique_ptr<SignalProcessor> clone() const override {
+        return std::make_unique<WienerFilter>(*this);
+    }
+
+    /** Порядок фильтра M */
+    size_t getWindowSize() const override { return filterOrder_; }
+
     /**
      * Установить параметры
      * @param filterOrder Порядок фильтра
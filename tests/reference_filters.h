@@ -0,0 +1,468 @@
+#ifndef REFERENCE_FILTERS_H
+#define REFERENCE_FILTERS_H
+
+/**
+ * Эталонные (простые и заведомо верные) реализации фильтров и ядер utils.
+ *
+ * Это прямые переложения формул в том виде, в каком алгоритмы были
+ * реализованы до оптимизаций: сортировка окна для медианы, полное построение
+ * R и p с решением системы методом Гаусса, ДПФ за O(N²) вместо БПФ, фильтр
+ * Калмана на скалярах. Оптимизированные пути в src/ сравниваются с ними в
+ * tests/test_equivalence.cpp.
+ *
+ * Меняя поведение фильтра намеренно, нужно менять и эталон — иначе
+ * эквивалентность тестирует не то, что задумано.
+ */
+
+#include "../src/morphological_filter.h"
+#include "../src/outlier_detection.h"
+#include "../src/utils/fft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace reference {
+
+using Signal = std::vector<double>;
+using Matrix = std::vector<std::vector<double>>;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Ядра
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** Медиана сортировкой; для чётного размера — среднее двух центральных */
+inline double median(std::vector<double> v) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    const size_t n = v.size();
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2.0;
+}
+
+/** Медиана абсолютных отклонений от med */
+inline double mad(const std::vector<double>& v, double med) {
+    std::vector<double> dev;
+    for (double x : v) dev.push_back(std::abs(x - med));
+    return median(dev);
+}
+
+/**
+ * Метод Гаусса с выбором главного элемента по столбцу
+ * @return решение или нули, если встретился нулевой ведущий элемент
+ */
+inline std::vector<double> solve(Matrix A, std::vector<double> b) {
+    const size_t n = A.size();
+    for (size_t c = 0; c < n; ++c) {
+        size_t pivot = c;
+        for (size_t r = c + 1; r < n; ++r) {
+            if (std::abs(A[r][c]) > std::abs(A[pivot][c])) pivot = r;
+        }
+        if (A[pivot][c] == 0.0) return std::vector<double>(n, 0.0);
+        std::swap(A[c], A[pivot]);
+        std::swap(b[c], b[pivot]);
+        for (size_t r = c + 1; r < n; ++r) {
+            const double f = A[r][c] / A[c][c];
+            for (size_t k = c; k < n; ++k) A[r][k] -= f * A[c][k];
+            b[r] -= f * b[c];
+        }
+    }
+    std::vector<double> x(n);
+    for (size_t i = n; i-- > 0;) {
+        double s = b[i];
+        for (size_t k = i + 1; k < n; ++k) s -= A[i][k] * x[k];
+        x[i] = s / A[i][i];
+    }
+    return x;
+}
+
+/** ДПФ по определению, O(N²); обратное — с нормировкой 1/N, как fft_inplace */
+inline CVector dft(const CVector& x, bool inverse = false) {
+    const size_t n = x.size();
+    CVector y(n);
+    const double sign = inverse ? 1.0 : -1.0;
+    for (size_t k = 0; k < n; ++k) {
+        Complex sum(0.0, 0.0);
+        for (size_t t = 0; t < n; ++t) {
+            // (k·t) mod n — угол без потери точности на больших k·t
+            const double ang = sign * 2.0 * M_PI * static_cast<double>((k * t) % n)
+                               / static_cast<double>(n);
+            sum += x[t] * Complex(std::cos(ang), std::sin(ang));
+        }
+        y[k] = inverse ? sum / static_cast<double>(n) : sum;
+    }
+    return y;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Фильтры
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** Медианный фильтр; за краями повторяется крайний отсчёт */
+inline Signal medianFilter(const Signal& x, size_t window) {
+    const long n = static_cast<long>(x.size());
+    const long half = static_cast<long>(window / 2);
+    Signal y(x.size());
+    for (long i = 0; i < n; ++i) {
+        std::vector<double> w;
+        for (long k = i - half; k <= i + half; ++k) w.push_back(x[std::clamp(k, 0L, n - 1)]);
+        y[i] = median(w);
+    }
+    return y;
+}
+
+/** Эрозия / дилатация со структурирующим элементом se (центр — se.size()/2) */
+inline Signal erosion(const Signal& x, const std::vector<double>& se) {
+    const long n = static_cast<long>(x.size());
+    const long half = static_cast<long>(se.size() / 2);
+    Signal y(x.size());
+    for (long i = 0; i < n; ++i) {
+        double v = std::numeric_limits<double>::infinity();
+        for (long j = 0; j < static_cast<long>(se.size()); ++j) {
+            const long k = i - half + j;
+            if (k >= 0 && k < n) v = std::min(v, x[k] - se[j]);
+        }
+        y[i] = v;
+    }
+    return y;
+}
+
+inline Signal dilation(const Signal& x, const std::vector<double>& se) {
+    const long n = static_cast<long>(x.size());
+    const long half = static_cast<long>(se.size() / 2);
+    Signal y(x.size());
+    for (long i = 0; i < n; ++i) {
+        double v = -std::numeric_limits<double>::infinity();
+        for (long j = 0; j < static_cast<long>(se.size()); ++j) {
+            const long k = i - half + j;
+            if (k >= 0 && k < n) v = std::max(v, x[k] + se[j]);
+        }
+        y[i] = v;
+    }
+    return y;
+}
+
+inline Signal morphological(const Signal& x, MorphologicalFilter::Operation op,
+                            const std::vector<double>& se) {
+    using Op = MorphologicalFilter::Operation;
+    switch (op) {
+        case Op::EROSION:  return erosion(x, se);
+        case Op::DILATION: return dilation(x, se);
+        case Op::OPENING:  return dilation(erosion(x, se), se);
+        case Op::CLOSING:  return erosion(dilation(x, se), se);
+    }
+    return x;
+}
+
+/**
+ * Фильтр Савицкого-Голея: коэффициенты из нормальных уравнений МНК,
+ * за краями — зеркальное отражение без повтора крайнего отсчёта
+ */
+inline Signal savgol(const Signal& x, size_t window, size_t order) {
+    const int half = static_cast<int>(window / 2);
+    Matrix A(order + 1, std::vector<double>(order + 1, 0.0));
+    for (size_t i = 0; i <= order; ++i)
+        for (size_t j = 0; j <= order; ++j)
+            for (int k = -half; k <= half; ++k) A[i][j] += std::pow(k, i + j);
+    std::vector<double> e0(order + 1, 0.0);
+    e0[0] = 1.0;
+    const std::vector<double> a = solve(A, e0);
+
+    std::vector<double> h(window, 0.0);
+    for (int k = -half; k <= half; ++k)
+        for (size_t j = 0; j <= order; ++j) h[k + half] += a[j] * std::pow(k, j);
+
+    const int n = static_cast<int>(x.size());
+    auto at = [&](int k) {
+        // Отражение, повторяемое для окна длиннее сигнала
+        while (k < 0 || k >= n) {
+            if (n == 1) return x[0];
+            k = k < 0 ? -k : 2 * (n - 1) - k;
+        }
+        return x[k];
+    };
+
+    Signal y(x.size());
+    for (int i = 0; i < n; ++i) {
+        double s = 0.0;
+        for (int k = -half; k <= half; ++k) s += h[k + half] * at(i + k);
+        y[i] = s;
+    }
+    return y;
+}
+
+/** Фильтр Калмана с моделью постоянной скорости, скалярная запись 2×2 */
+inline Signal kalman(const Signal& z, double q, double r, double dt) {
+    Signal y;
+    if (z.empty()) return y;
+    double p = z[0], v = 0.0;
+    double P00 = 1.0, P01 = 0.0, P10 = 0.0, P11 = 1.0;
+    const double Q00 = q * dt * dt * dt * dt / 4.0, Q01 = q * dt * dt * dt / 2.0;
+    const double Q11 = q * dt * dt;
+    y.push_back(z[0]);
+
+    for (size_t i = 1; i < z.size(); ++i) {
+        // Предсказание: x = F·x, P = F·P·Fᵀ + Q
+        p += dt * v;
+        const double a00 = P00 + dt * P10, a01 = P01 + dt * P11;
+        P00 = a00 + dt * a01 + Q00;
+        P01 = a01 + Q01;
+        P10 = P10 + dt * P11 + Q01;
+        P11 = P11 + Q11;
+
+        // Коррекция по измерению позиции
+        const double S = P00 + r;
+        if (std::abs(S) >= 1e-12) {
+            const double innovation = z[i] - p;
+            const double K0 = P00 / S, K1 = P10 / S;
+            p += K0 * innovation;
+            v += K1 * innovation;
+            const double n00 = (1.0 - K0) * P00, n01 = (1.0 - K0) * P01;
+            const double n10 = P10 - K1 * P00,   n11 = P11 - K1 * P01;
+            P00 = n00; P01 = n01; P10 = n10; P11 = n11;
+        }
+        y.push_back(p);
+    }
+    return y;
+}
+
+/** Обнаружение выбросов и замещение, как OutlierDetection (arOrder = 5) */
+inline Signal outliers(const Signal& x,
+                       OutlierDetection::DetectionMethod detection,
+                       OutlierDetection::InterpolationMethod interpolation,
+                       double threshold, size_t window) {
+    using DM = OutlierDetection::DetectionMethod;
+    using IM = OutlierDetection::InterpolationMethod;
+    const size_t n = x.size();
+    const size_t half = window / 2;
+    std::vector<bool> bad(n, false);
+    if (n == 0) return x;
+
+    auto lo = [&](size_t i) { return i >= half ? i - half : 0; };
+    auto hi = [&](size_t i) { return std::min(i + half + 1, n); };
+
+    if (detection == DM::MAD_BASED) {
+        for (size_t i = 0; i < n; ++i) {
+            std::vector<double> w(x.begin() + lo(i), x.begin() + hi(i));
+            if (w.size() < 3) continue;
+            const double med = median(w), m = mad(w, med);
+            bad[i] = m > 0.0 && std::abs(x[i] - med) > threshold * m;
+        }
+    } else if (detection == DM::STATISTICAL) {
+        const double mean = std::accumulate(x.begin(), x.end(), 0.0) / n;
+        double var = 0.0;
+        for (double v : x) var += (v - mean) * (v - mean);
+        const double sd = std::sqrt(var / n);
+        if (sd != 0.0) {
+            for (size_t i = 0; i < n; ++i) bad[i] = std::abs(x[i] - mean) / sd > threshold;
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            double sum = 0.0;
+            size_t count = 0;
+            for (size_t j = lo(i); j < hi(i); ++j) {
+                if (j != i) { sum += x[j]; ++count; }
+            }
+            if (count == 0) continue;
+            const double mean = sum / count;
+            double var = 0.0;
+            for (size_t j = lo(i); j < hi(i); ++j) {
+                if (j != i) var += (x[j] - mean) * (x[j] - mean);
+            }
+            const double sd = std::sqrt(var / count);
+            bad[i] = std::abs(x[i] - mean) > (sd == 0.0 ? threshold : threshold * sd);
+        }
+    }
+
+    auto linear = [&]() {
+        Signal y = x;
+        for (size_t i = 0; i < n; ++i) {
+            if (!bad[i]) continue;
+            long l = static_cast<long>(i) - 1;
+            while (l >= 0 && bad[l]) --l;
+            size_t r = i + 1;
+            while (r < n && bad[r]) ++r;
+            if (l >= 0 && r < n) {
+                y[i] = x[l] + (x[r] - x[l]) * (static_cast<double>(i) - l) / (static_cast<double>(r) - l);
+            } else if (l >= 0) {
+                y[i] = x[l];
+            } else if (r < n) {
+                y[i] = x[r];
+            }
+        }
+        return y;
+    };
+
+    if (interpolation == IM::LINEAR || interpolation == IM::SPLINE) return linear();
+
+    Signal y = x;
+    if (interpolation == IM::MEDIAN_BASED) {
+        const size_t h = std::min(half, size_t(5));
+        for (size_t i = 0; i < n; ++i) {
+            if (!bad[i]) continue;
+            std::vector<double> nb;
+            for (size_t j = (i >= h ? i - h : 0); j < std::min(i + h + 1, n); ++j) {
+                if (j != i && !bad[j]) nb.push_back(x[j]);
+            }
+            if (!nb.empty()) y[i] = median(nb);
+        }
+        return y;
+    }
+
+    // AUTOREGRESSIVE: взвешенное 1/j среднее уже обработанных предыдущих точек
+    for (size_t i = 0; i < n; ++i) {
+        if (!bad[i]) continue;
+        double sum = 0.0, wsum = 0.0;
+        for (size_t j = 1; j <= 5 && j <= i; ++j) {
+            if (!bad[i - j]) {
+                const double w = 1.0 / j;
+                sum += w * y[i - j];
+                wsum += w;
+            }
+        }
+        y[i] = wsum > 0.0 ? sum / wsum : linear()[i];
+    }
+    return y;
+}
+
+/**
+ * Веса Винера: R·w = p по всем n, где доступна хотя бы одна задержка
+ * (недоступные x[n-i] считаются нулевыми), с регуляризацией reg·I
+ */
+inline std::vector<double> wienerWeights(const Signal& x, const Signal& d, size_t M, double reg) {
+    const size_t N = x.size();
+    const size_t start = N > M ? M - 1 : 0;
+    const double K = static_cast<double>(N > start ? N - start : 1);
+    auto lag = [&](size_t n, size_t i) { return n >= i ? x[n - i] : 0.0; };
+
+    Matrix R(M, std::vector<double>(M, 0.0));
+    std::vector<double> p(M, 0.0);
+    for (size_t n = start; n < N; ++n) {
+        for (size_t i = 0; i < M; ++i) {
+            for (size_t j = 0; j < M; ++j) R[i][j] += lag(n, i) * lag(n, j);
+            p[i] += d[n] * lag(n, i);
+        }
+    }
+    for (size_t i = 0; i < M; ++i) {
+        for (size_t j = 0; j < M; ++j) R[i][j] /= K;
+        p[i] /= K;
+        R[i][i] += reg;
+    }
+    return solve(R, p);
+}
+
+/** Фильтр Винера: d — скользящее среднее, вне сигнала x[n-i] → x[0] */
+inline Signal wiener(const Signal& x, size_t M, size_t window, double reg) {
+    const size_t N = x.size();
+    if (N == 0) return x;
+    const size_t half = window / 2;
+    Signal d(N);
+    for (size_t n = 0; n < N; ++n) {
+        const size_t a = n >= half ? n - half : 0, b = std::min(n + half, N - 1);
+        d[n] = std::accumulate(x.begin() + a, x.begin() + b + 1, 0.0) / (b - a + 1);
+    }
+    const std::vector<double> w = wienerWeights(x, d, M, reg);
+    Signal y(N, 0.0);
+    for (size_t n = 0; n < N; ++n)
+        for (size_t i = 0; i < M; ++i) y[n] += w[i] * x[n >= i ? n - i : 0];
+    return y;
+}
+
+/**
+ * Робастный Винер: очистка MAD + медианная замена, d — скользящая медиана
+ * (окно обрезается у краёв), фильтрация очищенного сигнала с нулями за краем
+ */
+inline Signal robustWiener(const Signal& x, size_t M, size_t window, double reg,
+                           double threshold, size_t outlierWindow) {
+    const size_t N = x.size();
+    if (N == 0) return x;
+    if (outlierWindow == 0) outlierWindow = 1;
+    if (outlierWindow % 2 == 0) ++outlierWindow;
+
+    const Signal xc = outliers(x, OutlierDetection::DetectionMethod::MAD_BASED,
+                               OutlierDetection::InterpolationMethod::MEDIAN_BASED,
+                               threshold, outlierWindow);
+    const size_t half = window / 2;
+    Signal d(N);
+    for (size_t n = 0; n < N; ++n) {
+        const size_t a = n >= half ? n - half : 0, b = std::min(n + half, N - 1);
+        d[n] = median(std::vector<double>(xc.begin() + a, xc.begin() + b + 1));
+    }
+    const std::vector<double> w = wienerWeights(xc, d, M, reg);
+    Signal y(N, 0.0);
+    for (size_t n = 0; n < N; ++n)
+        for (size_t i = 0; i < M && i <= n; ++i) y[n] += w[i] * xc[n - i];
+    return y;
+}
+
+/**
+ * Спектральное вычитание (WOLA, окно Ханна) на ДПФ по определению.
+ * Параметры — уже нормализованные (как после validateParams)
+ */
+inline Signal spectralSubtraction(const Signal& input, size_t frame, size_t hop,
+                                  size_t noiseFrames, double alpha, double beta,
+                                  double updateRate, double gamma) {
+    const size_t N = input.size();
+    if (N == 0) return input;
+    if (N < frame) {
+        Signal padded(frame, 0.0);
+        std::copy(input.begin(), input.end(), padded.begin());
+        Signal y = spectralSubtraction(padded, frame, hop, noiseFrames, alpha, beta,
+                                       updateRate, gamma);
+        y.resize(N);
+        return y;
+    }
+
+    std::vector<double> win(frame);
+    for (size_t i = 0; i < frame; ++i)
+        win[i] = 0.5 * (1.0 - std::cos(2.0 * M_PI * i / static_cast<double>(frame - 1)));
+
+    Signal out(N + frame, 0.0), norm(N + frame, 0.0);
+    std::vector<double> noise(frame, 0.0);
+    size_t noiseCount = 0;
+
+    for (size_t start = 0; start + frame <= N + hop; start += hop) {
+        CVector X(frame);
+        for (size_t i = 0; i < frame; ++i)
+            X[i] = Complex((start + i < N ? input[start + i] : 0.0) * win[i], 0.0);
+        X = dft(X);
+
+        if (noiseCount < noiseFrames) {
+            for (size_t k = 0; k < frame; ++k) noise[k] += std::norm(X[k]);
+            if (++noiseCount == noiseFrames)
+                for (double& v : noise) v /= static_cast<double>(noiseCount);
+        } else {
+            double power = 0.0, meanNoise = 0.0;
+            for (size_t k = 0; k < frame; ++k) {
+                power += std::norm(X[k]);
+                meanNoise += noise[k];
+            }
+            if (power / frame <= gamma * (meanNoise / frame)) {
+                for (size_t k = 0; k < frame; ++k)
+                    noise[k] = (1.0 - updateRate) * noise[k] + updateRate * std::norm(X[k]);
+            }
+            for (size_t k = 0; k < frame; ++k) {
+                const double m2 = std::norm(X[k]);
+                const double s2 = std::max(m2 - alpha * noise[k], beta * noise[k]);
+                X[k] = m2 > 1e-30 ? X[k] * (std::sqrt(std::max(s2, 0.0)) / std::sqrt(m2))
+                                  : Complex(0.0, 0.0);
+            }
+        }
+
+        X = dft(X, true);
+        for (size_t i = 0; i < frame && start + i < out.size(); ++i) {
+            out[start + i]  += X[i].real() * win[i];
+            norm[start + i] += win[i] * win[i];
+        }
+    }
+
+    Signal y(N);
+    for (size_t i = 0; i < N; ++i) y[i] = norm[i] > 1e-12 ? out[i] / norm[i] : 0.0;
+    return y;
+}
+
+} // namespace reference
+
+#endif // REFERENCE_FILTERS_H
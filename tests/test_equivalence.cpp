@@ -0,0 +1,461 @@
+/**
+ * Эквивалентность оптимизированных фильтров и ядер эталонам (reference_filters.h).
+ *
+ * Каждый тест прогоняет kRandomCases случайных случаев (длина, параметры,
+ * форма сигнала) и набор краевых: N = 1, 2, окно длиннее сигнала, постоянный
+ * сигнал, ±Inf и NaN во входе. Генератор детерминирован (Xoshiro256 с
+ * фиксированным зерном) — упавший случай воспроизводится по номеру из
+ * сообщения.
+ *
+ * Сравнение (compareSignals): длины совпадают; там, где эталон конечен,
+ * |y − ref| ≤ abs + rel·|ref|; где эталон не конечен — выход тоже не конечен
+ * (NaN ↔ NaN, ±Inf ↔ ±Inf). Для фильтров с ограниченным окном отсчёты, чьё
+ * окно задевает NaN, не сравниваются: порядок сравнений с NaN (сортировка,
+ * min/max) не определён, и оптимизированный путь вправе его изменить.
+ */
+
+#include <gtest/gtest.h>
+
+#include "reference_filters.h"
+#include "../src/median_filter.h"
+#include "../src/wiener_filter.h"
+#include "../src/robust_wiener_filter.h"
+#include "../src/morphological_filter.h"
+#include "../src/savgol_filter.h"
+#include "../src/kalman_filter.h"
+#include "../src/outlier_detection.h"
+#include "../src/spectral_subtraction_filter.h"
+#include "../src/signal_processor.h"
+#include "../src/utils/median.h"
+#include "../src/utils/linear_system_solver.h"
+#include "../src/utils/random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Signal = std::vector<double>;
+
+constexpr size_t kRandomCases = 150;
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+/// Окно влияния NaN: kGlobal — NaN может испортить весь выход
+constexpr size_t kGlobal = std::numeric_limits<size_t>::max();
+
+struct Tolerance {
+    double abs = 0.0;
+    double rel = 0.0;
+};
+
+/**
+ * Генератор случаев: длина, форма сигнала, специальные значения
+ */
+class CaseGenerator {
+public:
+    explicit CaseGenerator(uint64_t seed) : rng_(seed) {}
+
+    size_t uniformSize(size_t lo, size_t hi) {
+        return std::uniform_int_distribution<size_t>(lo, hi)(rng_);
+    }
+
+    double uniform(double lo, double hi) {
+        return std::uniform_real_distribution<double>(lo, hi)(rng_);
+    }
+
+    size_t oddSize(size_t lo, size_t hi) { return uniformSize(lo / 2, (hi - 1) / 2) * 2 + 1; }
+
+    /// Длина: чаще короткая (краевые эффекты), иногда до maxN
+    size_t length(size_t maxN) {
+        const size_t kind = uniformSize(0, 9);
+        if (kind == 0) return uniformSize(1, 3);
+        if (kind < 5) return uniformSize(1, 64);
+        return uniformSize(1, maxN);
+    }
+
+    /// Белый шум, синус с шумом и импульсами, ступенька или константа
+    Signal signal(size_t n) {
+        Signal x(n);
+        const size_t kind = uniformSize(0, 3);
+        const double c = uniform(-5.0, 5.0);
+        for (size_t i = 0; i < n; ++i) {
+            const double noise = uniform(-1.0, 1.0);
+            switch (kind) {
+                case 0: x[i] = noise; break;
+                case 1: x[i] = std::sin(0.05 * i) + 0.3 * noise +
+                               (uniformSize(0, 30) == 0 ? uniform(-20.0, 20.0) : 0.0); break;
+                case 2: x[i] = (i < n / 2 ? -1.0 : 2.0) + 0.1 * noise; break;
+                default: x[i] = c; break;
+            }
+        }
+        return x;
+    }
+
+    /// Заменить несколько отсчётов на value
+    void inject(Signal& x, double value) {
+        const size_t count = std::min<size_t>(x.size(), uniformSize(1, 3));
+        for (size_t k = 0; k < count; ++k) x[uniformSize(0, x.size() - 1)] = value;
+    }
+
+private:
+    Xoshiro256 rng_;
+};
+
+/**
+ * Сравнить выход с эталоном (см. описание файла)
+ * @param reach Радиус влияния NaN для фильтров с окном; kGlobal — сравнивать
+ *              всё по правилу «не конечен ↔ не конечен»
+ */
+::testing::AssertionResult compareSignals(const Signal& x, const Signal& ref, const Signal& out,
+                                          Tolerance tol, size_t reach = kGlobal) {
+    if (ref.size() != out.size()) {
+        return ::testing::AssertionFailure() << "длина " << out.size()
+                                             << ", эталон " << ref.size();
+    }
+
+    std::vector<bool> skip(x.size(), false);
+    if (reach != kGlobal) {
+        for (size_t i = 0; i < x.size(); ++i) {
+            if (!std::isnan(x[i])) continue;
+            const size_t lo = i >= reach ? i - reach : 0;
+            const size_t hi = std::min(x.size(), i + reach + 1);
+            for (size_t k = lo; k < hi; ++k) skip[k] = true;
+        }
+    }
+
+    for (size_t i = 0; i < ref.size(); ++i) {
+        if (i < skip.size() && skip[i]) continue;
+        const double r = ref[i], y = out[i];
+        bool ok;
+        if (std::isnan(r)) {
+            ok = std::isnan(y);
+        } else if (std::isinf(r)) {
+            ok = y == r;
+        } else {
+            ok = std::isfinite(y) && std::abs(y - r) <= tol.abs + tol.rel * std::abs(r);
+        }
+        if (!ok) {
+            return ::testing::AssertionFailure()
+                << "отсчёт " << i << " из " << ref.size() << ": " << y
+                << ", эталон " << r << " (разность " << y - r << ")";
+        }
+    }
+    return ::testing::AssertionSuccess();
+}
+
+/**
+ * Прогнать случаи: run(gen, caseIndex, x) сравнивает фильтр с эталоном.
+ * Каждый случай — случайный сигнал; в каждом пятом — ±Inf, в каждом пятом — NaN
+ */
+template<typename Run>
+void forEachCase(uint64_t seed, size_t maxN, Run&& run) {
+    CaseGenerator gen(seed);
+    for (size_t c = 0; c < kRandomCases; ++c) {
+        Signal x = gen.signal(gen.length(maxN));
+        if (c % 5 == 3) gen.inject(x, gen.uniformSize(0, 1) ? kInf : -kInf);
+        if (c % 5 == 4) gen.inject(x, kNaN);
+        run(gen, c, x);
+    }
+}
+
+std::string describe(size_t c, const Signal& x) {
+    std::ostringstream s;
+    s << "случай " << c << ", N = " << x.size();
+    return s.str();
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Ядра utils
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(EquivalenceTest, FftMatchesDirectDft) {
+    CaseGenerator gen(101);
+    for (size_t log2n = 0; log2n <= 10; ++log2n) {
+        const size_t n = size_t(1) << log2n;
+        CVector x(n);
+        for (auto& v : x) v = Complex(gen.uniform(-1.0, 1.0), gen.uniform(-1.0, 1.0));
+
+        for (bool inverse : {false, true}) {
+            CVector y = x;
+            fft_impl::fft_inplace(y, inverse);
+            const CVector ref = reference::dft(x, inverse);
+            const double tol = 1e-12 * n * (inverse ? 1.0 / n : 1.0) * (log2n + 1) + 1e-13;
+            for (size_t k = 0; k < n; ++k) {
+                ASSERT_NEAR(y[k].real(), ref[k].real(), tol) << "N = " << n << ", k = " << k;
+                ASSERT_NEAR(y[k].imag(), ref[k].imag(), tol) << "N = " << n << ", k = " << k;
+            }
+        }
+    }
+}
+
+TEST(EquivalenceTest, MedianMatchesSort) {
+    CaseGenerator gen(102);
+    for (size_t c = 0; c < kRandomCases; ++c) {
+        Signal v = gen.signal(gen.uniformSize(0, 300));
+        if (c % 5 == 3 && !v.empty()) gen.inject(v, gen.uniformSize(0, 1) ? kInf : -kInf);
+        EXPECT_EQ(median(v), reference::median(v)) << describe(c, v);
+    }
+}
+
+TEST(EquivalenceTest, SolveLinearSystemMatchesGauss) {
+    namespace ublas = boost::numeric::ublas;
+    CaseGenerator gen(103);
+    for (size_t c = 0; c < kRandomCases; ++c) {
+        const size_t m = gen.uniformSize(1, 64);
+        // Диагональное преобладание — обусловленность O(1)
+        reference::Matrix A(m, std::vector<double>(m));
+        std::vector<double> b(m);
+        ublas::matrix<double> Au(m, m);
+        ublas::vector<double> bu(m);
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < m; ++j) {
+                A[i][j] = gen.uniform(-1.0, 1.0) + (i == j ? 2.0 * m : 0.0);
+                Au(i, j) = A[i][j];
+            }
+            b[i] = bu(i) = gen.uniform(-10.0, 10.0);
+        }
+        const auto w = solveLinearSystem(Au, bu);
+        const auto ref = reference::solve(A, b);
+        for (size_t i = 0; i < m; ++i) ASSERT_NEAR(w(i), ref[i], 1e-12) << "M = " << m;
+    }
+
+    // Вырожденная матрица — нулевое решение
+    ublas::matrix<double> zero(3, 3, 0.0);
+    const auto w = solveLinearSystem(zero, ublas::vector<double>(3, 1.0));
+    for (size_t i = 0; i < 3; ++i) EXPECT_EQ(w(i), 0.0);
+}
+
+TEST(EquivalenceTest, QualityMetricsMatchSeparateFunctions) {
+    CaseGenerator gen(104);
+    auto near = [](double a, double b) { return std::abs(a - b) <= 1e-9 + 1e-9 * std::abs(b); };
+    for (size_t c = 0; c < kRandomCases; ++c) {
+        const Signal clean = gen.signal(gen.length(5000));
+        Signal processed = clean;
+        const double noise = c % 7 == 0 ? 0.0 : gen.uniform(1e-3, 2.0);
+        for (double& v : processed) v += noise * gen.uniform(-1.0, 1.0);
+
+        const QualityMetrics m = calculateQualityMetrics(clean, processed);
+        double peak = 0.0, maxError = 0.0;
+        for (size_t i = 0; i < clean.size(); ++i) {
+            peak = std::max(peak, std::abs(clean[i]));
+            maxError = std::max(maxError, std::abs(processed[i] - clean[i]));
+        }
+        const double mse = calculateMSE(clean, processed);
+        const double psnr = mse < 1e-10 ? 100.0 : 10.0 * std::log10(peak * peak / mse);
+
+        EXPECT_PRED2(near, m.snr, calculateSNR(clean, processed)) << describe(c, clean);
+        EXPECT_PRED2(near, m.mse, mse) << describe(c, clean);
+        EXPECT_PRED2(near, m.correlation, calculateCorrelation(clean, processed))
+            << describe(c, clean);
+        EXPECT_PRED2(near, m.psnr, psnr) << describe(c, clean);
+        EXPECT_EQ(m.maxError, maxError) << describe(c, clean);
+    }
+
+    // Вырожденные случаи — нули, как у отдельных функций
+    const QualityMetrics empty = calculateQualityMetrics({}, {});
+    EXPECT_EQ(empty.snr, 0.0);
+    EXPECT_EQ(empty.correlation, 0.0);
+    const QualityMetrics mismatch = calculateQualityMetrics({1.0, 2.0}, {1.0});
+    EXPECT_EQ(mismatch.mse, 0.0);
+    EXPECT_EQ(mismatch.maxError, 0.0);
+}
+
+TEST(EquivalenceTest, QualityMetricsStableUnderLargeOffset) {
+    // Смещение 1e8 при амплитуде 1: Σa² − (Σa)²/N теряет все значащие цифры,
+    // центрированные моменты блоков — нет
+    const size_t n = 100000;
+    Signal clean(n), processed(n);
+    long double sa = 0, sb = 0;
+    for (size_t i = 0; i < n; ++i) {
+        clean[i] = 1e8 + std::sin(0.01 * i);
+        processed[i] = clean[i] + 0.1 * std::cos(0.37 * i);
+        sa += clean[i];
+        sb += processed[i];
+    }
+    const long double ma = sa / n, mb = sb / n;
+    long double cab = 0, caa = 0, cbb = 0;
+    for (size_t i = 0; i < n; ++i) {
+        cab += (clean[i] - ma) * (processed[i] - mb);
+        caa += (clean[i] - ma) * (clean[i] - ma);
+        cbb += (processed[i] - mb) * (processed[i] - mb);
+    }
+    const double expected = static_cast<double>(cab / std::sqrt(caa * cbb));
+
+    EXPECT_NEAR(calculateQualityMetrics(clean, processed).correlation, expected, 1e-9);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Фильтры
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(EquivalenceTest, MedianFilter) {
+    forEachCase(201, 3000, [](CaseGenerator& gen, size_t c, const Signal& x) {
+        const size_t w = gen.oddSize(1, 101);
+        MedianFilter filter(w);
+        EXPECT_TRUE(compareSignals(x, reference::medianFilter(x, w), filter.process(x),
+                                   {0.0, 0.0}, w / 2))
+            << describe(c, x) << ", окно " << w;
+    });
+}
+
+TEST(EquivalenceTest, MorphologicalFilter) {
+    using Op = MorphologicalFilter::Operation;
+    forEachCase(202, 3000, [](CaseGenerator& gen, size_t c, const Signal& x) {
+        const Op op = static_cast<Op>(gen.uniformSize(0, 3));
+        std::vector<double> se(gen.uniformSize(1, 41), 0.0);
+        if (gen.uniformSize(0, 1)) {
+            for (double& v : se) v = gen.uniform(0.0, 0.5);   // Неплоский элемент
+        }
+        MorphologicalFilter filter(op, se);
+        EXPECT_TRUE(compareSignals(x, reference::morphological(x, op, se), filter.process(x),
+                                   {0.0, 0.0}, se.size()))
+            << describe(c, x) << ", операция " << static_cast<int>(op)
+            << ", элемент " << se.size();
+    });
+}
+
+TEST(EquivalenceTest, SavgolFilter) {
+    forEachCase(203, 3000, [](CaseGenerator& gen, size_t c, const Signal& x) {
+        const size_t w = gen.oddSize(3, 51);
+        const size_t order = gen.uniformSize(0, std::min<size_t>(w - 1, 5));
+        SavgolFilter filter(w, order);
+        EXPECT_TRUE(compareSignals(x, reference::savgol(x, w, order), filter.process(x),
+                                   {1e-9, 1e-9}, w))
+            << describe(c, x) << ", окно " << w << ", порядок " << order;
+    });
+}
+
+TEST(EquivalenceTest, KalmanFilter) {
+    forEachCase(204, 5000, [](CaseGenerator& gen, size_t c, const Signal& x) {
+        const double q  = std::pow(10.0, gen.uniform(-4.0, 1.0));
+        const double r  = std::pow(10.0, gen.uniform(-3.0, 2.0));
+        const double dt = gen.uniform(0.1, 2.0);
+        KalmanFilter filter(q, r, dt);
+        EXPECT_TRUE(compareSignals(x, reference::kalman(x, q, r, dt), filter.process(x),
+                                   {1e-9, 1e-9}))
+            << describe(c, x) << ", q = " << q << ", r = " << r << ", dt = " << dt;
+    });
+}
+
+TEST(EquivalenceTest, OutlierDetection) {
+    using DM = OutlierDetection::DetectionMethod;
+    using IM = OutlierDetection::InterpolationMethod;
+    forEachCase(205, 3000, [](CaseGenerator& gen, size_t c, const Signal& x) {
+        const DM dm = static_cast<DM>(gen.uniformSize(0, 2));
+        const IM im = static_cast<IM>(gen.uniformSize(0, 3));
+        const double thr = gen.uniform(1.5, 5.0);
+        const size_t w = gen.oddSize(3, 41);
+        OutlierDetection filter(dm, im, thr, w);
+        const Signal out = filter.process(x);
+
+        // NaN делает порог и интерполяцию зависимыми от порядка сравнений —
+        // проверяется только длина
+        if (std::any_of(x.begin(), x.end(), [](double v) { return std::isnan(v); })) {
+            EXPECT_EQ(out.size(), x.size());
+            return;
+        }
+        EXPECT_TRUE(compareSignals(x, reference::outliers(x, dm, im, thr, w), out, {1e-12, 1e-12}))
+            << describe(c, x) << ", детектор " << static_cast<int>(dm)
+            << ", интерполяция " << static_cast<int>(im) << ", окно " << w;
+    });
+}
+
+TEST(EquivalenceTest, WienerFilter) {
+    forEachCase(206, 3000, [](CaseGenerator& gen, size_t c, const Signal& x) {
+        const size_t M   = gen.uniformSize(1, 40);
+        const size_t w   = gen.oddSize(1, 41);
+        const double reg = std::pow(10.0, gen.uniform(-4.0, -1.0));
+        WienerFilter filter(M, w, reg);
+        EXPECT_TRUE(compareSignals(x, reference::wiener(x, M, w, reg), filter.process(x),
+                                   {1e-8, 1e-7}))
+            << describe(c, x) << ", M = " << M << ", окно " << w << ", reg = " << reg;
+    });
+}
+
+TEST(EquivalenceTest, RobustWienerFilter) {
+    forEachCase(207, 2000, [](CaseGenerator& gen, size_t c, const Signal& x) {
+        const size_t M   = gen.uniformSize(1, 32);
+        const size_t w   = gen.oddSize(1, 31);
+        const double reg = std::pow(10.0, gen.uniform(-4.0, -1.0));
+        const double thr = gen.uniform(2.0, 5.0);
+        const size_t ow  = gen.uniformSize(0, 40);   // Чётное и 0 нормализуются фильтром
+        RobustWienerFilter filter(M, w, reg, thr, ow);
+        const Signal out = filter.process(x);
+
+        if (std::any_of(x.begin(), x.end(), [](double v) { return std::isnan(v); })) {
+            EXPECT_EQ(out.size(), x.size());   // Очистка выбросов с NaN — см. OutlierDetection
+            return;
+        }
+        EXPECT_TRUE(compareSignals(x, reference::robustWiener(x, M, w, reg, thr, ow), out,
+                                   {1e-8, 1e-7}))
+            << describe(c, x) << ", M = " << M << ", окно " << w << ", reg = " << reg
+            << ", порог " << thr << ", окно выбросов " << ow;
+    });
+}
+
+TEST(EquivalenceTest, SpectralSubtractionFilter) {
+    forEachCase(208, 1500, [](CaseGenerator& gen, size_t c, const Signal& x) {
+        const size_t frame = size_t(1) << gen.uniformSize(2, 7);   // 4 … 128
+        const size_t hop   = gen.uniformSize(1, frame);
+        const size_t noise = gen.uniformSize(1, 6);
+        const double alpha = gen.uniform(0.5, 4.0);
+        const double beta  = gen.uniform(1e-4, 0.1);
+        const double mu    = gen.uniform(0.0, 1.0);
+        const double gamma = gen.uniform(1.1, 4.0);
+        SpectralSubtractionFilter filter(frame, hop, noise, alpha, beta, mu, gamma);
+        const Signal out = filter.process(x);
+
+        // ±Inf даёт в спектре Inf − Inf; где появится NaN, зависит от порядка
+        // бабочек БПФ и ограничений усиления — проверяется только длина
+        if (std::any_of(x.begin(), x.end(), [](double v) { return !std::isfinite(v); })) {
+            EXPECT_EQ(out.size(), x.size());
+            return;
+        }
+        EXPECT_TRUE(compareSignals(x, reference::spectralSubtraction(x, frame, hop, noise, alpha,
+                                                                     beta, mu, gamma),
+                                   out, {1e-9, 1e-8}))
+            << describe(c, x) << ", кадр " << frame << ", шаг " << hop << ", шумовых кадров "
+            << noise;
+    });
+}
+
+TEST(EquivalenceTest, EdgeCases) {
+    // Окна и порядки длиннее сигнала, N = 1 и 2
+    for (const Signal& x : {Signal{3.5}, Signal{1.0, -2.0}, Signal{0.0, 0.0, 0.0}}) {
+        EXPECT_EQ(MedianFilter(51).process(x), reference::medianFilter(x, 51));
+        EXPECT_TRUE(compareSignals(x, reference::savgol(x, 31, 4),
+                                   SavgolFilter(31, 4).process(x), {1e-9, 1e-9}));
+        EXPECT_TRUE(compareSignals(x, reference::wiener(x, 16, 9, 1e-3),
+                                   WienerFilter(16, 9, 1e-3).process(x), {1e-8, 1e-7}));
+        EXPECT_TRUE(compareSignals(x, reference::robustWiener(x, 16, 9, 1e-3, 3.5, 11),
+                                   RobustWienerFilter(16, 9, 1e-3, 3.5, 11).process(x),
+                                   {1e-8, 1e-7}));
+        EXPECT_TRUE(compareSignals(x, reference::kalman(x, 0.1, 1.0, 1.0),
+                                   KalmanFilter(0.1, 1.0, 1.0).process(x), {1e-12, 1e-12}));
+        EXPECT_EQ(MorphologicalFilter(MorphologicalFilter::Operation::CLOSING, 25).process(x),
+                  reference::morphological(x, MorphologicalFilter::Operation::CLOSING,
+                                           std::vector<double>(25, 0.0)));
+        EXPECT_TRUE(compareSignals(x, reference::spectralSubtraction(x, 16, 4, 4, 2.0, 0.002,
+                                                                     0.1, 1.5),
+                                   SpectralSubtractionFilter(16, 4).process(x), {1e-9, 1e-8}));
+    }
+
+    // Пустой вход — пустой выход у всех
+    const Signal empty;
+    EXPECT_TRUE(MedianFilter(5).process(empty).empty());
+    EXPECT_TRUE(SavgolFilter(11, 3).process(empty).empty());
+    EXPECT_TRUE(WienerFilter().process(empty).empty());
+    EXPECT_TRUE(RobustWienerFilter().process(empty).empty());
+    EXPECT_TRUE(KalmanFilter().process(empty).empty());
+    EXPECT_TRUE(MorphologicalFilter().process(empty).empty());
+    EXPECT_TRUE(OutlierDetection().process(empty).empty());
+    EXPECT_TRUE(SpectralSubtractionFilter().process(empty).empty());
+}
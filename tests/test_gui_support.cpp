@@ -0,0 +1,354 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/signal_generator.h"
+#include "../src/median_filter.h"
+#include "../src/kalman_filter.h"
+#include "../src/wiener_filter.h"
+#include "../src/savgol_filter.h"
+#include "../src/morphological_filter.h"
+#include "../src/pipeline.h"
+#include "../src/background_filter.h"
+#include "../src/streaming_filter.h"
+#include "../src/utils/random.h"
+#include "../src/utils/triple_buffer.h"
+#include "../src/utils/minmax_pyramid.h"
+#include "../src/utils/scroll_ring.h"
+#include "../src/utils/spectrogram.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Пирамида min/max для прореживания кривых (MinMaxPyramid)
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(MinMaxPyramidTest, RangeMatchesDirectScan) {
+    Xoshiro256 rng(17);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<double> samples(1237);
+    for (double& v : samples) v = noise(rng);
+    samples[500] = std::numeric_limits<double>::quiet_NaN();   // NaN пропускается
+
+    const MinMaxPyramid lod(samples);
+    ASSERT_EQ(lod.size(), samples.size());
+    EXPECT_GT(lod.levels(), 5u);
+    EXPECT_LT(lod.memoryBytes(), samples.size() * sizeof(double) / 4);
+
+    for (int q = 0; q < 2000; ++q) {
+        size_t a = rng() % (samples.size() + 1);
+        size_t b = rng() % (samples.size() + 1);
+        if (a > b) std::swap(a, b);
+
+        float mn = std::numeric_limits<float>::infinity();
+        float mx = -std::numeric_limits<float>::infinity();
+        for (size_t i = a; i < b; ++i) {
+            if (std::isnan(samples[i])) continue;
+            mn = std::min(mn, static_cast<float>(samples[i]));
+            mx = std::max(mx, static_cast<float>(samples[i]));
+        }
+        const MinMaxPyramid::Range r = lod.range(a, b);
+        ASSERT_EQ(r.min, mn) << a << ".." << b;
+        ASSERT_EQ(r.max, mx) << a << ".." << b;
+    }
+    EXPECT_GT(lod.range(10, 10).min, lod.range(10, 10).max);   // Пустой отрезок
+}
+
+TEST(MinMaxPyramidTest, DecimatesToTwoVerticesPerColumn) {
+    std::vector<double> samples(1000000);
+    for (size_t i = 0; i < samples.size(); ++i) samples[i] = std::sin(0.001 * i);
+    samples[123457] = 50.0;   // Одиночный выброс не должен потеряться
+    const MinMaxPyramid lod(samples);
+
+    std::vector<MinMaxPyramid::Point> points;
+    lod.decimate(0, samples.size(), 1500, points);
+    ASSERT_EQ(points.size(), 3000u);
+    double peak = 0.0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (i > 0) { EXPECT_GE(points[i].index, points[i - 1].index); }
+        peak = std::max(peak, points[i].value);
+    }
+    EXPECT_EQ(peak, 50.0);
+
+    // Столбец: минимум и максимум его отсчётов
+    const size_t per = samples.size() / 1500;
+    const MinMaxPyramid::Range first = lod.range(0, per);
+    EXPECT_EQ(points[0].value, first.min);
+    EXPECT_EQ(points[1].value, first.max);
+
+    // Узкий видимый участок — отсчёты как есть
+    lod.decimate(2000, 2100, 1500, points);
+    ASSERT_EQ(points.size(), 100u);
+    EXPECT_EQ(points.front().index, 2000.0);
+    EXPECT_EQ(points.back().value, samples[2099]);
+
+    lod.decimate(5, 5, 100, points);
+    EXPECT_TRUE(points.empty());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Фоновая фильтрация (TripleBuffer, BackgroundFilter)
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(TripleBufferTest, ReaderSeesLatestPublishedValue) {
+    TripleBuffer<std::vector<int>> buffer;
+    EXPECT_FALSE(buffer.update());
+
+    buffer.writeBuffer() = {1};
+    buffer.publish();
+    buffer.writeBuffer() = {2};
+    buffer.publish();
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.readBuffer(), std::vector<int>{2});   // Промежуточная публикация пропущена
+    EXPECT_FALSE(buffer.update());
+
+    // Писатель и читатель в разных потоках: значения только растут и не рвутся
+    constexpr int kCount = 100000;
+    std::thread writer([&] {
+        for (int i = 3; i <= kCount; ++i) {
+            buffer.writeBuffer().assign(4, i);
+            buffer.publish();
+        }
+    });
+    int last = 2;
+    while (last < kCount) {
+        if (!buffer.update()) continue;
+        const auto& v = buffer.readBuffer();
+        ASSERT_EQ(v.size(), 4u);
+        EXPECT_EQ(v[0], v[3]);
+        EXPECT_GT(v[0], last);
+        last = v[0];
+    }
+    writer.join();
+}
+
+namespace {
+
+// Дождаться конца задания job, забирая снимки как поток отрисовки
+const FilterSnapshot& waitForJob(BackgroundFilter& background, uint64_t job) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    for (;;) {
+        background.poll();
+        const FilterSnapshot& s = background.snapshot();
+        if (s.job == job && s.state != FilterSnapshot::State::RUNNING) return s;
+        if (std::chrono::steady_clock::now() > deadline) {
+            ADD_FAILURE() << "задание " << job << " не завершилось";
+            return s;
+        }
+        std::this_thread::yield();
+    }
+}
+
+class ThrowingFilter : public SignalProcessor {
+public:
+    Signal process(const Signal&) override { throw std::runtime_error("boom"); }
+    std::string getName() const override { return "Throwing"; }
+    std::unique_ptr<SignalProcessor> clone() const override { return std::make_unique<ThrowingFilter>(); }
+    size_t getReach() const override { return 2; }
+};
+
+}  // namespace
+
+TEST(BackgroundFilterTest, ReportsReachOfLocalFilters) {
+    EXPECT_EQ(MedianFilter(7).getReach(), 3u);
+    EXPECT_EQ(SavgolFilter(11, 3).getReach(), 5u);
+    EXPECT_EQ(MorphologicalFilter(MorphologicalFilter::Operation::EROSION, 5).getReach(), 2u);
+    EXPECT_EQ(MorphologicalFilter(MorphologicalFilter::Operation::OPENING, 5).getReach(), 4u);
+    EXPECT_EQ(KalmanFilter().getReach(), SignalProcessor::kNonLocal);
+
+    Pipeline chain;
+    chain.emplace<MedianFilter>(5).emplace<SavgolFilter>(11, 3);
+    EXPECT_EQ(chain.getReach(), 7u);
+    chain.emplace<WienerFilter>(8, 5, 1e-4);
+    EXPECT_EQ(chain.getReach(), SignalProcessor::kNonLocal);
+}
+
+TEST(BackgroundFilterTest, ChunkedResultMatchesWholeSignal) {
+    SignalGenerator gen(7);
+    const auto input = gen.generateWhiteNoise(5003, 1.0);
+
+    std::vector<std::unique_ptr<SignalProcessor>> filters;
+    filters.push_back(std::make_unique<MedianFilter>(7));
+    filters.push_back(std::make_unique<SavgolFilter>(11, 3));
+    filters.push_back(std::make_unique<MorphologicalFilter>(MorphologicalFilter::Operation::CLOSING, 5));
+    auto chain = std::make_unique<Pipeline>();
+    chain->emplace<MedianFilter>(5).emplace<SavgolFilter>(9, 2);
+    filters.push_back(std::move(chain));
+    filters.push_back(std::make_unique<KalmanFilter>(0.1, 1.0, 1.0));   // Нелокальный — целиком
+
+    BackgroundFilter::Options options;
+    options.chunkSize = 100;   // Много участков, но не меньше 8·h
+    BackgroundFilter background(options);
+
+    for (auto& filter : filters) {
+        const auto expected = filter->clone()->process(input);
+        const uint64_t job = background.start(input, filter->clone());
+        const FilterSnapshot& s = waitForJob(background, job);
+        EXPECT_EQ(s.state, FilterSnapshot::State::FINISHED) << filter->getName();
+        EXPECT_EQ(s.done, input.size());
+        EXPECT_DOUBLE_EQ(s.progress(), 1.0);
+        EXPECT_EQ(s.output, expected) << filter->getName();
+    }
+    EXPECT_FALSE(background.busy());
+}
+
+TEST(BackgroundFilterTest, NewJobSupersedesOldAndCancelStops) {
+    SignalGenerator gen(11);
+    const auto input = gen.generateWhiteNoise(200000, 1.0);
+
+    BackgroundFilter::Options options;
+    options.chunkSize = 1000;
+    BackgroundFilter background(options);
+
+    const uint64_t first  = background.start(input, std::make_unique<MedianFilter>(31));
+    const uint64_t second = background.start(input, std::make_unique<MedianFilter>(3));
+    EXPECT_GT(second, first);
+    const FilterSnapshot& done = waitForJob(background, second);
+    EXPECT_EQ(done.state, FilterSnapshot::State::FINISHED);
+    EXPECT_EQ(done.output, MedianFilter(3).process(input));
+
+    const uint64_t third = background.start(input, std::make_unique<MedianFilter>(101));
+    background.cancel();
+    const FilterSnapshot& cancelled = waitForJob(background, third);
+    EXPECT_EQ(cancelled.state, FilterSnapshot::State::CANCELLED);
+    EXPECT_LT(cancelled.done, input.size());
+    for (size_t i = cancelled.done; i < input.size(); ++i) {
+        if (!std::isnan(cancelled.output[i])) { ADD_FAILURE() << "отсчёт " << i; break; }
+    }
+}
+
+TEST(BackgroundFilterTest, FilterExceptionFailsJob) {
+    BackgroundFilter background;
+    const uint64_t job = background.start(SignalProcessor::Signal(100, 1.0),
+                                          std::make_unique<ThrowingFilter>());
+    const FilterSnapshot& s = waitForJob(background, job);
+    EXPECT_EQ(s.state, FilterSnapshot::State::FAILED);
+    EXPECT_EQ(s.error, "boom");
+    EXPECT_THROW(background.start({}, nullptr), std::invalid_argument);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Живой режим (StreamingFilter, ScrollRing, Spectrogram)
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(StreamingFilterTest, BlockOutputMatchesWholeSignalDelayedByLatency) {
+    SignalGenerator gen(13);
+    const auto input = gen.generateWhiteNoise(3001, 1.0);
+
+    std::vector<std::unique_ptr<SignalProcessor>> filters;
+    filters.push_back(std::make_unique<MedianFilter>(7));
+    filters.push_back(std::make_unique<SavgolFilter>(11, 3));
+    filters.push_back(std::make_unique<MorphologicalFilter>(MorphologicalFilter::Operation::OPENING, 5));
+    auto chain = std::make_unique<Pipeline>();
+    chain->emplace<MedianFilter>(5).emplace<SavgolFilter>(9, 2);
+    filters.push_back(std::move(chain));
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<size_t> blockSize(0, 40);   // В том числе короче h и пустые
+
+    for (auto& filter : filters) {
+        const auto expected = filter->clone()->process(input);
+        StreamingFilter stream(filter->clone());
+        EXPECT_EQ(stream.latency(), filter->getReach());
+
+        SignalProcessor::Signal streamed, block;
+        for (size_t pos = 0; pos < input.size();) {
+            const size_t n = std::min(blockSize(rng), input.size() - pos);
+            stream.push(std::span<const double>(input).subspan(pos, n), block);
+            streamed.insert(streamed.end(), block.begin(), block.end());
+            pos += n;
+        }
+
+        // Выдано всё, кроме последних latency() отсчётов, и совпадает с process()
+        ASSERT_EQ(streamed.size(), input.size() - stream.latency()) << filter->getName();
+        EXPECT_TRUE(std::equal(streamed.begin(), streamed.end(), expected.begin()))
+            << filter->getName();
+    }
+
+    EXPECT_EQ(StreamingFilter(std::make_unique<KalmanFilter>()).latency(), 0u);
+    EXPECT_THROW(StreamingFilter(nullptr), std::invalid_argument);
+}
+
+TEST(ScrollRingTest, LastSamplesStayContiguous) {
+    constexpr size_t kCapacity = 10;
+    ScrollRing ring(kCapacity);
+    std::vector<double> cells(2 * kCapacity, -1.0);   // Как VBO из 2·N ячеек
+    size_t writes = 0;
+
+    std::vector<double> stream;
+    for (size_t block : {3u, 4u, 5u, 1u, 9u, 25u, 7u}) {
+        std::vector<double> samples(block);
+        for (auto& v : samples) {
+            v = static_cast<double>(stream.size());
+            stream.push_back(v);
+        }
+
+        ring.append(samples.size(), [&](size_t cell, size_t index, size_t n) {
+            ASSERT_LE(cell + n, cells.size());
+            std::copy_n(samples.begin() + index, n, cells.begin() + cell);
+            ++writes;
+        });
+        ASSERT_EQ(ring.total(), stream.size());
+        ASSERT_EQ(ring.visible(), std::min(stream.size(), kCapacity));
+
+        // Видимые ячейки подряд — ровно последние visible() отсчётов потока
+        const std::vector<double> shown(cells.begin() + ring.first(),
+                                        cells.begin() + ring.first() + ring.visible());
+        const std::vector<double> expected(stream.end() - ring.visible(), stream.end());
+        EXPECT_EQ(shown, expected) << "после " << stream.size() << " отсчётов";
+        EXPECT_EQ(cells[ring.newest()], stream.back());
+    }
+    // Каждый блок (и длиннее кольца) — не более двух отрезков и их зеркал
+    EXPECT_LE(writes, 7u * 4u);
+    EXPECT_THROW(ScrollRing(0), std::invalid_argument);
+}
+
+TEST(SpectrogramTest, SinePeaksInItsBinAtItsLevel) {
+    Spectrogram::Options options;
+    options.frameSize = 256;
+    options.hop       = 64;
+    Spectrogram spectrogram(options);
+    ASSERT_EQ(spectrogram.bins(), 129u);
+
+    // Синус амплитуды 0.5 точно в бине 32
+    std::vector<double> x(4096);
+    for (size_t i = 0; i < x.size(); ++i) x[i] = 0.5 * std::sin(2.0 * M_PI * 32.0 * i / 256.0);
+
+    std::vector<std::vector<float>> whole;
+    const size_t columns = spectrogram.push(x, [&](Spectrogram::Column c) {
+        whole.emplace_back(c.begin(), c.end());
+    });
+    EXPECT_EQ(columns, (x.size() - 256) / 64 + 1);
+    ASSERT_EQ(whole.size(), columns);
+    for (const auto& column : whole) {
+        const size_t peak = std::max_element(column.begin(), column.end()) - column.begin();
+        EXPECT_EQ(peak, 32u);
+        EXPECT_NEAR(column[32], 20.0 * std::log10(0.5), 0.01);
+        EXPECT_LT(column[64], column[32] - 60.0f);
+    }
+
+    // Те же столбцы, если поток приходит блоками произвольной длины
+    Spectrogram streamed(options);
+    std::vector<std::vector<float>> pieces;
+    size_t offset = 0;
+    for (size_t block = 1; offset < x.size(); block = block * 3 % 500 + 1) {
+        const size_t n = std::min(block, x.size() - offset);
+        streamed.push(std::span<const double>(x).subspan(offset, n), [&](Spectrogram::Column c) {
+            pieces.emplace_back(c.begin(), c.end());
+        });
+        offset += n;
+    }
+    EXPECT_EQ(pieces, whole);
+
+    options.frameSize = 200;
+    EXPECT_THROW(Spectrogram{options}, std::invalid_argument);
+    options.frameSize = 256;
+    options.hop       = 512;
+    EXPECT_THROW(Spectrogram{options}, std::invalid_argument);
+}
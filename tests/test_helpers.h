@@ -0,0 +1,29 @@
+#ifndef TEST_HELPERS_H
+#define TEST_HELPERS_H
+
+/**
+ * Общие вспомогательные классы тестов Google Test.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// Временный файл, удаляемый после теста (имя — по имени теста)
+class TempFile {
+public:
+    explicit TempFile(const std::string& contents)
+        : path_(::testing::TempDir() + "echo_test_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name())
+    {
+        std::ofstream out(path_, std::ios::binary);
+        out << contents;
+    }
+    ~TempFile() { std::remove(path_.c_str()); }
+    const std::string& path() const { return path_; }
+private:
+    std::string path_;
+};
+
+#endif // TEST_HELPERS_H
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "../src/signal_generator.h"
+#include "../src/median_filter.h"
+#include "../src/kalman_filter.h"
+#include "../src/parameter_tuner.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Подбор гиперпараметров (ParameterSpace, ParameterTuner)
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(ParameterTunerTest, EnumeratesCandidatesUnderConstraints) {
+    const auto savgol = savgolParameterSpace();
+    const auto candidates = savgol.candidates();
+    EXPECT_EQ(candidates.size(), 27u);   // 7 окон × 4 порядка без (5, 5)
+    for (const auto& v : candidates) {
+        EXPECT_LT(v[1], v[0]);
+        EXPECT_NO_THROW(savgol.create(v));
+    }
+    EXPECT_EQ(savgol.describe(candidates.front()), "window=5 order=2");
+
+    ParameterSpace space("median", [](const ParameterSpace::Values& v) {
+        return std::make_unique<MedianFilter>(static_cast<size_t>(v[0]));
+    });
+    space.addRange("window", 3, 9, 2).addLog("unused", 1e-2, 1.0, 3);
+    ASSERT_EQ(space.parameters().size(), 2u);
+    EXPECT_EQ(space.parameters()[0].values, (std::vector<double>{3, 5, 7, 9}));
+    EXPECT_NEAR(space.parameters()[1].values[1], 0.1, 1e-12);
+    EXPECT_EQ(space.candidates().size(), 12u);
+
+    for (const auto& builtin : builtinParameterSpaces()) {
+        EXPECT_FALSE(builtin.candidates().empty()) << builtin.name();
+    }
+    EXPECT_THROW(space.add("empty", {}), std::invalid_argument);
+}
+
+TEST(ParameterTunerTest, SuccessiveHalvingAgreesWithExhaustiveSearch) {
+    SignalGenerator gen(21);
+    ParameterTuner::Dataset dataset = gen.generateTestDataset(2048, 3);
+
+    ParameterSpace median("median", [](const ParameterSpace::Values& v) {
+        return std::make_unique<MedianFilter>(static_cast<size_t>(v[0]));
+    });
+    median.addRange("window", 1, 33, 2);
+
+    TuningOptions exhaustive;
+    exhaustive.eta = 1;
+    const TuningResult full = ParameterTuner(dataset, exhaustive).tune(median);
+    ASSERT_EQ(full.rungs.size(), 1u);
+    EXPECT_EQ(full.rungs[0].evaluations, 17u * 3u);
+    for (size_t i = 1; i < full.ranking.size(); ++i) {
+        EXPECT_GE(full.ranking[i - 1].score, full.ranking[i].score);
+    }
+
+    TuningOptions halving;
+    halving.eta       = 2;
+    halving.minPrefix = 256;
+    ParameterTuner tuner(dataset, halving);
+    const TuningResult result = tuner.tune(median);
+    ASSERT_GT(result.rungs.size(), 1u);
+    EXPECT_EQ(result.rungs.back().prefix, 2048u);
+    EXPECT_EQ(result.ranking.size(), 17u);
+
+    // Победитель — один из лучших при полном переборе, с близким качеством
+    const TuningCandidate& best = result.best();
+    EXPECT_EQ(best.rung, result.rungs.size() - 1);
+    EXPECT_GE(best.score, full.ranking[2].score);
+    EXPECT_NEAR(best.mean.snr, full.best().mean.snr, 0.5);
+
+    // Меньше вызовов фильтра, чем при полном переборе на полной длине
+    size_t samples = 0;
+    for (const TuningRung& rung : result.rungs) samples += rung.evaluations * rung.prefix;
+    EXPECT_LT(samples, 17u * 3u * 2048u);
+}
+
+TEST(ParameterTunerTest, CachesEvaluationsAndScoresFailuresAsWorst) {
+    SignalGenerator gen(5);
+    ParameterTuner tuner(gen.generateTestDataset(600, 2));
+
+    // window = 4 отвергается конструктором — кандидат проигрывает, но подбор идёт
+    ParameterSpace median("median", [](const ParameterSpace::Values& v) {
+        return std::make_unique<MedianFilter>(static_cast<size_t>(v[0]));
+    });
+    median.add("window", {3, 4, 5, 7});
+
+    const TuningResult first = tuner.tune(median);
+    EXPECT_EQ(first.ranking.back().description, "window=4");
+    EXPECT_TRUE(std::isinf(first.ranking.back().score));
+    EXPECT_NE(first.best().description, "window=4");
+    const size_t cached = tuner.cacheSize();
+    EXPECT_GT(cached, 0u);
+
+    // Повторный подбор берёт все оценки из кэша
+    const TuningResult second = tuner.tune(median);
+    EXPECT_EQ(tuner.cacheSize(), cached);
+    for (const TuningRung& rung : second.rungs) {
+        EXPECT_EQ(rung.evaluations, 0u);
+        EXPECT_EQ(rung.cacheHits, rung.candidates * 2);
+    }
+    EXPECT_EQ(second.best().description, first.best().description);
+    EXPECT_EQ(second.best().score, first.best().score);
+
+    // Значения, неразличимые в описании (6 значащих цифр), кэшируются раздельно
+    ParameterSpace fine("kalman", [](const ParameterSpace::Values& v) {
+        return std::make_unique<KalmanFilter>(v[0], 1.0, 1.0);
+    });
+    fine.add("q", {0.1, 0.1000000001});
+    const size_t before = tuner.cacheSize();
+    const TuningResult close = tuner.tune(fine);
+    ASSERT_EQ(close.ranking.size(), 2u);
+    EXPECT_EQ(close.ranking[0].description, close.ranking[1].description);
+    size_t evaluations = 0;
+    for (const TuningRung& rung : close.rungs) evaluations += rung.evaluations;
+    EXPECT_EQ(tuner.cacheSize() - before, evaluations);
+
+    // Другое пространство с тем же именем и теми же значениями не берёт чужие
+    // оценки; копия пространства — берёт
+    ParameterSpace namesake("median", [](const ParameterSpace::Values& v) {
+        return std::make_unique<MedianFilter>(static_cast<size_t>(v[0]) + 10);
+    });
+    namesake.add("window", {3, 4, 5, 7});
+    EXPECT_NE(namesake.id(), median.id());
+    const TuningResult other = tuner.tune(namesake);
+    EXPECT_EQ(other.rungs.front().cacheHits, 0u);
+    EXPECT_GT(other.rungs.front().evaluations, 0u);
+    EXPECT_NE(other.best().score, first.best().score);
+
+    const ParameterSpace copy = median;
+    EXPECT_EQ(copy.id(), median.id());
+    for (const TuningRung& rung : tuner.tune(copy).rungs) EXPECT_EQ(rung.evaluations, 0u);
+
+    tuner.clearCache();
+    EXPECT_EQ(tuner.cacheSize(), 0u);
+}
+
+TEST(ParameterTunerTest, RejectsInvalidInput) {
+    EXPECT_THROW(ParameterTuner(ParameterTuner::Dataset{}), std::invalid_argument);
+    EXPECT_THROW(ParameterTuner({{SignalProcessor::Signal(10, 0.0), SignalProcessor::Signal(9, 0.0)}}),
+                 std::invalid_argument);
+
+    ParameterTuner tuner({{SignalProcessor::Signal(64, 1.0), SignalProcessor::Signal(64, 1.0)}});
+    ParameterSpace none("none", [](const ParameterSpace::Values&) {
+        return std::make_unique<MedianFilter>(3);
+    });
+    none.add("x", {1.0}).require([](const ParameterSpace::Values&) { return false; });
+    EXPECT_THROW(tuner.tune(none), std::invalid_argument);
+}
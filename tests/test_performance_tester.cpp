@@ -0,0 +1,559 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+#include "test_helpers.h"
+#include "../src/signal_generator.h"
+#include "../src/median_filter.h"
+#include "../src/kalman_filter.h"
+#include "../src/wiener_filter.h"
+#include "../src/outlier_detection.h"
+#include "../src/utils/timing.h"
+#include "../src/utils/perf_counters.h"
+#include "../src/utils/alloc_tracker.h"
+#include "../src/utils/bench_report.h"
+#include "../src/performance_tester.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Параллельный PerformanceTester
+// ─────────────────────────────────────────────────────────────────────────────
+
+static PerformanceTester makeBenchmarkTester() {
+    PerformanceTester tester(17);
+    tester.addAlgorithm(std::make_unique<MedianFilter>(5));
+    tester.addAlgorithm(std::make_unique<KalmanFilter>(0.1, 1.0, 1.0));
+    tester.addAlgorithm(std::make_unique<WienerFilter>(8, 5, 1e-4));
+    tester.addAlgorithm(std::make_unique<OutlierDetection>(
+        OutlierDetection::DetectionMethod::MAD_BASED,
+        OutlierDetection::InterpolationMethod::LINEAR, 3.0, 11));
+    tester.generateTestDataset(700, 9);
+    return tester;
+}
+
+TEST(PerformanceTesterTest, ParallelRunMatchesSerial) {
+    PerformanceTester tester = makeBenchmarkTester();
+    const auto serial = tester.runFullTest();
+
+    PerformanceTester::RunOptions options;
+    options.numThreads   = 4;
+    options.serialTiming = true;
+    const auto parallel = tester.runFullTest(options);
+
+    ASSERT_EQ(serial.size(), 4u);
+    ASSERT_EQ(parallel.size(), serial.size());
+    for (size_t a = 0; a < serial.size(); ++a) {
+        EXPECT_EQ(parallel[a].algorithmName, serial[a].algorithmName);
+        EXPECT_EQ(parallel[a].snrResults, serial[a].snrResults);
+        EXPECT_EQ(parallel[a].mseResults, serial[a].mseResults);
+        EXPECT_EQ(parallel[a].correlationResults, serial[a].correlationResults);
+        EXPECT_EQ(parallel[a].avgSNR, serial[a].avgSNR);
+        EXPECT_EQ(parallel[a].executionTimes.size(), 9u);
+        EXPECT_GT(parallel[a].timingSamples, 0u);
+        EXPECT_GT(parallel[a].medianTimeNs, 0.0);
+    }
+}
+
+TEST(PerformanceTesterTest, CloneIsIndependent) {
+    KalmanFilter original(0.05, 2.0, 1.0);
+    SignalGenerator gen(3);
+    const auto input = gen.generateWhiteNoise(200, 1.0);
+
+    auto copy = original.clone();
+    EXPECT_EQ(copy->getName(), original.getName());
+    EXPECT_EQ(copy->process(input), original.process(input));
+
+    // Состояние копии не связано с оригиналом
+    original.process(gen.generateWhiteNoise(50, 4.0));
+    EXPECT_NE(dynamic_cast<KalmanFilter&>(*copy).getState(), original.getState());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Статистика замеров времени
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(TimingTest, SummaryPercentilesAndOutliers) {
+    // 1..100 нс: без выбросов, квантили — линейная интерполяция
+    std::vector<double> samples(100);
+    for (size_t i = 0; i < samples.size(); ++i) samples[i] = static_cast<double>(i + 1);
+    std::reverse(samples.begin(), samples.end());
+
+    TimingStats stats = summarizeTimings(samples);
+    EXPECT_EQ(stats.samples, 100u);
+    EXPECT_EQ(stats.rejected, 0u);
+    EXPECT_DOUBLE_EQ(stats.minNs, 1.0);
+    EXPECT_DOUBLE_EQ(stats.maxNs, 100.0);
+    EXPECT_DOUBLE_EQ(stats.medianNs, 50.5);
+    EXPECT_DOUBLE_EQ(stats.p90Ns, 90.1);
+    EXPECT_DOUBLE_EQ(stats.p99Ns, 99.01);
+    EXPECT_DOUBLE_EQ(stats.meanNs, 50.5);
+    EXPECT_DOUBLE_EQ(stats.madNs, 25.0);
+
+    // Два прерванных замера отбрасываются, быстрые — никогда
+    std::vector<double> noisy = {100, 101, 99, 100, 102, 98, 100, 5000, 101, 99, 20, 9000};
+    stats = summarizeTimings(noisy, 5.0);
+    EXPECT_EQ(stats.rejected, 2u);
+    EXPECT_EQ(stats.samples, 10u);
+    EXPECT_DOUBLE_EQ(stats.minNs, 20.0);
+    EXPECT_DOUBLE_EQ(stats.maxNs, 102.0);
+
+    EXPECT_EQ(summarizeTimings(noisy, 0.0).rejected, 0u);
+    EXPECT_EQ(summarizeTimings({}).samples, 0u);
+}
+
+TEST(TimingTest, MeasureHonoursWarmupAndRepetitionLimits) {
+    size_t calls = 0;
+    TimingOptions options;
+    options.warmupRuns      = 3;
+    options.minRepetitions  = 7;
+    options.maxRepetitions  = 7;
+    options.minTotalSeconds = 10.0;   // недостижимо — остановит maxRepetitions
+    TimingStats stats = measureTiming([&] { ++calls; }, options);
+    EXPECT_EQ(calls, 10u);
+    EXPECT_EQ(stats.samples + stats.rejected, 7u);
+    EXPECT_LE(stats.minNs, stats.medianNs);
+    EXPECT_LE(stats.medianNs, stats.p99Ns);
+
+    calls = 0;
+    stats = measureTiming([&] { ++calls; }, TimingOptions::singleShot());
+    EXPECT_EQ(calls, 1u);
+    EXPECT_EQ(stats.samples, 1u);
+
+    // Результат benchmark — выход фильтра, время — статистика повторов
+    MedianFilter filter(5);
+    SignalGenerator gen(8);
+    const auto input = gen.generateWhiteNoise(300, 1.0);
+    auto [output, timing] = filter.benchmark(input, options);
+    EXPECT_EQ(output, filter.process(input));
+    EXPECT_EQ(timing.samples + timing.rejected, 7u);
+    EXPECT_GT(timing.medianNs, 0.0);
+}
+
+TEST(TimingTest, DoNotOptimizeKeepsValuesIntact) {
+    // Барьеры не меняют значения и компилируются для любых типов
+    double x = 1.5;
+    doNotOptimize(x);
+    clobberMemory();
+    EXPECT_EQ(x, 1.5);
+
+    std::vector<double> v{1.0, 2.0, 3.0};
+    doNotOptimize(v);
+    doNotOptimize(v.data());
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_EQ(v[2], 3.0);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Аппаратные счётчики
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(PerfCountersTest, CountsOrFallsBackCleanly) {
+    PerfCounters counters;
+    counters.start();
+    volatile double sink = 0.0;
+    for (int i = 0; i < 100000; ++i) sink = sink + std::sqrt(static_cast<double>(i));
+    const PerfCounterValues values = counters.stop();
+
+    if (!counters.available()) {
+        EXPECT_FALSE(values.any());
+        EXPECT_FALSE(counters.error().empty());
+        EXPECT_EQ(values.ipc(), 0.0);
+    } else if (values.has(PerfEvent::INSTRUCTIONS)) {
+        EXPECT_GT(values.get(PerfEvent::INSTRUCTIONS), 100000.0);
+    }
+
+    // Сумма действительна, только если действительны оба слагаемых
+    PerfCounterValues a, b;
+    a.values = {100, 250, 0, 0, 0};
+    a.valid  = {true, true, false, false, false};
+    b = a;
+    b.valid[1] = false;
+    PerfCounterValues sum = a;
+    sum += a;
+    sum /= 2.0;
+    EXPECT_DOUBLE_EQ(sum.get(PerfEvent::CYCLES), 100.0);
+    EXPECT_DOUBLE_EQ(sum.ipc(), 2.5);
+    sum += b;
+    EXPECT_TRUE(sum.has(PerfEvent::CYCLES));
+    EXPECT_FALSE(sum.has(PerfEvent::INSTRUCTIONS));
+    EXPECT_EQ(sum.ipc(), 0.0);
+}
+
+TEST(PerfCountersTest, TesterReportsCountersPerAlgorithm) {
+    PerformanceTester tester(5);
+    tester.addAlgorithm(std::make_unique<MedianFilter>(5));
+    tester.addAlgorithm(std::make_unique<KalmanFilter>(0.1, 1.0, 1.0));
+    tester.generateTestDataset(400, 4);
+    tester.setTimingOptions(TimingOptions::singleShot());
+    tester.setCollectPerfCounters(true);
+
+    PerformanceTester::RunOptions options;
+    options.numThreads = 2;
+    const auto results = tester.runFullTest(options);
+    const bool available = PerfCounters().available();
+    for (const auto& result : results) {
+        EXPECT_EQ(result.perfSamples.size(), 4u);
+        EXPECT_EQ(result.perfCounters.any(), available && result.perfSamples[0].any());
+    }
+
+    EXPECT_NE(tester.generateReport(results).find("АППАРАТНЫЕ СЧЁТЧИКИ"), std::string::npos);
+
+    TempFile csv("");
+    tester.saveResultsToCSV(results, csv.path());
+    std::ifstream in(csv.path());
+    std::string header, row;
+    std::getline(in, header);
+    std::getline(in, row);
+    EXPECT_NE(header.find("Cycles,Instructions,IPC,L1D_Misses,LLC_Misses,Branch_Misses"),
+              std::string::npos);
+    EXPECT_EQ(std::count(row.begin(), row.end(), ','), std::count(header.begin(), header.end(), ','));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Учёт выделений памяти
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(AllocTrackerTest, ScopesCountAllocationsAndPeak) {
+    AllocScope outer;
+    {
+        AllocScope inner;
+        std::vector<double> a(1000);
+        std::vector<double> b(500);
+        const AllocStats s = inner.stats();
+        if (allocTrackingEnabled()) {
+            EXPECT_EQ(s.allocations, 2u);
+            EXPECT_EQ(s.bytes, 1500 * sizeof(double));
+            EXPECT_GE(s.peakBytes, 1500 * sizeof(double));
+        } else {
+            EXPECT_EQ(s.allocations, 0u);
+            EXPECT_EQ(s.peakBytes, 0u);
+        }
+    }
+    {
+        // Пик после освобождения не уменьшается, а следующий блок его не складывает
+        std::vector<double> c(100);
+    }
+    const AllocStats s = outer.stats();
+    if (allocTrackingEnabled()) {
+        EXPECT_EQ(s.allocations, 3u);
+        EXPECT_EQ(s.deallocations, 3u);
+        EXPECT_GE(s.peakBytes, 1500 * sizeof(double));
+        EXPECT_LT(s.peakBytes, 1600 * sizeof(double) + 256);
+    } else {
+        EXPECT_EQ(s.allocations, 0u);
+    }
+}
+
+TEST(AllocTrackerTest, TesterReportsAllocationsPerCall) {
+    PerformanceTester tester(6);
+    tester.addAlgorithm(std::make_unique<MedianFilter>(5));
+    tester.generateTestDataset(300, 3);
+    tester.setTimingOptions(TimingOptions::singleShot());
+    const auto results = tester.runFullTest();
+
+    ASSERT_EQ(results.size(), 1u);
+    if (allocTrackingEnabled()) {
+        ASSERT_EQ(results[0].allocSamples.size(), 3u);
+        // Как минимум выходной сигнал
+        EXPECT_GE(results[0].avgAllocations, 1.0);
+        EXPECT_GE(results[0].avgPeakBytes, 300.0 * sizeof(double));
+        EXPECT_NE(tester.generateReport(results).find("ВЫДЕЛЕНИЯ ПАМЯТИ"), std::string::npos);
+    } else {
+        EXPECT_TRUE(results[0].allocSamples.empty());
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// JSON-отчёты бенчмарков и сравнение с базовой линией
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Конфигурация с одинаковым временем medianNs и SNR на всех сигналах
+static BenchEntry makeBenchEntry(const std::string& name, double medianNs, double snr,
+                                 size_t numSignals = 5) {
+    BenchEntry entry;
+    entry.name = name;
+    for (size_t s = 0; s < numSignals; ++s) {
+        // Небольшой разброс между сигналами, как в реальных замерах
+        const double jitter = 1.0 + 0.002 * static_cast<double>(s % 3);
+        TimingStats t;
+        t.samples    = 50;
+        t.medianNs   = medianNs * jitter;
+        t.minNs      = t.medianNs * 0.95;
+        t.relativeCI = 0.01;
+        entry.timings.push_back(t);
+        entry.snr.push_back(snr + 0.01 * static_cast<double>(s));
+        entry.mse.push_back(1e-3);
+        entry.correlation.push_back(0.95);
+    }
+    return entry;
+}
+
+static BenchReport makeBenchReport(std::vector<BenchEntry> entries) {
+    BenchReport report;
+    report.benchmark   = "test";
+    report.environment = currentBenchEnvironment();
+    for (size_t s = 0; s < entries.front().snr.size(); ++s) {
+        report.signals.push_back("signal_" + std::to_string(s));
+    }
+    report.entries = std::move(entries);
+    return report;
+}
+
+TEST(BenchReportTest, JsonRoundTripPreservesEverything) {
+    BenchReport report = makeBenchReport({makeBenchEntry("Median(7)", 12345.5, 20.25),
+                                          makeBenchEntry("Outlier→\"q\"\\x", 999.0, 18.0)});
+    report.entries[0].hasAllocations = true;
+    report.entries[0].allocations    = 3.0;
+    report.entries[0].peakBytes      = 8192.0;
+    report.entries[1].snr[2] = std::numeric_limits<double>::infinity();
+    report.entries[1].runMediansNs.assign(5, {990.0, 1010.5, 1003.0});
+    report.environment.buildFlags = "Release -O2 -march=\"native\"";
+    report.environment.warnings   = {"регулятор частоты \"powersave\"", "Turbo Boost включён"};
+
+    TempFile tmp("");
+    writeBenchJson(tmp.path(), report);
+    const BenchReport back = readBenchJson(tmp.path());
+
+    EXPECT_EQ(back.benchmark, "test");
+    EXPECT_EQ(back.environment.gitRevision, report.environment.gitRevision);
+    EXPECT_EQ(back.environment.compiler, report.environment.compiler);
+    EXPECT_EQ(back.environment.buildFlags, report.environment.buildFlags);
+    EXPECT_EQ(back.environment.cpuModel, report.environment.cpuModel);
+    EXPECT_EQ(back.environment.hardwareThreads, report.environment.hardwareThreads);
+    EXPECT_EQ(back.environment.allocTracking, allocTrackingEnabled());
+    EXPECT_EQ(back.environment.warnings, report.environment.warnings);
+    EXPECT_EQ(back.signals, report.signals);
+
+    ASSERT_EQ(back.entries.size(), 2u);
+    EXPECT_EQ(back.entries[1].name, "Outlier→\"q\"\\x");
+    EXPECT_TRUE(back.entries[0].hasAllocations);
+    EXPECT_EQ(back.entries[0].allocations, 3.0);
+    EXPECT_EQ(back.entries[0].peakBytes, 8192.0);
+    EXPECT_FALSE(back.entries[1].hasAllocations);
+    EXPECT_TRUE(back.entries[0].runMediansNs.empty());
+    EXPECT_EQ(back.entries[1].runMediansNs, report.entries[1].runMediansNs);
+    for (size_t e = 0; e < 2; ++e) {
+        ASSERT_EQ(back.entries[e].timings.size(), 5u);
+        for (size_t s = 0; s < 5; ++s) {
+            const TimingStats& a = report.entries[e].timings[s];
+            const TimingStats& b = back.entries[e].timings[s];
+            EXPECT_EQ(b.samples, a.samples);
+            EXPECT_EQ(b.medianNs, a.medianNs);   // Кратчайшая точная запись
+            EXPECT_EQ(b.minNs, a.minNs);
+            EXPECT_EQ(b.relativeCI, a.relativeCI);
+        }
+    }
+    EXPECT_EQ(back.entries[0].snr, report.entries[0].snr);
+    // Бесконечность не представима в JSON — читается как NaN
+    EXPECT_TRUE(std::isnan(back.entries[1].snr[2]));
+}
+
+TEST(BenchReportTest, ReadRejectsMalformedJson) {
+    TempFile tmp("{\"entries\": [ {\"name\": \"x\", \"snr\": [1, ");
+    EXPECT_THROW(readBenchJson(tmp.path()), std::runtime_error);
+}
+
+TEST(BenchReportTest, IdenticalRunsDoNotRegress) {
+    const BenchReport base = makeBenchReport({makeBenchEntry("A", 1000.0, 20.0),
+                                              makeBenchEntry("B", 5000.0, 15.0)});
+    const BenchComparison cmp = compareBenchReports(base, base);
+    ASSERT_EQ(cmp.deltas.size(), 2u);
+    EXPECT_FALSE(cmp.failed());
+    EXPECT_NEAR(cmp.deltas[0].timeRatio, 1.0, 1e-12);
+    EXPECT_LE(cmp.deltas[0].timeRatioLow, 1.0);
+    EXPECT_GE(cmp.deltas[0].timeRatioHigh, 1.0);
+}
+
+TEST(BenchReportTest, FlagsSignificantSlowdownOnly) {
+    const BenchReport base = makeBenchReport({makeBenchEntry("A", 1000.0, 20.0),
+                                              makeBenchEntry("B", 1000.0, 20.0)});
+    // A: +30% (значимо), B: +3% (в пределах допуска 5%)
+    const BenchReport cur  = makeBenchReport({makeBenchEntry("A", 1300.0, 20.0),
+                                              makeBenchEntry("B", 1030.0, 20.0)});
+    const BenchComparison cmp = compareBenchReports(base, cur);
+
+    ASSERT_EQ(cmp.deltas.size(), 2u);
+    EXPECT_TRUE(cmp.deltas[0].slower);
+    EXPECT_NEAR(cmp.deltas[0].timeRatio, 1.3, 1e-9);
+    EXPECT_FALSE(cmp.deltas[1].slower);
+    EXPECT_EQ(cmp.regressions(), 1u);
+    EXPECT_TRUE(cmp.failed());
+    EXPECT_NE(formatBenchComparison(cmp).find("медленнее"), std::string::npos);
+
+    // Ускорение — не регрессия
+    EXPECT_FALSE(compareBenchReports(cur, base).failed());
+}
+
+TEST(BenchReportTest, NoisyTimingsAreNotSignificant) {
+    BenchReport base = makeBenchReport({makeBenchEntry("A", 1000.0, 20.0, 1)});
+    BenchReport cur  = makeBenchReport({makeBenchEntry("A", 1100.0, 20.0, 1)});
+    // Замеры с ДИ медианы ±20% не позволяют утверждать о замедлении на 10%
+    base.entries[0].timings[0].relativeCI = 0.2;
+    cur.entries[0].timings[0].relativeCI  = 0.2;
+    EXPECT_FALSE(compareBenchReports(base, cur).deltas[0].slower);
+}
+
+TEST(BenchReportTest, RunToRunSpreadDecidesSignificance) {
+    BenchReport base = makeBenchReport({makeBenchEntry("A", 1000.0, 20.0, 1)});
+    BenchReport cur  = makeBenchReport({makeBenchEntry("A", 1200.0, 20.0, 1)});
+    // Узкий ДИ внутри прогона, но прогоны расходятся на ±25%
+    base.entries[0].runMediansNs = {{800.0, 1000.0, 1250.0}};
+    cur.entries[0].runMediansNs  = {{960.0, 1200.0, 1500.0}};
+    EXPECT_FALSE(compareBenchReports(base, cur).deltas[0].slower);
+
+    // Стабильные прогоны — то же замедление значимо
+    base.entries[0].runMediansNs = {{995.0, 1000.0, 1005.0}};
+    cur.entries[0].runMediansNs  = {{1195.0, 1200.0, 1205.0}};
+    const BenchDelta d = compareBenchReports(base, cur).deltas[0];
+    EXPECT_TRUE(d.slower);
+    EXPECT_GT(d.timeRatioLow, 1.15);
+    EXPECT_LT(d.timeRatioHigh, 1.25);
+}
+
+TEST(BenchReportTest, FlagsSnrLossAndAllocationGrowth) {
+    BenchReport base = makeBenchReport({makeBenchEntry("A", 1000.0, 20.0),
+                                        makeBenchEntry("B", 1000.0, 20.0)});
+    BenchReport cur  = makeBenchReport({makeBenchEntry("A", 1000.0, 19.5),
+                                        makeBenchEntry("B", 1000.0, 20.0)});
+    for (BenchReport* r : {&base, &cur}) {
+        for (BenchEntry& e : r->entries) e.hasAllocations = true;
+    }
+    base.entries[1].allocations = 2.0;
+    cur.entries[1].allocations  = 3.0;
+
+    const BenchComparison cmp = compareBenchReports(base, cur);
+    EXPECT_TRUE(cmp.deltas[0].snrLoss);
+    EXPECT_NEAR(cmp.deltas[0].snrDelta, -0.5, 1e-9);
+    EXPECT_FALSE(cmp.deltas[0].moreAllocs);
+    EXPECT_FALSE(cmp.deltas[1].snrLoss);
+    EXPECT_TRUE(cmp.deltas[1].moreAllocs);
+    EXPECT_EQ(cmp.regressions(), 2u);
+
+    BenchThresholds loose;
+    loose.snrTolerance = 1.0;
+    EXPECT_FALSE(compareBenchReports(base, cur, loose).deltas[0].snrLoss);
+}
+
+TEST(BenchReportTest, ReportsMissingAddedAndDatasetMismatch) {
+    const BenchReport base = makeBenchReport({makeBenchEntry("A", 1000.0, 20.0),
+                                              makeBenchEntry("Old", 1000.0, 20.0)});
+    BenchReport cur = makeBenchReport({makeBenchEntry("A", 1000.0, 20.0),
+                                       makeBenchEntry("New", 1000.0, 20.0)});
+    BenchComparison cmp = compareBenchReports(base, cur);
+    EXPECT_EQ(cmp.missing, std::vector<std::string>{"Old"});
+    EXPECT_EQ(cmp.added, std::vector<std::string>{"New"});
+    EXPECT_FALSE(cmp.failed());
+
+    cur.signals[0] = "other";
+    cmp = compareBenchReports(base, cur);
+    EXPECT_TRUE(cmp.datasetMismatch);
+    EXPECT_TRUE(cmp.failed());
+}
+
+TEST(BenchReportTest, TesterWritesComparableJson) {
+    PerformanceTester tester(7);
+    tester.addAlgorithm(std::make_unique<MedianFilter>(5));
+    tester.generateTestDataset(200, 3);
+    tester.setTimingOptions(TimingOptions::singleShot());
+    const auto results = tester.runFullTest();
+
+    TempFile tmp("");
+    tester.saveResultsToJSON(results, tmp.path());
+    const BenchReport report = readBenchJson(tmp.path());
+
+    EXPECT_EQ(report.benchmark, "performance_tester");
+    ASSERT_EQ(report.signals.size(), 3u);
+    ASSERT_EQ(report.entries.size(), 1u);
+    EXPECT_EQ(report.entries[0].name, results[0].algorithmName);
+    EXPECT_EQ(report.entries[0].snr, results[0].snrResults);
+    ASSERT_EQ(report.entries[0].timings.size(), 3u);
+    EXPECT_EQ(report.entries[0].timings[1].medianNs, results[0].timings[1].medianNs);
+    EXPECT_FALSE(compareBenchReports(report, report).failed());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Масштабируемость: подбор модели сложности
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Точки t(N) на длинах 10²..10⁶, три на декаду
+static PerformanceTester::ScalabilityResult
+makeScalability(const std::function<double(double)>& timeUs, size_t window = 1) {
+    PerformanceTester::ScalabilityResult result;
+    result.windowSize = window;
+    for (double n = 100.0; n <= 1e6 * 1.0001; n *= std::pow(10.0, 1.0 / 3.0)) {
+        PerformanceTester::ScalabilityPoint p;
+        p.length   = static_cast<size_t>(std::llround(n));
+        p.medianUs = timeUs(static_cast<double>(p.length));
+        result.points.push_back(p);
+    }
+    PerformanceTester::fitComplexity(result);
+    return result;
+}
+
+TEST(ScalabilityTest, FitsKnownComplexities) {
+    using Model = PerformanceTester::ComplexityModel;
+
+    const auto linear = makeScalability([](double n) { return 3.0 + 0.01 * n; });
+    EXPECT_EQ(linear.bestModel, Model::LINEAR);
+    EXPECT_NEAR(linear.exponent, 1.0, 0.02);
+    EXPECT_NEAR(linear.fits[0].coefficient, 0.01, 1e-6);
+    EXPECT_NEAR(linear.fits[0].intercept, 3.0, 1e-3);
+    EXPECT_LT(linear.fits[0].rmsRelError, 1e-9);
+
+    const auto nlogn = makeScalability([](double n) { return 1e-3 * n * std::log2(n); });
+    EXPECT_EQ(nlogn.bestModel, Model::N_LOG_N);
+    EXPECT_GT(nlogn.exponent, 1.03);
+    EXPECT_LT(nlogn.exponent, 1.15);
+
+    const auto quadratic = makeScalability([](double n) { return 5.0 + 1e-6 * n * n; });
+    EXPECT_EQ(quadratic.bestModel, Model::QUADRATIC);
+    EXPECT_NEAR(quadratic.exponent, 2.0, 0.02);
+
+    // Линейный рост у фильтра с окном относится к O(N·w), коэффициент — на отсчёт·w
+    const auto windowed = makeScalability([](double n) { return 0.07 * n; }, 7);
+    EXPECT_EQ(windowed.bestModel, Model::N_WINDOW);
+    EXPECT_NEAR(windowed.fits[2].coefficient, 0.01, 1e-9);
+}
+
+TEST(ScalabilityTest, MeasuresThroughputAndStopsSlowAlgorithms) {
+    PerformanceTester tester(3);
+    tester.addAlgorithm(std::make_unique<MedianFilter>(5));
+
+    PerformanceTester::ScalabilityOptions options;
+    options.minLength        = 1000;
+    options.maxLength        = 100000;
+    options.lengthsPerDecade = 2;
+    options.signalsPerLength = 1;
+    options.timing           = TimingOptions::singleShot();
+
+    auto results = tester.testScalability(options);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].windowSize, 5u);
+    ASSERT_EQ(results[0].points.size(), 5u);    // 1000, 3162, 10000, 31623, 100000
+    EXPECT_EQ(results[0].points.front().length, 1000u);
+    EXPECT_EQ(results[0].points.back().length, 100000u);
+    for (const auto& p : results[0].points) {
+        EXPECT_GT(p.medianUs, 0.0);
+        EXPECT_NEAR(p.msamplesPerSec, p.length / p.medianUs, 1e-9);
+        EXPECT_NEAR(p.gbPerSec, p.msamplesPerSec * 16.0 / 1000.0, 1e-9);
+    }
+    EXPECT_FALSE(results[0].truncated);
+    EXPECT_EQ(results[0].fits.size(), 4u);
+    EXPECT_NE(tester.generateScalabilityReport(results).find("Лучшая модель"), std::string::npos);
+
+    // Предел времени вызова останавливает рост длины после первой точки
+    options.maxCallSeconds = 1e-9;
+    results = tester.testScalability(options);
+    EXPECT_EQ(results[0].points.size(), 1u);
+    EXPECT_TRUE(results[0].truncated);
+
+    // Прежний интерфейс: (длина, мкс) для каждой запрошенной длины
+    tester.setTimingOptions(TimingOptions::singleShot());
+    const auto legacy = tester.testScalability(std::vector<size_t>{200, 400});
+    ASSERT_EQ(legacy.size(), 1u);
+    ASSERT_EQ(legacy.begin()->second.size(), 2u);
+    EXPECT_EQ(legacy.begin()->second[1].first, 400u);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../src/signal_generator.h"
+#include "../src/median_filter.h"
+#include "../src/kalman_filter.h"
+#include "../src/wiener_filter.h"
+#include "../src/outlier_detection.h"
+#include "../src/pipeline.h"
+#include "../src/pipelined_executor.h"
+#include "../src/utils/spsc_queue.h"
+#include "../src/utils/alloc_tracker.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Pipeline
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(PipelineTest, MatchesSequentialProcessing) {
+    SignalGenerator gen(8);
+    const auto input = gen.generateTestDataset(500, 1).front().second;
+
+    Pipeline chain;
+    chain.emplace<OutlierDetection>()
+         .emplace<MedianFilter>(5)
+         .emplace<KalmanFilter>(0.1, 1.0, 1.0);
+
+    OutlierDetection outliers;
+    MedianFilter median(5);
+    KalmanFilter kalman(0.1, 1.0, 1.0);
+    const auto expected = kalman.process(median.process(outliers.process(input)));
+
+    EXPECT_EQ(chain.process(input), expected);
+    EXPECT_EQ(chain.process(input), expected);   // Повторный вызов на тех же буферах
+    EXPECT_EQ(chain.getName(), outliers.getName() + "→" + median.getName() + "→" +
+                               kalman.getName());
+    EXPECT_EQ(chain.getWindowSize(), outliers.getWindowSize() + median.getWindowSize() - 1);
+
+    ASSERT_EQ(chain.stageStats().size(), 3u);
+    for (const auto& st : chain.stageStats()) {
+        EXPECT_EQ(st.calls, 2u);
+        EXPECT_GE(st.totalNs, st.lastNs);
+    }
+
+    // Копия независима и даёт тот же результат
+    auto copy = chain.clone();
+    EXPECT_EQ(copy->process(input), expected);
+    EXPECT_EQ(chain.stageStats()[0].calls, 2u);
+
+    // Пустая цепочка — тождественна
+    Pipeline identity;
+    EXPECT_EQ(identity.process(input), input);
+    EXPECT_THROW(identity.add(nullptr), std::invalid_argument);
+}
+
+TEST(PipelineTest, FusesPointwiseStages) {
+    const SignalProcessor::Signal input = {3.0, -1.0, 4.0, 1.0, -5.0, 9.0, 2.0};
+
+    Pipeline chain;
+    chain.emplace<MedianFilter>(3)
+         .addPointwise("gain", [](double v) { return 2.0 * v; })
+         .addPointwise("offset", [](double v) { return v + 1.0; });
+
+    ASSERT_EQ(chain.size(), 1u);   // Поточечные этапы слиты с медианой
+    EXPECT_EQ(chain.stageStats()[0].name, "MedianFilter_3+gain+offset");
+
+    auto expected = MedianFilter(3).process(input);
+    for (double& v : expected) v = 2.0 * v + 1.0;
+    EXPECT_EQ(chain.process(input), expected);
+
+    // Поточечный этап в начале цепочки — копирование входа с преобразованием
+    Pipeline leading;
+    leading.addPointwise("neg", [](double v) { return -v; }).emplace<MedianFilter>(3);
+    ASSERT_EQ(leading.size(), 2u);
+    SignalProcessor::Signal negated = input;
+    for (double& v : negated) v = -v;
+    EXPECT_EQ(leading.process(input), MedianFilter(3).process(negated));
+    EXPECT_EQ(leading.getName(), "neg→MedianFilter_3");
+}
+
+TEST(PipelineTest, ReusesBuffersBetweenCalls) {
+    SignalGenerator gen(9);
+    const auto input = gen.generateWhiteNoise(4096, 1.0);
+
+    Pipeline chain;
+    chain.emplace<KalmanFilter>(0.1, 1.0, 1.0)
+         .addPointwise("gain", [](double v) { return 0.5 * v; })
+         .emplace<KalmanFilter>(0.2, 1.0, 1.0);
+
+    SignalProcessor::Signal output;
+    chain.processInto(input, output);
+    const double* data   = output.data();
+    const size_t  buffer = chain.bufferBytes();
+    EXPECT_EQ(buffer, input.size() * sizeof(double));   // Один промежуточный буфер
+
+    // Выделения самих этапов на прогретом выходе
+    KalmanFilter kalman(0.1, 1.0, 1.0);
+    SignalProcessor::Signal kalmanOut;
+    kalman.processInto(input, kalmanOut);
+    size_t stageAllocations;
+    {
+        AllocScope scope;
+        kalman.processInto(input, kalmanOut);
+        stageAllocations = scope.stats().allocations;
+    }
+
+    AllocScope scope;
+    chain.processInto(input, output);
+    const AllocStats s = scope.stats();
+
+    // Цепочка не добавляет выделений к выделениям этапов
+    EXPECT_EQ(s.allocations, 2 * stageAllocations);
+    EXPECT_EQ(output.data(), data);
+    EXPECT_EQ(chain.bufferBytes(), buffer);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Конвейерное исполнение (PipelinedExecutor, SpscQueue)
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(SpscQueueTest, PreservesOrderAcrossThreads) {
+    SpscQueue<uint64_t> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+
+    constexpr uint64_t kCount = 200000;
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < kCount; ++i) {
+            uint64_t v = i;
+            while (!queue.tryPush(v)) std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0, v = 0;
+    while (expected < kCount) {
+        if (queue.tryPop(v)) {
+            ASSERT_EQ(v, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_FALSE(queue.tryPop(v));
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(PipelinedExecutorTest, MatchesSerialProcessingPerBlock) {
+    SignalGenerator gen(10);
+    std::vector<SignalProcessor::Signal> blocks;
+    for (size_t i = 0; i < 40; ++i) blocks.push_back(gen.generateWhiteNoise(200 + 7 * i, 1.0));
+
+    std::vector<std::unique_ptr<SignalProcessor>> stages;
+    stages.push_back(std::make_unique<OutlierDetection>());
+    stages.push_back(std::make_unique<WienerFilter>(8, 5, 1e-4));
+    stages.push_back(std::make_unique<KalmanFilter>(0.1, 1.0, 1.0));
+    PipelinedExecutor::Options options;
+    options.queueCapacity = 2;
+    PipelinedExecutor executor(std::move(stages), options);
+
+    OutlierDetection outliers;
+    WienerFilter wiener(8, 5, 1e-4);
+    KalmanFilter kalman(0.1, 1.0, 1.0);
+
+    for (int repeat = 0; repeat < 2; ++repeat) {   // Второй прогон — на возвращённых буферах
+        const auto results = executor.run(blocks);
+        ASSERT_EQ(results.size(), blocks.size());
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            EXPECT_EQ(results[i], kalman.process(wiener.process(outliers.process(blocks[i]))))
+                << "блок " << i;
+        }
+    }
+
+    ASSERT_EQ(executor.metrics().size(), 3u);
+    EXPECT_EQ(executor.metrics()[1].name, wiener.getName());
+    for (const auto& m : executor.metrics()) {
+        EXPECT_EQ(m.blocks, blocks.size());
+        EXPECT_GT(m.busyNs, 0);
+        EXPECT_LE(m.maxQueueDepth, 2u);   // Противодавление держит очередь в пределах ёмкости
+        EXPECT_LE(m.meanQueueDepth, 2.0);
+    }
+    EXPECT_GT(executor.lastRunNs(), 0);
+}
+
+TEST(PipelinedExecutorTest, SinkReceivesBlocksInOrderAndErrorsPropagate) {
+    std::vector<std::unique_ptr<SignalProcessor>> stages;
+    stages.push_back(std::make_unique<MedianFilter>(3));
+    stages.push_back(std::make_unique<MedianFilter>(5));
+    PipelinedExecutor executor(std::move(stages));
+
+    size_t produced = 0, nextIndex = 0;
+    const size_t n = executor.run(
+        [&](SignalProcessor::Signal& block) {
+            if (produced == 100) return false;
+            block.assign(16, static_cast<double>(produced++));
+            return true;
+        },
+        [&](size_t index, const SignalProcessor::Signal& block) {
+            EXPECT_EQ(index, nextIndex++);
+            EXPECT_EQ(block, SignalProcessor::Signal(16, static_cast<double>(index)));
+        });
+    EXPECT_EQ(n, 100u);
+    EXPECT_EQ(nextIndex, 100u);
+
+    // Ошибка в приёмнике останавливает конвейер и доходит до вызывающего
+    EXPECT_THROW(executor.run(
+        [](SignalProcessor::Signal& block) { block.assign(8, 1.0); return true; },
+        [](size_t index, const SignalProcessor::Signal&) {
+            if (index == 10) throw std::runtime_error("sink");
+        }), std::runtime_error);
+
+    EXPECT_THROW(PipelinedExecutor({}), std::invalid_argument);
+}
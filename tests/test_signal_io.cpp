@@ -0,0 +1,638 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <complex>
+#include <iomanip>
+#include <sstream>
+#include <filesystem>
+#include <cmath>
+#include "test_helpers.h"
+#include "../src/signal_generator.h"
+#include "../src/signal_source.h"
+#include "../src/radar_scenario.h"
+#include "../src/composite_signal.h"
+#include "../src/doppler_nip_filter.h"
+#include "../src/utils/csv_reader.h"
+#include "../src/utils/csv_writer.h"
+#include "../src/utils/mapped_file.h"
+#include "../src/utils/signal_file.h"
+#include "../src/utils/signal_archive.h"
+#include "../src/utils/random.h"
+#include "../src/utils/noise_engine.h"
+#include "../src/utils/alloc_tracker.h"
+#include "../src/performance_tester.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CSV: вещественный сигнал "Index,Value"
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(CsvReaderTest, ParsesIndexValueColumns) {
+    auto s = parseSignalCSV("Index,Value\n0,1.5\n1,-2.25\n2,3e-3\n");
+    ASSERT_EQ(s.size(), 3u);
+    EXPECT_DOUBLE_EQ(s[0], 1.5);
+    EXPECT_DOUBLE_EQ(s[1], -2.25);
+    EXPECT_DOUBLE_EQ(s[2], 3e-3);
+}
+
+TEST(CsvReaderTest, HandlesCrLfMissingNewlineAndPlusSign) {
+    auto s = parseSignalCSV("Index,Value\r\n0, +1.0\r\n1,2.0");
+    ASSERT_EQ(s.size(), 2u);
+    EXPECT_DOUBLE_EQ(s[0], 1.0);
+    EXPECT_DOUBLE_EQ(s[1], 2.0);
+}
+
+TEST(CsvReaderTest, SkipsMalformedLines) {
+    // Пустая строка, строка без запятой, пустое и нечисловое значение
+    auto s = parseSignalCSV("Index,Value\n\n7\n1,\n2,abc\n3,4.0\n");
+    ASSERT_EQ(s.size(), 1u);
+    EXPECT_DOUBLE_EQ(s[0], 4.0);
+}
+
+TEST(CsvReaderTest, HeaderOnlyAndEmptyInput) {
+    EXPECT_TRUE(parseSignalCSV("").empty());
+    EXPECT_TRUE(parseSignalCSV("Index,Value\n").empty());
+}
+
+TEST(CsvReaderTest, RoundTripThroughSignalGenerator) {
+    SignalGenerator gen(7);
+    auto original = gen.generateWhiteNoise(1000, 1.0);
+
+    TempFile tmp("");
+    SignalGenerator::saveSignalToCSV(original, tmp.path());
+    auto loaded = SignalGenerator::loadSignalFromCSV(tmp.path());
+
+    ASSERT_EQ(loaded.size(), original.size());
+    for (size_t i = 0; i < original.size(); ++i) {
+        EXPECT_NEAR(loaded[i], original[i], 1e-5 * (1.0 + std::abs(original[i])));
+    }
+}
+
+TEST(CsvReaderTest, MissingFileThrows) {
+    EXPECT_THROW(readSignalCSV("/nonexistent/dir/signal.csv"), std::runtime_error);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CSV: комплексный сигнал "Re,Im"
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(CsvReaderTest, ParsesComplexWithCommentsAndSingleColumn) {
+    auto c = parseComplexCSV("# burst\n1.0,-2.0\n\n3.5\n#x\n-1e-2,4e1\r\n");
+    ASSERT_EQ(c.size(), 3u);
+    EXPECT_EQ(c[0], std::complex<double>(1.0, -2.0));
+    EXPECT_EQ(c[1], std::complex<double>(3.5, 0.0));
+    EXPECT_EQ(c[2], std::complex<double>(-1e-2, 40.0));
+}
+
+TEST(CsvReaderTest, ComplexRejectsNonNumericField) {
+    EXPECT_THROW(parseComplexCSV("1.0,foo\n"), std::invalid_argument);
+}
+
+TEST(CsvReaderTest, DopplerRoundTrip) {
+    ComplexSignal burst = { {1.0, 0.5}, {-0.25, 2.0}, {0.0, -1.0} };
+    TempFile tmp("");
+    DopplerNipFilter::saveToCSV(burst, tmp.path());
+    auto loaded = DopplerNipFilter::loadFromCSV(tmp.path());
+    ASSERT_EQ(loaded.size(), burst.size());
+    for (size_t i = 0; i < burst.size(); ++i) {
+        EXPECT_NEAR(loaded[i].real(), burst[i].real(), 1e-8);
+        EXPECT_NEAR(loaded[i].imag(), burst[i].imag(), 1e-8);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CsvWriter
+// ─────────────────────────────────────────────────────────────────────────────
+
+static std::string readAll(const std::string& path) {
+    MappedFile mf(path);
+    return std::string(mf.view());
+}
+
+TEST(CsvWriterTest, ShortestRoundTripIsExact) {
+    std::vector<double> s = {0.1, -2.5, 1e-300, 123456789.125, 1.0 / 3.0, 0.0};
+    TempFile tmp("");
+    writeSignalCSV(tmp.path(), s, 1);
+    EXPECT_EQ(readAll(tmp.path()).substr(0, 33), "Index,Value\n0,0.1\n1,-2.5\n2,1e-300");
+    EXPECT_EQ(readSignalCSV(tmp.path()), s);
+}
+
+TEST(CsvWriterTest, ParallelOutputMatchesSequential) {
+    SignalGenerator gen(7);
+    auto s = gen.generateWhiteNoise(200000, 1.0);
+    TempFile seq(""), par("");
+    writeSignalCSV(seq.path(), s, 1);
+    writeSignalCSV(par.path(), s, 4);
+    EXPECT_EQ(readAll(seq.path()), readAll(par.path()));
+    EXPECT_EQ(readSignalCSV(par.path()), s);
+}
+
+TEST(CsvWriterTest, ComplexMatchesFixedStreamFormat) {
+    ComplexSignal burst = { {1.0, 0.5}, {-0.25, 2.0}, {1e-9, -123.456789012} };
+    TempFile tmp("");
+    writeComplexCSV(tmp.path(), burst, 8, 1);
+
+    std::ostringstream expected;
+    expected << std::fixed << std::setprecision(8);
+    for (const auto& c : burst) expected << c.real() << "," << c.imag() << "\n";
+    EXPECT_EQ(readAll(tmp.path()), expected.str());
+}
+
+TEST(CsvWriterTest, ComplexBlockMemoryFollowsActualLineLength) {
+    // Строки ~20 байт: блок не должен резервироваться под худший случай %.Nf
+    SignalGenerator gen(3);
+    const auto re = gen.generateWhiteNoise(200000, 1.0);
+    ComplexSignal signal(re.size());
+    for (size_t i = 0; i < re.size(); ++i) signal[i] = {re[i], -re[i]};
+
+    TempFile tmp("");
+    AllocScope scope;
+    writeComplexCSV(tmp.path(), signal, 6, 1);
+    const AllocStats s = scope.stats();
+    if (allocTrackingEnabled()) {
+        // Буфер записи 1 МиБ + блок 65536 строк по ~32 байта (раньше ~46 МБ)
+        EXPECT_LT(s.peakBytes, size_t(4) << 20);
+    }
+
+    // Строки длиннее оценки (|x| ~ 1e300): буфер блока дорастает по ходу
+    ComplexSignal wide(3000);
+    for (size_t i = 0; i < wide.size(); ++i) wide[i] = {1e300 * (i % 7 + 1), -1e-300 * i};
+    writeComplexCSV(tmp.path(), wide, 17, 1);
+    std::ostringstream expected;
+    expected << std::fixed << std::setprecision(17);
+    for (const auto& c : wide) expected << c.real() << "," << c.imag() << "\n";
+    EXPECT_EQ(readAll(tmp.path()), expected.str());
+}
+
+TEST(CsvWriterTest, SmallBufferAndUnwritablePath) {
+    TempFile tmp("");
+    {
+        CsvWriter w(tmp.path(), 16);
+        for (int i = 0; i < 100; ++i) w.writeIndex(i).writeChar(',').writeFixed(i * 0.5, 2).writeChar('\n');
+    }
+    auto text = readAll(tmp.path());
+    EXPECT_EQ(text.substr(0, 15), "0,0.00\n1,0.50\n2");
+    EXPECT_NE(text.find("99,49.50\n"), std::string::npos);
+
+    EXPECT_THROW(CsvWriter("/nonexistent_dir/out.csv"), std::runtime_error);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// MappedFile
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(MappedFileTest, MapsContentsAndHandlesEmptyFile) {
+    TempFile full("hello");
+    MappedFile mf(full.path());
+    EXPECT_EQ(mf.view(), "hello");
+    EXPECT_TRUE(mf.isMapped());
+
+    TempFile empty("");
+    MappedFile me(empty.path());
+    EXPECT_EQ(me.size(), 0u);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Бинарный контейнер .sig
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(SignalFileTest, RealRoundTripIsExactAndZeroCopy) {
+    SignalGenerator gen(11);
+    auto original = gen.generateWhiteNoise(4097, 2.0);
+
+    TempFile tmp("");
+    const std::string path = tmp.path() + ".sig";
+    saveSignalBinary(original, path, SampleType::FLOAT64, 1000.0);
+
+    SignalFile file(path);
+    EXPECT_EQ(file.sampleType(), SampleType::FLOAT64);
+    EXPECT_EQ(file.length(), original.size());
+    EXPECT_EQ(file.channels(), 1u);
+    EXPECT_DOUBLE_EQ(file.sampleRate(), 1000.0);
+
+    auto view = file.samples<double>();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view.data()) % 64, 0u);
+    ASSERT_EQ(view.size(), original.size());
+    for (size_t i = 0; i < original.size(); ++i) EXPECT_EQ(view[i], original[i]);
+
+    EXPECT_EQ(SignalGenerator::loadSignal(path), original);
+    EXPECT_THROW(file.samples<float>(), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(SignalFileTest, Float32AndComplexTypes) {
+    TempFile tmp("");
+    const std::string realPath = tmp.path() + "_f32.sig";
+    const std::string cplxPath = tmp.path() + "_c64.sig";
+
+    std::vector<double> real = {0.5, -1.25, 3.0};
+    saveSignalBinary(real, realPath, SampleType::FLOAT32);
+    EXPECT_EQ(loadSignalBinary(realPath), real);
+
+    ComplexSignal burst = { {1.0, 2.0}, {-0.5, 0.25}, {0.0, -4.0} };
+    saveComplexSignalBinary(burst, cplxPath, SampleType::COMPLEX64);
+    EXPECT_EQ(DopplerNipFilter::loadFromFile(cplxPath), burst);
+    EXPECT_THROW(SignalFile(cplxPath).toReal(), std::runtime_error);
+
+    std::remove(realPath.c_str());
+    std::remove(cplxPath.c_str());
+}
+
+TEST(SignalFileTest, StreamingWriterMatchesSingleWrite) {
+    // Блоки нечётной длины float32 проверяют перенос неполного слова суммы
+    std::vector<double> data(1001);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = 0.001 * static_cast<double>(i);
+
+    TempFile tmp("");
+    const std::string a = tmp.path() + "_a.sig";
+    const std::string b = tmp.path() + "_b.sig";
+
+    saveSignalBinary(data, a, SampleType::FLOAT32);
+    {
+        SignalFileWriter w(b, SampleType::FLOAT32);
+        std::span<const double> all(data);
+        w.append(all.subspan(0, 3));
+        w.append(all.subspan(3, 500));
+        w.append(all.subspan(503));
+    }
+
+    SignalFile fa(a), fb(b);
+    EXPECT_EQ(fa.header().checksum, fb.header().checksum);
+    EXPECT_EQ(fa.toReal(), fb.toReal());
+    std::remove(a.c_str());
+    std::remove(b.c_str());
+}
+
+TEST(SignalFileTest, DetectsCorruptionAndTruncation) {
+    TempFile tmp("");
+    const std::string path = tmp.path() + ".sig";
+    saveSignalBinary(std::vector<double>(64, 1.0), path);
+
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(100);
+        f.put('\x7f');
+    }
+    EXPECT_THROW(SignalFile{path}, std::runtime_error);
+    EXPECT_NO_THROW(SignalFile(path, false));
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "DSIG";
+    EXPECT_THROW(SignalFile{path}, std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(SignalFileTest, CsvConversionRoundTrip) {
+    TempFile csv("Index,Value\n0,1.5\n1,-2\n2,0.125\n");
+    const std::string sig  = csv.path() + ".sig";
+    const std::string back = csv.path() + "_back.csv";
+
+    convertCSVToBinary(csv.path(), sig, false, SampleType::FLOAT64);
+    convertBinaryToCSV(sig, back);
+    EXPECT_EQ(readSignalCSV(back), (std::vector<double>{1.5, -2.0, 0.125}));
+
+    std::remove(sig.c_str());
+    std::remove(back.c_str());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Архив .sga
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(SignalArchiveTest, RandomAccessAcrossCodecsAndChunks) {
+    SignalGenerator gen(3);
+    auto noise = gen.generateWhiteNoise(10007, 1.0);
+    std::vector<double> ramp(300);
+    for (size_t i = 0; i < ramp.size(); ++i) ramp[i] = 0.5 * static_cast<double>(i);
+    ComplexSignal burst = { {1.0, -1.0}, {0.5, 0.25} };
+
+    TempFile tmp("");
+    for (ChunkCodec codec : {ChunkCodec::RAW, ChunkCodec::ZLIB, ChunkCodec::SHUFFLE_ZLIB}) {
+        SignalArchiveWriter::Options opt;
+        opt.codec        = codec;
+        opt.chunkSamples = 1000;   // несколько блоков на сигнал, последний неполный
+        opt.numThreads   = 3;
+        {
+            SignalArchiveWriter w(tmp.path(), opt);
+            w.add("a/noise", noise);
+            w.add("b/ramp", ramp);
+            w.add("radar/burst", burst);
+            w.add("empty", std::vector<double>{});
+            EXPECT_THROW(w.add("a/noise", ramp), std::invalid_argument);
+        }
+
+        SignalArchive ar(tmp.path());
+        ASSERT_EQ(ar.size(), 4u);
+        EXPECT_EQ(ar.find("b/ramp"), 1u);
+        EXPECT_EQ(ar.find("missing"), ar.size());
+        EXPECT_EQ(ar.read(ar.find("b/ramp")), ramp);
+        EXPECT_EQ(ar.read(0, 4), noise);
+        EXPECT_EQ(ar.readComplex(2), burst);
+        EXPECT_TRUE(ar.read(3).empty());
+        EXPECT_THROW(ar.read(2), std::runtime_error);
+
+        auto many = ar.readMany({1, 0}, 4);
+        EXPECT_EQ(many[0], ramp);
+        EXPECT_EQ(many[1], noise);
+    }
+}
+
+TEST(SignalArchiveTest, PerformanceTesterRoundTrip) {
+    TempFile tmp("");
+    PerformanceTester writer(5);
+    writer.generateTestDataset(512, 6);
+    writer.saveTestArchive(tmp.path());
+
+    PerformanceTester reader(99);
+    reader.loadTestArchive(tmp.path(), 2);
+    EXPECT_EQ(reader.getDatasetStatistics(), writer.getDatasetStatistics());
+
+    SignalArchive ar(tmp.path());
+    auto pairs = ar.readPairs();
+    ASSERT_EQ(pairs.size(), 6u);
+    EXPECT_EQ(ar.name(0), "clean/signal_000000");
+    EXPECT_EQ(ar.name(1), "noisy/signal_000000");
+}
+
+TEST(SignalArchiveTest, DetectsCorruptedChunk) {
+    TempFile tmp("");
+    {
+        SignalArchiveWriter::Options opt;
+        opt.codec = ChunkCodec::RAW;
+        SignalArchiveWriter w(tmp.path(), opt);
+        w.add("x", std::vector<double>(256, 2.0));
+    }
+    {
+        std::fstream f(tmp.path(), std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(64 + 17);
+        f.put('\x55');
+    }
+    SignalArchive ar(tmp.path());
+    EXPECT_THROW(ar.read(0), std::runtime_error);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Потоковые источники
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Собрать источник блоками нестандартного размера
+static std::vector<double> drain(SignalSource& source, size_t blockSize) {
+    std::vector<double> all, block(blockSize);
+    while (size_t n = source.generateBlock(block)) all.insert(all.end(), block.begin(), block.begin() + n);
+    return all;
+}
+
+TEST(SignalSourceTest, BasicAndEchoMatchBatchGenerators) {
+    using ST = SignalGenerator::SignalType;
+    using ET = SignalGenerator::EchoType;
+    for (ST type : {ST::SINE, ST::SQUARE, ST::TRIANGLE, ST::SAWTOOTH}) {
+        BasicSignalSource src(type, 3001, 0.8, 0.013, 1.1, 0.3);
+        EXPECT_EQ(drain(src, 97), SignalGenerator(1).generateBasicSignal(type, 3001, 0.8, 0.013, 1.1, 0.3));
+    }
+    for (ET type : {ET::RECTANGULAR, ET::TRIANGULAR, ET::GAUSSIAN, ET::EXPONENTIAL, ET::CHIRP}) {
+        EchoSignalSource src(5, type, 2000, 0.7, 120, 0.4, 0.02);
+        EXPECT_EQ(drain(src, 333), SignalGenerator(5).generateEchoSignal(type, 2000, 0.7, 120, 0.4, 0.02));
+    }
+}
+
+TEST(SignalSourceTest, ImpulseNoiseMatchesBatchAcrossBlockBoundaries) {
+    using NT = SignalGenerator::NoiseType;
+    for (NT type : {NT::IMPULSE, NT::RANDOM_SPIKES, NT::BURST, NT::PERIODIC}) {
+        ImpulseNoiseSource src(9, 5000, type, 0.05, 1.5, 7);
+        // Блок 3 < длины пакета: пакеты пересекают границы блоков
+        EXPECT_EQ(drain(src, 3), SignalGenerator(9).generateImpulseNoise(5000, type, 0.05, 1.5, 7));
+    }
+}
+
+TEST(SignalSourceTest, SumSourceStreamsToBinaryFile) {
+    std::vector<std::unique_ptr<SignalSource>> parts;
+    parts.push_back(std::make_unique<BasicSignalSource>(SignalGenerator::SignalType::SINE, 100000));
+    parts.push_back(std::make_unique<ImpulseNoiseSource>(3, 100000));
+    SumSource sum(std::move(parts));
+
+    TempFile tmp("");
+    EXPECT_EQ(writeSourceToFile(sum, tmp.path(), SampleType::FLOAT64, 4096), 100000u);
+    EXPECT_TRUE(sum.done());
+
+    SignalGenerator gen(3);
+    auto expected = gen.addImpulseNoise(gen.generateBasicSignal(SignalGenerator::SignalType::SINE, 100000));
+    EXPECT_EQ(loadSignalBinary(tmp.path()), expected);
+
+    std::vector<std::unique_ptr<SignalSource>> mismatched;
+    mismatched.push_back(std::make_unique<WhiteNoiseSource>(1, 10));
+    mismatched.push_back(std::make_unique<WhiteNoiseSource>(1, 11));
+    EXPECT_THROW(SumSource(std::move(mismatched)), std::invalid_argument);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Независимые потоки ГСЧ и параллельная генерация наборов
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(RandomStreamTest, XoshiroReferenceValuesAndJump) {
+    Xoshiro256 rng(42);
+    EXPECT_EQ(rng(), 0x15780b2e0c2ec716ULL);
+    EXPECT_EQ(rng(), 0x6104d9866d113a7eULL);
+
+    Xoshiro256 jumped(42);
+    jumped.jump();
+    EXPECT_EQ(jumped(), 0x50086ef83cbf4f4aULL);
+
+    auto streams = Xoshiro256::streams(Xoshiro256(42), 3);
+    ASSERT_EQ(streams.size(), 3u);
+    EXPECT_EQ(streams[0], Xoshiro256(42));
+    EXPECT_EQ(streams[1](), 0x50086ef83cbf4f4aULL);
+    EXPECT_FALSE(streams[1] == streams[2]);
+}
+
+TEST(RandomStreamTest, DatasetIsIndependentOfThreadCount) {
+    auto serial   = SignalGenerator(17).generateTestDataset(700, 13, 0.05, 1);
+    auto parallel = SignalGenerator(17).generateTestDataset(700, 13, 0.05, 4);
+    EXPECT_EQ(serial, parallel);
+
+    // Пара i зависит только от своего потока: префикс набора совпадает
+    auto prefix = SignalGenerator(17).generateTestDataset(700, 5, 0.05, 3);
+    EXPECT_TRUE(std::equal(prefix.begin(), prefix.end(), serial.begin()));
+
+    EXPECT_EQ(SignalGenerator(5).generateWienerTestDataset(512, 10.0, 0.02, 5.0, 1),
+              SignalGenerator(5).generateWienerTestDataset(512, 10.0, 0.02, 5.0, 8));
+}
+
+TEST(NoiseEngineTest, GaussianMomentsAndTail) {
+    std::vector<double> g(1 << 20);
+    NoiseEngine(11).fillGaussian(g, 0.5, 2.0);
+
+    double mean = 0.0, var = 0.0, tail = 0.0;
+    for (double v : g) mean += v;
+    mean /= g.size();
+    for (double v : g) {
+        var += (v - mean) * (v - mean);
+        if (std::abs(v - 0.5) > 6.0) tail += 1.0;     // |z| > 3σ
+    }
+    var /= g.size();
+    EXPECT_NEAR(mean, 0.5, 0.01);
+    EXPECT_NEAR(var, 4.0, 0.03);
+    EXPECT_NEAR(tail / g.size(), 0.0027, 0.0004);
+}
+
+TEST(NoiseEngineTest, SequenceDoesNotDependOnRequestSizes) {
+    std::vector<double> whole(5000), parts(5000);
+    NoiseEngine a(3), b(3);
+    a.fillGaussian(whole);
+    for (size_t i = 0, step = 1; i < parts.size(); i += step, step = step * 2 + 1) {
+        b.fillGaussian(std::span<double>(parts).subspan(i, std::min(step, parts.size() - i)));
+    }
+    EXPECT_EQ(whole, parts);
+
+    std::vector<double> other(5000);
+    NoiseEngine(4).fillGaussian(other);
+    EXPECT_NE(whole, other);
+}
+
+TEST(NoiseEngineTest, UniformAndImpulses) {
+    std::vector<double> u(100000);
+    NoiseEngine engine(8);
+    engine.fillUniform(u, -1.0, 3.0);
+    EXPECT_GE(*std::min_element(u.begin(), u.end()), -1.0);
+    EXPECT_LT(*std::max_element(u.begin(), u.end()), 3.0);
+
+    std::vector<double> spikes(100000, 0.0);
+    engine.addImpulses(spikes, 0.05, 1.0, 2.0);
+    size_t hits = 0;
+    for (double v : spikes) {
+        if (v != 0.0) {
+            ++hits;
+            EXPECT_GE(std::abs(v), 1.0);
+            EXPECT_LE(std::abs(v), 2.0);
+        }
+    }
+    EXPECT_NEAR(hits / 100000.0, 0.05, 0.005);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Радиолокационный сценарий
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(RadarScenarioTest, IndependentOfThreadCountAndMaskMatchesEvents) {
+    RadarScenarioConfig cfg;
+    cfg.numGates  = 1000;       // Не кратно размеру блока
+    cfg.numPulses = 32;
+    cfg.nipRate   = 0.5;
+    cfg.seed      = 7;
+    cfg.numThreads = 1;
+    const RadarScenario a = generateRadarScenario(cfg);
+    cfg.numThreads = 3;
+    const RadarScenario b = generateRadarScenario(cfg);
+
+    EXPECT_EQ(a.clean, b.clean);
+    EXPECT_EQ(a.noisy, b.noisy);
+    EXPECT_EQ(a.nipMask, b.nipMask);
+    ASSERT_FALSE(a.nipEvents.empty());
+
+    std::vector<uint8_t> expected(a.nipMask.size(), 0);
+    for (const NipEvent& e : a.nipEvents) {
+        ASSERT_LE(e.firstGate + e.numGates, cfg.numGates);
+        for (size_t g = e.firstGate; g < e.firstGate + e.numGates; ++g) {
+            expected[g * cfg.numPulses + e.pulse] = 1;
+        }
+    }
+    EXPECT_EQ(a.nipMask, expected);
+    for (size_t i = 0; i < a.noisy.size(); ++i) {
+        EXPECT_EQ(a.noisy[i] != a.clean[i], a.nipMask[i] == 1) << "ячейка " << i;
+    }
+
+    cfg.numPulses = 1;
+    EXPECT_THROW(generateRadarScenario(cfg), std::invalid_argument);
+}
+
+TEST(RadarScenarioTest, SavedCubeAndDetectorAccuracy) {
+    // Без целей и помехи: спектр пачки с НИП равномерен, обнаружитель должен
+    // находить почти все поражённые дискреты и указывать верный импульс
+    RadarScenarioConfig cfg;
+    cfg.numGates         = 2048;
+    cfg.numTargets       = 0;
+    cfg.clutterAmplitude = 0.0;
+    cfg.noiseStd         = 0.01;
+    cfg.nipRate          = 0.3;
+    cfg.nipAmplitudeMin  = 5.0;
+    const RadarScenario sc = generateRadarScenario(cfg);
+
+    const NipDetectorEvaluation ev = evaluateNipDetector(sc, DopplerNipFilter(), 2);
+    EXPECT_EQ(ev.gates, cfg.numGates);
+    ASSERT_GT(ev.gatesWithNip, 0u);
+    EXPECT_GT(ev.detectionRate(), 0.95);
+    EXPECT_GT(ev.correctPulse, 0.9 * ev.detected);
+
+    const std::string dir = ::testing::TempDir() + "radar_scenario";
+    saveRadarScenario(sc, dir, SampleType::COMPLEX128);
+    SignalFile cube(dir + "/scenario_noisy.sig");
+    EXPECT_EQ(cube.length(), cfg.numGates);
+    EXPECT_EQ(cube.channels(), cfg.numPulses);
+    auto view = cube.samples<std::complex<double>>();
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), sc.noisy.begin()));
+    EXPECT_EQ(cube.toComplex(5)[17], sc.burst(17)[5]);
+
+    EXPECT_THROW(saveRadarScenario(sc, dir, SampleType::FLOAT32), std::invalid_argument);
+    std::filesystem::remove_all(dir);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Составные сигналы по спецификации
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(CompositeSignalTest, DefaultSpecsMatchFormulasAtAnyLength) {
+    const auto specs = defaultCompositeSpecs();
+    ASSERT_EQ(specs.size(), 10u);
+
+    // 8: биение двух синусов (табличный синус против std::sin)
+    const auto beat = renderCompositeSignal(specs[8], 4096);
+    for (size_t n = 0; n < beat.size(); ++n) {
+        const double t = static_cast<double>(n);
+        EXPECT_NEAR(beat[n], 0.5 * std::sin(2 * M_PI * 0.08 * t) + 0.5 * std::sin(2 * M_PI * 0.085 * t),
+                    1e-12);
+    }
+
+    // 6: ступеньки и прямоугольный импульс — точные значения на границах
+    const auto steps = renderCompositeSignal(specs[6], 4096);
+    EXPECT_EQ(steps[1361], -0.5);
+    EXPECT_EQ(steps[1362], 0.5);
+    EXPECT_EQ(steps[1700], 1.0);
+    EXPECT_EQ(steps[3455], 0.0);
+    EXPECT_EQ(steps[3456], 1.0);
+
+    // Длина произвольная, результат не зависит от числа потоков
+    for (const auto& spec : specs) {
+        const auto a = renderCompositeSignal(spec, 100003, 1);
+        const auto b = renderCompositeSignal(spec, 100003, 3);
+        ASSERT_EQ(a.size(), 100003u);
+        EXPECT_EQ(a, b) << spec.description;
+    }
+}
+
+TEST(CompositeSignalTest, FadeAndParsing) {
+    std::istringstream text(
+        "# два одинаковых уровня с переходом дают ровную единицу\n"
+        "signal  crossfade \n"
+        "constant 0   0.4 fade=0.1\n"
+        "constant 0.4 1   fade=0.1   # комментарий\n"
+        "signal phase\n"
+        "sine 0 1 phase=3pi/4 freq=1/8 env=am\n");
+    const auto specs = parseCompositeSpecs(text);
+    ASSERT_EQ(specs.size(), 2u);
+    EXPECT_EQ(specs[0].description, "crossfade");
+    EXPECT_DOUBLE_EQ(specs[1].segments[0].phase, 0.75 * M_PI);
+    EXPECT_DOUBLE_EQ(specs[1].segments[0].frequency, 0.125);
+    EXPECT_EQ(specs[1].segments[0].envelope, Envelope::AM);
+
+    for (double v : renderCompositeSignal(specs[0], 1000)) EXPECT_NEAR(v, 1.0, 1e-12);
+
+    for (const char* bad : {"sine 0 1\n",                       // участок до 'signal'
+                            "signal x\nwobble 0 1\n",          // неизвестная форма
+                            "signal x\nsine 0 1 freq=abc\n",   // не число
+                            "signal x\nsine 0.5 0.2\n",        // begin ≥ end
+                            "signal x\nsine 0 1 colour=1\n",   // неизвестный параметр
+                            "signal x\n"}) {                    // нет участков
+        std::istringstream in(bad);
+        EXPECT_THROW(parseCompositeSpecs(in), std::runtime_error) << bad;
+    }
+}
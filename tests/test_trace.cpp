@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/property_tree/json_parser.hpp>
+#include "test_helpers.h"
+#include "../src/signal_generator.h"
+#include "../src/wiener_filter.h"
+#include "../src/utils/trace.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Трассировка этапов
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(TraceTest, RecordsNestedSpansPerThread) {
+    { TraceSpan ignored("до traceStart"); }
+
+    traceStart();
+    {
+        TraceSpan outer("outer");
+        { TraceSpan inner("inner"); }
+    }
+    std::thread([] {
+        traceSetThreadName("worker \"1\"");
+        TraceSpan span("worker span");
+    }).join();
+    traceStop();
+    { TraceSpan ignored("после traceStop"); }
+
+    const std::vector<TraceRecord> records = traceSnapshot();
+    ASSERT_EQ(records.size(), 3u);
+    const auto find = [&](const std::string& name) {
+        return *std::find_if(records.begin(), records.end(),
+                             [&](const TraceRecord& r) { return r.name == name; });
+    };
+    const TraceRecord outer = find("outer"), inner = find("inner"), worker = find("worker span");
+    EXPECT_EQ(outer.threadId, inner.threadId);
+    EXPECT_NE(outer.threadId, worker.threadId);
+    EXPECT_LE(outer.startNs, inner.startNs);
+    EXPECT_GE(outer.startNs + outer.durationNs, inner.startNs + inner.durationNs);
+
+    // Chrome trace: метаданные дорожек + полные события "X" с ts/dur в мкс
+    TempFile tmp("");
+    writeChromeTrace(tmp.path());
+    boost::property_tree::ptree root;
+    boost::property_tree::read_json(tmp.path(), root);
+    size_t complete = 0;
+    bool namedWorker = false;
+    for (const auto& item : root.get_child("traceEvents")) {
+        const auto& e = item.second;
+        if (e.get<std::string>("ph") == "X") {
+            ++complete;
+            EXPECT_GE(e.get<double>("dur"), 0.0);
+        } else if (e.get<std::string>("name") == "thread_name") {
+            namedWorker |= e.get<std::string>("args.name") == "worker \"1\"";
+        }
+    }
+    EXPECT_EQ(complete, 3u);
+    EXPECT_TRUE(namedWorker);
+
+    // Новый traceStart очищает прежние события
+    traceStart();
+    traceStop();
+    EXPECT_TRUE(traceSnapshot().empty());
+}
+
+TEST(TraceTest, FilterStagesAppearOnlyWhenCompiledIn) {
+    SignalGenerator gen(3);
+    const auto input = gen.generateWhiteNoise(256, 1.0);
+
+    traceStart();
+    WienerFilter(8, 5, 1e-4).process(input);
+    traceStop();
+
+    const std::vector<TraceRecord> records = traceSnapshot();
+    if (!traceCompiledIn()) {
+        EXPECT_TRUE(records.empty());
+        return;
+    }
+    std::vector<std::string> names;
+    for (const auto& r : records) names.push_back(r.name);
+    for (const char* stage : {"WienerFilter::process", "WienerFilter::estimateDesired",
+                              "WienerFilter::buildCorrelationMatrix", "solveLinearSystem",
+                              "WienerFilter::fir"}) {
+        EXPECT_NE(std::find(names.begin(), names.end(), stage), names.end()) << stage;
+    }
+    EXPECT_EQ(names.front(), "WienerFilter::process");   // Внешняя область — первой
+}
@@ -11,19 +11,30 @@
 #include "../src/signal_classifier.h"
 #include "../src/adaptive_filter_selector.h"
 #include "../src/doppler_nip_filter.h"
+#include "../src/background_filter.h"
+#include "../src/streaming_filter.h"
+#include "../src/signal_source.h"
+#include "../src/utils/spectrogram.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <map>
 #include <format>
 #include <iomanip>
+#include <span>
+#include <sstream>
 
 // ─── Режим РЛС: обработка НИП доплеровскими фазовыми фильтрами ───────────────
 /**
  * Запустить режим визуализации РЛС (split-view).
  *
- * @param noisyFile   CSV-файл с НИП (Re,Im на строку)
- * @param cleanFile   CSV-файл чистого сигнала (Re,Im, опционально)
+ * @param noisyFile   CSV (Re,Im на строку) или .sig с НИП
+ * @param cleanFile   CSV (Re,Im) или .sig чистого сигнала (опционально)
  * @param threshold   Порог CV обнаружения НИП (по умолчанию 0.5)
  * @return            0 при успехе
  */
@@ -35,7 +46,7 @@ int runRadarMode(const std::string& noisyFile,
 
     // ── Загрузка входных данных ────────────────────────────────────────────
     std::cout << "Загрузка зашумлённой пачки: " << noisyFile << "\n";
-    ComplexSignal noisyBurst = DopplerNipFilter::loadFromCSV(noisyFile);
+    ComplexSignal noisyBurst = DopplerNipFilter::loadFromFile(noisyFile);
     if (noisyBurst.empty()) {
         std::cerr << "Ошибка: файл пуст или не найден: " << noisyFile << "\n";
         return 1;
@@ -45,7 +56,7 @@ int runRadarMode(const std::string& noisyFile,
     ComplexSignal cleanBurst;
     if (!cleanFile.empty()) {
         std::cout << "Загрузка чистой пачки: " << cleanFile << "\n";
-        cleanBurst = DopplerNipFilter::loadFromCSV(cleanFile);
+        cleanBurst = DopplerNipFilter::loadFromFile(cleanFile);
     }
 
     // ── Применяем алгоритм ────────────────────────────────────────────────
@@ -109,14 +120,17 @@ void printUsage(const char* programName) {
     std::cout << "Использование: " << programName << " [опции]\n\n";
     std::cout << "Опции:\n";
     std::cout << "  --radar FILE             РЛС-режим: подавление НИП (split-view)\n";
-    std::cout << "                           FILE — CSV с НИП (Re,Im на строку)\n";
-    std::cout << "  --radar-clean FILE       Чистая пачка для сравнения (Re,Im CSV)\n";
+    std::cout << "                           FILE — CSV с НИП (Re,Im на строку) или .sig\n";
+    std::cout << "  --radar-clean FILE       Чистая пачка для сравнения (Re,Im CSV или .sig)\n";
     std::cout << "  --nip-threshold THR      Порог CV для обнаружения НИП (по умолч. 0.50)\n";
     std::cout << "  -f, --filter TYPE        Тип фильтра: median, wiener, robust_wiener, robust_wiener_auto, morpho, outlier, savgol, kalman, spectral, auto\n";
-    std::cout << "  -i, --input FILE         Входной файл с зашумленным сигналом (.csv)\n";
-    std::cout << "  -c, --clean FILE         Чистый сигнал для сравнения (.csv)\n";
+    std::cout << "  -i, --input FILE         Входной файл с зашумленным сигналом (.csv, .sig)\n";
+    std::cout << "  -c, --clean FILE         Чистый сигнал для сравнения (.csv, .sig)\n";
     std::cout << "  -p, --params PARAMS      Параметры фильтра (зависят от типа)\n";
     std::cout << "  --prefilter              Предварительная обработка outlier_detection (MAD,linear,3.0,11)\n";
+    std::cout << "  --live                   Живой режим: поток через фильтр, прокрутка и водопад\n";
+    std::cout << "                           (источник — -i/-c по кругу или синтетический поток)\n";
+    std::cout << "  --live-rate SPS          Отсчётов в секунду в живом режиме (по умолч. 20000)\n";
     std::cout << "  -h, --help               Показать эту справку\n\n";
 
     std::cout << "Параметры фильтров:\n";
@@ -150,6 +164,7 @@ void printUsage(const char* programName) {
     std::cout << "  " << programName << " -f spectral       -i data/noisy/signal_1.csv -c data/clean/signal_1.csv\n";
     std::cout << "  " << programName << " -f spectral       -i data/noisy/signal_1.csv -c data/clean/signal_1.csv -p 512,128,6,3.0,0.002\n";
     std::cout << "  " << programName << " -f auto           -i data/noisy/signal_1.csv -c data/clean/signal_1.csv\n";
+    std::cout << "  " << programName << " -f median         --live --live-rate 50000\n";
 }
 
 struct FilterParams {
@@ -158,6 +173,9 @@ struct FilterParams {
     std::string cleanFile;
     std::string params;
     bool        prefilter    = false; ///< запустить outlier_detection перед основным фильтром
+    // Живой режим
+    bool        liveMode     = false;
+    double      liveRate     = 20000; ///< отсчётов в секунду
     // РЛС-режим
     bool        radarMode    = false;
     std::string radarFile;            ///< файл пачки с НИП (Re,Im)
@@ -202,6 +220,13 @@ FilterParams parseCommandLine(int argc, char* argv[]) {
         else if (arg == "--prefilter") {
             params.prefilter = true;
         }
+        // ── Живой режим ────────────────────────────────────────────────────
+        else if (arg == "--live") {
+            params.liveMode = true;
+        }
+        else if (arg == "--live-rate" && i + 1 < argc) {
+            params.liveRate = std::stod(argv[++i]);
+        }
         else {
             std::cerr << "Неизвестный параметр: " << arg << std::endl;
             printUsage(argv[0]);
@@ -374,6 +399,248 @@ std::unique_ptr<SignalProcessor> createFilter(const std::string& type, const std
     }
 }
 
+// ─── Живой режим: поток через фильтр с прокруткой и водопадом ───────────────
+/**
+ * Запустить живой режим: источник выдаёт liveRate отсчётов в секунду,
+ * каждый кадр новые отсчёты проходят через фильтр и дописываются в
+ * прокручиваемые кривые, спектрограмма выхода — в водопад.
+ *
+ * @return 0 при успехе
+ */
+int runLiveMode(const FilterParams& params)
+{
+    using Signal = SignalProcessor::Signal;
+    std::cout << "\n=== ЖИВОЙ РЕЖИМ: ПОТОКОВАЯ ФИЛЬТРАЦИЯ ===\n\n";
+
+    // ── Источник: файлы по кругу или синтетический поток ──────────────────
+    static constexpr uint64_t kEndless = uint64_t(1) << 62;   // «бесконечный» поток
+    std::unique_ptr<SignalSource> noisyFeed, cleanFeed;
+    float yMin = -3.0f, yMax = 3.0f;
+
+    // Запись файла по кругу
+    auto load = [](const std::string& file) {
+        auto samples = std::make_shared<const Signal>(SignalGenerator::loadSignal(file));
+        if (samples->empty()) throw std::runtime_error("Файл пуст: " + file);
+        return samples;
+    };
+    auto loop = [](std::shared_ptr<const Signal> samples) {
+        return std::make_unique<FunctionSource>(kEndless, [samples](uint64_t i) {
+            return (*samples)[i % samples->size()];
+        });
+    };
+
+    if (!params.inputFile.empty()) {
+        std::cout << "Источник: " << params.inputFile << " (по кругу)\n";
+        const auto noisy = load(params.inputFile);
+        const auto [mn, mx] = std::minmax_element(noisy->begin(), noisy->end());
+        const double pad = 0.1 * (*mx - *mn) + 1e-6;
+        yMin = static_cast<float>(*mn - pad);
+        yMax = static_cast<float>(*mx + pad);
+
+        noisyFeed = loop(noisy);
+        if (!params.cleanFile.empty()) cleanFeed = loop(load(params.cleanFile));
+    } else {
+        std::cout << "Источник: синусоида + белый шум + импульсные помехи\n";
+        std::vector<std::unique_ptr<SignalSource>> parts;
+        parts.push_back(std::make_unique<BasicSignalSource>(SignalGenerator::SignalType::SINE,
+                                                            kEndless, 1.0, 0.01));
+        parts.push_back(std::make_unique<WhiteNoiseSource>(1, kEndless, 0.01));
+        parts.push_back(std::make_unique<ImpulseNoiseSource>(2, kEndless,
+                            SignalGenerator::NoiseType::RANDOM_SPIKES, 0.005, 2.0));
+        noisyFeed = std::make_unique<SumSource>(std::move(parts));
+        cleanFeed = std::make_unique<BasicSignalSource>(SignalGenerator::SignalType::SINE,
+                                                        kEndless, 1.0, 0.01);
+    }
+
+    StreamingFilter stream(createFilter(params.filterType, params.params));
+    std::cout << "Фильтр: " << stream.name() << " (запаздывание " << stream.latency() << " отсч.)\n";
+    std::cout << "Скорость: " << params.liveRate << " отсчётов/с\n";
+
+    // Водопад охватывает те же отсчёты, что и кривые
+    Spectrogram spectrogram;
+    LiveViewOptions options;
+    options.yMin             = yMin;
+    options.yMax             = yMax;
+    options.waterfallBins    = spectrogram.bins();
+    options.waterfallColumns = options.samples / spectrogram.options().hop;
+
+    SignalVisualizer visualizer(1200, 800, "Live | " + stream.name());
+    if (!visualizer.initialize() || !visualizer.enableLiveView(options)) {
+        std::cerr << "Ошибка инициализации визуализатора\n";
+        return 1;
+    }
+
+    // ── Каждый кадр: новые отсчёты → фильтр → кривые и водопад ────────────
+    using Clock = std::chrono::steady_clock;
+    auto   lastFrame  = Clock::now();
+    auto   lastTitle  = lastFrame;
+    double due        = 0.0;     // Отсчётов, которые пора выдать
+    bool   waterfallOfInput = false;
+    long long filterNs = 0;
+    uint64_t  filtered = 0;
+    Signal noisyBlock, cleanBlock, filteredBlock;
+
+    const std::function<void(Spectrogram::Column)> toWaterfall = [&](Spectrogram::Column column) {
+        visualizer.appendWaterfallColumn(column);
+    };
+
+    visualizer.setFrameCallback([&] {
+        const auto now = Clock::now();
+        due += params.liveRate * std::chrono::duration<double>(now - lastFrame).count();
+        lastFrame = now;
+        // После остановки (перетаскивание окна и т. п.) не догоняем больше экрана
+        const size_t n = static_cast<size_t>(std::min(due, static_cast<double>(options.samples)));
+        due = std::min(due - static_cast<double>(n), 1.0);
+        if (n == 0) return;
+
+        noisyBlock.resize(n);
+        noisyFeed->generateBlock(noisyBlock);
+        visualizer.appendLiveSamples(SignalVisualizer::Trace::NOISY, noisyBlock);
+        if (cleanFeed) {
+            cleanBlock.resize(n);
+            cleanFeed->generateBlock(cleanBlock);
+            visualizer.appendLiveSamples(SignalVisualizer::Trace::ORIGINAL, cleanBlock);
+        }
+
+        const auto t0 = Clock::now();
+        stream.push(noisyBlock, filteredBlock);
+        filterNs += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+        filtered += filteredBlock.size();
+        visualizer.appendLiveSamples(SignalVisualizer::Trace::FILTERED, filteredBlock);
+
+        spectrogram.push(waterfallOfInput ? noisyBlock : filteredBlock, toWaterfall);
+
+        if (now - lastTitle >= std::chrono::milliseconds(500) && filtered > 0) {
+            visualizer.setTitle(std::format("Live | {} | {:.0f} отсч/с | фильтр {:.1f} нс/отсч | водопад: {}",
+                                            stream.name(), params.liveRate,
+                                            static_cast<double>(filterNs) / static_cast<double>(filtered),
+                                            waterfallOfInput ? "вход" : "выход"));
+            lastTitle = now;
+            filterNs  = 0;
+            filtered  = 0;
+        }
+    });
+
+    visualizer.setKeyHandler([&](int key) {
+        if (key != GLFW_KEY_W) return;
+        waterfallOfInput = !waterfallOfInput;
+        spectrogram.reset();
+        std::cout << "Водопад: " << (waterfallOfInput ? "вход" : "выход фильтра") << "\n";
+    });
+
+    std::cout << "\nВерхняя панель: поток (новые отсчёты справа), нижняя: спектрограмма\n";
+    std::cout << "Клавиши: W — водопад входа / выхода фильтра\n";
+    visualizer.run();
+    return 0;
+}
+
+// ─── Настройка фильтра во время работы (клавиши [ и ]) ───────────────────────
+/**
+ * Основной параметр фильтра, меняемый клавишами
+ */
+struct TunableFilter {
+    std::string defaults;          ///< Параметры по умолчанию (как в createFilter)
+    size_t      index;             ///< Номер параметра в строке через запятую
+    double      step;              ///< Шаг; для multiplicative — множитель
+    double      minValue;
+    bool        multiplicative = false;
+};
+
+const std::map<std::string, TunableFilter>& tunableFilters() {
+    static const std::map<std::string, TunableFilter> filters = {
+        {"median",        {"7",                            0, 2.0,  1.0}},
+        {"wiener",        {"8,5,1e-4",                     0, 2.0,  2.0}},
+        {"robust_wiener", {"10,5,1e-4,3.5,11",             0, 2.0,  2.0}},
+        {"morpho",        {"opening,5",                    1, 2.0,  1.0}},
+        {"outlier",       {"mad,linear,3.0,11",            2, 0.25, 0.5}},
+        {"savgol",        {"11,3",                         0, 2.0,  3.0}},
+        {"kalman",        {"0.1,1.0,1.0",                  0, 2.0,  1e-6, true}},
+        {"spectral",      {"256,64,4,2.0,0.002,0.1,1.5",   3, 0.5,  0.5}},
+    };
+    return filters;
+}
+
+/**
+ * Сдвинуть основной параметр на шаг
+ * @param direction +1 — увеличить, −1 — уменьшить
+ * @return Новая строка параметров (недостающие дополняются значениями по умолчанию)
+ */
+std::string adjustParams(const std::string& type, const std::string& params, int direction) {
+    const TunableFilter& tf = tunableFilters().at(type);
+    auto parts    = split(params, ',');
+    auto defaults = split(tf.defaults, ',');
+    for (size_t i = parts.size(); i < defaults.size(); i++) parts.push_back(defaults[i]);
+
+    double value = std::stod(parts[tf.index]);
+    if (tf.multiplicative) value = direction > 0 ? value * tf.step : value / tf.step;
+    else                   value += direction * tf.step;
+
+    std::ostringstream out;
+    out << std::max(value, tf.minValue);
+    parts[tf.index] = out.str();
+
+    std::string result;
+    for (size_t i = 0; i < parts.size(); i++) result += (i ? "," : "") + parts[i];
+    return result;
+}
+
+std::string windowTitle(const std::string& algorithm, const FilterSnapshot& s) {
+    std::string title = "Signal Filter Visualization - " + algorithm;
+    switch (s.state) {
+        case FilterSnapshot::State::RUNNING:
+            return title + std::format(" | {:.0f}% (C — отмена)", 100.0 * s.progress());
+        case FilterSnapshot::State::FINISHED:
+            return title + std::format(" | {:.1f} мс", s.elapsedUs / 1000.0);
+        case FilterSnapshot::State::CANCELLED:
+            return title + " | отменено";
+        case FilterSnapshot::State::FAILED:
+            return title + " | ошибка";
+        default:
+            return title + " | фильтрация...";
+    }
+}
+
+/** Предфильтр, выполненный до запуска основного фильтра */
+struct PrefilterResult {
+    long long                     timeUs = 0;
+    std::optional<QualityMetrics> metrics;   ///< Если задан чистый сигнал
+};
+
+/** Итог завершённого фонового задания — в консоль */
+void printResults(const FilterSnapshot& s, const std::string& algorithm,
+                  const SignalProcessor::Signal& cleanSignal, const PrefilterResult& prefilter) {
+    if (s.state == FilterSnapshot::State::CANCELLED) {
+        std::cout << "Фильтрация отменена (" << s.done << " из " << s.total << " отсчётов)\n";
+        return;
+    }
+    if (s.state == FilterSnapshot::State::FAILED) {
+        std::cerr << "Ошибка фильтрации: " << s.error << "\n";
+        return;
+    }
+
+    std::cout << "\n=== РЕЗУЛЬТАТЫ ФИЛЬТРАЦИИ ===\n";
+    std::cout << "Алгоритм: " << algorithm << "\n";
+    std::cout << "Время предфильтра: " << prefilter.timeUs << " мкс\n";
+    std::cout << "Время основного фильтра: " << s.elapsedUs << " мкс\n";
+    std::cout << "Суммарное время: " << (prefilter.timeUs + s.elapsedUs) << " мкс\n";
+
+    if (!cleanSignal.empty()) {
+        if (prefilter.metrics) {
+            std::cout << "\nПосле предфильтра:\n";
+            std::cout << "  SNR: " << std::fixed << std::setprecision(2) << prefilter.metrics->snr << " дБ\n";
+            std::cout << "  MSE: " << std::scientific << std::setprecision(2) << prefilter.metrics->mse << "\n";
+        }
+
+        QualityMetrics m = calculateQualityMetrics(cleanSignal, s.output);
+        std::cout << "\nПосле основного фильтра:\n";
+        std::cout << "  SNR: " << std::fixed << std::setprecision(2) << m.snr << " дБ\n";
+        std::cout << "  MSE: " << std::scientific << std::setprecision(2) << m.mse << "\n";
+        std::cout << "  Корреляция: " << std::fixed << std::setprecision(3) << m.correlation << "\n";
+    } else {
+        std::cout << "Метрики качества не рассчитаны (отсутствует чистый сигнал)\n";
+    }
+}
+
 int main(int argc, char* argv[]) {
     std::cout << "================================================\n";
     std::cout << "  ВИЗУАЛИЗАЦИЯ ФИЛЬТРАЦИИ РАДИОЛОКАЦИОННЫХ СИГНАЛОВ\n";
@@ -399,6 +666,9 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
+        // ── Живой режим (--live) ──────────────────────────────────────────
+        if (params.liveMode) return runLiveMode(params);
+
         if (params.inputFile.empty()) {
             std::cerr << "Ошибка: необходимо указать входной файл (-i)" << std::endl;
             return 1;
@@ -406,37 +676,43 @@ int main(int argc, char* argv[]) {
 
         // ── Загрузка сигналов ─────────────────────────────────────────────
         std::cout << "Загрузка зашумленного сигнала: " << params.inputFile << "\n";
-        auto noisySignal = SignalGenerator::loadSignalFromCSV(params.inputFile);
+        auto noisySignal = SignalGenerator::loadSignal(params.inputFile);
 
         SignalProcessor::Signal cleanSignal;
         if (!params.cleanFile.empty()) {
             std::cout << "Загрузка чистого сигнала: " << params.cleanFile << "\n";
-            cleanSignal = SignalGenerator::loadSignalFromCSV(params.cleanFile);
+            cleanSignal = SignalGenerator::loadSignal(params.cleanFile);
         }
 
         // ── Предфильтрация outlier_detection ─────────────────────────────
+        // Выполняется сразу и один раз: её результат — вход основного фильтра
+        // и анализа режимов auto, а клавиши [ и ] меняют только основной фильтр
         SignalProcessor::Signal inputForFilter = noisySignal;
-        long long prefilterTime = 0;
+        PrefilterResult prefilter;
 
         if (params.prefilter) {
             std::cout << "Предфильтрация: OutlierDetection(MAD, linear, 3.0, 11)...\n";
-            OutlierDetection prefilter(
+            OutlierDetection outliers(
                 OutlierDetection::DetectionMethod::MAD_BASED,
                 OutlierDetection::InterpolationMethod::LINEAR,
                 3.0, 11);
-            auto [preOut, preTime] = prefilter.measurePerformance(noisySignal);
-            inputForFilter = preOut;
-            prefilterTime  = preTime;
-            std::cout << "  Предфильтрация завершена за " << prefilterTime << " мкс\n";
+            auto [preOut, preTime] = outliers.measurePerformance(noisySignal);
+            inputForFilter   = std::move(preOut);
+            prefilter.timeUs = preTime;
+            if (!cleanSignal.empty())
+                prefilter.metrics = calculateQualityMetrics(cleanSignal, inputForFilter);
+            std::cout << "  Предфильтрация завершена за " << prefilter.timeUs << " мкс\n";
         }
 
-        // ── Основной фильтр ───────────────────────────────────────────────
-        std::cout << "Создание фильтра: " << params.filterType;
-        if (!params.params.empty()) std::cout << " (параметры: " << params.params << ")";
-        std::cout << "\n";
+        // ── Фильтр: создаётся здесь, считается в фоновом потоке ───────────
+        // Окно открывается сразу, отфильтрованная кривая дорисовывается по
+        // мере готовности. Режимы auto анализируют сигнал один раз при
+        // запуске; у остальных основной параметр меняется клавишами [ и ]
+        std::string filterParams = params.params;
+        if (filterParams.empty() && tunableFilters().count(params.filterType))
+            filterParams = tunableFilters().at(params.filterType).defaults;
 
-        SignalProcessor::Signal filteredSignal;
-        long long filterTime = 0;
+        std::unique_ptr<SignalProcessor> autoFilter;
         std::string algorithmDescription;
 
         if (params.filterType == "robust_wiener_auto") {
@@ -461,14 +737,9 @@ int main(int argc, char* argv[]) {
                       << wp.outlierThreshold << "\n";
             std::cout << "  outlierWindow    = " << wp.outlierWindow    << "\n\n";
 
-            RobustWienerFilter filter(wp.filterOrder, wp.desiredWindow,
-                                      wp.regularization, wp.outlierThreshold,
-                                      wp.outlierWindow);
-
-            auto t0 = std::chrono::high_resolution_clock::now();
-            filteredSignal = filter.process(inputForFilter);
-            auto t1 = std::chrono::high_resolution_clock::now();
-            filterTime = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+            autoFilter = std::make_unique<RobustWienerFilter>(
+                wp.filterOrder, wp.desiredWindow, wp.regularization,
+                wp.outlierThreshold, wp.outlierWindow);
 
             algorithmDescription = "RobustWienerAuto[ord=" + std::to_string(wp.filterOrder)
                 + ",win=" + std::to_string(wp.desiredWindow)
@@ -476,81 +747,110 @@ int main(int argc, char* argv[]) {
                 + "]";
 
         } else if (params.filterType == "auto") {
-            // ── Автоматический режим: классификация → выбор → применение ─────
+            // ── Автоматический режим: классификация → выбор ───────────────────
             AdaptiveFilterSelector selector;
             SignalClassifier::SignalType detectedType;
-            std::string chosenFilterName;
-
-            auto t0 = std::chrono::high_resolution_clock::now();
-            filteredSignal = selector.processAuto(inputForFilter, detectedType, chosenFilterName);
-            auto t1 = std::chrono::high_resolution_clock::now();
-            filterTime = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+            autoFilter = selector.selectFilter(inputForFilter, detectedType);
 
             std::cout << "\n=== АВТОМАТИЧЕСКАЯ КЛАССИФИКАЦИЯ ===\n";
             std::cout << "Обнаруженный тип сигнала: "
                       << SignalClassifier::typeToString(detectedType) << "\n";
             std::cout << "Причина выбора: "
                       << AdaptiveFilterSelector::getSelectionReason(detectedType) << "\n";
-            std::cout << "Выбранный фильтр: " << chosenFilterName << "\n";
+            std::cout << "Выбранный фильтр: " << autoFilter->getName() << "\n";
 
             algorithmDescription = "AUTO[" + SignalClassifier::typeToString(detectedType)
-                                   + "] → " + chosenFilterName;
-        } else {
-            auto filter = createFilter(params.filterType, params.params);
-            auto [out, ft] = filter->measurePerformance(inputForFilter);
-            filteredSignal = std::move(out);
-            filterTime     = ft;
-            if (params.prefilter)
-                algorithmDescription = "OutlierDetection → " + filter->getName();
-            else
-                algorithmDescription = filter->getName();
+                                   + "] → " + autoFilter->getName();
         }
 
-        // ── Метрики ───────────────────────────────────────────────────────
-        std::cout << "\n=== РЕЗУЛЬТАТЫ ФИЛЬТРАЦИИ ===\n";
-        std::cout << "Алгоритм: " << algorithmDescription << "\n";
-
-        std::cout << "Время предфильтра: " << prefilterTime << " мкс\n";
-        std::cout << "Время основного фильтра: " << filterTime  << " мкс\n";
-        std::cout << "Суммарное время: " << (prefilterTime + filterTime) << " мкс\n";
-
-        if (!cleanSignal.empty()) {
-            // Метрики после предфильтра (если включён)
-            if (params.prefilter) {
-                double snrPre  = calculateSNR(cleanSignal, inputForFilter);
-                double msePre  = calculateMSE(cleanSignal, inputForFilter);
-                std::cout << "\nПосле предфильтра:\n";
-                std::cout << "  SNR: " << std::fixed << std::setprecision(2) << snrPre << " дБ\n";
-                std::cout << "  MSE: " << std::scientific << std::setprecision(2) << msePre << "\n";
+        BackgroundFilter background;
+        uint64_t currentJob = 0;
+
+        // Новое задание отменяет предыдущее; при недопустимых параметрах
+        // (конструктор бросил исключение) прежнее задание остаётся
+        auto restart = [&]() -> bool {
+            std::unique_ptr<SignalProcessor> filter;
+            try {
+                filter = autoFilter ? autoFilter->clone()
+                                    : createFilter(params.filterType, filterParams);
+            } catch (const std::exception& e) {
+                std::cerr << "Недопустимые параметры " << params.filterType
+                          << " (" << filterParams << "): " << e.what() << "\n";
+                return false;
             }
+            if (!autoFilter) {
+                algorithmDescription = params.prefilter ? "OutlierDetection → " + filter->getName()
+                                                        : filter->getName();
+            }
+            std::cout << "Фильтрация в фоне: " << algorithmDescription << "\n";
+            currentJob = background.start(inputForFilter, std::move(filter));
+            return true;
+        };
 
-            double snr = calculateSNR(cleanSignal, filteredSignal);
-            double mse = calculateMSE(cleanSignal, filteredSignal);
-            double correlation = calculateCorrelation(cleanSignal, filteredSignal);
-
-            std::cout << "\nПосле основного фильтра:\n";
-            std::cout << "  SNR: " << std::fixed << std::setprecision(2) << snr << " дБ\n";
-            std::cout << "  MSE: " << std::scientific << std::setprecision(2) << mse << "\n";
-            std::cout << "  Корреляция: " << std::fixed << std::setprecision(3) << correlation << "\n";
-        } else {
-            std::cout << "Метрики качества не рассчитаны (отсутствует чистый сигнал)\n";
-        }
+        std::cout << "Создание фильтра: " << params.filterType;
+        if (!filterParams.empty() && !autoFilter) std::cout << " (параметры: " << filterParams << ")";
+        std::cout << "\n";
+        if (!restart()) return 1;
 
         // ── OpenGL визуализация ───────────────────────────────────────────
         std::cout << "\nИнициализация OpenGL визуализации...\n";
 
-        std::string title = "Signal Filter Visualization - ";
-        title += algorithmDescription;
-
-        SignalVisualizer visualizer(1200, 800, title);
+        SignalVisualizer visualizer(1200, 800, windowTitle(algorithmDescription, FilterSnapshot()));
 
         if (!visualizer.initialize()) {
             std::cerr << "Ошибка инициализации визуализатора\n";
             return 1;
         }
 
-        // Передаём: noisy = исходный зашумлённый, filtered = результат цепочки, clean = эталон
-        visualizer.setSignalData(noisySignal, filteredSignal, cleanSignal);
+        // Передаём: noisy = исходный зашумлённый, clean = эталон; filtered
+        // появится из фонового потока
+        visualizer.setSignalData(noisySignal, {}, cleanSignal);
+
+        // Пирамида кривой перестраивается целиком, поэтому во время счёта
+        // кривая обновляется не чаще kRedrawPeriod, а не каждый кадр
+        using Clock = std::chrono::steady_clock;
+        constexpr auto kRedrawPeriod = std::chrono::milliseconds(100);
+        auto lastRedraw = Clock::now() - kRedrawPeriod;
+        bool pending    = false;   // снимок забран, но ещё не показан
+
+        visualizer.setFrameCallback([&] {
+            if (background.poll() && background.snapshot().job == currentJob) pending = true;
+            if (!pending) return;
+
+            const FilterSnapshot& s = background.snapshot();
+            const bool running = s.state == FilterSnapshot::State::RUNNING;
+            if (running && Clock::now() - lastRedraw < kRedrawPeriod) return;
+
+            pending    = false;
+            lastRedraw = Clock::now();
+            visualizer.updateFilteredSignal(s.output, s.state == FilterSnapshot::State::FINISHED);
+            visualizer.setTitle(windowTitle(algorithmDescription, s));
+            if (!running) printResults(s, algorithmDescription, cleanSignal, prefilter);
+        });
+
+        visualizer.setKeyHandler([&](int key) {
+            if (key == GLFW_KEY_C) {
+                if (background.busy()) {
+                    background.cancel();
+                    std::cout << "Отмена фильтрации...\n";
+                }
+                return;
+            }
+            const int direction = key == GLFW_KEY_RIGHT_BRACKET ? 1
+                                : key == GLFW_KEY_LEFT_BRACKET  ? -1 : 0;
+            if (direction == 0) return;
+
+            if (autoFilter || !tunableFilters().count(params.filterType)) {
+                std::cout << "Параметры " << params.filterType << " не настраиваются клавишами\n";
+                return;
+            }
+            const std::string previous = filterParams;
+            filterParams = adjustParams(params.filterType, filterParams, direction);
+            if (filterParams == previous) return;
+
+            std::cout << "\nПараметры: " << filterParams << "\n";
+            if (!restart()) filterParams = previous;
+        });
 
         std::cout << "\nЛегенда цветов:\n";
         if (!cleanSignal.empty()) std::cout << "  Зеленый - чистый сигнал\n";
@@ -559,6 +859,7 @@ int main(int argc, char* argv[]) {
         if (params.filterType == "auto" || params.prefilter)
             std::cout << " (" << algorithmDescription << ")";
         std::cout << "\n";
+        std::cout << "Клавиши: [ / ] — уменьшить / увеличить основной параметр фильтра, C — отменить фильтрацию\n";
 
         visualizer.run();
 
@@ -0,0 +1,20 @@
+#version 330 core
+// Прокручиваемая кривая из кольцевого VBO: в буфере только значения отсчётов,
+// X вычисляется по номеру вершины — самый новый отсчёт у правого края
+layout (location = 0) in float aValue;
+// newestVertex: ячейка самого нового отсчёта кривой
+uniform int   newestVertex;
+// lag: на сколько отсчётов кривая отстаёт от самой новой из кривых панели
+uniform float lag;
+// capacity: отсчётов на ширину окна
+uniform float capacity;
+// yRange: (min, max) значений панели
+uniform vec2  yRange;
+uniform float zoom;
+uniform vec2  offset;
+void main() {
+    float age = float(newestVertex - gl_VertexID) + lag;
+    float nx  = 1.0 - 2.0 * age / max(capacity - 1.0, 1.0);
+    float ny  = -1.0 + 2.0 * (aValue - yRange.x) / (yRange.y - yRange.x);
+    gl_Position = vec4(nx * zoom + offset.x, ny * zoom + offset.y, 0.0, 1.0);
+}
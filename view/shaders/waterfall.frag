@@ -0,0 +1,28 @@
+#version 330 core
+in vec2 TexCoord;
+out vec4 FragColor;
+// waterfall: R32F, x — столбцы по кольцу (время), y — бины (частота), значения в дБ
+uniform sampler2D waterfall;
+// head: доля ширины, с которой начинается самый старый столбец
+uniform float head;
+// dbRange: уровни (min, max), соответствующие краям палитры
+uniform vec2  dbRange;
+
+// Палитра: чёрный → синий → пурпурный → жёлтый → белый
+vec3 palette(float t) {
+    vec3 c0 = vec3(0.0, 0.0, 0.0);
+    vec3 c1 = vec3(0.1, 0.1, 0.6);
+    vec3 c2 = vec3(0.7, 0.1, 0.5);
+    vec3 c3 = vec3(1.0, 0.8, 0.1);
+    vec3 c4 = vec3(1.0, 1.0, 1.0);
+    if (t < 0.25) return mix(c0, c1, t / 0.25);
+    if (t < 0.50) return mix(c1, c2, (t - 0.25) / 0.25);
+    if (t < 0.75) return mix(c2, c3, (t - 0.50) / 0.25);
+    return mix(c3, c4, (t - 0.75) / 0.25);
+}
+
+void main() {
+    float db = texture(waterfall, vec2(fract(TexCoord.x + head), TexCoord.y)).r;
+    float t  = clamp((db - dbRange.x) / (dbRange.y - dbRange.x), 0.0, 1.0);
+    FragColor = vec4(palette(t), 1.0);
+}
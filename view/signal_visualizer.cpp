@@ -5,6 +5,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cmath>
+#include <stdexcept>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -41,6 +42,7 @@ SignalVisualizer::SignalVisualizer(int width, int height, const std::string& tit
     , logicalWidth_(width)
     , logicalHeight_(height)
     , windowTitle_(title)
+    , liveView_(false)
     , minY_(-2.0f), maxY_(2.0f)
     , autoScale_(true)
     , specMinY_(-80.0f), specMaxY_(0.0f)
@@ -51,13 +53,9 @@ SignalVisualizer::SignalVisualizer(int width, int height, const std::string& tit
     , showSpecBefore_(true), showSpecAfter_(true), showSpecDiff_(true)
     , splitView_(false), splitRatio_(0.6f)
     , shaderProgram_(0)
-    , originalVAO_(0), originalVBO_(0)
-    , noisyVAO_(0),    noisyVBO_(0)
-    , filteredVAO_(0), filteredVBO_(0)
-    , specBeforeVAO_(0), specBeforeVBO_(0)
-    , specAfterVAO_(0),  specAfterVBO_(0)
-    , specDiffVAO_(0),   specDiffVBO_(0)
     , textureShaderProgram_(0)
+    , liveShaderProgram_(0)
+    , waterfallShaderProgram_(0)
     , originalColor_(0.0f, 0.8f, 0.0f)
     , noisyColor_(0.8f, 0.0f, 0.0f)
     , filteredColor_(0.0f, 0.4f, 0.9f)
@@ -140,60 +138,46 @@ bool SignalVisualizer::initializeGLEW()
 
 bool SignalVisualizer::createShaderProgram()
 {
-    std::string vsSource = loadShaderSource(SHADER_DIR + "signal.vert");
-    std::string fsSource = loadShaderSource(SHADER_DIR + "signal.frag");
-    if (vsSource.empty() || fsSource.empty()) return false;
-
-    GLuint vs = compileShader(vsSource, GL_VERTEX_SHADER);
-    if (!vs) return false;
-    GLuint fs = compileShader(fsSource, GL_FRAGMENT_SHADER);
-    if (!fs) { glDeleteShader(vs); return false; }
-
-    shaderProgram_ = glCreateProgram();
-    glAttachShader(shaderProgram_, vs);
-    glAttachShader(shaderProgram_, fs);
-    glLinkProgram(shaderProgram_);
+    shaderProgram_ = createProgram("signal.vert", "signal.frag");
+    return shaderProgram_ != 0;
+}
 
-    GLint ok; GLchar log[512];
-    glGetProgramiv(shaderProgram_, GL_LINK_STATUS, &ok);
-    if (!ok) {
-        glGetProgramInfoLog(shaderProgram_, 512, nullptr, log);
-        std::cerr << "Ошибка линковки шейдера: " << log << std::endl;
-        glDeleteShader(vs); glDeleteShader(fs);
-        return false;
-    }
-    glDeleteShader(vs); glDeleteShader(fs);
+bool SignalVisualizer::createTextureShaderProgram()
+{
+    textureShaderProgram_ = createProgram("button.vert", "button.frag");
+    if (!textureShaderProgram_) return false;
+    glUseProgram(textureShaderProgram_);
+    glUniform1i(glGetUniformLocation(textureShaderProgram_, "texSampler"), 0);
     return true;
 }
 
-bool SignalVisualizer::createTextureShaderProgram()
+GLuint SignalVisualizer::createProgram(const std::string& vertexFile, const std::string& fragmentFile)
 {
-    std::string vsSource = loadShaderSource(SHADER_DIR + "button.vert");
-    std::string fsSource = loadShaderSource(SHADER_DIR + "button.frag");
-    if (vsSource.empty() || fsSource.empty()) return false;
+    std::string vsSource = loadShaderSource(SHADER_DIR + vertexFile);
+    std::string fsSource = loadShaderSource(SHADER_DIR + fragmentFile);
+    if (vsSource.empty() || fsSource.empty()) return 0;
 
     GLuint vs = compileShader(vsSource, GL_VERTEX_SHADER);
-    if (!vs) return false;
+    if (!vs) return 0;
     GLuint fs = compileShader(fsSource, GL_FRAGMENT_SHADER);
-    if (!fs) { glDeleteShader(vs); return false; }
+    if (!fs) { glDeleteShader(vs); return 0; }
 
-    textureShaderProgram_ = glCreateProgram();
-    glAttachShader(textureShaderProgram_, vs);
-    glAttachShader(textureShaderProgram_, fs);
-    glLinkProgram(textureShaderProgram_);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs); glDeleteShader(fs);
 
     GLint ok; GLchar log[512];
-    glGetProgramiv(textureShaderProgram_, GL_LINK_STATUS, &ok);
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
     if (!ok) {
-        glGetProgramInfoLog(textureShaderProgram_, 512, nullptr, log);
-        std::cerr << "Ошибка линковки текстурного шейдера: " << log << std::endl;
-        glDeleteShader(vs); glDeleteShader(fs);
-        return false;
+        glGetProgramInfoLog(program, 512, nullptr, log);
+        std::cerr << "Ошибка линковки шейдера " << vertexFile << " + " << fragmentFile
+                  << ": " << log << std::endl;
+        glDeleteProgram(program);
+        return 0;
     }
-    glDeleteShader(vs); glDeleteShader(fs);
-    glUseProgram(textureShaderProgram_);
-    glUniform1i(glGetUniformLocation(textureShaderProgram_, "texSampler"), 0);
-    return true;
+    return program;
 }
 
 GLuint SignalVisualizer::compileShader(const std::string& source, GLenum type)  // NOLINT
@@ -247,23 +231,34 @@ void SignalVisualizer::setSignalData(const SignalProcessor::Signal& noisy,
                                      const SignalProcessor::Signal& filtered,
                                      const SignalProcessor::Signal& original)
 {
-    noisySignal_    = noisy;
-    filteredSignal_ = filtered;
-    originalSignal_ = original;
+    noisySignal_.lod    = MinMaxPyramid(noisy);
+    filteredSignal_.lod = MinMaxPyramid(filtered);
+    originalSignal_.lod = MinMaxPyramid(original);
 
     if (autoScale_) calculateAutoScale();
     updateSignalBuffers();
     initializeToggleButtons();
 }
 
+void SignalVisualizer::updateFilteredSignal(const SignalProcessor::Signal& filtered, bool rescale)
+{
+    filteredSignal_.lod = MinMaxPyramid(filtered);
+    if (rescale && autoScale_) {
+        calculateAutoScale();
+        updateSignalBuffers();
+    } else {
+        createSignalBuffers(filteredSignal_, minY_, maxY_);
+    }
+}
+
 void SignalVisualizer::enableSplitView(const SignalProcessor::Signal& specBefore,
                                        const SignalProcessor::Signal& specAfter,
                                        const SignalProcessor::Signal& specDiff,
                                        float ratio)
 {
-    specBefore_ = specBefore;
-    specAfter_  = specAfter;
-    specDiff_   = specDiff;
+    specBefore_.lod = MinMaxPyramid(specBefore);
+    specAfter_.lod  = MinMaxPyramid(specAfter);
+    specDiff_.lod   = MinMaxPyramid(specDiff);
     splitRatio_ = std::max(0.3f, std::min(0.8f, ratio));
     splitView_  = true;
 
@@ -278,6 +273,105 @@ void SignalVisualizer::disableSplitView()
     specButtons_.clear();
 }
 
+// ─── Живой режим ─────────────────────────────────────────────────────────────
+
+bool SignalVisualizer::enableLiveView(const LiveViewOptions& options)
+{
+    if (!liveShaderProgram_)
+        liveShaderProgram_ = createProgram("live.vert", "signal.frag");
+    if (!waterfallShaderProgram_)
+        waterfallShaderProgram_ = createProgram("button.vert", "waterfall.frag");
+    if (!liveShaderProgram_ || !waterfallShaderProgram_) return false;
+
+    liveOptions_ = options;
+    liveOptions_.samples = std::max<size_t>(options.samples, 2);
+    const size_t n = liveOptions_.samples;
+
+    // Кольцо кривой: 2·N float, заполняется по мере поступления отсчётов
+    for (LiveCurve* curve : {&liveOriginal_, &liveNoisy_, &liveFiltered_}) {
+        curve->ring = ScrollRing(n);
+        if (curve->vao == 0) { glGenVertexArrays(1, &curve->vao); glGenBuffers(1, &curve->vbo); }
+        glBindVertexArray(curve->vao);
+        glBindBuffer(GL_ARRAY_BUFFER, curve->vbo);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(2 * n * sizeof(float)),
+                     nullptr, GL_STREAM_DRAW);
+        glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+    }
+    glBindVertexArray(0);
+
+    // Водопад: текстура columns × bins, столбцы пишутся по кольцу;
+    // незаполненная часть — на нижнем уровне палитры
+    if (waterfall_.texture) { glDeleteTextures(1, &waterfall_.texture); waterfall_.texture = 0; }
+    waterfall_.columns = options.waterfallColumns;
+    waterfall_.bins    = options.waterfallBins;
+    waterfall_.written = 0;
+    if (waterfall_.columns > 0 && waterfall_.bins > 0) {
+        const std::vector<float> blank(waterfall_.columns * waterfall_.bins, options.waterfallMinDb);
+        glGenTextures(1, &waterfall_.texture);
+        glBindTexture(GL_TEXTURE_2D, waterfall_.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F,
+                     static_cast<GLsizei>(waterfall_.columns), static_cast<GLsizei>(waterfall_.bins),
+                     0, GL_RED, GL_FLOAT, blank.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        if (waterfall_.vao == 0) {
+            const float quad[] = { -1,-1,0,0,  1,-1,1,0,  -1,1,0,1,  1,1,1,1 };
+            glGenVertexArrays(1, &waterfall_.vao); glGenBuffers(1, &waterfall_.vbo);
+            glBindVertexArray(waterfall_.vao);
+            glBindBuffer(GL_ARRAY_BUFFER, waterfall_.vbo);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+            glEnableVertexAttribArray(1);
+            glBindVertexArray(0);
+        }
+        splitRatio_ = std::max(0.3f, std::min(0.8f, options.splitRatio));
+    }
+
+    minY_ = options.yMin;
+    maxY_ = options.yMax;
+    splitView_ = false;
+    liveView_  = true;
+    initializeToggleButtons();
+    return true;
+}
+
+void SignalVisualizer::appendLiveSamples(Trace trace, std::span<const double> samples)
+{
+    if (!liveView_ || samples.empty()) return;
+    LiveCurve& curve = trace == Trace::ORIGINAL ? liveOriginal_
+                     : trace == Trace::NOISY    ? liveNoisy_
+                                                : liveFiltered_;
+
+    liveScratch_.assign(samples.begin(), samples.end());
+    glBindBuffer(GL_ARRAY_BUFFER, curve.vbo);
+    curve.ring.append(samples.size(), [&](size_t cell, size_t index, size_t n) {
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(cell * sizeof(float)),
+                        static_cast<GLsizeiptr>(n * sizeof(float)), liveScratch_.data() + index);
+    });
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SignalVisualizer::appendWaterfallColumn(std::span<const float> column)
+{
+    if (!waterfall_.texture) return;
+    if (column.size() != waterfall_.bins)
+        throw std::invalid_argument("appendWaterfallColumn: column size must equal waterfallBins");
+
+    const GLint x = static_cast<GLint>(waterfall_.written % waterfall_.columns);
+    glBindTexture(GL_TEXTURE_2D, waterfall_.texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, 0, 1, static_cast<GLsizei>(waterfall_.bins),
+                    GL_RED, GL_FLOAT, column.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    ++waterfall_.written;
+}
+
 // ─── Масштабирование ─────────────────────────────────────────────────────────
 
 void SignalVisualizer::calculateAutoScale()
@@ -286,9 +380,10 @@ void SignalVisualizer::calculateAutoScale()
         minY_ = -2.0f; maxY_ = 2.0f; return;
     }
     double mn =  1e30, mx = -1e30;
-    for (const auto& sig : {noisySignal_, filteredSignal_, originalSignal_}) {
-        if (!sig.empty()) {
-            for (double v : sig) { mn = std::min(mn, v); mx = std::max(mx, v); }
+    for (const Curve* sig : {&noisySignal_, &filteredSignal_, &originalSignal_}) {
+        if (!sig->empty()) {
+            const MinMaxPyramid::Range r = sig->lod.range(0, sig->lod.size());
+            mn = std::min<double>(mn, r.min); mx = std::max<double>(mx, r.max);
         }
     }
     double range = mx - mn;
@@ -301,9 +396,10 @@ void SignalVisualizer::calculateAutoScale()
 void SignalVisualizer::calculateSpectrumScale()
 {
     double mn =  1e30, mx = -1e30;
-    for (const auto& sig : {specBefore_, specAfter_, specDiff_}) {
-        if (!sig.empty()) {
-            for (double v : sig) { mn = std::min(mn, v); mx = std::max(mx, v); }
+    for (const Curve* sig : {&specBefore_, &specAfter_, &specDiff_}) {
+        if (!sig->empty()) {
+            const MinMaxPyramid::Range r = sig->lod.range(0, sig->lod.size());
+            mn = std::min<double>(mn, r.min); mx = std::max<double>(mx, r.max);
         }
     }
     if (mn > mx) { specMinY_ = -80.0f; specMaxY_ = 0.0f; return; }
@@ -316,11 +412,11 @@ void SignalVisualizer::calculateSpectrumScale()
 
 // ─── Буферы ───────────────────────────────────────────────────────────────────
 
-float SignalVisualizer::indexToX(size_t index, size_t signalLength) const
+float SignalVisualizer::indexToX(double index, size_t signalLength) const
 {
     if (signalLength <= 1) return offsetX_;
-    float nx = -1.0f + (2.0f * index) / static_cast<float>(signalLength - 1);
-    return (nx * zoomFactor_) + offsetX_;
+    double nx = -1.0 + (2.0 * index) / static_cast<double>(signalLength - 1);
+    return static_cast<float>(nx * zoomFactor_ + offsetX_);
 }
 
 float SignalVisualizer::valueToY(double value, float yMin, float yMax) const
@@ -330,30 +426,52 @@ float SignalVisualizer::valueToY(double value, float yMin, float yMax) const
     return (ny * zoomFactor_) + offsetY_;
 }
 
+void SignalVisualizer::visibleRange(size_t signalLength, size_t& first, size_t& last) const
+{
+    first = 0; last = signalLength;
+    if (signalLength <= 1) return;
+
+    // X = nx·zoom + offsetX ∈ [-1, 1]  →  nx ∈ [(-1 − offsetX)/zoom, (1 − offsetX)/zoom]
+    const double scale = 0.5 * static_cast<double>(signalLength - 1);
+    const double lo = ((-1.0 - offsetX_) / zoomFactor_ + 1.0) * scale;
+    const double hi = (( 1.0 - offsetX_) / zoomFactor_ + 1.0) * scale;
+    const double n  = static_cast<double>(signalLength);
+
+    // По соседнему отсчёту за краями — чтобы линия доходила до границы окна
+    first = static_cast<size_t>(std::clamp(std::floor(lo), 0.0, n));
+    last  = static_cast<size_t>(std::clamp(std::ceil(hi) + 1.0, 0.0, n));
+}
+
 /**
- * Заполняет VAO/VBO для одной кривой.
- * yMin/yMax — диапазон значений панели, в которой она рисуется.
+ * Заполняет VAO/VBO видимой частью одной кривой: не больше двух вершин
+ * на столбец пикселей. Буфер растёт только при нехватке места.
  */
-void SignalVisualizer::createSignalBuffers(const SignalProcessor::Signal& signal,
-                                           GLuint& vao, GLuint& vbo,
-                                           float yMin, float yMax,
-                                           float /*xMin*/, float /*xMax*/)
-{
-    if (signal.empty()) return;
-
-    std::vector<float> verts;
-    verts.reserve(signal.size() * 2);
-    for (size_t i = 0; i < signal.size(); ++i) {
-        verts.push_back(indexToX(i, signal.size()));
-        verts.push_back(valueToY(signal[i], yMin, yMax));
-    }
-
-    if (vao == 0) { glGenVertexArrays(1, &vao); glGenBuffers(1, &vbo); }
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(verts.size() * sizeof(float)),
-                 verts.data(), GL_DYNAMIC_DRAW);
+void SignalVisualizer::createSignalBuffers(Curve& curve, float yMin, float yMax)
+{
+    curve.vertexCount = 0;
+    if (curve.empty()) return;
+
+    size_t first, last;
+    visibleRange(curve.lod.size(), first, last);
+    curve.lod.decimate(first, last, static_cast<size_t>(std::max(windowWidth_, 1)), lodPoints_);
+
+    lodVertices_.clear();
+    for (const MinMaxPyramid::Point& p : lodPoints_) {
+        lodVertices_.push_back(indexToX(p.index, curve.lod.size()));
+        lodVertices_.push_back(valueToY(p.value, yMin, yMax));
+    }
+    curve.vertexCount = lodPoints_.size();
+
+    if (curve.vao == 0) { glGenVertexArrays(1, &curve.vao); glGenBuffers(1, &curve.vbo); }
+    glBindVertexArray(curve.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, curve.vbo);
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(lodVertices_.size() * sizeof(float));
+    if (curve.vertexCount > curve.capacity) {
+        glBufferData(GL_ARRAY_BUFFER, bytes, lodVertices_.data(), GL_DYNAMIC_DRAW);
+        curve.capacity = curve.vertexCount;
+    } else if (bytes > 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, lodVertices_.data());
+    }
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glBindVertexArray(0);
@@ -361,19 +479,16 @@ void SignalVisualizer::createSignalBuffers(const SignalProcessor::Signal& signal
 
 void SignalVisualizer::updateSignalBuffers()
 {
-    createSignalBuffers(originalSignal_, originalVAO_, originalVBO_, minY_, maxY_);
-    createSignalBuffers(noisySignal_,    noisyVAO_,    noisyVBO_,    minY_, maxY_);
-    createSignalBuffers(filteredSignal_, filteredVAO_, filteredVBO_, minY_, maxY_);
+    createSignalBuffers(originalSignal_, minY_, maxY_);
+    createSignalBuffers(noisySignal_,    minY_, maxY_);
+    createSignalBuffers(filteredSignal_, minY_, maxY_);
 }
 
 void SignalVisualizer::updateSpectrumBuffers()
 {
-    createSignalBuffers(specBefore_, specBeforeVAO_, specBeforeVBO_,
-                        specMinY_, specMaxY_);
-    createSignalBuffers(specAfter_,  specAfterVAO_,  specAfterVBO_,
-                        specMinY_, specMaxY_);
-    createSignalBuffers(specDiff_,   specDiffVAO_,   specDiffVBO_,
-                        specMinY_, specMaxY_);
+    createSignalBuffers(specBefore_, specMinY_, specMaxY_);
+    createSignalBuffers(specAfter_,  specMinY_, specMaxY_);
+    createSignalBuffers(specDiff_,   specMinY_, specMaxY_);
 }
 
 // ═════════════════════════════════════════════════════════════════════════════
@@ -393,6 +508,7 @@ void SignalVisualizer::run()
 
     while (!shouldClose()) {
         processEvents();
+        if (frameCallback_) frameCallback_();
         render();
         glfwSwapBuffers(window_);
     }
@@ -408,6 +524,12 @@ void SignalVisualizer::processEvents()
     glfwPollEvents();
 }
 
+void SignalVisualizer::setTitle(const std::string& title)
+{
+    windowTitle_ = title;
+    if (window_) glfwSetWindowTitle(window_, windowTitle_.c_str());
+}
+
 // ─── Отрисовка ────────────────────────────────────────────────────────────────
 
 void SignalVisualizer::render()
@@ -415,7 +537,9 @@ void SignalVisualizer::render()
     glClearColor(0.12f, 0.12f, 0.14f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    if (splitView_) {
+    if (liveView_) {
+        drawLiveView();
+    } else if (splitView_) {
         drawTopPanel();
         drawBottomPanel();
     } else {
@@ -430,11 +554,11 @@ void SignalVisualizer::render()
                       static_cast<float>(windowHeight_));
 
         if (!originalSignal_.empty() && showOriginal_)
-            drawSignal(originalVAO_, originalSignal_.size(), originalColor_);
+            drawSignal(originalSignal_, originalColor_);
         if (!noisySignal_.empty() && showNoisy_)
-            drawSignal(noisyVAO_, noisySignal_.size(), noisyColor_);
+            drawSignal(noisySignal_, noisyColor_);
         if (!filteredSignal_.empty() && showFiltered_)
-            drawSignal(filteredVAO_, filteredSignal_.size(), filteredColor_);
+            drawSignal(filteredSignal_, filteredColor_);
 
         drawToggleButtons();
     }
@@ -453,11 +577,11 @@ void SignalVisualizer::drawTopPanel()
     drawAxes(0, 0, static_cast<float>(windowWidth_), static_cast<float>(topH));
 
     if (!originalSignal_.empty() && showOriginal_)
-        drawSignal(originalVAO_, originalSignal_.size(), originalColor_);
+        drawSignal(originalSignal_, originalColor_);
     if (!noisySignal_.empty() && showNoisy_)
-        drawSignal(noisyVAO_, noisySignal_.size(), noisyColor_);
+        drawSignal(noisySignal_, noisyColor_);
     if (!filteredSignal_.empty() && showFiltered_)
-        drawSignal(filteredVAO_, filteredSignal_.size(), filteredColor_);
+        drawSignal(filteredSignal_, filteredColor_);
 
     // Метка панели
     // (текстовый рендеринг не реализован в OpenGL-3.3 core без FreeType;
@@ -514,27 +638,97 @@ void SignalVisualizer::drawBottomPanel()
     drawAxes(0, 0, static_cast<float>(windowWidth_), static_cast<float>(botH));
 
     if (!specBefore_.empty() && showSpecBefore_)
-        drawSignal(specBeforeVAO_, specBefore_.size(), specBeforeColor_);
+        drawSignal(specBefore_, specBeforeColor_);
     if (!specAfter_.empty() && showSpecAfter_)
-        drawSignal(specAfterVAO_, specAfter_.size(), specAfterColor_);
+        drawSignal(specAfter_, specAfterColor_);
     if (!specDiff_.empty() && showSpecDiff_)
-        drawSignal(specDiffVAO_, specDiff_.size(), specDiffColor_);
+        drawSignal(specDiff_, specDiffColor_);
 
     drawSpecButtons();
 }
 
 // ─── Рисование одной кривой ───────────────────────────────────────────────────
 
-void SignalVisualizer::drawSignal(GLuint vao, size_t cnt, const Color& color)
+void SignalVisualizer::drawSignal(const Curve& curve, const Color& color)
 {
-    if (!vao || !cnt) return;
+    if (!curve.vao || !curve.vertexCount) return;
     glUniform3f(glGetUniformLocation(shaderProgram_, "color"),
                 color.r, color.g, color.b);
-    glBindVertexArray(vao);
-    glDrawArrays(GL_LINE_STRIP, 0, static_cast<GLsizei>(cnt));
+    glBindVertexArray(curve.vao);
+    glDrawArrays(GL_LINE_STRIP, 0, static_cast<GLsizei>(curve.vertexCount));
     glBindVertexArray(0);
 }
 
+// ─── Живой режим: прокручиваемые кривые и водопад ────────────────────────────
+
+void SignalVisualizer::drawLiveView()
+{
+    const bool withWaterfall = waterfall_.texture != 0;
+    const int  topH = withWaterfall ? static_cast<int>(windowHeight_ * splitRatio_) : windowHeight_;
+
+    glViewport(0, windowHeight_ - topH, windowWidth_, topH);
+    glUseProgram(shaderProgram_);
+    drawGrid(0, 0, static_cast<float>(windowWidth_), static_cast<float>(topH));
+    drawAxes(0, 0, static_cast<float>(windowWidth_), static_cast<float>(topH));
+
+    // Кривые выравниваются по самому новому отсчёту среди всех кривых
+    uint64_t newest = 0;
+    for (const LiveCurve* c : {&liveOriginal_, &liveNoisy_, &liveFiltered_})
+        newest = std::max(newest, c->ring.total());
+
+    glUseProgram(liveShaderProgram_);
+    glUniform1f(glGetUniformLocation(liveShaderProgram_, "capacity"),
+                static_cast<float>(liveOptions_.samples));
+    glUniform2f(glGetUniformLocation(liveShaderProgram_, "yRange"), minY_, maxY_);
+    glUniform1f(glGetUniformLocation(liveShaderProgram_, "zoom"), zoomFactor_);
+    glUniform2f(glGetUniformLocation(liveShaderProgram_, "offset"), offsetX_, offsetY_);
+    if (showOriginal_) drawLiveCurve(liveOriginal_, originalColor_, newest);
+    if (showNoisy_)    drawLiveCurve(liveNoisy_,    noisyColor_,    newest);
+    if (showFiltered_) drawLiveCurve(liveFiltered_, filteredColor_, newest);
+
+    glUseProgram(shaderProgram_);
+    drawToggleButtons();
+
+    if (withWaterfall) {
+        glViewport(0, 0, windowWidth_, windowHeight_ - topH);
+        drawWaterfall();
+    }
+}
+
+void SignalVisualizer::drawLiveCurve(const LiveCurve& curve, const Color& color, uint64_t newestSample)
+{
+    if (!curve.vao || curve.ring.total() == 0) return;
+    glUniform3f(glGetUniformLocation(liveShaderProgram_, "color"), color.r, color.g, color.b);
+    glUniform1i(glGetUniformLocation(liveShaderProgram_, "newestVertex"),
+                static_cast<GLint>(curve.ring.newest()));
+    glUniform1f(glGetUniformLocation(liveShaderProgram_, "lag"),
+                static_cast<float>(newestSample - curve.ring.total()));
+    glBindVertexArray(curve.vao);
+    glDrawArrays(GL_LINE_STRIP, static_cast<GLint>(curve.ring.first()),
+                 static_cast<GLsizei>(curve.ring.visible()));
+    glBindVertexArray(0);
+}
+
+void SignalVisualizer::drawWaterfall()
+{
+    // Самый новый столбец — у правого края, как и у кривых
+    const float head = static_cast<float>(waterfall_.written % waterfall_.columns)
+                     / static_cast<float>(waterfall_.columns);
+
+    glUseProgram(waterfallShaderProgram_);
+    glUniform1i(glGetUniformLocation(waterfallShaderProgram_, "waterfall"), 0);
+    glUniform1f(glGetUniformLocation(waterfallShaderProgram_, "head"), head);
+    glUniform2f(glGetUniformLocation(waterfallShaderProgram_, "dbRange"),
+                liveOptions_.waterfallMinDb, liveOptions_.waterfallMaxDb);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, waterfall_.texture);
+    glBindVertexArray(waterfall_.vao);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(shaderProgram_);
+}
+
 // ─── Сетка и оси ─────────────────────────────────────────────────────────────
 
 void SignalVisualizer::drawGrid(float /*vpX*/, float /*vpY*/,
@@ -722,6 +916,8 @@ void SignalVisualizer::framebufferSizeCallback(GLFWwindow* window, int w, int h)
         vis->windowHeight_ = h;
         // Обновляем логический размер (для hit-test курсора)
         glfwGetWindowSize(window, &vis->logicalWidth_, &vis->logicalHeight_);
+        // Число столбцов изменилось — прореживаем заново
+        vis->updateViewTransform();
     }
 }
 
@@ -771,6 +967,9 @@ void SignalVisualizer::keyCallback(GLFWwindow* window, int key, int /*sc*/,
                 vis->showSpecDiff_ = !vis->showSpecDiff_;
                 std::cout << "Разность НИП: " << (vis->showSpecDiff_ ? "показан" : "скрыт") << "\n";
             } break;
+        default:
+            if (vis->keyHandler_) vis->keyHandler_(key);
+            break;
     }
 }
 
@@ -900,19 +1099,30 @@ void SignalVisualizer::cleanup()
 {
     cleanupButtonTextures();
 
-    auto del = [](GLuint& vao, GLuint& vbo) {
-        if (vao) { glDeleteVertexArrays(1, &vao); vao = 0; }
-        if (vbo) { glDeleteBuffers(1,  &vbo);     vbo = 0; }
+    auto del = [](Curve& curve) {
+        if (curve.vao) { glDeleteVertexArrays(1, &curve.vao); curve.vao = 0; }
+        if (curve.vbo) { glDeleteBuffers(1,  &curve.vbo);     curve.vbo = 0; }
+        curve.vertexCount = curve.capacity = 0;
     };
-    del(originalVAO_,  originalVBO_);
-    del(noisyVAO_,     noisyVBO_);
-    del(filteredVAO_,  filteredVBO_);
-    del(specBeforeVAO_,specBeforeVBO_);
-    del(specAfterVAO_, specAfterVBO_);
-    del(specDiffVAO_,  specDiffVBO_);
+    del(originalSignal_);
+    del(noisySignal_);
+    del(filteredSignal_);
+    del(specBefore_);
+    del(specAfter_);
+    del(specDiff_);
+
+    for (LiveCurve* curve : {&liveOriginal_, &liveNoisy_, &liveFiltered_}) {
+        if (curve->vao) { glDeleteVertexArrays(1, &curve->vao); curve->vao = 0; }
+        if (curve->vbo) { glDeleteBuffers(1,  &curve->vbo);     curve->vbo = 0; }
+    }
+    if (waterfall_.texture) { glDeleteTextures(1, &waterfall_.texture);    waterfall_.texture = 0; }
+    if (waterfall_.vao)     { glDeleteVertexArrays(1, &waterfall_.vao);    waterfall_.vao = 0; }
+    if (waterfall_.vbo)     { glDeleteBuffers(1, &waterfall_.vbo);         waterfall_.vbo = 0; }
 
     if (shaderProgram_)        { glDeleteProgram(shaderProgram_);        shaderProgram_        = 0; }
     if (textureShaderProgram_) { glDeleteProgram(textureShaderProgram_); textureShaderProgram_ = 0; }
+    if (liveShaderProgram_)      { glDeleteProgram(liveShaderProgram_);      liveShaderProgram_      = 0; }
+    if (waterfallShaderProgram_) { glDeleteProgram(waterfallShaderProgram_); waterfallShaderProgram_ = 0; }
 
     if (window_) { glfwDestroyWindow(window_); window_ = nullptr; }
     glfwTerminate();
@@ -2,15 +2,33 @@
 #define SIGNAL_VISUALIZER_H
 
 #include "../src/signal_processor.h"
+#include "../src/utils/minmax_pyramid.h"
+#include "../src/utils/scroll_ring.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <functional>
+#include <span>
 #include <string>
 #include <vector>
 
+/**
+ * Параметры живого режима (SignalVisualizer::enableLiveView)
+ */
+struct LiveViewOptions {
+    size_t samples          = 8192;    ///< Отсчётов на ширину окна
+    float  yMin             = -2.0f;   ///< Диапазон значений временной панели
+    float  yMax             =  2.0f;
+    size_t waterfallColumns = 0;       ///< Столбцов водопада; 0 — без водопада
+    size_t waterfallBins    = 0;       ///< Бинов в столбце (Spectrogram::bins())
+    float  waterfallMinDb   = -80.0f;  ///< Уровни, соответствующие краям палитры
+    float  waterfallMaxDb   =   0.0f;
+    float  splitRatio       = 0.6f;    ///< Доля высоты временной панели (с водопадом)
+};
+
 /**
  * Класс для визуализации сигналов с использованием OpenGL.
  *
- * Поддерживает два режима:
+ * Поддерживает три режима:
  *
  * 1. Обычный режим (splitView_ = false):
  *    Одна панель — временной сигнал (original / noisy / filtered).
@@ -22,6 +40,25 @@
  *      - specBefore_  (до компенсации)
  *      - specAfter_   (после компенсации)
  *      - specDiff_    (разность = подавленная НИП)
+ *
+ * 3. Живой режим (enableLiveView()):
+ *    Кривые прокручиваются справа налево по мере поступления отсчётов
+ *    (appendLiveSamples() из колбэка кадра), внизу — водопад: спектрограмма
+ *    или доплеровские спектры по столбцу на appendWaterfallColumn().
+ *    Каждая кривая живёт в кольцевом VBO (utils/scroll_ring.h), водопад —
+ *    в кольцевой текстуре; за кадр на GPU уходят только новые отсчёты и
+ *    столбцы (glBufferSubData / glTexSubImage2D), а сдвиг делают шейдеры.
+ *
+ * Кривые рисуются с прореживанием (utils/minmax_pyramid.h): в буфер вершин
+ * попадает только видимая часть сигнала, не больше двух вершин (min и max)
+ * на столбец пикселей. При зуме, панорамировании и изменении размера окна
+ * видимая часть прореживается заново — время кадра не зависит от длины
+ * сигнала, и запись из миллионов отсчётов остаётся интерактивной.
+ *
+ * Данные можно менять во время run(): колбэк кадра (setFrameCallback)
+ * вызывается в потоке отрисовки перед каждым кадром — например, чтобы
+ * забрать частичный результат фонового фильтра и передать его в
+ * updateFilteredSignal().
  */
 class SignalVisualizer {
 private:
@@ -32,15 +69,53 @@ private:
     int logicalHeight_;
     std::string windowTitle_;
 
+    // ── Кривая: отсчёты с пирамидой min/max и буфер видимых вершин ──────
+    struct Curve {
+        MinMaxPyramid lod;
+        GLuint vao         = 0;
+        GLuint vbo         = 0;
+        size_t vertexCount = 0;   ///< Вершин видимой части
+        size_t capacity    = 0;   ///< Вершин, под которые выделен vbo
+
+        bool empty() const { return lod.empty(); }
+    };
+
     // ── Данные временного сигнала ─────────────────────────────────────────
-    SignalProcessor::Signal originalSignal_;
-    SignalProcessor::Signal noisySignal_;
-    SignalProcessor::Signal filteredSignal_;
+    Curve originalSignal_;
+    Curve noisySignal_;
+    Curve filteredSignal_;
 
     // ── Данные доплеровского спектра (дБ) ─────────────────────────────────
-    SignalProcessor::Signal specBefore_;   ///< Спектр до компенсации
-    SignalProcessor::Signal specAfter_;    ///< Спектр после компенсации
-    SignalProcessor::Signal specDiff_;     ///< Разность (подавленная НИП)
+    Curve specBefore_;   ///< Спектр до компенсации
+    Curve specAfter_;    ///< Спектр после компенсации
+    Curve specDiff_;     ///< Разность (подавленная НИП)
+
+    // ── Рабочие буферы прореживания (переиспользуются между кадрами) ─────
+    std::vector<MinMaxPyramid::Point> lodPoints_;
+    std::vector<float>                lodVertices_;
+
+    // ── Живой режим: кольцевые VBO кривых и кольцевая текстура водопада ──
+    struct LiveCurve {
+        ScrollRing ring;
+        GLuint     vao = 0;
+        GLuint     vbo = 0;   ///< 2·N float: отсчёт хранится в ячейках t mod N и t mod N + N
+    };
+    struct Waterfall {
+        GLuint   texture = 0;   ///< R32F, columns × bins, столбцы по кольцу
+        GLuint   vao     = 0;   ///< Прямоугольник панели
+        GLuint   vbo     = 0;
+        size_t   columns = 0;
+        size_t   bins    = 0;
+        uint64_t written = 0;   ///< Столбцов записано за всё время
+    };
+
+    bool            liveView_;
+    LiveViewOptions liveOptions_;
+    LiveCurve       liveOriginal_;
+    LiveCurve       liveNoisy_;
+    LiveCurve       liveFiltered_;
+    Waterfall       waterfall_;
+    std::vector<float> liveScratch_;   ///< Отсчёты блока в float для загрузки
 
     // ── Параметры отображения (временная панель) ──────────────────────────
     float minY_, maxY_;
@@ -70,20 +145,20 @@ private:
     bool splitView_;           ///< true → верхняя (60%) + нижняя (40%) панели
     float splitRatio_;         ///< Доля высоты для верхней панели (0..1, по умолч. 0.6)
 
-    // ── OpenGL объекты (временные кривые) ─────────────────────────────────
+    // ── OpenGL объекты ────────────────────────────────────────────────────
     GLuint shaderProgram_;
-    GLuint originalVAO_, originalVBO_;
-    GLuint noisyVAO_,    noisyVBO_;
-    GLuint filteredVAO_, filteredVBO_;
 
-    // ── OpenGL объекты (спектральные кривые) ──────────────────────────────
-    GLuint specBeforeVAO_, specBeforeVBO_;
-    GLuint specAfterVAO_,  specAfterVBO_;
-    GLuint specDiffVAO_,   specDiffVBO_;
+    // ── Колбэки приложения ────────────────────────────────────────────────
+    std::function<void()>    frameCallback_;
+    std::function<void(int)> keyHandler_;
 
     // ── Шейдерная программа для текстурных кнопок ────────────────────────
     GLuint textureShaderProgram_;
 
+    // ── Шейдеры живого режима (создаются в enableLiveView) ────────────────
+    GLuint liveShaderProgram_;
+    GLuint waterfallShaderProgram_;
+
     // ── Цвета ─────────────────────────────────────────────────────────────
     struct Color {
         float r, g, b;
@@ -140,6 +215,15 @@ public:
                        const SignalProcessor::Signal& filtered,
                        const SignalProcessor::Signal& original = {});
 
+    /**
+     * Заменить отфильтрованный сигнал, сохранив вид.
+     * NaN-отсчёты (ещё не посчитанные) не рисуются.
+     * @param rescale Пересчитать автомасштаб по всем трём кривым (если он
+     *                включён) — для окончательного результата; промежуточные
+     *                снимки рисуются в прежнем масштабе
+     */
+    void updateFilteredSignal(const SignalProcessor::Signal& filtered, bool rescale = false);
+
     // ── Split-view API ────────────────────────────────────────────────────
 
     /**
@@ -161,10 +245,40 @@ public:
      */
     void disableSplitView();
 
+    // ── Живой режим ───────────────────────────────────────────────────────
+
+    /// Кривая временной панели
+    enum class Trace { ORIGINAL, NOISY, FILTERED };
+
+    /**
+     * Включить живой режим (вызывать после initialize()).
+     * Кривые и водопад начинаются пустыми.
+     * @return false — не удалось собрать шейдеры
+     */
+    bool enableLiveView(const LiveViewOptions& options = LiveViewOptions());
+
+    /**
+     * Дописать отсчёты кривой. Кривые выравниваются по номеру отсчёта:
+     * если отфильтрованный поток запаздывает, его конец не доходит до
+     * правого края.
+     */
+    void appendLiveSamples(Trace trace, std::span<const double> samples);
+
+    /** Дописать столбец водопада (waterfallBins значений, дБ) */
+    void appendWaterfallColumn(std::span<const float> column);
+
     // ── Цикл работы ──────────────────────────────────────────────────────
 
     void run();
     bool shouldClose() const;
+
+    /** Вызывать перед каждым кадром run() (в потоке отрисовки) */
+    void setFrameCallback(std::function<void()> callback) { frameCallback_ = std::move(callback); }
+
+    /** Обработчик клавиш, не занятых визуализатором (код GLFW_KEY_*) */
+    void setKeyHandler(std::function<void(int key)> handler) { keyHandler_ = std::move(handler); }
+
+    void setTitle(const std::string& title);
     void render();
     void processEvents();
 
@@ -174,14 +288,17 @@ private:
     bool initializeGLEW();
     bool createShaderProgram();
     bool createTextureShaderProgram();
+    /** Собрать программу из файлов SHADER_DIR; 0 — ошибка (уже выведена) */
+    GLuint createProgram(const std::string& vertexFile, const std::string& fragmentFile);
     GLuint compileShader(const std::string& source, GLenum type);
     GLuint loadTexture(const std::string& path);
 
     // ── Буферы ────────────────────────────────────────────────────────────
-    void createSignalBuffers(const SignalProcessor::Signal& signal,
-                             GLuint& vao, GLuint& vbo,
-                             float yMin, float yMax,
-                             float xMin = -1.0f, float xMax = 1.0f);
+    /**
+     * Прорядить видимую часть кривой и загрузить её вершины в VBO.
+     * yMin/yMax — диапазон значений панели, в которой она рисуется.
+     */
+    void createSignalBuffers(Curve& curve, float yMin, float yMax);
     void updateSignalBuffers();
     void updateSpectrumBuffers();
 
@@ -191,9 +308,15 @@ private:
 
     // ── Координатные преобразования ───────────────────────────────────────
     /**
-     * Преобразование индекса → X в диапазоне [-1, +1].
+     * Преобразование индекса (дробного — середина столбца) → X в диапазоне [-1, +1].
      */
-    float indexToX(size_t index, size_t signalLength) const;
+    float indexToX(double index, size_t signalLength) const;
+
+    /**
+     * Отсчёты [first, last) кривой длины signalLength, попадающие в окно
+     * при текущих зуме и панорамировании (с соседним отсчётом по краям).
+     */
+    void visibleRange(size_t signalLength, size_t& first, size_t& last) const;
 
     /**
      * Преобразование значения → Y в панельных координатах [-1, +1]
@@ -205,7 +328,11 @@ private:
     void drawTopPanel();
     void drawBottomPanel();
 
-    void drawSignal(GLuint vao, size_t pointCount, const Color& color);
+    void drawSignal(const Curve& curve, const Color& color);
+
+    void drawLiveView();
+    void drawLiveCurve(const LiveCurve& curve, const Color& color, uint64_t newestSample);
+    void drawWaterfall();
     void drawGrid(float vpX, float vpY, float vpW, float vpH);
     void drawAxes(float vpX, float vpY, float vpW, float vpH);
 